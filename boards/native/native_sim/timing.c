@@ -0,0 +1,55 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Timing functions counting host nanoseconds, so that the execution time
+ * of code can be measured while the simulated time stands still.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "timing_bottom.h"
+
+void board_timing_init(void)
+{
+}
+
+void board_timing_start(void)
+{
+}
+
+void board_timing_stop(void)
+{
+}
+
+timing_t board_timing_counter_get(void)
+{
+	return native_sim_host_time_ns();
+}
+
+uint64_t board_timing_cycles_get(volatile timing_t *const start,
+				 volatile timing_t *const end)
+{
+	return *end - *start;
+}
+
+uint64_t board_timing_freq_get(void)
+{
+	return NSEC_PER_SEC;
+}
+
+uint64_t board_timing_cycles_to_ns(uint64_t cycles)
+{
+	return cycles;
+}
+
+uint64_t board_timing_cycles_to_ns_avg(uint64_t cycles, uint32_t count)
+{
+	return cycles / count;
+}
+
+uint32_t board_timing_freq_get_mhz(void)
+{
+	return (uint32_t)(NSEC_PER_SEC / MHZ(1));
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Bottom/Linux side of the host clock based timing functions
+ */
+
+#undef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+
+#include <stdint.h>
+#include <time.h>
+#include "timing_bottom.h"
+
+uint64_t native_sim_host_time_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BOARDS_NATIVE_NATIVE_SIM_TIMING_BOTTOM_H
+#define BOARDS_NATIVE_NATIVE_SIM_TIMING_BOTTOM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t native_sim_host_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOARDS_NATIVE_NATIVE_SIM_TIMING_BOTTOM_H */
@@ -92,6 +92,154 @@ extern "C" {
 		}						\
 	} while (0)
 
+/**
+ * @brief Writes an ERROR level message to the log with rate limiting.
+ *
+ * @details At most @kconfig{CONFIG_LOG_RATELIMIT_BURST} messages are logged
+ * from the call site per @kconfig{CONFIG_LOG_RATELIMIT_INTERVAL_MS}, further
+ * ones are suppressed and their number is reported later.
+ *
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_ERR_RATELIMIT(...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_ERR, CONFIG_LOG_RATELIMIT_BURST, \
+			CONFIG_LOG_RATELIMIT_INTERVAL_MS, __VA_ARGS__)
+
+/**
+ * @brief Writes a WARNING level message to the log with rate limiting.
+ *
+ * @details At most @kconfig{CONFIG_LOG_RATELIMIT_BURST} messages are logged
+ * from the call site per @kconfig{CONFIG_LOG_RATELIMIT_INTERVAL_MS}, further
+ * ones are suppressed and their number is reported later.
+ *
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_WRN_RATELIMIT(...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_WRN, CONFIG_LOG_RATELIMIT_BURST, \
+			CONFIG_LOG_RATELIMIT_INTERVAL_MS, __VA_ARGS__)
+
+/**
+ * @brief Writes an INFO level message to the log with rate limiting.
+ *
+ * @details At most @kconfig{CONFIG_LOG_RATELIMIT_BURST} messages are logged
+ * from the call site per @kconfig{CONFIG_LOG_RATELIMIT_INTERVAL_MS}, further
+ * ones are suppressed and their number is reported later.
+ *
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_INF_RATELIMIT(...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_INF, CONFIG_LOG_RATELIMIT_BURST, \
+			CONFIG_LOG_RATELIMIT_INTERVAL_MS, __VA_ARGS__)
+
+/**
+ * @brief Writes a DEBUG level message to the log with rate limiting.
+ *
+ * @details At most @kconfig{CONFIG_LOG_RATELIMIT_BURST} messages are logged
+ * from the call site per @kconfig{CONFIG_LOG_RATELIMIT_INTERVAL_MS}, further
+ * ones are suppressed and their number is reported later.
+ *
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_DBG_RATELIMIT(...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_DBG, CONFIG_LOG_RATELIMIT_BURST, \
+			CONFIG_LOG_RATELIMIT_INTERVAL_MS, __VA_ARGS__)
+
+/**
+ * @brief Writes an ERROR level message to the log with a given rate limit.
+ *
+ * @param _burst       Number of messages logged per interval.
+ * @param _interval_ms Interval in milliseconds.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_ERR_RATELIMIT_RATE(_burst, _interval_ms, ...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_ERR, _burst, _interval_ms, __VA_ARGS__)
+
+/**
+ * @brief Writes a WARNING level message to the log with a given rate limit.
+ *
+ * @param _burst       Number of messages logged per interval.
+ * @param _interval_ms Interval in milliseconds.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_WRN_RATELIMIT_RATE(_burst, _interval_ms, ...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_WRN, _burst, _interval_ms, __VA_ARGS__)
+
+/**
+ * @brief Writes an INFO level message to the log with a given rate limit.
+ *
+ * @param _burst       Number of messages logged per interval.
+ * @param _interval_ms Interval in milliseconds.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_INF_RATELIMIT_RATE(_burst, _interval_ms, ...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_INF, _burst, _interval_ms, __VA_ARGS__)
+
+/**
+ * @brief Writes a DEBUG level message to the log with a given rate limit.
+ *
+ * @param _burst       Number of messages logged per interval.
+ * @param _interval_ms Interval in milliseconds.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_DBG_RATELIMIT_RATE(_burst, _interval_ms, ...) \
+	Z_LOG_RATELIMIT(LOG_LEVEL_DBG, _burst, _interval_ms, __VA_ARGS__)
+
+/**
+ * @brief Writes an ERROR level message to the log for one in every @p _n calls.
+ *
+ * @details The first call logs, the following @p _n - 1 calls are suppressed
+ * and their number is reported later.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_ERR_SAMPLED(_n, ...) Z_LOG_SAMPLED(LOG_LEVEL_ERR, _n, __VA_ARGS__)
+
+/**
+ * @brief Writes a WARNING level message to the log for one in every @p _n calls.
+ *
+ * @details The first call logs, the following @p _n - 1 calls are suppressed
+ * and their number is reported later.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_WRN_SAMPLED(_n, ...) Z_LOG_SAMPLED(LOG_LEVEL_WRN, _n, __VA_ARGS__)
+
+/**
+ * @brief Writes an INFO level message to the log for one in every @p _n calls.
+ *
+ * @details The first call logs, the following @p _n - 1 calls are suppressed
+ * and their number is reported later.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_INF_SAMPLED(_n, ...) Z_LOG_SAMPLED(LOG_LEVEL_INF, _n, __VA_ARGS__)
+
+/**
+ * @brief Writes a DEBUG level message to the log for one in every @p _n calls.
+ *
+ * @details The first call logs, the following @p _n - 1 calls are suppressed
+ * and their number is reported later.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_DBG_SAMPLED(_n, ...) Z_LOG_SAMPLED(LOG_LEVEL_DBG, _n, __VA_ARGS__)
+
 /**
  * @brief Unconditionally print raw log message.
  *
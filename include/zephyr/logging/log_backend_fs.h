@@ -0,0 +1,65 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LOG_BACKEND_FS_H_
+#define ZEPHYR_LOG_BACKEND_FS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief File system backend statistics.
+ */
+struct log_backend_fs_stats {
+	/** Bytes of formatted log output handed to the backend. */
+	uint64_t bytes_logged;
+	/** Bytes passed to fs_write(). */
+	uint64_t bytes_written;
+	/** Number of fs_write() calls. */
+	uint32_t writes;
+	/** Number of fs_sync() calls. */
+	uint32_t syncs;
+	/** Number of times a new log file was started. */
+	uint32_t rotations;
+	/** Number of times the log processing thread was blocked on the file system. */
+	uint32_t stalls;
+	/** Longest time the log processing thread was blocked, in microseconds. */
+	uint32_t stall_max_us;
+	/** Total time the log processing thread was blocked, in microseconds. */
+	uint64_t stall_total_us;
+};
+
+/**
+ * @brief Get the file system backend statistics.
+ *
+ * @details In synchronous mode every write blocks the log processing thread, so
+ *          each write counts as a stall. With CONFIG_LOG_BACKEND_FS_ASYNC only
+ *          waiting for a buffer that is still being written counts.
+ *
+ * @param stats Location to store the statistics at.
+ */
+void log_backend_fs_stats_get(struct log_backend_fs_stats *stats);
+
+/**
+ * @brief Write out the buffered log output.
+ *
+ * @details With CONFIG_LOG_BACKEND_FS_ASYNC the output is buffered in RAM and
+ *          written when a buffer fills up or after
+ *          CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT milliseconds. This
+ *          function writes the buffered output right away, from the calling
+ *          thread, and returns once it is on the file system. It does nothing
+ *          in synchronous mode.
+ */
+void log_backend_fs_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LOG_BACKEND_FS_H_ */
@@ -319,6 +319,92 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG(_level, ...)                 Z_LOG2(_level, 0, Z_LOG_CURRENT_DATA(), __VA_ARGS__)
 #define Z_LOG_INSTANCE(_level, _inst, ...) Z_LOG2(_level, 1, Z_LOG_INST(_inst), __VA_ARGS__)
 
+/*****************************************************************************/
+/****************** Macros for rate limited logging **************************/
+/*****************************************************************************/
+
+/** @brief State of a rate limited or sampled logging call site.
+ *
+ * One instance per call site is placed in an iterable section so that the log
+ * core can report suppressed messages. All fields updated at runtime are
+ * atomic, call sites never take a lock.
+ */
+struct log_ratelimit {
+	/** Messages left in the current interval or, when sampling, call counter. */
+	atomic_t tokens;
+	/** Uptime in milliseconds at which the current interval started. */
+	atomic_t start;
+	/** Messages suppressed since the last report. */
+	atomic_t suppressed;
+	/** Source of the last suppressed message. */
+	const void *source;
+	/** Format string of the last suppressed message. */
+	const char *fmt;
+	/** Interval in milliseconds or, when sampling, the sampling period. */
+	uint32_t period;
+	/** Messages allowed per interval, 0 when sampling. */
+	uint16_t burst;
+	/** Level of the call site. */
+	uint8_t level;
+};
+
+/** @brief Take a token of a rate limited call site.
+ *
+ * @param rl     Call site state.
+ * @param source Source of the message.
+ * @param fmt    Format string of the message.
+ *
+ * @retval true  Message shall be logged.
+ * @retval false Message is suppressed.
+ */
+bool z_log_ratelimit_take(struct log_ratelimit *rl, const void *source, const char *fmt);
+
+/** @brief Check if a sampled call site shall log.
+ *
+ * @param rl     Call site state.
+ * @param source Source of the message.
+ * @param fmt    Format string of the message.
+ *
+ * @retval true  Message shall be logged.
+ * @retval false Message is suppressed.
+ */
+bool z_log_sample_take(struct log_ratelimit *rl, const void *source, const char *fmt);
+
+/* The state is not __used so that it is dropped together with call sites
+ * removed at compile time, e.g. debug messages of a module logging at info
+ * level. Calls from user mode cannot access it and are not limited.
+ */
+#ifdef CONFIG_LOG
+#define Z_LOG_LIMITED(_level, _take, _burst, _period, ...)                                        \
+	do {                                                                                       \
+		static Z_DECL_ALIGN(struct log_ratelimit) _log_rl                                  \
+			__in_section(_log_ratelimit, static, _log_rl_) __noasan = {                \
+			.tokens = ATOMIC_INIT(_burst),                                             \
+			.period = (_period),                                                       \
+			.burst = (_burst),                                                         \
+			.level = (_level),                                                         \
+		};                                                                                 \
+		BUILD_ASSERT(((_period) > 0) && ((_burst) <= UINT16_MAX),                          \
+			     "Invalid log rate limit");                                            \
+		if (!Z_LOG_LEVEL_ALL_CHECK(_level, 0, Z_LOG_CURRENT_DATA())) {                     \
+			break;                                                                     \
+		}                                                                                  \
+		if ((!IS_ENABLED(CONFIG_USERSPACE) || !k_is_user_context()) &&                     \
+		    !_take(&_log_rl, Z_LOG_CURRENT_DATA(), GET_ARG_N(1, __VA_ARGS__))) {           \
+			break;                                                                     \
+		}                                                                                  \
+		Z_LOG(_level, __VA_ARGS__);                                                        \
+	} while (false)
+#else
+#define Z_LOG_LIMITED(_level, _take, _burst, _period, ...) Z_LOG(_level, __VA_ARGS__)
+#endif
+
+#define Z_LOG_RATELIMIT(_level, _burst, _interval_ms, ...)                                         \
+	Z_LOG_LIMITED(_level, z_log_ratelimit_take, _burst, _interval_ms, __VA_ARGS__)
+
+#define Z_LOG_SAMPLED(_level, _n, ...)                                                             \
+	Z_LOG_LIMITED(_level, z_log_sample_take, 0, _n, __VA_ARGS__)
+
 /*****************************************************************************/
 /****************** Macros for hexdump logging *******************************/
 /*****************************************************************************/
@@ -284,6 +284,21 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get number of messages dropped on a CPU.
+ *
+ * Requires CONFIG_LOG_PERCPU_BUFFERS option. The counter is not cleared when
+ * the dropped messages are reported.
+ *
+ * @param cpu_id CPU index.
+ * @param[out] dropped Number of messages dropped since boot on the CPU.
+ *
+ * @retval -EINVAL if @p cpu_id is not a valid CPU index.
+ * @retval -ENOTSUP if per-CPU buffers are not enabled.
+ * @retval 0 successfully read the counter.
+ */
+int log_cpu_dropped_get(unsigned int cpu_id, uint32_t *dropped);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
@@ -51,6 +51,13 @@ uint32_t z_log_dropped_read_and_clear(void);
  */
 bool z_log_dropped_pending(void);
 
+/** @brief Report messages suppressed by rate limited and sampled call sites.
+ *
+ * Called by the log processing when in deferred mode. Reports are emitted at
+ * most once per CONFIG_LOG_RATELIMIT_INTERVAL_MS.
+ */
+void z_log_ratelimit_process(void);
+
 /** @brief Free allocated buffer.
  *
  * @param buf Buffer.
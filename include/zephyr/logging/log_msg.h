@@ -499,7 +499,40 @@ do { \
  *
  * @param ...  Optional string with arguments (fmt, ...). It may be empty.
  */
-#if defined(CONFIG_LOG_ALWAYS_RUNTIME) || !defined(CONFIG_LOG)
+/* Macro handles case when there is no string provided, in that case variable
+ * is not created.
+ */
+#define Z_LOG_MSG_ARG_TYPES_VAR(_name, ...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(_, ##__VA_ARGS__), \
+		    (/* No args provided, no variable */), \
+		    (static const uint8_t _name[] = \
+			CBPRINTF_PACKAGE_ARG_TYPES(__VA_ARGS__);))
+
+/** @brief Get the argument type descriptor created by Z_LOG_MSG_ARG_TYPES_VAR.
+ *
+ * @param _name Variable name.
+ * @param ... Optional log message with arguments (may be empty).
+ */
+#define Z_LOG_MSG_ARG_TYPES(_name, ...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(_, ##__VA_ARGS__), (NULL), (_name))
+
+#if defined(CONFIG_LOG_RUNTIME_ARG_DESC) && defined(CONFIG_LOG)
+/* Types of the arguments are resolved at compile time, each call site gets a
+ * constant descriptor and packaging does not parse the format string.
+ */
+#define Z_LOG_MSG_CREATE2(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
+			  _level, _data, _dlen, ...) \
+do {\
+	Z_LOG_MSG_STR_VAR(_fmt, ##__VA_ARGS__) \
+	Z_LOG_MSG_ARG_TYPES_VAR(_arg_types, ##__VA_ARGS__) \
+	z_log_msg_runtime_create_desc((_domain_id), (void *)(_source), \
+				      (_level), (uint8_t *)(_data), (_dlen),\
+				      Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
+				      Z_LOG_MSG_ARG_TYPES(_arg_types, ##__VA_ARGS__), \
+				      Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__));\
+	(_mode) = Z_LOG_MSG_MODE_RUNTIME; \
+} while (false)
+#elif defined(CONFIG_LOG_ALWAYS_RUNTIME) || !defined(CONFIG_LOG)
 #define Z_LOG_MSG_CREATE2(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
 			  _level, _data, _dlen, ...) \
 do {\
@@ -716,6 +749,71 @@ static inline void z_log_msg_runtime_create(uint8_t domain_id,
 	va_end(ap);
 }
 
+/** @brief Create message at runtime using argument types known at compile time.
+ *
+ * Like z_log_msg_runtime_vcreate() but the types of the arguments are taken
+ * from @p arg_types instead of parsing @p fmt.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param arg_types Argument type descriptor (see CBPRINTF_PACKAGE_ARG_TYPES()).
+ * If null, types are determined from @p fmt.
+ *
+ * @param fmt String.
+ *
+ * @param ap Variable list of string arguments.
+ */
+void z_log_msg_runtime_vcreate_desc(uint8_t domain_id, const void *source,
+				    uint8_t level, const void *data,
+				    size_t dlen, uint32_t package_flags,
+				    const uint8_t *arg_types, const char *fmt,
+				    va_list ap);
+
+/** @brief Create message at runtime using argument types known at compile time.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param arg_types Argument type descriptor.
+ *
+ * @param fmt String.
+ *
+ * @param ... String arguments.
+ */
+static inline void z_log_msg_runtime_create_desc(uint8_t domain_id,
+						  const void *source,
+						  uint8_t level, const void *data,
+						  size_t dlen, uint32_t package_flags,
+						  const uint8_t *arg_types,
+						  const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	z_log_msg_runtime_vcreate_desc(domain_id, source, level, data, dlen,
+				       package_flags, arg_types, fmt, ap);
+	va_end(ap);
+}
+
 static inline bool z_log_item_is_msg(const union log_msg_generic *msg)
 {
 	return msg->generic.type == Z_LOG_MSG_LOG;
@@ -90,6 +90,19 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#ifdef CONFIG_LOG_OUTPUT_PREFIX_CACHE
+	/* "[hh:mm:ss." part of the timestamp and the second it was built for */
+	uint32_t ts_cache_seconds;
+	uint8_t ts_cache_len;
+	char ts_cache[sizeof("[4294967295:00:00.")];
+	/* Last printed level, thread, domain and source prefix */
+	const char *prefix_source;
+	const char *prefix_domain;
+	k_tid_t prefix_tid;
+	uint8_t prefix_key;
+	uint8_t prefix_len;
+	char prefix[CONFIG_LOG_OUTPUT_PREFIX_CACHE_SIZE];
+#endif
 };
 
 /** @brief Log_output instance structure. */
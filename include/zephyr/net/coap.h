@@ -1236,6 +1236,18 @@ void coap_replies_clear(struct coap_reply *replies, size_t len);
  */
 int coap_resource_notify(struct coap_resource *resource);
 
+/**
+ * @brief Advances the observe sequence number of this resource.
+ *
+ * Used when a notification is built by the caller instead of the @a
+ * notify callback, the returned value goes into its Observe option.
+ *
+ * @param resource Resource that was updated
+ *
+ * @return the new value of the resource age.
+ */
+int coap_resource_increment_age(struct coap_resource *resource);
+
 /**
  * @brief Returns if this request is enabling observing a resource.
  *
@@ -301,6 +301,104 @@ int coap_resource_remove_observer_by_addr(struct coap_resource *resource,
 int coap_resource_remove_observer_by_token(struct coap_resource *resource,
 					   const uint8_t *token, uint8_t token_len);
 
+/**
+ * @brief Send a notification to every observer of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The options and payload of @p cpkt are encoded once and shared by all observers, only the
+ * message id and the token are replaced for each of them. Non-confirmable notifications are
+ * sent without copying the packet, confirmable ones are tracked for retransmission like with
+ * @ref coap_resource_send. The token and message id of @p cpkt are ignored.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt Notification to send, of type @ref COAP_TYPE_CON or @ref COAP_TYPE_NON_CON
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of observers notified in case of success or negative in case of error.
+ */
+int coap_resource_notify_all(struct coap_resource *resource, const struct coap_packet *cpkt,
+			     const struct coap_transmission_parameters *params);
+
+/**
+ * @brief Source of a block-wise (Block2) response body.
+ */
+struct coap_block_source {
+	/**
+	 * Read up to @p len bytes of the body starting at @p offset into @p buf . Returns the
+	 * number of bytes read, less than @p len only at the end of the body, or a negative
+	 * error code.
+	 */
+	int (*read)(struct coap_resource *resource, const struct sockaddr *addr, size_t offset,
+		    uint8_t *buf, size_t len, void *user_data);
+	/** Content format of the body, negative to omit the Content-Format option */
+	int content_format;
+	/** Total size of the body reported with the Size2 option, 0 if unknown */
+	size_t size;
+	/** User data passed to the read callback */
+	void *user_data;
+};
+
+/**
+ * @brief Sink of a block-wise (Block1) request body.
+ */
+struct coap_block_sink {
+	/**
+	 * Store @p len bytes of the body at @p offset , @p last is set for the final block.
+	 * Returns 0 on success, -EFBIG if the body is too large, -EINVAL if it is invalid or
+	 * another negative error code.
+	 */
+	int (*write)(struct coap_resource *resource, const struct sockaddr *addr, size_t offset,
+		     const uint8_t *buf, size_t len, bool last, void *user_data);
+	/** Response code sent once the last block is stored, 0 for 2.04 Changed */
+	uint8_t code;
+	/** User data passed to the write callback */
+	void *user_data;
+};
+
+/**
+ * @brief Reply to a GET request of the provided @p resource with one block of a body.
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The block requested by the Block2 option of @p request is read from @p source directly into
+ * the response, using the smaller of the requested size and
+ * @kconfig{CONFIG_COAP_SERVER_BLOCK_SIZE}. No transfer state is kept between requests, so
+ * any number of clients can fetch the body concurrently, and @p source is only asked for the
+ * block being sent.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param request CoAP request to reply to
+ * @param addr Peer address
+ * @param addr_len Peer address length
+ * @param source Body of the response
+ * @return 0 in case of success, a positive response code to reply with or negative in case of
+ *         error. The result can be returned as is from a resource handler.
+ */
+int coap_resource_reply_block2(struct coap_resource *resource, const struct coap_packet *request,
+			       const struct sockaddr *addr, socklen_t addr_len,
+			       const struct coap_block_source *source);
+
+/**
+ * @brief Pass one block of a PUT or POST request of the provided @p resource to a sink.
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The payload of @p request is written to @p sink at the offset given by its Block1 option,
+ * or at offset 0 as the last block if the option is absent, and the request is acknowledged
+ * with 2.31 Continue or the final response code.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param request CoAP request carrying the block
+ * @param addr Peer address
+ * @param addr_len Peer address length
+ * @param sink Destination of the request body
+ * @return 0 in case of success, a positive response code to reply with or negative in case of
+ *         error. The result can be returned as is from a resource handler.
+ */
+int coap_resource_receive_block1(struct coap_resource *resource, const struct coap_packet *request,
+				 const struct sockaddr *addr, socklen_t addr_len,
+				 const struct coap_block_sink *sink);
+
 /**
  * @}
  */
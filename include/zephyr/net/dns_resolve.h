@@ -420,6 +420,11 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** Number of servers the query was sent to that have not
+		 * failed yet.
+		 */
+		uint8_t servers_pending;
 	} queries[DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -104,6 +105,15 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER)
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif
+
+/* Size accounted for each dynamic table entry besides its name and value */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -127,6 +137,39 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+/** HPACK dynamic table of an encoder, see RFC 7541 ch 2.3.2. */
+struct http_hpack_dynamic_table {
+	/** Names and values of the entries, oldest first. */
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	/** Table entries, oldest first. */
+	struct http_hpack_dynamic_entry {
+		/** Hash of the name. */
+		uint16_t name_hash;
+		/** Hash of the name and the value. */
+		uint16_t field_hash;
+		/** Length of the name. */
+		uint16_t name_len;
+		/** Length of the value. */
+		uint16_t value_len;
+	} entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+
+	/** Table size, as defined in RFC 7541 ch 4.1. */
+	uint16_t size;
+
+	/** Maximum table size. */
+	uint16_t max_size;
+
+	/** Smallest maximum size set since the last size update was sent. */
+	uint16_t min_size;
+
+	/** Number of entries. */
+	uint8_t count;
+
+	/** A dynamic table size update is to be sent. */
+	bool size_update;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -137,6 +180,12 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header,
+				   struct http_hpack_dynamic_table *table);
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table);
+void http_hpack_dynamic_table_set_max_size(struct http_hpack_dynamic_table *table,
+					   uint32_t max_size);
 
 /** @endcond */
 
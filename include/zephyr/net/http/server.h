@@ -37,12 +37,14 @@ extern "C" {
 
 #if defined(CONFIG_HTTP_SERVER)
 #define HTTP_SERVER_CLIENT_BUFFER_SIZE   CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE
+#define HTTP_SERVER_CLIENT_TX_BUFFER_SIZE CONFIG_HTTP_SERVER_CLIENT_TX_BUFFER_SIZE
 #define HTTP_SERVER_MAX_STREAMS          CONFIG_HTTP_SERVER_MAX_STREAMS
 #define HTTP_SERVER_MAX_CONTENT_TYPE_LEN CONFIG_HTTP_SERVER_MAX_CONTENT_TYPE_LENGTH
 #define HTTP_SERVER_MAX_URL_LENGTH       CONFIG_HTTP_SERVER_MAX_URL_LENGTH
 #define HTTP_SERVER_MAX_HEADER_LEN       CONFIG_HTTP_SERVER_MAX_HEADER_LEN
 #else
 #define HTTP_SERVER_CLIENT_BUFFER_SIZE   0
+#define HTTP_SERVER_CLIENT_TX_BUFFER_SIZE 0
 #define HTTP_SERVER_MAX_STREAMS          0
 #define HTTP_SERVER_MAX_CONTENT_TYPE_LEN 0
 #define HTTP_SERVER_MAX_URL_LENGTH       0
@@ -112,6 +114,13 @@ struct http_resource_detail_static {
 
 	/** Size of the static resource. */
 	size_t static_data_len;
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	/** @cond INTERNAL_HIDDEN */
+	/** Entity tag of the content, computed by the server on first use. */
+	uint32_t etag;
+	/** @endcond */
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -382,6 +391,14 @@ struct http_client_ctx {
 	/** Client data buffer.  */
 	unsigned char buffer[HTTP_SERVER_CLIENT_BUFFER_SIZE];
 
+#if HTTP_SERVER_CLIENT_TX_BUFFER_SIZE > 0
+	/** Client output buffer. */
+	unsigned char tx_buffer[HTTP_SERVER_CLIENT_TX_BUFFER_SIZE];
+
+	/** Data waiting to be sent in the output buffer. */
+	size_t tx_len;
+#endif
+
 	/** Cursor indicating currently processed byte. */
 	unsigned char *cursor;
 
@@ -406,6 +423,11 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/** HPACK dynamic table used to encode response headers. */
+	struct http_hpack_dynamic_table hpack_table;
+#endif
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -435,6 +457,14 @@ struct http_client_ctx {
 	/** Request method. */
 	enum http_method method;
 
+	/** Content encodings accepted by the client for the current request. */
+	uint8_t accept_encoding;
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	/** Entity tag from the If-None-Match header of the current request. */
+	uint32_t if_none_match;
+#endif
+
 	/** HTTP/1 parser state. */
 	enum http1_parser_state parser_state;
 
@@ -471,8 +501,22 @@ struct http_client_ctx {
 	/** Flag indicating Websocket key is being processed. */
 	bool websocket_sec_key_next : 1;
 
+	/** Flag indicating Accept-Encoding header is being processed. */
+	bool accept_encoding_next : 1;
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	/** Flag indicating that if_none_match holds a valid entity tag. */
+	bool has_if_none_match : 1;
+
+	/** Flag indicating that the If-None-Match header matches any entity. */
+	bool if_none_match_any : 1;
+
+	/** Flag indicating If-None-Match header is being processed. */
+	bool if_none_match_next : 1;
+#endif
 };
 
 #if defined(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)
@@ -467,6 +467,28 @@ struct mqtt_transport {
 #endif
 };
 
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+/** @brief Internal. QoS 1 or QoS 2 message awaiting acknowledgment. */
+struct mqtt_inflight_msg {
+	/** Internal. Wall clock value (in milliseconds) of the last
+	 *  transmission.
+	 */
+	uint32_t timestamp;
+
+	/** Internal. Message id of the tracked message. */
+	uint16_t message_id;
+
+	/** Internal. Length of the stored packet, 0 if the slot is free. */
+	uint16_t len;
+
+	/** Internal. Acknowledgment the message is waiting for. */
+	uint8_t state;
+
+	/** Internal. Packet to be retransmitted, PUBLISH or PUBREL. */
+	uint8_t data[CONFIG_MQTT_LIB_INFLIGHT_MSG_SIZE];
+};
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -485,6 +507,21 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_LIB_TX_QUEUE)
+	/** Internal. Number of bytes waiting in the outbound queue. */
+	uint32_t tx_queue_len;
+
+	/** Internal. Outbound queue, written out with a single transport
+	 *  write.
+	 */
+	uint8_t tx_queue[CONFIG_MQTT_LIB_TX_QUEUE_SIZE];
+#endif /* CONFIG_MQTT_LIB_TX_QUEUE */
+
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	/** Internal. QoS 1 and QoS 2 messages awaiting acknowledgment. */
+	struct mqtt_inflight_msg inflight[CONFIG_MQTT_LIB_INFLIGHT_WINDOW];
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
 };
 
 /**
@@ -622,11 +659,33 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note With @kconfig{CONFIG_MQTT_LIB_TX_QUEUE} enabled the packet is only
+ *       copied to the outbound queue, see @ref mqtt_flush.
+ * @note With @kconfig{CONFIG_MQTT_LIB_INFLIGHT} enabled QoS 1 and QoS 2
+ *       messages are kept until acknowledged, and the function returns
+ *       -EBUSY when @kconfig{CONFIG_MQTT_LIB_INFLIGHT_WINDOW} messages are
+ *       already awaiting acknowledgment.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to write out the packets waiting in the outbound queue.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @note Queued packets are also written out by @ref mqtt_input,
+ *       @ref mqtt_live and by any API sending a control packet other than
+ *       PUBLISH. Does nothing if @kconfig{CONFIG_MQTT_LIB_TX_QUEUE} is
+ *       disabled.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_flush(struct mqtt_client *client);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -663,6 +722,10 @@ int mqtt_publish_qos2_receive(struct mqtt_client *client,
  *                   Shall not be NULL.
  * @param[in] param Identifies message being released.
  *
+ * @note With @kconfig{CONFIG_MQTT_LIB_INFLIGHT} enabled the library sends
+ *       PUBREL on its own, and this call does nothing for messages it has
+ *       already released.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish_qos2_release(struct mqtt_client *client,
@@ -766,7 +829,9 @@ int mqtt_live(struct mqtt_client *client);
  *
  * @return Time in milliseconds until next keep alive message is expected to
  *         be sent. Function will return -1 if keep alive messages are
- *         not enabled.
+ *         not enabled. The time is shortened to the next retransmission
+ *         of an unacknowledged message, and is 0 while packets wait in the
+ *         outbound queue.
  */
 int mqtt_keepalive_time_left(const struct mqtt_client *client);
 
@@ -59,10 +59,47 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+/* One instruction of a compiled rule list. Each condition of a rule becomes
+ * one instruction, execution continues with the next instruction if the
+ * condition holds and jumps to the first instruction of the next rule
+ * (jf) otherwise.
+ */
+struct npf_insn {
+	uint8_t op;
+	uint8_t negate;
+	uint16_t jf;
+	uint16_t hash_first;
+	uint16_t hash_mask;
+	union {
+		struct npf_test *test;
+		enum net_verdict verdict;
+	};
+};
+
+struct npf_prog {
+	atomic_t readers;
+	uint16_t len;
+	uint16_t hash_used;
+	struct npf_insn insns[CONFIG_NET_PKT_FILTER_COMPILED_MAX_INSNS];
+	const void *hash_slots[CONFIG_NET_PKT_FILTER_COMPILED_HASH_SLOTS];
+};
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;   /**< List head */
 	struct k_spinlock lock;  /**< Lock protecting the list access */
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	/** Active compiled program, NULL if the list is interpreted */
+	atomic_ptr_t prog;
+	/** Program storage, one is active while the other one is rebuilt */
+	struct npf_prog progs[2];
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -109,6 +146,26 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule);
  */
 bool npf_remove_all_rules(struct npf_rule_list *rules);
 
+/**
+ * @brief Rebuild the compiled program of the given rule list
+ *
+ * With CONFIG_NET_PKT_FILTER_COMPILED the rule list is compiled whenever
+ * rules are inserted or removed. Address sets that are large enough to be
+ * hashed are indexed at that time, so this must be called after modifying
+ * such a set while its rule is installed. Does nothing if compiled rules
+ * are not enabled.
+ *
+ * @param rules the affected rule list
+ */
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+void npf_rules_update(struct npf_rule_list *rules);
+#else
+static inline void npf_rules_update(struct npf_rule_list *rules)
+{
+	ARG_UNUSED(rules);
+}
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 /* convenience shortcuts */
@@ -24,6 +24,20 @@
 
 #include <stddef.h>
 
+struct prometheus_collector;
+
+/**
+ * @brief Callback invoked before the metrics of a collector are formatted
+ *
+ * Lets metrics that mirror values maintained elsewhere, such as kernel or
+ * network statistics, be refreshed only when somebody actually scrapes them.
+ *
+ * @param collector Collector about to be scraped.
+ * @param user_data User data given to prometheus_collector_set_scrape_cb().
+ */
+typedef void (*prometheus_scrape_cb_t)(const struct prometheus_collector *collector,
+				       void *user_data);
+
 /**
  * @brief Prometheus collector definition
  *
@@ -36,6 +50,10 @@ struct prometheus_collector {
 	struct prometheus_metric *metric[CONFIG_PROMETHEUS_MAX_METRICS];
 	/** Number of metrics associated with the collector */
 	size_t size;
+	/** Callback invoked at the start of every scrape */
+	prometheus_scrape_cb_t scrape_cb;
+	/** User data passed to the scrape callback */
+	void *user_data;
 };
 
 /**
@@ -76,6 +94,33 @@ int prometheus_collector_register_metric(struct prometheus_collector *collector,
 const void *prometheus_collector_get_metric(const struct prometheus_collector *collector,
 					    const char *name);
 
+/**
+ * @brief Set the scrape callback of a Prometheus collector
+ *
+ * The callback is invoked by the formatter before the first metric of the
+ * collector is written.
+ *
+ * @param collector Pointer to the collector.
+ * @param cb Callback to invoke, or NULL to remove the current one.
+ * @param user_data User data passed to the callback.
+ *
+ * @return 0 if successful, otherwise a negative error code.
+ * @retval -EINVAL Invalid arguments.
+ */
+int prometheus_collector_set_scrape_cb(struct prometheus_collector *collector,
+				       prometheus_scrape_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the scrape callback of a Prometheus collector
+ *
+ * @param collector Pointer to the collector.
+ *
+ * @return The callback set with prometheus_collector_set_scrape_cb(), or NULL
+ *         if there is none.
+ */
+prometheus_scrape_cb_t prometheus_collector_get_scrape_cb(
+	const struct prometheus_collector *collector);
+
 /**
  * @}
  */
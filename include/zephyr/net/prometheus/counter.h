@@ -18,9 +18,18 @@
 
 #include <stdint.h>
 
+#include <zephyr/spinlock.h>
+#include <zephyr/toolchain.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
+/** @cond INTERNAL_HIDDEN */
+struct prometheus_counter_shard {
+	struct k_spinlock lock;
+	uint64_t value;
+} __aligned(PROMETHEUS_SHARD_ALIGN);
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus counter metric.
  *
@@ -30,8 +39,19 @@
 struct prometheus_counter {
 	/** Base of the Prometheus counter metric */
 	struct prometheus_metric *base;
-	/** Value of the Prometheus counter metric */
+	/**
+	 * Value of the Prometheus counter metric. Not maintained when
+	 * CONFIG_PROMETHEUS_PERCPU_METRICS is enabled, use
+	 * prometheus_counter_get() to read the value.
+	 */
 	uint64_t value;
+	/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+	struct prometheus_counter_shard shards[CONFIG_MP_MAX_NUM_CPUS];
+#else
+	struct k_spinlock lock;
+#endif
+	/** @endcond */
 };
 
 /**
@@ -70,6 +90,40 @@ struct prometheus_counter {
  */
 int prometheus_counter_inc(struct prometheus_counter *counter);
 
+/**
+ * @brief Add to the value of a Prometheus counter metric
+ *
+ * Increments the value of the specified counter metric by the given amount.
+ * With CONFIG_PROMETHEUS_PERCPU_METRICS only the share of the CPU running the
+ * caller is updated, so that concurrent updates from other CPUs do not
+ * contend.
+ *
+ * @param counter Pointer to the counter metric to increment.
+ * @param value Amount to add.
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value);
+
+/**
+ * @brief Set the value of a Prometheus counter metric
+ *
+ * Meant for counters that mirror a value maintained elsewhere, such as
+ * statistics refreshed from a collector scrape callback.
+ *
+ * @param counter Pointer to the counter metric to set.
+ * @param value New value of the counter.
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value);
+
+/**
+ * @brief Get the value of a Prometheus counter metric
+ *
+ * @param counter Pointer to the counter metric.
+ * @return Value of the counter, summed over all CPUs.
+ */
+uint64_t prometheus_counter_get(struct prometheus_counter *counter);
+
 /**
  * @}
  */
@@ -18,6 +18,79 @@
 
 #include <zephyr/net/prometheus/collector.h>
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Streaming formatter state
+ *
+ * Holds the position of a formatter walking through the metrics of a
+ * collector, so that the exposition can be produced in chunks of any size
+ * without ever being held in memory as a whole.
+ */
+struct prometheus_format_ctx {
+	/** @cond INTERNAL_HIDDEN */
+	const struct prometheus_collector *collector;
+	/* Metric being formatted and line within that metric */
+	size_t metric;
+	size_t line;
+	/* Entry of the metric being formatted and the values read from it when
+	 * its TYPE line was written, so that all samples of a metric agree.
+	 */
+	const void *entry;
+	union {
+		uint64_t counter;
+		double gauge;
+		struct {
+			double sum;
+			unsigned long count;
+		} observed;
+	} snapshot;
+	/** @endcond */
+};
+
+/**
+ * @brief Start formatting the exposition data of a collector
+ *
+ * Invokes the scrape callback of the collector, if any, and resets the
+ * formatter to the first metric.
+ *
+ * @param ctx Formatter state to initialize.
+ * @param collector Pointer to the collector containing the data to format.
+ */
+void prometheus_format_init(struct prometheus_format_ctx *ctx,
+			    const struct prometheus_collector *collector);
+
+/**
+ * @brief Format the next chunk of exposition data
+ *
+ * Writes as many complete lines as fit into the buffer and NUL terminates
+ * them. A line that does not fit is written by the next call.
+ *
+ * @param ctx Formatter state set up with prometheus_format_init().
+ * @param buffer Pointer to the buffer where the chunk will be stored.
+ * @param buffer_size Size of the buffer.
+ *
+ * @return Number of bytes written, not counting the terminating NUL, or 0 once
+ *         all metrics have been formatted.
+ * @retval -EINVAL Invalid arguments or unsupported metric type.
+ * @retval -ENOMEM A single line does not fit into an empty buffer.
+ */
+int prometheus_format_next(struct prometheus_format_ctx *ctx, char *buffer, size_t buffer_size);
+
+/**
+ * @brief Check whether all exposition data has been formatted
+ *
+ * @param ctx Formatter state set up with prometheus_format_init().
+ *
+ * @return true if prometheus_format_next() has nothing left to write.
+ */
+static inline bool prometheus_format_done(const struct prometheus_format_ctx *ctx)
+{
+	return ctx->metric >= ctx->collector->size;
+}
+
 /**
  * @brief Format exposition data for Prometheus
  *
@@ -29,6 +102,8 @@
  * @param buffer_size Size of the buffer.
  *
  * @return 0 on success, negative errno on error.
+ * @retval -ENOMEM The buffer is too small for the whole exposition, use
+ *         prometheus_format_next() to produce it in chunks instead.
  */
 int prometheus_format_exposition(const struct prometheus_collector *collector, char *buffer,
 				 size_t buffer_size);
@@ -16,6 +16,7 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -30,6 +31,9 @@ struct prometheus_gauge {
 	struct prometheus_metric *base;
 	/** Value of the Prometheus gauge metric */
 	double value;
+	/** @cond INTERNAL_HIDDEN */
+	struct k_spinlock lock;
+	/** @endcond */
 };
 
 /**
@@ -73,6 +77,18 @@ struct prometheus_gauge {
  */
 int prometheus_gauge_set(struct prometheus_gauge *gauge, double value);
 
+/**
+ * @brief Get the value of a Prometheus gauge metric
+ *
+ * The value is read under the same lock that serializes prometheus_gauge_set(),
+ * so a concurrent update is never observed half written.
+ *
+ * @param gauge Pointer to the gauge metric.
+ *
+ * @return Value of the gauge metric.
+ */
+double prometheus_gauge_get(struct prometheus_gauge *gauge);
+
 /**
  * @}
  */
@@ -16,6 +16,8 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
+#include <zephyr/toolchain.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -33,6 +35,14 @@ struct prometheus_histogram_bucket {
 	unsigned long count;
 };
 
+/** @cond INTERNAL_HIDDEN */
+struct prometheus_histogram_shard {
+	struct k_spinlock lock;
+	double sum;
+	unsigned long count;
+} __aligned(PROMETHEUS_SHARD_ALIGN);
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus histogram metric.
  *
@@ -46,10 +56,25 @@ struct prometheus_histogram {
 	struct prometheus_histogram_bucket *buckets;
 	/** Number of buckets in the histogram */
 	size_t num_buckets;
-	/** Sum of all observed values in the histogram */
+	/**
+	 * Sum of all observed values in the histogram. Not maintained when
+	 * CONFIG_PROMETHEUS_PERCPU_METRICS is enabled, use
+	 * prometheus_histogram_get() to read it.
+	 */
 	double sum;
-	/** Total count of observations in the histogram */
+	/**
+	 * Total count of observations in the histogram. Not maintained when
+	 * CONFIG_PROMETHEUS_PERCPU_METRICS is enabled, use
+	 * prometheus_histogram_get() to read it.
+	 */
 	unsigned long count;
+	/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+	struct prometheus_histogram_shard shards[CONFIG_MP_MAX_NUM_CPUS];
+#else
+	struct k_spinlock lock;
+#endif
+	/** @endcond */
 };
 
 /**
@@ -95,6 +120,18 @@ struct prometheus_histogram {
  */
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value);
 
+/**
+ * @brief Get the sum and count of a Prometheus histogram metric
+ *
+ * Reads the sum and the count of observations as one consistent pair.
+ *
+ * @param histogram Pointer to the histogram metric.
+ * @param sum Where to store the sum of all observed values.
+ * @param count Where to store the total count of observations.
+ */
+void prometheus_histogram_get(struct prometheus_histogram *histogram, double *sum,
+			      unsigned long *count);
+
 /**
  * @}
  */
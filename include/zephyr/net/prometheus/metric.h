@@ -39,6 +39,17 @@ enum prometheus_metric_type {
 #define MAX_METRIC_NAME_LENGTH        32
 #define MAX_METRIC_DESCRIPTION_LENGTH 64
 
+/** @cond INTERNAL_HIDDEN */
+/* Per-CPU shards each take a whole cache line, so that CPUs updating their
+ * own shard do not bounce the line of their neighbours.
+ */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define PROMETHEUS_SHARD_ALIGN CONFIG_DCACHE_LINE_SIZE
+#else
+#define PROMETHEUS_SHARD_ALIGN 64
+#endif
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus metric base.
  *
@@ -0,0 +1,50 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROMETHEUS_STATS_H_
+#define ZEPHYR_INCLUDE_PROMETHEUS_STATS_H_
+
+/**
+ * @file
+ *
+ * @brief Prometheus system statistics APIs.
+ *
+ * @addtogroup prometheus
+ * @{
+ */
+
+#include <zephyr/net/prometheus/collector.h>
+
+/**
+ * @brief Register the system statistics metrics with a Prometheus collector
+ *
+ * Registers the network statistics counters when
+ * CONFIG_PROMETHEUS_NET_STATS is enabled and the CPU usage counters when
+ * CONFIG_PROMETHEUS_THREAD_STATS is enabled. Unless the collector already has
+ * a scrape callback, one is installed that calls prometheus_stats_update(), so
+ * the values are only gathered when the collector is scraped.
+ *
+ * @param collector Pointer to the collector to register the metrics with.
+ *
+ * @return 0 if successful, otherwise a negative error code.
+ * @retval -EINVAL Invalid arguments.
+ * @retval -ENOMEM CONFIG_PROMETHEUS_MAX_METRICS is too small.
+ */
+int prometheus_stats_register(struct prometheus_collector *collector);
+
+/**
+ * @brief Refresh the system statistics metrics
+ *
+ * To be called from a custom scrape callback when the collector needs one of
+ * its own.
+ */
+void prometheus_stats_update(void);
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_PROMETHEUS_STATS_H_ */
@@ -16,6 +16,7 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -50,6 +51,9 @@ struct prometheus_summary {
 	double sum;
 	/** Total count of observations in the summary metric */
 	unsigned long count;
+	/** @cond INTERNAL_HIDDEN */
+	struct k_spinlock lock;
+	/** @endcond */
 };
 
 /**
@@ -96,6 +100,18 @@ struct prometheus_summary {
  */
 int prometheus_summary_observe(struct prometheus_summary *summary, double value);
 
+/**
+ * @brief Get the sum and count of a Prometheus summary metric
+ *
+ * Reads the sum and the count of observations as one consistent pair.
+ *
+ * @param summary Pointer to the summary metric.
+ * @param sum Where to store the sum of all observed values.
+ * @param count Where to store the total count of observations.
+ */
+void prometheus_summary_get(struct prometheus_summary *summary, double *sum,
+			    unsigned long *count);
+
 /**
  * @}
  */
@@ -1179,6 +1179,9 @@ struct ifreq {
 /** Domain used with SOCKET */
 #define SO_DOMAIN 39
 
+/** Maximum pacing rate of a connection (bytes per second) */
+#define SO_MAX_PACING_RATE 47
+
 /** Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
@@ -1214,6 +1217,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm (string) */
+#define TCP_CONGESTION 5
 
 /** @} */
 
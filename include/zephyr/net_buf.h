@@ -1070,6 +1070,21 @@ struct net_buf_data_alloc {
 
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+struct net_buf_pool_cache {
+	/** Protects the cache against flushing from other CPUs */
+	struct k_spinlock lock;
+
+	/** Number of cached buffers */
+	uint8_t count;
+
+	/** Cached free buffers, without any data attached */
+	struct net_buf *bufs[CONFIG_NET_BUF_POOL_CPU_CACHE_SIZE];
+};
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+/** @endcond */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1102,6 +1117,14 @@ struct net_buf_pool {
 	const char *name;
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	/** Number of threads waiting for a free buffer. */
+	atomic_t waiters;
+
+	/** Per-CPU caches of free buffers. */
+	struct net_buf_pool_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -1434,6 +1457,60 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate several variable length buffers from a pool.
+ *
+ * All buffers are taken from the pool with as few accesses to the shared
+ * free list as possible. Either all @a count buffers are allocated, or none
+ * of them is and the pool is left untouched.
+ *
+ * @note The timeout value will be overridden to K_NO_WAIT if called from the
+ *       system workqueue.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param bufs Array where the allocated buffers are stored.
+ * @param count Number of buffers to allocate.
+ * @param timeout Affects the action taken should the pool be empty.
+ *        If K_NO_WAIT, then return immediately. If K_FOREVER, then
+ *        wait as long as necessary. Otherwise, wait until the specified
+ *        timeout. The timeout applies to the whole operation.
+ *
+ * @retval 0 All buffers were allocated.
+ * @retval -ENOMEM Not enough buffers or data could be allocated.
+ */
+#if defined(CONFIG_NET_BUF_LOG)
+int __must_check net_buf_alloc_len_bulk_debug(struct net_buf_pool *pool,
+					      size_t size,
+					      struct net_buf **bufs,
+					      size_t count,
+					      k_timeout_t timeout,
+					      const char *func, int line);
+#define net_buf_alloc_len_bulk(_pool, _size, _bufs, _count, _timeout)	\
+	net_buf_alloc_len_bulk_debug(_pool, _size, _bufs, _count,	\
+				     _timeout, __func__, __LINE__)
+#else
+int __must_check net_buf_alloc_len_bulk(struct net_buf_pool *pool,
+					size_t size,
+					struct net_buf **bufs,
+					size_t count,
+					k_timeout_t timeout);
+#endif
+
+/**
+ * @brief Allocate several buffers with the pool's fixed data size.
+ *
+ * @copydetails net_buf_alloc_len_bulk
+ */
+static inline int __must_check net_buf_alloc_bulk(struct net_buf_pool *pool,
+						  struct net_buf **bufs,
+						  size_t count,
+						  k_timeout_t timeout)
+{
+	return net_buf_alloc_len_bulk(pool, pool->alloc->max_alloc_size, bufs,
+				      count, timeout);
+}
+
 /**
  * @brief Get a buffer from a FIFO.
  *
@@ -1457,6 +1534,12 @@ __deprecated struct net_buf * __must_check net_buf_get(struct k_fifo *fifo,
 						       k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+bool net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+#endif
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1477,9 +1560,31 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	if (net_buf_pool_cache_put(pool, buf)) {
+		return;
+	}
+#endif
+
 	k_lifo_put(&pool->free, buf);
 }
 
+/**
+ * @brief Return the buffers cached by all CPUs to the pool.
+ *
+ * Only has an effect when CONFIG_NET_BUF_POOL_CPU_CACHE is enabled.
+ *
+ * @param pool Pool whose caches are flushed.
+ */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+void net_buf_pool_cache_flush(struct net_buf_pool *pool);
+#else
+static inline void net_buf_pool_cache_flush(struct net_buf_pool *pool)
+{
+	ARG_UNUSED(pool);
+}
+#endif
+
 /**
  * @brief Reset buffer
  *
@@ -1530,6 +1635,8 @@ __deprecated void net_buf_put(struct k_fifo *fifo, struct net_buf *buf);
  * @brief Decrements the reference count of a buffer.
  *
  * The buffer is put back into the pool if the reference count reaches zero.
+ * Fragments that are freed along with it are returned to their pool as one
+ * list, unless the pool has a custom destroy callback.
  *
  * @param buf A valid pointer on a buffer
  */
@@ -16,6 +16,7 @@
 #include <zephyr/logging/log_instance.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/util.h>
 
 #if defined CONFIG_SHELL_GETOPT
@@ -859,13 +860,24 @@ struct shell_ctx {
 	/** Printf buffer size.*/
 	char printf_buff[CONFIG_SHELL_PRINTF_BUFF_SIZE];
 
+#if defined CONFIG_SHELL_OUTPUT_BUFFER
+	/** Output not yet accepted by the transport. */
+	struct ring_buf out_ring;
+	uint8_t out_ring_buff[CONFIG_SHELL_OUTPUT_BUFFER_SIZE];
+
+	/** Colors to restore before output that is not colored. */
+	struct shell_vt100_colors out_col;
+	bool out_col_pending;
+#endif
+
 	volatile union shell_backend_cfg cfg;
 	volatile union shell_backend_ctx ctx;
 
 	struct k_poll_signal signals[SHELL_SIGNALS];
 
 	/** Events that should be used only internally by shell thread.
-	 * Event for SHELL_SIGNAL_TXDONE is initialized but unused.
+	 * Event for SHELL_SIGNAL_TXDONE is only used with
+	 * CONFIG_SHELL_OUTPUT_BUFFER.
 	 */
 	struct k_poll_event events[SHELL_SIGNALS];
 
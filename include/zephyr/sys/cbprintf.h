@@ -474,6 +474,57 @@ int cbvprintf_package(void *packaged,
 		      const char *format,
 		      va_list ap);
 
+/** @brief Build the argument type descriptor of a formatted string.
+ *
+ * Descriptor is an initializer for a @c uint8_t array holding the
+ * @ref cbprintf_package_arg_type of each argument, followed by
+ * @ref CBPRINTF_PACKAGE_ARG_TYPE_END. Types are determined at compile time
+ * from the arguments, so the descriptor can be a static constant of the call
+ * site. Strings must be passed as @c char pointers, other character pointers
+ * are packaged as plain pointers.
+ *
+ * @param ... String with arguments (fmt, ...).
+ */
+#define CBPRINTF_PACKAGE_ARG_TYPES(... /* fmt, ... */) \
+	{ Z_CBPRINTF_ARG_TYPES(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+			       GET_ARGS_LESS_N(1, __VA_ARGS__)) }
+
+/** @brief Capture state required to output formatted data later.
+ *
+ * Like cbvprintf_package() but the type of each argument is taken from
+ * @p arg_types instead of being determined by parsing @p format. Except for
+ * arguments not matching their conversion specifications, the package is
+ * the same.
+ *
+ * @param packaged pointer to where the packaged data can be stored. See
+ * cbvprintf_package().
+ *
+ * @param len See cbvprintf_package().
+ *
+ * @param flags option flags. See @ref CBPRINTF_PACKAGE_FLAGS.
+ * @ref CBPRINTF_PACKAGE_ARGS_ARE_TAGGED must not be set.
+ *
+ * @param arg_types Argument type descriptor, see
+ * @ref CBPRINTF_PACKAGE_ARG_TYPES.
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ap captured stack arguments matching @p arg_types.
+ *
+ * @retval nonegative the number of bytes successfully stored at @p packaged.
+ * This will not exceed @p len.
+ * @retval -EINVAL if @p arg_types is not acceptable
+ * @retval -ENOSPC if @p packaged was not null and the space required to store
+ * exceed @p len.
+ */
+int cbvprintf_package_desc(void *packaged,
+			   size_t len,
+			   uint32_t flags,
+			   const uint8_t *arg_types,
+			   const char *format,
+			   va_list ap);
+
 /** @brief Convert a package.
  *
  * Converting may include appending strings used in the package to the package body.
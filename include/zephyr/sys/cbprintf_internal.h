@@ -883,7 +883,8 @@ do { \
 }
 #endif
 
-#ifdef CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
 #ifdef __cplusplus
 /*
  * Remove qualifiers like const, volatile. And also transform
@@ -1029,6 +1030,15 @@ do { \
 		    (CBPRINTF_PACKAGE_ARG_TYPE_END), \
 		    (Z_CBPRINTF_TAGGED_ARGS_2(__VA_ARGS__)))
 
-#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+#define Z_CBPRINTF_ARG_TYPES_2(...) \
+	FOR_EACH(Z_CBPRINTF_ARG_TYPE, (,), __VA_ARGS__), \
+	CBPRINTF_PACKAGE_ARG_TYPE_END
+
+#define Z_CBPRINTF_ARG_TYPES(_num_args, ...) \
+	COND_CODE_0(_num_args, \
+		    (CBPRINTF_PACKAGE_ARG_TYPE_END), \
+		    (Z_CBPRINTF_ARG_TYPES_2(__VA_ARGS__)))
+
+#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS || CONFIG_CBPRINTF_PACKAGE_ARG_DESC */
 
 #endif /* ZEPHYR_INCLUDE_SYS_CBPRINTF_INTERNAL_H_ */
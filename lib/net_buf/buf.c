@@ -222,6 +222,191 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+struct cache_key {
+	unsigned int irq;
+	k_spinlock_key_t spin;
+};
+
+/* The cache of the current CPU is normally only accessed by that CPU, the
+ * lock is there so that other CPUs can flush it when a thread has to wait
+ * for a buffer.
+ */
+static struct net_buf_pool_cache *cache_lock(struct net_buf_pool *pool,
+					     struct cache_key *key)
+{
+	struct net_buf_pool_cache *cache;
+
+	key->irq = arch_irq_lock();
+	cache = &pool->cpu_cache[arch_curr_cpu()->id];
+	key->spin = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct net_buf_pool_cache *cache,
+			 struct cache_key *key)
+{
+	k_spin_unlock(&cache->lock, key->spin);
+	arch_irq_unlock(key->irq);
+}
+
+bool net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_pool_cache *cache;
+	struct cache_key key;
+	bool cached = false;
+
+	cache = cache_lock(pool, &key);
+
+	/* Threads waiting for a buffer are pending on the free LIFO, so the
+	 * buffer must go there in that case.
+	 */
+	if (atomic_get(&pool->waiters) == 0 &&
+	    cache->count < ARRAY_SIZE(cache->bufs)) {
+		cache->bufs[cache->count++] = buf;
+		cached = true;
+	}
+
+	cache_unlock(cache, &key);
+
+	return cached;
+}
+
+static size_t cache_get(struct net_buf_pool *pool, struct net_buf **bufs,
+			size_t count)
+{
+	struct net_buf_pool_cache *cache;
+	struct cache_key key;
+	size_t i;
+
+	cache = cache_lock(pool, &key);
+
+	for (i = 0; i < count && cache->count > 0U; i++) {
+		bufs[i] = cache->bufs[--cache->count];
+	}
+
+	cache_unlock(cache, &key);
+
+	return i;
+}
+
+void net_buf_pool_cache_flush(struct net_buf_pool *pool)
+{
+	for (int i = 0; i < ARRAY_SIZE(pool->cpu_cache); i++) {
+		struct net_buf_pool_cache *cache = &pool->cpu_cache[i];
+		k_spinlock_key_t key;
+		sys_snode_t *node;
+		sys_slist_t list;
+
+		sys_slist_init(&list);
+
+		key = k_spin_lock(&cache->lock);
+
+		/* Oldest first, so the most recently freed buffer ends up at
+		 * the head of the LIFO.
+		 */
+		while (cache->count > 0U) {
+			sys_slist_prepend(&list,
+					  &cache->bufs[--cache->count]->node);
+		}
+
+		k_spin_unlock(&cache->lock, key);
+
+		/* Put the buffers at the head of the LIFO, they were freed
+		 * recently and are the most likely to still be in the data
+		 * cache.
+		 */
+		while ((node = sys_slist_get(&list)) != NULL) {
+			k_lifo_put(&pool->free, CONTAINER_OF(node, struct net_buf, node));
+		}
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+
+/* Get a buffer from the free LIFO of the pool, possibly waiting for one */
+static struct net_buf *pool_get_free(struct net_buf_pool *pool,
+				     k_timeout_t timeout)
+{
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	struct net_buf *buf;
+
+	buf = k_lifo_get(&pool->free, K_NO_WAIT);
+	if (buf != NULL) {
+		return buf;
+	}
+
+	/* The LIFO is empty, the remaining free buffers may be sitting in
+	 * the caches of other CPUs.
+	 */
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		net_buf_pool_cache_flush(pool);
+		return k_lifo_get(&pool->free, K_NO_WAIT);
+	}
+
+	/* Keep freed buffers from being cached while we are waiting */
+	atomic_inc(&pool->waiters);
+	net_buf_pool_cache_flush(pool);
+
+	buf = k_lifo_get(&pool->free, timeout);
+
+	atomic_dec(&pool->waiters);
+
+	return buf;
+#else
+	return k_lifo_get(&pool->free, timeout);
+#endif
+}
+
+/* Return a list of freed buffers to the free LIFO of the pool in one go */
+static void pool_put_free(struct net_buf_pool *pool, sys_slist_t *list)
+{
+	sys_snode_t *node = sys_slist_peek_head(list);
+
+	if (node == NULL) {
+		return;
+	}
+
+	/* A single buffer is put at the head of the LIFO, so that it is the
+	 * next one to be allocated.
+	 */
+	if (node == sys_slist_peek_tail(list)) {
+		sys_slist_init(list);
+		k_lifo_put(&pool->free, CONTAINER_OF(node, struct net_buf, node));
+		return;
+	}
+
+	(void)k_queue_merge_slist(&pool->free._queue, list);
+}
+
+static int buf_init(struct net_buf *buf, size_t size, k_timeout_t timeout)
+{
+	if (size) {
+#if __ASSERT_ON
+		size_t req_size = size;
+#endif
+		buf->__buf = data_alloc(buf, &size, timeout);
+		if (!buf->__buf) {
+			return -ENOMEM;
+		}
+
+#if __ASSERT_ON
+		NET_BUF_ASSERT(req_size <= size);
+#endif
+	} else {
+		buf->__buf = NULL;
+	}
+
+	buf->ref   = 1U;
+	buf->flags = 0U;
+	buf->frags = NULL;
+	buf->size  = size;
+	memset(buf->user_data, 0, buf->user_data_size);
+	net_buf_reset(buf);
+
+	return 0;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -239,6 +424,12 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	if (cache_get(pool, &buf, 1) == 1) {
+		goto success;
+	}
+#endif
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -280,7 +471,7 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
-		buf = k_lifo_get(&pool->free, K_NO_WAIT);
+		buf = pool_get_free(pool, K_NO_WAIT);
 		while (!buf) {
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 			NET_BUF_WARN("%s():%d: Pool %s low on buffers.",
@@ -289,7 +480,7 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 			NET_BUF_WARN("%s():%d: Pool %p low on buffers.",
 				     func, line, pool);
 #endif
-			buf = k_lifo_get(&pool->free, WARN_ALLOC_INTERVAL);
+			buf = pool_get_free(pool, WARN_ALLOC_INTERVAL);
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 			NET_BUF_WARN("%s():%d: Pool %s blocked for %u secs",
 				     func, line, pool->name,
@@ -301,10 +492,10 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #endif
 		}
 	} else {
-		buf = k_lifo_get(&pool->free, timeout);
+		buf = pool_get_free(pool, timeout);
 	}
 #else
-	buf = k_lifo_get(&pool->free, timeout);
+	buf = pool_get_free(pool, timeout);
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
@@ -314,38 +505,100 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 success:
 	NET_BUF_DBG("allocated buf %p", buf);
 
-	if (size) {
-#if __ASSERT_ON
-		size_t req_size = size;
+	if (buf_init(buf, size, sys_timepoint_timeout(end)) < 0) {
+		NET_BUF_ERR("%s():%d: Failed to allocate data", func, line);
+		net_buf_destroy(buf);
+		return NULL;
+	}
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_dec(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
 #endif
-		timeout = sys_timepoint_timeout(end);
-		buf->__buf = data_alloc(buf, &size, timeout);
-		if (!buf->__buf) {
-			NET_BUF_ERR("%s():%d: Failed to allocate data",
-				    func, line);
-			net_buf_destroy(buf);
-			return NULL;
-		}
+	return buf;
+}
 
-#if __ASSERT_ON
-		NET_BUF_ASSERT(req_size <= size);
+#if defined(CONFIG_NET_BUF_LOG)
+int net_buf_alloc_len_bulk_debug(struct net_buf_pool *pool, size_t size,
+				 struct net_buf **bufs, size_t count,
+				 k_timeout_t timeout, const char *func, int line)
+#else
+int net_buf_alloc_len_bulk(struct net_buf_pool *pool, size_t size,
+			   struct net_buf **bufs, size_t count,
+			   k_timeout_t timeout)
 #endif
-	} else {
-		buf->__buf = NULL;
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	size_t got = 0;
+	size_t i = 0;
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(bufs);
+
+	NET_BUF_DBG("%s():%d: pool %p size %zu count %zu", func, line, pool,
+		    size, count);
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	got = cache_get(pool, bufs, count);
+#endif
+
+	/* Take as many buffers as possible from the uninitialized ones
+	 * while holding the lock only once.
+	 */
+	key = k_spin_lock(&pool->lock);
+
+	while (got < count && pool->uninit_count) {
+		bufs[got++] = pool_get_uninit(pool, pool->uninit_count--);
 	}
 
-	buf->ref   = 1U;
-	buf->flags = 0U;
-	buf->frags = NULL;
-	buf->size  = size;
-	memset(buf->user_data, 0, buf->user_data_size);
-	net_buf_reset(buf);
+	k_spin_unlock(&pool->lock, key);
+
+	if (got < count && !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	    k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
+		LOG_WRN("Timeout discarded. No blocking in syswq");
+		end = sys_timepoint_calc(K_NO_WAIT);
+	}
+
+	while (got < count) {
+		bufs[got] = pool_get_free(pool, sys_timepoint_timeout(end));
+		if (!bufs[got]) {
+			NET_BUF_ERR("%s():%d: Failed to get %zu free buffers",
+				    func, line, count);
+			goto fail;
+		}
+
+		got++;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (buf_init(bufs[i], size, sys_timepoint_timeout(end)) < 0) {
+			NET_BUF_ERR("%s():%d: Failed to allocate data",
+				    func, line);
+			goto fail;
+		}
+	}
 
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
+	atomic_sub(&pool->avail_count, count);
 	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
 #endif
-	return buf;
+	return 0;
+
+fail:
+	/* Buffers at index i and above do not own any data yet */
+	while (got > 0) {
+		got--;
+
+		if (got >= i) {
+			bufs[got]->__buf = NULL;
+		}
+
+		net_buf_destroy(bufs[got]);
+		bufs[got] = NULL;
+	}
+
+	return -ENOMEM;
 }
 
 #if defined(CONFIG_NET_BUF_LOG)
@@ -457,8 +710,13 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line)
 void net_buf_unref(struct net_buf *buf)
 #endif
 {
+	struct net_buf_pool *free_pool = NULL;
+	sys_slist_t free_list;
+
 	__ASSERT_NO_MSG(buf);
 
+	sys_slist_init(&free_list);
+
 	while (buf) {
 		struct net_buf *frags = buf->frags;
 		struct net_buf_pool *pool;
@@ -467,14 +725,14 @@ void net_buf_unref(struct net_buf *buf)
 		if (!buf->ref) {
 			NET_BUF_ERR("%s():%d: buf %p double free", func, line,
 				    buf);
-			return;
+			break;
 		}
 #endif
 		NET_BUF_DBG("buf %p ref %u pool_id %u frags %p", buf, buf->ref,
 			    buf->pool_id, buf->frags);
 
 		if (--buf->ref > 0) {
-			return;
+			break;
 		}
 
 		buf->data = NULL;
@@ -489,12 +747,42 @@ void net_buf_unref(struct net_buf *buf)
 
 		if (pool->destroy) {
 			pool->destroy(buf);
-		} else {
-			net_buf_destroy(buf);
+			buf = frags;
+			continue;
+		}
+
+		/* Consecutive fragments from the same pool are collected and
+		 * returned to the pool's free LIFO at once.
+		 */
+		if (pool != free_pool) {
+			if (free_pool) {
+				pool_put_free(free_pool, &free_list);
+			}
+
+			free_pool = pool;
+		}
+
+		if (buf->__buf) {
+			if (!(buf->flags & NET_BUF_EXTERNAL_DATA)) {
+				pool->alloc->cb->unref(buf, buf->__buf);
+			}
+			buf->__buf = NULL;
 		}
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+		if (!net_buf_pool_cache_put(pool, buf)) {
+			sys_slist_append(&free_list, &buf->node);
+		}
+#else
+		sys_slist_append(&free_list, &buf->node);
+#endif
+
 		buf = frags;
 	}
+
+	if (free_pool) {
+		pool_put_free(free_pool, &free_list);
+	}
 }
 
 struct net_buf *net_buf_ref(struct net_buf *buf)
@@ -230,8 +230,52 @@ static int append_string(cbprintf_convert_cb cb, void *ctx, const char *str, uin
 	return cb(str, strl, ctx);
 }
 
-int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
-		      const char *fmt, va_list ap)
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
+/* Get index of the conversion in @p fmt which consumes the nth argument. A '*'
+ * width or precision consumes an argument of its own but belongs to the same
+ * conversion, so the result matches the argument index of a parsed format string.
+ */
+static int arg_conversion_idx(const char *fmt, int n)
+{
+	int conv = -1;
+	bool parsing = false;
+	char c;
+
+	while ((c = *fmt++) != '\0') {
+		if (!parsing) {
+			if (c == '%') {
+				parsing = true;
+				conv++;
+			}
+			continue;
+		}
+
+		if (c == '%') {
+			parsing = false;
+			conv--;
+		} else if (c == '*') {
+			if (n-- == 0) {
+				break;
+			}
+		} else if (strchr("#-+ 0123456789.hlLjzt", c) == NULL) {
+			parsing = false;
+			if (n-- == 0) {
+				break;
+			}
+		}
+	}
+
+	return conv;
+}
+#endif
+
+/* Package the arguments. Their types are taken from the tags preceding them
+ * with CBPRINTF_PACKAGE_ARGS_ARE_TAGGED, from @p arg_types if it is not null
+ * or from the format string otherwise.
+ */
+static int package_args(void *packaged, size_t len, uint32_t flags,
+			const uint8_t *arg_types, const char *fmt, va_list ap)
 {
 /*
  * Internally, a byte is used to store location of a string argument within a
@@ -256,6 +300,7 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 	int arg_idx	      = -1; /* Argument index. Preincremented thus starting from -1.*/
 	unsigned int i;
 	const char *s;
+	const char *fmt0 = fmt;     /* format string start */
 	bool parsing = false;
 	/* Flag indicates that rw strings are stored as array with positions,
 	 * instead of appending them to the package.
@@ -268,6 +313,13 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 	int fros_cnt = 1 + Z_CBPRINTF_PACKAGE_FIRST_RO_STR_CNT_GET(flags);
 	bool is_str_arg = false;
 	union cbprintf_package_hdr *pkg_hdr = packaged;
+	bool args_tagged =
+		IS_ENABLED(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) &&
+		((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) == CBPRINTF_PACKAGE_ARGS_ARE_TAGGED);
+
+	ARG_UNUSED(args_tagged);
+	ARG_UNUSED(arg_types);
+	ARG_UNUSED(fmt0);
 
 	/* Buffer must be aligned at least to size of a pointer. */
 	if ((uintptr_t)packaged % sizeof(void *)) {
@@ -343,36 +395,47 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 
 	while (true) {
 
-#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS)
-		if ((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED)
-		    == CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) {
-			int arg_tag = va_arg(ap, int);
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
+		if (args_tagged || (arg_types != NULL)) {
+			int arg_tag;
 
-			/*
-			 * Here we copy the tag over to the package.
-			 */
-			align = VA_STACK_ALIGN(int);
-			size = sizeof(int);
+			if (args_tagged) {
+				arg_tag = va_arg(ap, int);
+
+				/*
+				 * Here we copy the tag over to the package.
+				 */
+				align = VA_STACK_ALIGN(int);
+				size = sizeof(int);
 
-			/* align destination buffer location */
-			buf = (void *)ROUND_UP(buf, align);
+				/* align destination buffer location */
+				buf = (void *)ROUND_UP(buf, align);
 
-			/* make sure the data fits */
-			if (buf0 != NULL && BUF_OFFSET + size > len) {
-				return -ENOSPC;
-			}
+				/* make sure the data fits */
+				if (buf0 != NULL && BUF_OFFSET + size > len) {
+					return -ENOSPC;
+				}
 
-			if (buf0 != NULL) {
-				*(int *)buf = arg_tag;
-			}
+				if (buf0 != NULL) {
+					*(int *)buf = arg_tag;
+				}
 
-			buf += sizeof(int);
+				buf += sizeof(int);
+			} else {
+				/* Types are known at compile time, the package
+				 * looks as if the format string was parsed.
+				 */
+				arg_tag = *arg_types++;
+			}
 
 			if (arg_tag == CBPRINTF_PACKAGE_ARG_TYPE_END) {
 				/* End of arguments */
 				break;
 			}
 
+			arg_idx++;
+
 			/*
 			 * There are lots of __fallthrough here since
 			 * quite a few of the data types have the same
@@ -438,7 +501,8 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 					}
 					if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
 						memcpy(buf, (uint8_t *)&v, size);
-					} else if (fmt[-1] == 'L') {
+					} else if (arg_tag ==
+						   CBPRINTF_PACKAGE_ARG_TYPE_LONG_DOUBLE) {
 						*(long double *)buf = v.ld;
 					} else {
 						*(double *)buf = v.d;
@@ -463,7 +527,7 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 			}
 
 		} else
-#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+#endif
 		{
 			/* Scan the format string */
 			if (*++fmt == '\0') {
@@ -649,6 +713,15 @@ process_string:
 					 */
 					str_ptr_pos[s_idx] = s_ptr_idx;
 					str_ptr_arg[s_idx] = arg_idx;
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
+					/* Tagged and described arguments are counted
+					 * one by one, including '*' width and precision.
+					 */
+					if ((args_tagged || (arg_types != NULL)) && (arg_idx >= 0)) {
+						str_ptr_arg[s_idx] = arg_conversion_idx(fmt0, arg_idx);
+					}
+#endif
 					if (is_ro) {
 						/* flag read-only string. */
 						str_ptr_pos[s_idx] |= STR_POS_RO_FLAG;
@@ -815,6 +888,23 @@ process_string:
 #undef STR_POS_MASK
 }
 
+int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
+		      const char *format, va_list ap)
+{
+	return package_args(packaged, len, flags, NULL, format, ap);
+}
+
+#ifdef CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+int cbvprintf_package_desc(void *packaged, size_t len, uint32_t flags,
+			   const uint8_t *arg_types, const char *format,
+			   va_list ap)
+{
+	__ASSERT_NO_MSG(arg_types != NULL);
+
+	return package_args(packaged, len, flags, arg_types, format, ap);
+}
+#endif
+
 int cbprintf_package(void *packaged, size_t len, uint32_t flags,
 		     const char *format, ...)
 {
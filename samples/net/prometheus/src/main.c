@@ -19,6 +19,7 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/histogram.h>
 #include <zephyr/net/prometheus/summary.h>
+#include <zephyr/net/prometheus/stats.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,32 +41,87 @@ static uint16_t test_http_service_port = CONFIG_NET_SAMPLE_HTTP_SERVER_SERVICE_P
 HTTP_SERVICE_DEFINE(test_http_service, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &test_http_service_port, 1,
 		    10, NULL);
 
+/* Exposition state of a /metrics request, kept per client so that clients of
+ * the HTTP and the HTTPS service can be scraped at the same time.
+ */
+static struct metrics_request {
+	struct http_client_ctx *client;
+	struct prometheus_format_ctx format_ctx;
+	char buffer[256];
+} metrics_requests[CONFIG_HTTP_SERVER_MAX_CLIENTS];
+
+static struct metrics_request *metrics_request_get(struct http_client_ctx *client, bool alloc)
+{
+	struct metrics_request *free_req = NULL;
+
+	ARRAY_FOR_EACH_PTR(metrics_requests, req) {
+		if (req->client == client) {
+			return req;
+		}
+
+		if (req->client == NULL && free_req == NULL) {
+			free_req = req;
+		}
+	}
+
+	if (alloc && free_req != NULL) {
+		free_req->client = client;
+	}
+
+	return alloc ? free_req : NULL;
+}
+
 static int dyn_handler(struct http_client_ctx *client, enum http_data_status status,
 		       uint8_t *buffer, size_t len, struct http_response_ctx *response_ctx,
 		       void *user_data)
 {
+	struct metrics_request *req;
 	int ret;
-	static uint8_t prom_buffer[256];
 
-	if (status == HTTP_SERVER_DATA_FINAL) {
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		req = metrics_request_get(client, false);
+		if (req != NULL) {
+			req->client = NULL;
+		}
 
-		/* incrase counter per request */
-		prometheus_counter_inc(prom_context.counter);
+		return 0;
+	}
 
-		/* clear buffer */
-		(void)memset(prom_buffer, 0, sizeof(prom_buffer));
+	if (status == HTTP_SERVER_DATA_FINAL) {
+		req = metrics_request_get(client, false);
+		if (req == NULL) {
+			req = metrics_request_get(client, true);
+			if (req == NULL) {
+				LOG_ERR("No free metrics request");
+				return -EBUSY;
+			}
+
+			/* incrase counter per request */
+			prometheus_counter_inc(prom_context.counter);
+
+			prometheus_format_init(&req->format_ctx, prom_context.collector);
+		}
 
-		/* format exposition data */
-		ret = prometheus_format_exposition(prom_context.collector, prom_buffer,
-						   sizeof(prom_buffer));
+		/* format the next chunk of exposition data, the server calls
+		 * us again until the final chunk is sent
+		 */
+		ret = prometheus_format_next(&req->format_ctx, req->buffer, sizeof(req->buffer));
 		if (ret < 0) {
 			LOG_ERR("Cannot format exposition data (%d)", ret);
+			req->client = NULL;
 			return ret;
 		}
 
-		response_ctx->body = prom_buffer;
-		response_ctx->body_len = strlen(prom_buffer);
-		response_ctx->final_chunk = true;
+		response_ctx->body = (const uint8_t *)req->buffer;
+		response_ctx->body_len = ret;
+		response_ctx->final_chunk = prometheus_format_done(&req->format_ctx);
+
+		/* The server thread sends the last chunk before it calls any
+		 * handler again, so the slot can be reused right away.
+		 */
+		if (response_ctx->final_chunk) {
+			req->client = NULL;
+		}
 	}
 
 	return 0;
@@ -170,6 +226,10 @@ int main(void)
 
 	prometheus_collector_register_metric(prom_context.collector, prom_context.counter->base);
 
+#if defined(CONFIG_PROMETHEUS_NET_STATS) || defined(CONFIG_PROMETHEUS_THREAD_STATS)
+	prometheus_stats_register(prom_context.collector);
+#endif
+
 	setup_tls();
 
 	http_server_start();
@@ -6,6 +6,7 @@
 
 import logging
 import re
+import time
 
 from twister_harness import Shell
 from twister_harness import DeviceAdapter
@@ -37,3 +38,28 @@ def test_shell_perf(dut: DeviceAdapter, shell: Shell):
     while i < length:
         i += int(lines[i], 16) + 1
         assert i <= length, 'one of the samples is not true to size'
+
+
+def test_shell_perf_continuous(dut: DeviceAdapter, shell: Shell):
+
+    shell.base_timeout=10
+
+    logger.info('send "perf continuous start 99" command')
+    lines = shell.exec_command('perf continuous start 99')
+    assert 'Enabled continuous perf' in lines, 'expected response not found'
+    time.sleep(1)
+    shell.exec_command('perf continuous stop')
+    logger.info('response is valid')
+
+    logger.info('send "perf continuous collapse" command')
+    lines = shell.exec_command('perf continuous collapse')
+    headers = [re.match(r"Perf collapsed (\d+) samples", line) for line in lines]
+    headers = [match for match in headers if match is not None]
+    assert len(headers) == 1, 'expected response not found'
+    samples = int(headers[0].group(1))
+    assert samples != 0, 'no samples'
+
+    chains = [line for line in lines if re.match(r"cpu\d+;\S+ \d+$", line)]
+    assert len(chains) != 0, 'no call chains'
+    counted = sum(int(line.rsplit(' ', 1)[1]) for line in chains)
+    assert counted <= samples, 'more samples in call chains than taken'
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Log Parser for Dictionary-based Logging
+
+This uses the JSON database file to decode the binary log
+frames sent by the network backend over UDP or TCP and print
+the log messages.
+"""
+
+import argparse
+import logging
+import socket
+import struct
+import sys
+
+import parserlib
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+# Frame header in network byte order: magic, version, reserved,
+# payload length and sequence number
+FRAME_HDR = struct.Struct("!HBBHI")
+FRAME_MAGIC = 0x5a4c
+FRAME_VERSION = 1
+
+
+class FrameDecoder:
+    """Check frame headers and sequence numbers and decode the records"""
+
+    def __init__(self, log_parser):
+        self.log_parser = log_parser
+        self.next_seq = None
+        self.frames = 0
+        self.lost = 0
+
+    def decode(self, frame):
+        """Decode one complete frame, return False if it is malformed"""
+        if len(frame) < FRAME_HDR.size:
+            logger.error("------ Short frame (%d bytes)", len(frame))
+            return False
+
+        magic, version, _, length, seq = FRAME_HDR.unpack_from(frame)
+        if magic != FRAME_MAGIC or version != FRAME_VERSION:
+            logger.error("------ Unknown frame (magic 0x%04x, version %d)", magic, version)
+            return False
+
+        if len(frame) != FRAME_HDR.size + length:
+            logger.error("------ Frame %d length mismatch", seq)
+            return False
+
+        if self.next_seq is not None and seq != self.next_seq:
+            lost = (seq - self.next_seq) & 0xffffffff
+            self.lost += lost
+            print(f"--- {lost} frames lost ---")
+
+        self.next_seq = (seq + 1) & 0xffffffff
+        self.frames += 1
+
+        return self.log_parser.parse_log_data(frame[FRAME_HDR.size:])
+
+
+def receive_udp(args, decoder):
+    """Decode one frame per datagram"""
+    with socket.socket(args.family, socket.SOCK_DGRAM) as sock:
+        sock.bind((args.address, args.port))
+
+        while True:
+            frame, _ = sock.recvfrom(65535)
+            if not decoder.decode(frame):
+                logger.error("ERROR: there were error(s) parsing log data")
+
+
+def split_frames(stream, decoder):
+    """Decode the complete frames at the start of stream and return the rest,
+    or None if a frame cannot be decoded"""
+    while len(stream) >= FRAME_HDR.size:
+        end = FRAME_HDR.size + FRAME_HDR.unpack_from(stream)[3]
+        if len(stream) < end:
+            break
+
+        if not decoder.decode(stream[:end]):
+            return None
+
+        stream = stream[end:]
+
+    return stream
+
+
+def receive_tcp(args, decoder):
+    """Split the stream of each connection into frames"""
+    with socket.socket(args.family, socket.SOCK_STREAM) as sock:
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        sock.bind((args.address, args.port))
+        sock.listen(1)
+
+        while True:
+            conn, addr = sock.accept()
+            logger.debug("# Connection from %s", addr[0])
+            decoder.next_seq = None
+            stream = b""
+
+            with conn:
+                while stream is not None:
+                    data = conn.recv(4096)
+                    if not data:
+                        break
+
+                    stream = split_frames(stream + data, decoder)
+
+            if stream is None:
+                logger.error("ERROR: cannot parse stream, connection dropped")
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("--address", default="",
+                           help="Local address to listen on (default: all)")
+    argparser.add_argument("--port", type=int, default=514,
+                           help="Local port to listen on (default: 514)")
+    argparser.add_argument("--tcp", action="store_true",
+                           help="Accept TCP connections instead of UDP datagrams")
+    argparser.add_argument("--ipv6", dest="family", action="store_const",
+                           const=socket.AF_INET6, default=socket.AF_INET,
+                           help="Listen on IPv6")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def main():
+    """Main function of network log parser"""
+    args = parse_args()
+
+    if args.dbfile is None or '.json' not in args.dbfile:
+        logger.error("ERROR: invalid log database path: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    logging.basicConfig(format=LOGGER_FORMAT)
+
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    log_parser = parserlib.get_log_parser(args.dbfile, logger)
+    if log_parser is None:
+        sys.exit(1)
+
+    decoder = FrameDecoder(log_parser)
+
+    try:
+        if args.tcp:
+            receive_tcp(args, decoder)
+        else:
+            receive_udp(args, decoder)
+    except KeyboardInterrupt:
+        pass
+
+    logger.info("# %d frames received, %d lost", decoder.frames, decoder.lost)
+
+
+if __name__ == "__main__":
+    main()
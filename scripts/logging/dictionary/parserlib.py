@@ -17,8 +17,8 @@ import logging
 import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
 
-def parser(logdata, dbfile, logger):
-    """function of serial parser"""
+def get_log_parser(dbfile, logger):
+    """Read the database file and return a parser matching its version"""
     # Read from database file
     database = LogDatabase.read_json_database(dbfile)
 
@@ -29,10 +29,6 @@ def parser(logdata, dbfile, logger):
         logger.error("ERROR: Cannot open database file:  exiting...")
         sys.exit(1)
 
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file:  exiting...")
-        sys.exit(1)
-
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
         logger.debug("# Build ID: %s", database.get_build_id())
@@ -41,10 +37,22 @@ def parser(logdata, dbfile, logger):
             logger.debug("# Endianness: Little")
         else:
             logger.debug("# Endianness: Big")
+    else:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+
+    return log_parser
+
 
+def parser(logdata, dbfile, logger):
+    """function of serial parser"""
+    log_parser = get_log_parser(dbfile, logger)
+
+    if logdata is None:
+        logger.error("ERROR: cannot read log from file:  exiting...")
+        sys.exit(1)
+
+    if log_parser is not None:
         ret = log_parser.parse_log_data(logdata)
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
-    else:
-        logger.error("ERROR: Cannot find a suitable parser matching database version!")
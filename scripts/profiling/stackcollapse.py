@@ -12,8 +12,12 @@ This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
 from addresses
 
+The output of "perf continuous collapse" is already aggregated, only its
+addresses are translated and call chains ending up the same are merged.
+
 Usage:
     ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
+    ./script/perf/stackcollapse.py <file with perf continuous collapse output> <ELF file>
 """
 
 import re
@@ -54,12 +58,39 @@ def collapse(buf, elf):
         buf = buf[8 + 8 * count:]
 
 
+def merge_funcs(funcs):
+    """Merge adjacent frames of the same function"""
+    merged = []
+    for func in funcs:
+        if not merged or merged[-1] != func:
+            merged.append(func)
+    return merged
+
+
+def collapse_aggregated(lines, elf):
+    stacks = {}
+    for line in filter(None, lines):
+        chain, count = line.rsplit(" ", 1)
+        cpu, thread, *addrs = chain.split(";")
+
+        funcs = merge_funcs(addr_to_sym(int(a, 16), elf) for a in addrs)
+        stack = ";".join([cpu, thread] + funcs)
+        stacks[stack] = stacks.get(stack, 0) + int(count)
+
+    for stack, count in stacks.items():
+        print(stack, count)
+
+
 if __name__ == "__main__":
     elf = ELFFile(open(sys.argv[2], "rb"))
     with open(sys.argv[1], "r") as f:
         inp = f.read()
 
     lines = inp.splitlines()
+    if re.match(r"Perf collapsed \d+ samples", lines[0]):
+        collapse_aggregated(lines[1:], elf)
+        sys.exit(0)
+
     assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
     buf = binascii.unhexlify("".join(lines[1:]))
     collapse(buf, elf)
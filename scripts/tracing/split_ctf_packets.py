@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to split CTF packets written with CONFIG_TRACING_PERCPU_BUFFERS
+into one stream file per CPU.
+
+The packets of all CPUs are interleaved in the captured data. CTF readers
+expect the packets of one stream file to come from a single CPU, so they
+are sorted into channel0_<cpu> files next to the generated metadata:
+
+    mkdir ctf
+    cp build/zephyr/ctf/metadata ctf/
+    ./scripts/tracing/split_ctf_packets.py -i channel0_0 -o ctf
+    babeltrace2 ctf
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+# struct packet_header and struct packet_context of the metadata
+PACKET_HDR = struct.Struct("<IIIIIIII")
+PACKET_MAGIC = 0xC1FC1FC1
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-i", "--input", required=True,
+            help="captured tracing data")
+    parser.add_argument("-o", "--output", required=True,
+            help="directory to write the per-CPU stream files to")
+    args = parser.parse_args()
+    return args
+
+
+def split_packets(data):
+    """Yield the CPU and data of every packet, stop at the first bad one"""
+    offset = 0
+
+    while offset + PACKET_HDR.size <= len(data):
+        (magic, _, _, _, content_size, packet_size, _,
+         cpu_id) = PACKET_HDR.unpack_from(data, offset)
+        size = packet_size // 8
+
+        if magic != PACKET_MAGIC or size < PACKET_HDR.size or \
+           content_size > packet_size or offset + size > len(data):
+            print(f"Bad packet at offset {offset}, ignoring the rest", file=sys.stderr)
+            return
+
+        yield cpu_id, data[offset:offset + size]
+        offset += size
+
+
+def main():
+    args = parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    streams = {}
+    for cpu_id, packet in split_packets(data):
+        streams.setdefault(cpu_id, []).append(packet)
+
+    os.makedirs(args.output, exist_ok=True)
+
+    for cpu_id, packets in sorted(streams.items()):
+        with open(os.path.join(args.output, f"channel0_{cpu_id}"), "wb") as f:
+            for packet in packets:
+                f.write(packet)
+
+        print(f"CPU {cpu_id}: {len(packets)} packets")
+
+
+if __name__ == "__main__":
+    main()
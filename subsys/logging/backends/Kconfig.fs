@@ -66,4 +66,49 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_ASYNC
+	bool "Write logs from a separate work queue"
+	help
+	  When enabled the formatted output is collected in one of two RAM
+	  buffers while the other one is written to the file system by a
+	  dedicated low priority work queue. File writes, syncs and rotation
+	  then no longer stall the log processing thread, which only waits
+	  when both buffers are full. Writes are made in chunks of
+	  LOG_BACKEND_FS_ASYNC_BUF_SIZE bytes, so the file system sees fewer
+	  and larger writes. Buffered output is lost on a crash or reset.
+
+if LOG_BACKEND_FS_ASYNC
+
+config LOG_BACKEND_FS_ASYNC_BUF_SIZE
+	int "Size of each buffer"
+	default 512
+	help
+	  Size of each of the two RAM buffers in bytes. A multiple of the
+	  flash page or file system block size gives aligned writes as long
+	  as the buffers fill up before the flush timeout. It must not be
+	  larger than LOG_BACKEND_FS_FILE_SIZE.
+
+config LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT
+	int "Flush timeout in milliseconds"
+	default 1000
+	help
+	  Buffered output is written at the latest this long after it was
+	  logged, even if the buffer is not full.
+
+config LOG_BACKEND_FS_ASYNC_PRIORITY
+	int "Work queue thread priority"
+	default 14
+	help
+	  Priority of the thread writing the log files. It should not be
+	  higher than the priority of the log processing thread, which runs
+	  at the lowest application priority by default.
+
+config LOG_BACKEND_FS_ASYNC_STACK_SIZE
+	int "Work queue thread stack size"
+	default 2048
+	help
+	  Stack size of the thread writing the log files.
+
+endif # LOG_BACKEND_FS_ASYNC
+
 endif # LOG_BACKEND_FS
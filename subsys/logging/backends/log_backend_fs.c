@@ -9,8 +9,10 @@
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_std.h>
+#include <zephyr/logging/log_backend_fs.h>
 #include <assert.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -28,6 +30,16 @@ static struct fs_file_t fs_file;
 static enum backend_fs_state backend_state = BACKEND_FS_NOT_INITIALIZED;
 static int file_ctr, newest, oldest;
 
+static struct log_backend_fs_stats stats;
+static struct k_spinlock stats_lock;
+
+#define STATS_UPDATE(expr)                                                                         \
+	do {                                                                                       \
+		k_spinlock_key_t key = k_spin_lock(&stats_lock);                                   \
+		expr;                                                                              \
+		k_spin_unlock(&stats_lock, key);                                                   \
+	} while (false)
+
 static int allocate_new_file(struct fs_file_t *file);
 static int del_oldest_log(void);
 static int get_log_file_id(struct fs_dirent *ent);
@@ -182,6 +194,7 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 		}
 
 		rc = fs_write(f, data, length);
+		STATS_UPDATE(stats.writes++; stats.bytes_written += length);
 		if (rc >= 0) {
 			if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
 			    (rc != length)) {
@@ -212,6 +225,7 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 		}
 
 		rc = fs_sync(f);
+		STATS_UPDATE(stats.syncs++);
 		if (rc < 0) {
 			/* Something is wrong */
 			goto on_error;
@@ -413,6 +427,7 @@ static int allocate_new_file(struct fs_file_t *file)
 	}
 	++file_ctr;
 	newest = curr_file_num;
+	STATS_UPDATE(stats.rotations++);
 
 out:
 	return rc;
@@ -450,13 +465,239 @@ static int del_oldest_log(void)
 BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 	     "Immediate logging is not supported by LOG FS backend.");
 
+void log_backend_fs_stats_get(struct log_backend_fs_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	*out = stats;
+	k_spin_unlock(&stats_lock, key);
+}
+
+#if defined(CONFIG_LOG_BACKEND_FS_ASYNC) || !defined(CONFIG_LOG_BACKEND_FS_TESTSUITE)
+static void stall_record(uint32_t start)
+{
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	STATS_UPDATE(stats.stalls++; stats.stall_total_us += us;
+		     stats.stall_max_us = MAX(stats.stall_max_us, us));
+}
+#endif
+
+#ifdef CONFIG_LOG_BACKEND_FS_ASYNC
+/* The log processing thread fills one buffer while the other one is written
+ * by a low priority work queue, which also does the file rotation and syncing.
+ * A buffer is handed over when it is full, so the file system sees writes of
+ * CONFIG_LOG_BACKEND_FS_ASYNC_BUF_SIZE bytes, or when the flush timeout expires
+ * with data still buffered.
+ */
+BUILD_ASSERT(CONFIG_LOG_BACKEND_FS_ASYNC_BUF_SIZE <= CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+	     "Async buffer must not be larger than a log file");
+
+struct fs_async_buf {
+	uint8_t __aligned(4) data[CONFIG_LOG_BACKEND_FS_ASYNC_BUF_SIZE];
+	size_t len;
+};
+
+static struct fs_async_buf async_bufs[2];
+static struct fs_async_buf *active = &async_bufs[0];
+static struct fs_async_buf *pending;
+
+/* Protects the active buffer */
+static K_MUTEX_DEFINE(async_lock);
+/* Available while no buffer is being written */
+static K_SEM_DEFINE(async_free, 1, 1);
+
+static K_THREAD_STACK_DEFINE(async_stack, CONFIG_LOG_BACKEND_FS_ASYNC_STACK_SIZE);
+static struct k_work_q async_wq;
+
+static void async_write_handler(struct k_work *work);
+static void async_flush_handler(struct k_work *work);
+
+static K_WORK_DEFINE(async_write_work, async_write_handler);
+static K_WORK_DELAYABLE_DEFINE(async_flush_work, async_flush_handler);
+
+static void async_write_pending(void)
+{
+	log_output_write(write_log_to_file, pending->data, pending->len, NULL);
+
+	pending->len = 0;
+	pending = NULL;
+	k_sem_give(&async_free);
+}
+
+static void async_write_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	async_write_pending();
+}
+
+/* Hand the active buffer over for writing, called with async_lock held and
+ * async_free taken.
+ */
+static void async_swap(void)
+{
+	pending = active;
+	active = (active == &async_bufs[0]) ? &async_bufs[1] : &async_bufs[0];
+	active->len = 0;
+}
+
+static void async_flush_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	/* The log thread may hold the lock while waiting for this queue to
+	 * finish a write, so never block on it here.
+	 */
+	if (k_mutex_lock(&async_lock, K_NO_WAIT) != 0) {
+		k_work_schedule_for_queue(&async_wq, &async_flush_work,
+					  K_MSEC(CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT));
+		return;
+	}
+
+	if (active->len == 0) {
+		k_mutex_unlock(&async_lock);
+		return;
+	}
+
+	if (k_sem_take(&async_free, K_NO_WAIT) != 0) {
+		/* Another buffer is being written, try again later */
+		k_mutex_unlock(&async_lock);
+		k_work_schedule_for_queue(&async_wq, &async_flush_work,
+					  K_MSEC(CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT));
+		return;
+	}
+
+	async_swap();
+	k_mutex_unlock(&async_lock);
+
+	async_write_pending();
+}
+
+static int async_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t left = length;
+
+	ARG_UNUSED(ctx);
+
+	(void)k_mutex_lock(&async_lock, K_FOREVER);
+
+	while (left > 0) {
+		size_t n = MIN(left, sizeof(active->data) - active->len);
+
+		memcpy(&active->data[active->len], data, n);
+		active->len += n;
+		data += n;
+		left -= n;
+
+		if (active->len == sizeof(active->data)) {
+			if (k_sem_take(&async_free, K_NO_WAIT) != 0) {
+				uint32_t start = k_cycle_get_32();
+
+				/* The other buffer is still being written */
+				(void)k_sem_take(&async_free, K_FOREVER);
+				stall_record(start);
+			}
+
+			async_swap();
+			k_work_submit_to_queue(&async_wq, &async_write_work);
+		}
+	}
+
+	if (active->len > 0) {
+		k_work_schedule_for_queue(&async_wq, &async_flush_work,
+					  K_MSEC(CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT));
+	}
+
+	k_mutex_unlock(&async_lock);
+
+	STATS_UPDATE(stats.bytes_logged += length);
+
+	return length;
+}
+
+void log_backend_fs_flush(void)
+{
+	(void)k_mutex_lock(&async_lock, K_FOREVER);
+
+	if (active->len == 0) {
+		k_mutex_unlock(&async_lock);
+		/* Wait for a write in progress to finish */
+		(void)k_sem_take(&async_free, K_FOREVER);
+		k_sem_give(&async_free);
+		return;
+	}
+
+	(void)k_sem_take(&async_free, K_FOREVER);
+	async_swap();
+	/* Nothing is buffered any more */
+	(void)k_work_cancel_delayable(&async_flush_work);
+	k_mutex_unlock(&async_lock);
+
+	async_write_pending();
+}
+
+static void async_init(void)
+{
+	static bool started;
+	struct k_work_queue_config cfg = {
+		.name = "log_fs",
+	};
+
+	if (started) {
+		return;
+	}
+
+	started = true;
+	k_work_queue_start(&async_wq, async_stack, K_THREAD_STACK_SIZEOF(async_stack),
+			   CONFIG_LOG_BACKEND_FS_ASYNC_PRIORITY, &cfg);
+}
+
+#ifdef CONFIG_LOG_BACKEND_FS_TESTSUITE
+/* Buffered counterpart of write_log_to_file() for the test suite */
+int write_log_to_buffer(uint8_t *data, size_t length, void *ctx)
+{
+	async_init();
+
+	return async_out(data, length, ctx);
+}
+#endif
+
+#define FS_OUTPUT_FUNC async_out
+#else
+void log_backend_fs_flush(void)
+{
+}
+#endif /* CONFIG_LOG_BACKEND_FS_ASYNC */
+
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#ifndef CONFIG_LOG_BACKEND_FS_ASYNC
+static int sync_out(uint8_t *data, size_t length, void *ctx)
+{
+	uint32_t start = k_cycle_get_32();
+	int rc;
+
+	rc = write_log_to_file(data, length, ctx);
+	stall_record(start);
+	STATS_UPDATE(stats.bytes_logged += length);
+
+	return rc;
+}
+
+#define FS_OUTPUT_FUNC sync_out
+#endif /* !CONFIG_LOG_BACKEND_FS_ASYNC */
+
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
-LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+LOG_OUTPUT_DEFINE(log_output, FS_OUTPUT_FUNC, buf, MAX_FLASH_WRITE_SIZE);
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
+	ARG_UNUSED(backend);
+
+#ifdef CONFIG_LOG_BACKEND_FS_ASYNC
+	async_init();
+#endif
 }
 
 static void panic(struct log_backend const *const backend)
@@ -11,7 +11,10 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_net.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/net/hostname.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/socket.h>
@@ -88,6 +91,102 @@ fail:
 
 LOG_OUTPUT_DEFINE(log_output_net, line_out, output_buf, sizeof(output_buf));
 
+#if defined(CONFIG_LOG_DICTIONARY_SUPPORT)
+/* In dictionary mode the binary records are batched into frames, each sent as
+ * one UDP datagram or written to the TCP stream as is. A frame starts with a
+ * header in network byte order:
+ *
+ *   magic (2) "ZL" | version (1) | reserved (1) | length (2) | sequence (4)
+ *
+ * followed by length bytes of records. The sequence number counts frames, so
+ * the receiver can tell how many were lost.
+ */
+#define DICT_FRAME_MAGIC    0x5a4c
+#define DICT_FRAME_VERSION  1
+#define DICT_FRAME_HDR_SIZE 10
+
+static uint8_t dict_frame[CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE];
+static size_t dict_frame_len = DICT_FRAME_HDR_SIZE;
+static uint32_t dict_frame_seq;
+static uint32_t dict_dropped;
+
+static int dict_out(uint8_t *data, size_t length, void *output_ctx)
+{
+	ARG_UNUSED(output_ctx);
+
+	/* Room for the whole record is made before it is written */
+	__ASSERT_NO_MSG(dict_frame_len + length <= sizeof(dict_frame));
+
+	memcpy(&dict_frame[dict_frame_len], data, length);
+	dict_frame_len += length;
+
+	return length;
+}
+
+/* Records are written straight to the frame, the output buffer is unused */
+static uint8_t dict_output_buf[1];
+LOG_OUTPUT_DEFINE(log_output_net_dict, dict_out, dict_output_buf, sizeof(dict_output_buf));
+
+static void dict_frame_send(void)
+{
+	int ret;
+
+	if (dict_frame_len == DICT_FRAME_HDR_SIZE) {
+		return;
+	}
+
+	sys_put_be16(DICT_FRAME_MAGIC, &dict_frame[0]);
+	dict_frame[2] = DICT_FRAME_VERSION;
+	dict_frame[3] = 0U;
+	sys_put_be16(dict_frame_len - DICT_FRAME_HDR_SIZE, &dict_frame[4]);
+	sys_put_be32(dict_frame_seq++, &dict_frame[6]);
+
+	if (ctx.sock >= 0) {
+		ret = zsock_send(ctx.sock, dict_frame, dict_frame_len,
+				 ctx.is_tcp ? 0 : ZSOCK_MSG_DONTWAIT);
+		if (ret < 0) {
+			DBG("Cannot send frame %u (%d)\n", dict_frame_seq - 1, -errno);
+		}
+	}
+
+	dict_frame_len = DICT_FRAME_HDR_SIZE;
+}
+
+static void dict_frame_reserve(size_t len)
+{
+	if (dict_frame_len + len > sizeof(dict_frame)) {
+		dict_frame_send();
+	}
+}
+
+static void dict_process(struct log_msg *msg)
+{
+	size_t len = sizeof(struct log_dict_output_normal_msg_hdr_t) +
+		     msg->hdr.desc.package_len + msg->hdr.desc.data_len;
+
+	if (len > sizeof(dict_frame) - DICT_FRAME_HDR_SIZE) {
+		/* Would never fit in a frame */
+		dict_dropped++;
+	} else {
+		if (dict_dropped > 0U) {
+			dict_frame_reserve(sizeof(struct log_dict_output_dropped_msg_t));
+			log_dict_output_dropped_process(&log_output_net_dict, dict_dropped);
+			dict_dropped = 0U;
+		}
+
+		dict_frame_reserve(len);
+		log_dict_output_msg_process(&log_output_net_dict, msg, 0);
+	}
+
+	/* Send once the queue is drained, so that a burst of messages shares
+	 * frames while a lone message is not held back.
+	 */
+	if (!log_data_pending()) {
+		dict_frame_send();
+	}
+}
+#endif /* CONFIG_LOG_DICTIONARY_SUPPORT */
+
 static int do_net_init(struct log_backend_net_ctx *ctx)
 {
 	struct sockaddr *local_addr = NULL;
@@ -211,13 +310,37 @@ static void process(const struct log_backend *const backend,
 		net_init_done = true;
 	}
 
+#if defined(CONFIG_LOG_DICTIONARY_SUPPORT)
+	if (log_format_current == LOG_OUTPUT_DICT) {
+		dict_process(&msg->log);
+		return;
+	}
+#endif
+
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
 	log_output_func(&log_output_net, &msg->log, flags);
 }
 
+#if defined(CONFIG_LOG_DICTIONARY_SUPPORT)
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	if (log_format_current == LOG_OUTPUT_DICT) {
+		dict_dropped += cnt;
+	}
+}
+#endif
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
+#if defined(CONFIG_LOG_DICTIONARY_SUPPORT)
+	if (log_format_current == LOG_OUTPUT_DICT) {
+		dict_frame_send();
+	}
+#endif
+
 	log_format_current = log_type;
 	return 0;
 }
@@ -342,6 +465,9 @@ const struct log_backend_api log_backend_net_api = {
 	.init = init_net,
 	.process = process,
 	.format_set = format_set,
+#if defined(CONFIG_LOG_DICTIONARY_SUPPORT)
+	.dropped = dropped,
+#endif
 };
 
 /* Note that the backend can be activated only after we have networking
@@ -138,6 +138,21 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+/* CPU 0 uses log_buffer, every other CPU gets a buffer of the same size so
+ * that concurrent loggers never contend on the same buffer lock.
+ */
+#define LOG_CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static struct mpsc_pbuf_buffer cpu_log_buffer[LOG_CPU_BUFFERS];
+
+/* Oldest message already claimed from each buffer, waiting to be merged. */
+static union log_msg_generic *cpu_pending_msg[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t cpu_dropped_cnt[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -584,6 +599,8 @@ bool z_impl_log_process(void)
 		}
 
 		last_failure_report += CONFIG_LOG_FAILURE_REPORT_PERIOD;
+
+		z_log_ratelimit_process();
 	}
 
 	return z_log_msg_pending();
@@ -613,6 +630,9 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	atomic_inc(&cpu_dropped_cnt[arch_curr_cpu()->id]);
+#endif
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -633,12 +653,60 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+int log_cpu_dropped_get(unsigned int cpu_id, uint32_t *dropped)
+{
+	__ASSERT_NO_MSG(dropped != NULL);
+
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	if (cpu_id >= CONFIG_MP_MAX_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+	*dropped = (uint32_t)atomic_get(&cpu_dropped_cnt[cpu_id]);
+
+	return 0;
+#else
+	ARG_UNUSED(cpu_id);
+
+	return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+static struct mpsc_pbuf_buffer *cpu_buffer(unsigned int cpu_id)
+{
+	return cpu_id == 0 ? &log_buffer : &cpu_log_buffer[cpu_id - 1];
+}
+
+/* A thread may migrate between allocating and committing a message, so the
+ * buffer is found from the message location rather than the current CPU.
+ */
+static struct mpsc_pbuf_buffer *msg_buffer(const struct log_msg *msg)
+{
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)cpu_buf32;
+
+	if (offset < sizeof(cpu_buf32)) {
+		return &cpu_log_buffer[offset / sizeof(cpu_buf32[0])];
+	}
+
+	return &log_buffer;
+}
+#endif
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -656,7 +724,11 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	return msg_alloc(cpu_buffer(arch_curr_cpu()->id), wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -678,7 +750,11 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	msg_commit(msg_buffer(msg), msg);
+#else
 	msg_commit(&log_buffer, msg);
+#endif
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -758,8 +834,47 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 	return msg;
 }
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+/* Merge the per-CPU buffers by claiming the message with the lowest timestamp. */
+static union log_msg_generic *z_log_msg_claim_cpu_oldest(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = 0;
+	int chosen = 0;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (cpu_pending_msg[i] == NULL) {
+			cpu_pending_msg[i] =
+				(union log_msg_generic *)mpsc_pbuf_claim(cpu_buffer(i));
+		}
+
+		if (cpu_pending_msg[i] != NULL) {
+			log_timestamp_t t = log_msg_get_timestamp(&cpu_pending_msg[i]->log);
+
+			if (msg == NULL || t < t_min) {
+				t_min = t;
+				msg = cpu_pending_msg[i];
+				chosen = i;
+			}
+		}
+	}
+
+	if (msg) {
+		cpu_pending_msg[chosen] = NULL;
+		curr_log_buffer = cpu_buffer(chosen);
+	}
+
+	return msg;
+}
+#endif
+
 union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	ARG_UNUSED(backoff);
+
+	return z_log_msg_claim_cpu_oldest();
+#else
 	size_t len;
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
@@ -770,6 +885,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	}
 
 	return z_log_msg_local_claim();
+#endif
 }
 
 static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generic *msg)
@@ -795,6 +911,15 @@ static bool msg_pending(struct mpsc_pbuf_buffer *buffer)
 
 bool z_log_msg_pending(void)
 {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		if (cpu_pending_msg[cpu] != NULL || msg_pending(cpu_buffer(cpu))) {
+			return true;
+		}
+	}
+
+	return false;
+#else
 	size_t len;
 	int i = 0;
 
@@ -821,6 +946,7 @@ bool z_log_msg_pending(void)
 	}
 
 	return false;
+#endif
 }
 
 void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len)
@@ -882,6 +1008,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_size, cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -893,7 +1029,20 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	int ret = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	for (int i = 0; (ret == 0) && (i < LOG_CPU_BUFFERS); i++) {
+		uint32_t cpu_max;
+
+		ret = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return ret;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
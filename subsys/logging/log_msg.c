@@ -342,9 +342,33 @@ static inline void z_vrfy_z_log_msg_static_create(const void *source,
 #include <zephyr/syscalls/z_log_msg_static_create_mrsh.c>
 #endif
 
+static int runtime_package(void *packaged, size_t len, uint32_t flags,
+			   const uint8_t *arg_types, const char *fmt, va_list ap)
+{
+#ifdef CONFIG_LOG_RUNTIME_ARG_DESC
+	if (arg_types != NULL) {
+		return cbvprintf_package_desc(packaged, len, flags, arg_types, fmt, ap);
+	}
+#else
+	ARG_UNUSED(arg_types);
+#endif
+
+	return cbvprintf_package(packaged, len, flags, fmt, ap);
+}
+
 void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
 				uint32_t package_flags, const char *fmt, va_list ap)
+{
+	z_log_msg_runtime_vcreate_desc(domain_id, source, level, data, dlen,
+				       package_flags, NULL, fmt, ap);
+}
+EXPORT_SYMBOL(z_log_msg_runtime_vcreate);
+
+void z_log_msg_runtime_vcreate_desc(uint8_t domain_id, const void *source,
+				    uint8_t level, const void *data, size_t dlen,
+				    uint32_t package_flags, const uint8_t *arg_types,
+				    const char *fmt, va_list ap)
 {
 	int plen;
 
@@ -352,8 +376,8 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		va_list ap2;
 
 		va_copy(ap2, ap);
-		plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
-					 package_flags, fmt, ap2);
+		plen = runtime_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
+				       package_flags, arg_types, fmt, ap2);
 		__ASSERT_NO_MSG(plen >= 0);
 		va_end(ap2);
 	} else {
@@ -385,7 +409,7 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	}
 
 	if (pkg && fmt) {
-		plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
+		plen = runtime_package(pkg, (size_t)plen, package_flags, arg_types, fmt, ap);
 		__ASSERT_NO_MSG(plen >= 0);
 	}
 
@@ -397,7 +421,7 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		z_log_msg_finalize(msg, source, desc, data);
 	}
 }
-EXPORT_SYMBOL(z_log_msg_runtime_vcreate);
+EXPORT_SYMBOL(z_log_msg_runtime_vcreate_desc);
 
 int16_t log_msg_get_source_id(struct log_msg *msg)
 {
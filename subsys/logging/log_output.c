@@ -16,6 +16,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -137,6 +138,72 @@ static int cr_out_func(int c, void *ctx)
 	return 0;
 }
 
+/* Copy a run of characters into the output buffer, flushing it as it fills up.
+ * Used instead of the per-character out_func() for everything that needs no
+ * formatting.
+ */
+static void out_write(const struct log_output *output, const char *data, size_t len)
+{
+	struct log_output_control_block *cb = output->control_block;
+
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		/* Backend must be thread safe in synchronous operation. */
+		log_output_write(output->func, (uint8_t *)data, len, cb->ctx);
+		return;
+	}
+
+	while (len > 0) {
+		size_t chunk;
+
+		if (cb->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - cb->offset);
+		memcpy(&output->buf[cb->offset], data, chunk);
+		atomic_add(&cb->offset, chunk);
+		data += chunk;
+		len -= chunk;
+	}
+
+	__ASSERT_NO_MSG(cb->offset <= output->size);
+}
+
+static int print_str(const struct log_output *output, const char *str)
+{
+	size_t len = strlen(str);
+
+	out_write(output, str, len);
+
+	return len;
+}
+
+/* Write value as a decimal number of at least width characters, padded with
+ * pad, and return the number of characters written.
+ */
+static size_t dec_fmt(char *buf, uint32_t value, size_t width, char pad)
+{
+	char digits[10];
+	size_t n = 0;
+	size_t len = 0;
+
+	do {
+		digits[n++] = '0' + (value % 10U);
+		value /= 10U;
+	} while (value != 0U);
+
+	while (width > n) {
+		buf[len++] = pad;
+		width--;
+	}
+
+	while (n > 0) {
+		buf[len++] = digits[--n];
+	}
+
+	return len;
+}
+
 static int print_formatted(const struct log_output *output,
 			   const char *fmt, ...)
 {
@@ -190,6 +257,57 @@ static void __attribute__((unused)) get_YMD_from_seconds(uint64_t seconds,
 	output_date->day += seconds / SECONDS_IN_DAY;
 }
 
+/* Print the default "[hh:mm:ss.mmm,uuu] " timestamp. The "[hh:mm:ss." part
+ * only changes once a second, so with the prefix cache it is kept formatted
+ * and copied for every message logged within the same second.
+ */
+static int hms_timestamp_print(const struct log_output *output, uint32_t total_seconds,
+			       uint32_t hours, uint32_t mins, uint32_t seconds,
+			       uint32_t ms, uint32_t us)
+{
+	char str[sizeof("[4294967295:00:00.000,000] ")];
+	size_t len = 0;
+
+#ifdef CONFIG_LOG_OUTPUT_PREFIX_CACHE
+	struct log_output_control_block *cb = output->control_block;
+
+	if (cb->ts_cache_len > 0 && cb->ts_cache_seconds == total_seconds) {
+		len = cb->ts_cache_len;
+		memcpy(str, cb->ts_cache, len);
+	}
+#else
+	ARG_UNUSED(total_seconds);
+#endif
+
+	if (len == 0) {
+		str[len++] = '[';
+		len += dec_fmt(&str[len], hours, 2, '0');
+		str[len++] = ':';
+		len += dec_fmt(&str[len], mins, 2, '0');
+		str[len++] = ':';
+		len += dec_fmt(&str[len], seconds, 2, '0');
+		str[len++] = '.';
+
+#ifdef CONFIG_LOG_OUTPUT_PREFIX_CACHE
+		if (len <= sizeof(cb->ts_cache)) {
+			memcpy(cb->ts_cache, str, len);
+			cb->ts_cache_len = len;
+			cb->ts_cache_seconds = total_seconds;
+		}
+#endif
+	}
+
+	len += dec_fmt(&str[len], ms, 3, '0');
+	str[len++] = ',';
+	len += dec_fmt(&str[len], us, 3, '0');
+	str[len++] = ']';
+	str[len++] = ' ';
+
+	out_write(output, str, len);
+
+	return len;
+}
+
 static int timestamp_print(const struct log_output *output,
 			   uint32_t flags, log_timestamp_t timestamp)
 {
@@ -203,7 +321,14 @@ static int timestamp_print(const struct log_output *output,
 
 	if (!format) {
 #ifndef CONFIG_LOG_TIMESTAMP_64BIT
-		length = print_formatted(output, "[%08lu] ", timestamp);
+		char str[sizeof("[4294967295] ")];
+
+		length = 0;
+		str[length++] = '[';
+		length += dec_fmt(&str[length], timestamp, 8, '0');
+		str[length++] = ']';
+		str[length++] = ' ';
+		out_write(output, str, length);
 #else
 		length = print_formatted(output, "[%016llu] ", timestamp);
 #endif
@@ -258,13 +383,21 @@ static int timestamp_print(const struct log_output *output,
 			length = log_custom_timestamp_print(output, timestamp, print_formatted);
 		} else {
 			if (IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_LINUX_TIMESTAMP)) {
-				length = print_formatted(output,
 #if defined(CONFIG_LOG_TIMESTAMP_64BIT)
-							"[%5llu.%06d] ",
+				length = print_formatted(output, "[%5llu.%06d] ",
+							 total_seconds, ms * 1000U + us);
 #else
-							"[%5lu.%06d] ",
+				char str[sizeof("[4294967295.000000] ")];
+
+				length = 0;
+				str[length++] = '[';
+				length += dec_fmt(&str[length], total_seconds, 5, ' ');
+				str[length++] = '.';
+				length += dec_fmt(&str[length], ms * 1000U + us, 6, '0');
+				str[length++] = ']';
+				str[length++] = ' ';
+				out_write(output, str, length);
 #endif
-							total_seconds, ms * 1000U + us);
 			} else if (IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_DATE_TIMESTAMP)) {
 #if defined(CONFIG_REQUIRES_FULL_LIBC)
 				char time_str[sizeof("1970-01-01 00:00:00")];
@@ -310,9 +443,8 @@ static int timestamp_print(const struct log_output *output,
 							 mins, seconds, ms * 1000U + us);
 #endif
 			} else {
-				length = print_formatted(output,
-							"[%02u:%02u:%02u.%03u,%03u] ",
-							hours, mins, seconds, ms, us);
+				length = hms_timestamp_print(output, total_seconds, hours, mins,
+							     seconds, ms, us);
 			}
 		}
 	} else {
@@ -328,7 +460,7 @@ static void color_print(const struct log_output *output,
 	if (color) {
 		const char *log_color = start && (colors[level] != NULL) ?
 				colors[level] : LOG_COLOR_CODE_DEFAULT;
-		print_formatted(output, "%s", log_color);
+		print_str(output, log_color);
 	}
 }
 
@@ -357,31 +489,81 @@ static int ids_print(const struct log_output *output,
 	int total = 0;
 
 	if (level_on) {
-		total += print_formatted(output, "<%s> ", severity[level]);
+		total += print_str(output, "<");
+		total += print_str(output, severity[level]);
+		total += print_str(output, "> ");
 	}
 
 	if (IS_ENABLED(CONFIG_LOG_THREAD_ID_PREFIX) && thread_on) {
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
-			total += print_formatted(output, "[%s] ",
-				tid == NULL ? "irq" : k_thread_name_get(tid));
+			total += print_str(output, "[");
+			total += print_str(output, tid == NULL ? "irq" : k_thread_name_get(tid));
+			total += print_str(output, "] ");
 		} else {
 			total += print_formatted(output, "[%p] ", tid);
 		}
 	}
 
 	if (domain) {
-		total += print_formatted(output, "%s/", domain);
+		total += print_str(output, domain);
+		total += print_str(output, "/");
 	}
 
 	if (source) {
-		total += print_formatted(output,
-				(func_on &&
-				((1 << level) & LOG_FUNCTION_PREFIX_MASK)) ?
-				"%s." : "%s: ",
-				source);
+		total += print_str(output, source);
+		total += print_str(output,
+				   (func_on && ((1 << level) & LOG_FUNCTION_PREFIX_MASK)) ?
+				   "." : ": ");
+	}
+
+	return total;
+}
+
+/* Print the level, thread, domain and source part of the prefix, copying it
+ * from the cache when the previous message had the same one. The part is
+ * taken straight from the output buffer after it is printed, unless the buffer
+ * had to be flushed in the meantime.
+ */
+static int cached_ids_print(const struct log_output *output,
+			    bool level_on,
+			    bool func_on,
+			    bool thread_on,
+			    const char *domain,
+			    const char *source,
+			    k_tid_t tid,
+			    uint32_t level)
+{
+#ifdef CONFIG_LOG_OUTPUT_PREFIX_CACHE
+	struct log_output_control_block *cb = output->control_block;
+	uint8_t key = level | (level_on ? BIT(3) : 0) | (func_on ? BIT(4) : 0) |
+		      (thread_on ? BIT(5) : 0);
+	size_t start = cb->offset;
+	int total;
+
+	if (cb->prefix_len > 0 && cb->prefix_key == key && cb->prefix_source == source &&
+	    cb->prefix_domain == domain && cb->prefix_tid == tid) {
+		out_write(output, cb->prefix, cb->prefix_len);
+
+		return cb->prefix_len;
+	}
+
+	total = ids_print(output, level_on, func_on, thread_on, domain, source, tid, level);
+
+	if (total > 0 && (size_t)total <= sizeof(cb->prefix) && cb->offset == start + total) {
+		memcpy(cb->prefix, &output->buf[start], total);
+		cb->prefix_len = total;
+		cb->prefix_key = key;
+		cb->prefix_source = source;
+		cb->prefix_domain = domain;
+		cb->prefix_tid = tid;
+	} else {
+		cb->prefix_len = 0;
 	}
 
 	return total;
+#else
+	return ids_print(output, level_on, func_on, thread_on, domain, source, tid, level);
+#endif
 }
 
 static void newline_print(const struct log_output *ctx, uint32_t flags)
@@ -396,9 +578,9 @@ static void newline_print(const struct log_output *ctx, uint32_t flags)
 	}
 
 	if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
-		print_formatted(ctx, "\n");
+		print_str(ctx, "\n");
 	} else {
-		print_formatted(ctx, "\r\n");
+		print_str(ctx, "\r\n");
 	}
 }
 
@@ -406,40 +588,56 @@ static void hexdump_line_print(const struct log_output *output,
 			       const uint8_t *data, uint32_t length,
 			       int prefix_offset, uint32_t flags)
 {
+	static const char spaces[] = "                ";
+	static const char hex[] = "0123456789abcdef";
+	/* Hex bytes, bar and characters, with a gap after every 8 bytes */
+	char line[HEXDUMP_BYTES_IN_LINE * 4 + 2 * (HEXDUMP_BYTES_IN_LINE / 8) + 1];
+	size_t len = 0;
+
 	newline_print(output, flags);
 
-	for (int i = 0; i < prefix_offset; i++) {
-		print_formatted(output, " ");
+	while (prefix_offset > 0) {
+		int n = MIN(prefix_offset, (int)sizeof(spaces) - 1);
+
+		out_write(output, spaces, n);
+		prefix_offset -= n;
 	}
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[len++] = ' ';
 		}
 
 		if (i < length) {
-			print_formatted(output, "%02x ", data[i]);
+			line[len++] = hex[data[i] >> 4];
+			line[len++] = hex[data[i] & 0xf];
+			line[len++] = ' ';
 		} else {
-			print_formatted(output, "   ");
+			line[len++] = ' ';
+			line[len++] = ' ';
+			line[len++] = ' ';
 		}
 	}
 
-	print_formatted(output, "|");
+	line[len++] = '|';
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[len++] = ' ';
 		}
 
 		if (i < length) {
 			unsigned char c = (unsigned char)data[i];
 
-			print_formatted(output, "%c",
-			      isprint((int)c) != 0 ? c : '.');
+			line[len++] = isprint((int)c) != 0 ? c : '.';
 		} else {
-			print_formatted(output, " ");
+			line[len++] = ' ';
 		}
 	}
+
+	__ASSERT_NO_MSG(len <= sizeof(line));
+
+	out_write(output, line, len);
 }
 
 static void log_msg_hexdump(const struct log_output *output,
@@ -659,7 +857,8 @@ static uint32_t prefix_print(const struct log_output *output,
 	}
 
 	if (tag) {
-		length += print_formatted(output, "%s ", tag);
+		length += print_str(output, tag);
+		length += print_str(output, " ");
 	}
 
 	if (stamp) {
@@ -670,13 +869,14 @@ static uint32_t prefix_print(const struct log_output *output,
 	    flags & LOG_OUTPUT_FLAG_FORMAT_SYSLOG) {
 		length += syslog_print(output, level_on, func_on, &thread_on, domain,
 				       source_off ? NULL : source, tid, level, length);
+		length += ids_print(output, level_on, func_on, thread_on, domain,
+				    source_off ? NULL : source, tid, level);
 	} else {
 		color_prefix(output, colors_on, level);
+		length += cached_ids_print(output, level_on, func_on, thread_on, domain,
+					   source_off ? NULL : source, tid, level);
 	}
 
-	length += ids_print(output, level_on, func_on, thread_on, domain,
-			    source_off ? NULL : source, tid, level);
-
 	return length;
 }
 
@@ -688,6 +888,25 @@ static void postfix_print(const struct log_output *output,
 	newline_print(output, flags);
 }
 
+/* Most messages have no arguments. When the package holds nothing but a format
+ * string without conversion specifiers, the string is copied to the output
+ * as a whole rather than being interpreted by cbprintf one character at a time.
+ */
+static const char *package_literal_get(const uint8_t *package)
+{
+	const struct cbprintf_package_hdr_ext *hdr = (const void *)package;
+
+	if ((hdr->hdr.desc.len * sizeof(int) != sizeof(*hdr)) || (hdr->hdr.desc.str_cnt != 0)) {
+		return NULL;
+	}
+
+	if (hdr->fmt == NULL || strchr(hdr->fmt, '%') != NULL) {
+		return NULL;
+	}
+
+	return hdr->fmt;
+}
+
 void log_output_process(const struct log_output *output,
 			log_timestamp_t timestamp,
 			const char *domain,
@@ -717,10 +936,16 @@ void log_output_process(const struct log_output *output,
 	}
 
 	if (package) {
-		int err = cbpprintf(cb, (void *)output, (void *)package);
+		const char *literal = cb == out_func ? package_literal_get(package) : NULL;
 
-		(void)err;
-		__ASSERT_NO_MSG(err >= 0);
+		if (literal != NULL) {
+			print_str(output, literal);
+		} else {
+			int err = cbpprintf(cb, (void *)output, (void *)package);
+
+			(void)err;
+			__ASSERT_NO_MSG(err >= 0);
+		}
 	}
 
 	if (data_len) {
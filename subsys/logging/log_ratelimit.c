@@ -0,0 +1,127 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef CONFIG_LOG_MODE_DEFERRED
+/* Set while the report timer is running, cleared by the report. */
+static atomic_t report_armed;
+/* Set when the report timer expired and the log thread shall report. */
+static atomic_t report_due;
+
+static void report_timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	atomic_set(&report_due, 1);
+	log_thread_trigger();
+}
+
+static K_TIMER_DEFINE(report_timer, report_timer_expiry, NULL);
+#endif
+
+static void report(struct log_ratelimit *rl, uint32_t cnt)
+{
+#ifdef CONFIG_LOG_MODE_MINIMAL
+	z_log_minimal_printk("%c: %u messages suppressed: \"%s\"\n",
+			     z_log_minimal_level_to_char(rl->level), cnt, rl->fmt);
+#else
+	z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, rl->source, rl->level, NULL, 0, 0,
+				 "%u messages suppressed: \"%s\"", cnt, rl->fmt);
+#endif
+}
+
+static bool suppress(struct log_ratelimit *rl, const void *source, const char *fmt)
+{
+	/* Written before the counter so that the report sees them. */
+	rl->source = source;
+	rl->fmt = fmt;
+
+	if (atomic_inc(&rl->suppressed) != 0) {
+		return false;
+	}
+
+#ifdef CONFIG_LOG_MODE_DEFERRED
+	/* The first suppression of a call site makes the log thread report
+	 * after an interval, unless a report is already scheduled.
+	 */
+	if (atomic_cas(&report_armed, 0, 1)) {
+		k_timer_start(&report_timer, K_MSEC(CONFIG_LOG_RATELIMIT_INTERVAL_MS),
+			      K_NO_WAIT);
+	}
+#endif
+
+	return false;
+}
+
+static bool pass(struct log_ratelimit *rl)
+{
+	/* Without the log thread, the call site reports before its next message. */
+	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && (atomic_get(&rl->suppressed) != 0)) {
+		uint32_t cnt = (uint32_t)atomic_set(&rl->suppressed, 0);
+
+		if (cnt != 0) {
+			report(rl, cnt);
+		}
+	}
+
+	return true;
+}
+
+bool z_log_ratelimit_take(struct log_ratelimit *rl, const void *source, const char *fmt)
+{
+	uint32_t now = k_uptime_get_32();
+	atomic_val_t start = atomic_get(&rl->start);
+
+	/* Only the context which moves the interval forward refills the bucket.
+	 * Others racing with it may see an empty bucket and suppress a message
+	 * which would have fitted, that is accepted to stay lock-free.
+	 */
+	if (((now - (uint32_t)start) >= rl->period) && atomic_cas(&rl->start, start, now)) {
+		atomic_set(&rl->tokens, rl->burst);
+	}
+
+	if (atomic_dec(&rl->tokens) <= 0) {
+		return suppress(rl, source, fmt);
+	}
+
+	return pass(rl);
+}
+
+bool z_log_sample_take(struct log_ratelimit *rl, const void *source, const char *fmt)
+{
+	if (((uint32_t)atomic_inc(&rl->tokens) % rl->period) != 0) {
+		return suppress(rl, source, fmt);
+	}
+
+	return pass(rl);
+}
+
+#ifdef CONFIG_LOG_MODE_DEFERRED
+void z_log_ratelimit_process(void)
+{
+	if (!atomic_cas(&report_due, 1, 0)) {
+		return;
+	}
+
+	/* Cleared before reading the counters so that a message suppressed
+	 * after its call site was reported arms the timer again.
+	 */
+	atomic_clear(&report_armed);
+
+	STRUCT_SECTION_FOREACH(log_ratelimit, rl) {
+		uint32_t cnt = (uint32_t)atomic_set(&rl->suppressed, 0);
+
+		if (cnt != 0) {
+			report(rl, cnt);
+		}
+	}
+}
+#endif /* CONFIG_LOG_MODE_DEFERRED */
@@ -142,6 +142,8 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	struct net_ipv4_hdr *ipv4_hdr;
 	struct net_pkt *pkt;
 	struct net_buf *last;
+	uint16_t old_offset;
+	uint16_t old_len;
 	int i;
 
 	k_work_cancel_delayable(&reass->timer);
@@ -195,12 +197,28 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		goto error;
 	}
 
-	/* Fix the total length, offset and checksum of the IPv4 packet */
+	/* Fix the total length and offset of the IPv4 packet. The checksum
+	 * of the first fragment is updated for the changed fields only when
+	 * the stack verified it, it is not known to be valid if the check was
+	 * offloaded.
+	 */
+	old_len = ipv4_hdr->len;
+	old_offset = UNALIGNED_GET((uint16_t *)ipv4_hdr->offset);
+
 	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
 	ipv4_hdr->offset[0] = 0;
 	ipv4_hdr->offset[1] = 0;
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt),
+					 NET_IF_CHECKSUM_IPV4_HEADER)) {
+		ipv4_hdr->chksum = net_chksum_update_u16(ipv4_hdr->chksum, old_len,
+							 ipv4_hdr->len);
+		ipv4_hdr->chksum = net_chksum_update_u16(ipv4_hdr->chksum,
+							 old_offset, 0);
+	} else {
+		ipv4_hdr->chksum = 0;
+		ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+	}
 
 	net_pkt_set_data(pkt, &ipv4_access);
 	net_pkt_set_ip_reassembled(pkt, true);
@@ -420,6 +438,25 @@ drop:
 	return NET_DROP;
 }
 
+/* The header checksum of an outgoing packet can only be updated incrementally
+ * if the stack computed it. It is left unset when the interface offloads it,
+ * and raw sockets provide their own header with any checksum.
+ */
+static bool ipv4_tx_chksum_is_valid(struct net_pkt *pkt, const struct net_ipv4_hdr *hdr)
+{
+	struct net_context *ctx = net_pkt_context(pkt);
+
+	if (!net_if_need_calc_tx_checksum(net_pkt_iface(pkt), NET_IF_CHECKSUM_IPV4_HEADER)) {
+		return false;
+	}
+
+	if (ctx != NULL && net_context_get_proto(ctx) == IPPROTO_RAW) {
+		return false;
+	}
+
+	return hdr->chksum != 0U;
+}
+
 static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fit_len,
 			      uint16_t frag_offset, bool final)
 {
@@ -464,12 +501,15 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 	/* Update the header of the packet */
 	NET_PKT_DATA_ACCESS_DEFINE(ipv4_access, struct net_ipv4_hdr);
 	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_ipv4_hdr old_hdr;
 
 	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt, &ipv4_access);
 	if (!ipv4_hdr) {
 		goto fail;
 	}
 
+	memcpy(&old_hdr, ipv4_hdr, sizeof(old_hdr));
+
 	memcpy(ipv4_hdr->id, &rand_id, sizeof(rand_id));
 	offset_pkt = frag_offset / 8;
 
@@ -480,8 +520,20 @@ static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fi
 	sys_put_be16(offset_pkt, ipv4_hdr->offset);
 	ipv4_hdr->len = htons((fit_len + net_pkt_ip_hdr_len(pkt)));
 
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	if (net_pkt_ipv4_opts_len(pkt) == 0 && ipv4_tx_chksum_is_valid(pkt, &old_hdr)) {
+		/* The copied header has a valid checksum, only the length,
+		 * ID and offset fields changed.
+		 */
+		ipv4_hdr->chksum = net_chksum_update(
+			ipv4_hdr->chksum,
+			(uint8_t *)&old_hdr + offsetof(struct net_ipv4_hdr, len),
+			(uint8_t *)ipv4_hdr + offsetof(struct net_ipv4_hdr, len),
+			offsetof(struct net_ipv4_hdr, ttl) -
+			offsetof(struct net_ipv4_hdr, len));
+	} else {
+		ipv4_hdr->chksum = 0;
+		ipv4_hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	}
 
 	net_pkt_set_chksum_done(frag_pkt, true);
 
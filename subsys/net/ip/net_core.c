@@ -480,6 +480,10 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
+#if defined(CONFIG_NET_RX_STEERING)
+	} else if (tc == 0 && net_rx_steering_submit(iface, pkt)) {
+		/* Best effort flows are spread over several RX threads */
+#endif
 	} else {
 		net_tc_submit_to_rx_queue(tc, pkt);
 	}
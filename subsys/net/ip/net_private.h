@@ -171,6 +171,24 @@ static inline void net_tc_rx_init(void) { }
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_RX_STEERING)
+struct net_rx_steering_stats {
+	atomic_t pkts;
+	atomic_t bytes;
+	/* Packets waiting in the queue, and the most seen so far */
+	atomic_t depth;
+	atomic_t max_depth;
+};
+
+/* Return false if the flow of the packet is unknown, the packet must then be
+ * queued by priority.
+ */
+extern bool net_rx_steering_submit(struct net_if *iface, struct net_pkt *pkt);
+extern int net_rx_steering_stats_get(int queue,
+				     struct net_rx_steering_stats *stats);
+extern int net_rx_steering_queue_count(void);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -256,6 +274,30 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Incrementally update an Internet checksum (RFC 1624) after some of
+ *        the data it covers was changed, without walking the whole data.
+ *
+ * @param chksum   Checksum field, as stored in the header
+ * @param old_data Old contents of the changed 16-bit aligned fields
+ * @param new_data New contents of the changed fields
+ * @param len      Length of the changed fields, must be even
+ *
+ * @return Updated checksum field, to be stored as is
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
+/**
+ * @brief Incrementally update an Internet checksum (RFC 1624) after a
+ *        single 16-bit field changed. The values are as stored in the packet.
+ */
+static inline uint16_t net_chksum_update_u16(uint16_t chksum, uint16_t old_val,
+					     uint16_t new_val)
+{
+	return net_chksum_update(chksum, &old_val, &new_val, sizeof(uint16_t));
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -8,15 +8,19 @@
 LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
 #include <string.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -279,6 +283,314 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 }
 #endif
 
+#if defined(CONFIG_NET_RX_STEERING)
+#define RX_STEERING_QUEUES CONFIG_NET_RX_STEERING_QUEUES
+
+struct rx_steering_queue {
+	struct net_traffic_class tc;
+	struct net_rx_steering_stats stats;
+};
+
+K_KERNEL_STACK_ARRAY_DEFINE(rx_steering_stack, RX_STEERING_QUEUES,
+			    CONFIG_NET_RX_STACK_SIZE);
+
+static struct rx_steering_queue rx_steering_queues[RX_STEERING_QUEUES];
+static uint32_t rx_steering_seed;
+
+static uint32_t rx_flow_hash_add(uint32_t hash, uint32_t val)
+{
+	hash ^= val;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+static uint32_t rx_flow_hash_words(uint32_t hash, const uint8_t *data,
+				   size_t len)
+{
+	for (size_t i = 0; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+		hash = rx_flow_hash_add(hash, UNALIGNED_GET((uint32_t *)&data[i]));
+	}
+
+	return hash;
+}
+
+/* Skip the link layer header, return the network protocol of the frame
+ * or 0 if it cannot be steered.
+ */
+static uint16_t rx_flow_skip_l2(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	uint16_t ptype;
+	uint8_t vhl;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_vlan_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(struct net_eth_hdr))) {
+			return 0;
+		}
+
+		/* Without a VLAN tag, the tpid is the type of the frame */
+		if (ntohs(hdr.vlan.tpid) != NET_ETH_PTYPE_VLAN) {
+			return ntohs(hdr.vlan.tpid);
+		}
+
+		if (net_pkt_read(pkt, &hdr.vlan.tci,
+				 sizeof(hdr) - sizeof(struct net_eth_hdr))) {
+			return 0;
+		}
+
+		return ntohs(hdr.type);
+	}
+#endif
+
+	/* Other links have no protocol field the frame could be classified
+	 * with before L2 processing, e.g. IEEE 802.15.4 frames carry
+	 * compressed headers. Only the packets the driver marked as IP are
+	 * known to start with the IP header.
+	 */
+	switch (net_pkt_family(pkt)) {
+	case AF_INET:
+		ptype = NET_ETH_PTYPE_IP;
+		break;
+	case AF_INET6:
+		ptype = NET_ETH_PTYPE_IPV6;
+		break;
+	default:
+		return 0;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (net_pkt_read_u8(pkt, &vhl)) {
+		return 0;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if ((vhl & 0xf0) != (ptype == NET_ETH_PTYPE_IP ? 0x40 : 0x60)) {
+		return 0;
+	}
+
+	return ptype;
+}
+
+/* Hash the addresses, protocol and ports of the flow. Fragments and
+ * packets with extension headers are hashed on the addresses only, so that
+ * all the packets of a datagram are handled by the same queue. Return
+ * false if the packet is not a known IP packet.
+ */
+static bool rx_flow_hash(struct net_if *iface, struct net_pkt *pkt,
+			 uint32_t *hash)
+{
+	uint8_t proto = 0;
+	size_t opt_len = 0;
+	uint32_t ports;
+
+	*hash = rx_steering_seed;
+
+	switch (rx_flow_skip_l2(iface, pkt)) {
+	case NET_ETH_PTYPE_IP: {
+		struct net_ipv4_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr))) {
+			return false;
+		}
+
+		*hash = rx_flow_hash_words(*hash, hdr.src, sizeof(hdr.src));
+		*hash = rx_flow_hash_words(*hash, hdr.dst, sizeof(hdr.dst));
+
+		if ((sys_get_be16(hdr.offset) & (NET_IPV4_MORE_FRAG_MASK |
+						 NET_IPV4_FRAGH_OFFSET_MASK)) == 0 &&
+		    (hdr.vhl & NET_IPV4_IHL_MASK) * 4U >= sizeof(hdr)) {
+			proto = hdr.proto;
+			opt_len = (hdr.vhl & NET_IPV4_IHL_MASK) * 4U - sizeof(hdr);
+		}
+
+		break;
+	}
+	case NET_ETH_PTYPE_IPV6: {
+		struct net_ipv6_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr))) {
+			return false;
+		}
+
+		*hash = rx_flow_hash_words(*hash, hdr.src, sizeof(hdr.src));
+		*hash = rx_flow_hash_words(*hash, hdr.dst, sizeof(hdr.dst));
+		proto = hdr.nexthdr;
+
+		break;
+	}
+	default:
+		return false;
+	}
+
+	if (proto != IPPROTO_TCP && proto != IPPROTO_UDP) {
+		return true;
+	}
+
+	/* Source and destination ports lead both UDP and TCP headers */
+	if (net_pkt_skip(pkt, opt_len) || net_pkt_read_be32(pkt, &ports)) {
+		return true;
+	}
+
+	*hash = rx_flow_hash_add(rx_flow_hash_add(*hash, proto), ports);
+
+	return true;
+}
+
+bool net_rx_steering_submit(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	struct rx_steering_queue *queue;
+	uint32_t hash;
+	atomic_val_t depth;
+	bool known;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+	known = rx_flow_hash(iface, pkt, &hash);
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if (!known) {
+		return false;
+	}
+
+	queue = &rx_steering_queues[((uint64_t)hash * RX_STEERING_QUEUES) >> 32];
+
+	atomic_inc(&queue->stats.pkts);
+	atomic_add(&queue->stats.bytes, net_pkt_get_len(pkt));
+
+	depth = atomic_inc(&queue->stats.depth) + 1;
+	if (depth > atomic_get(&queue->stats.max_depth)) {
+		/* Racy but good enough for statistics */
+		atomic_set(&queue->stats.max_depth, depth);
+	}
+
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+	submit_to_queue(&queue->tc.fifo, pkt);
+
+	return true;
+}
+
+int net_rx_steering_stats_get(int queue, struct net_rx_steering_stats *stats)
+{
+	if (queue < 0 || queue >= RX_STEERING_QUEUES) {
+		return -EINVAL;
+	}
+
+	*stats = rx_steering_queues[queue].stats;
+
+	return 0;
+}
+
+int net_rx_steering_queue_count(void)
+{
+	return RX_STEERING_QUEUES;
+}
+
+static void rx_steering_handler(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct rx_steering_queue *queue = p1;
+	struct net_pkt *pkt;
+
+	while (1) {
+		pkt = k_fifo_get(&queue->tc.fifo, K_FOREVER);
+		if (pkt == NULL) {
+			continue;
+		}
+
+		atomic_dec(&queue->stats.depth);
+
+		net_process_rx_packet(pkt);
+	}
+}
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+/* Return the n:th CPU of the steering CPU mask, wrapping around */
+static int rx_steering_cpu(int n)
+{
+	uint32_t mask = (uint32_t)CONFIG_NET_RX_STEERING_CPU_MASK &
+			BIT_MASK(arch_num_cpus());
+	int count = POPCOUNT(mask);
+
+	if (count == 0) {
+		return -1;
+	}
+
+	n %= count;
+
+	for (int cpu = 0; cpu < 32; cpu++) {
+		if ((mask & BIT(cpu)) != 0U && n-- == 0) {
+			return cpu;
+		}
+	}
+
+	return -1;
+}
+#endif
+
+static void rx_steering_init(void)
+{
+	uint8_t thread_priority = rx_tc2thread(0);
+	int priority;
+	int i;
+
+	priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
+		K_PRIO_COOP(thread_priority) :
+		K_PRIO_PREEMPT(thread_priority);
+
+	rx_steering_seed = sys_rand32_get();
+
+	for (i = 0; i < RX_STEERING_QUEUES; i++) {
+		struct rx_steering_queue *queue = &rx_steering_queues[i];
+		k_tid_t tid;
+#if defined(CONFIG_SCHED_CPU_MASK)
+		int cpu = rx_steering_cpu(i);
+#endif
+
+		NET_DBG("[%d] Starting RX steering handler %p stack size %zd "
+			"prio %d", i, &queue->tc.handler,
+			K_KERNEL_STACK_SIZEOF(rx_steering_stack[i]), priority);
+
+		k_fifo_init(&queue->tc.fifo);
+
+		tid = k_thread_create(&queue->tc.handler, rx_steering_stack[i],
+				      K_KERNEL_STACK_SIZEOF(rx_steering_stack[i]),
+				      rx_steering_handler,
+				      queue, NULL, NULL,
+				      priority, 0, K_FOREVER);
+		if (!tid) {
+			NET_ERR("Cannot create RX steering thread %d", i);
+			continue;
+		}
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		if (cpu >= 0 && k_thread_cpu_pin(tid, cpu) < 0) {
+			NET_ERR("Cannot pin RX steering thread %d to CPU %d",
+				i, cpu);
+		}
+#endif
+
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			char name[MAX_NAME_LEN];
+
+			snprintk(name, sizeof(name), "rx_s[%d]", i);
+			k_thread_name_set(tid, name);
+		}
+
+		k_thread_start(tid);
+	}
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 /* Create a fifo for each traffic class we are using. All the network
  * traffic goes through these classes.
  */
@@ -395,5 +707,9 @@ void net_tc_rx_init(void)
 
 		k_thread_start(tid);
 	}
+
+#if defined(CONFIG_NET_RX_STEERING)
+	rx_steering_init();
+#endif
 #endif
 }
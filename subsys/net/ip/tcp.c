@@ -81,6 +81,7 @@ static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
+static int tcp_send_data(struct tcp *conn);
 static const char *tcp_state_to_str(enum tcp_state state, bool prefix);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
@@ -442,21 +443,21 @@ static void tcp_derive_rto(struct tcp *conn)
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-/* Implementation according to RFC6582 */
-
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+static void tcp_ca_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	NET_DBG("conn: %p, ca %s %s, cwnd=%d, ssthres=%d, fast_pend=%i, srtt=%u",
+		conn, conn->ca_ops->name, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes, conn->ca.srtt);
 }
 
+/* Implementation according to RFC6582 */
+
 static void tcp_new_reno_init(struct tcp *conn)
 {
 	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
 	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
@@ -466,7 +467,7 @@ static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+		tcp_ca_log(conn, "fast_retransmit");
 	}
 }
 
@@ -474,7 +475,7 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	tcp_ca_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
@@ -484,7 +485,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 
 	new_win += conn_mss(conn);
 	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	tcp_ca_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
@@ -510,32 +511,421 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			conn->ca.cwnd -= acked_len;
 		}
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+	tcp_ca_log(conn, "pkts_acked");
 }
 
-static void tcp_ca_init(struct tcp *conn)
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+
+/* Implementation according to RFC9438. Windows are in bytes and times in
+ * milliseconds, beta_cubic and C are expressed in tenths.
+ */
+#define TCP_CUBIC_BETA 7
+#define TCP_CUBIC_C 4
+/* Bound |t - K| so that C * (t - K)^3 * MSS cannot overflow */
+#define TCP_CUBIC_MAX_DELTA_MS 20000
+
+static uint32_t tcp_cubic_cbrt(uint64_t val)
+{
+	uint64_t root = 0;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		root <<= 1;
+		b = 3 * root * (root + 1) + 1;
+		if ((val >> shift) >= b) {
+			val -= b << shift;
+			root++;
+		}
+	}
+
+	return (uint32_t)root;
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_collision_avoidance_cubic *cubic = &conn->ca.cubic;
+
+	/* Fast convergence: release bandwidth to newer flows when the
+	 * window did not reach the previous maximum.
+	 */
+	if (conn->ca.cwnd < cubic->w_max) {
+		cubic->w_max = (conn->ca.cwnd * (10 + TCP_CUBIC_BETA)) / 20;
+	} else {
+		cubic->w_max = conn->ca.cwnd;
+	}
+
+	cubic->epoch_start = 0;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				(conn->unacked_len * TCP_CUBIC_BETA) / 10);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	tcp_new_reno_init(conn);
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.cubic.w_max = 0;
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh, UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_collision_avoidance_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, mss);
+	uint32_t now = k_uptime_get_32();
+	int64_t target;
+	int64_t delta;
+
+	/* Slow start and fast recovery are the same as for New Reno */
+	if (conn->ca.pending_fast_retransmit_bytes > 0 ||
+	    conn->ca.cwnd < conn->ca.ssthresh) {
+		tcp_new_reno_pkts_acked(conn, acked_len);
+		return;
+	}
+
+	if (cubic->epoch_start == 0) {
+		cubic->epoch_start = now;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cubic_root((W_max - cwnd) / C) */
+			cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						  10U * NSEC_PER_SEC /
+						  (TCP_CUBIC_C * mss));
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = cwnd;
+		}
+	}
+
+	/* W_cubic(t + RTT) = C * (t + RTT - K)^3 + W_max */
+	delta = (int64_t)(now - cubic->epoch_start) + conn->ca.srtt - cubic->k;
+	delta = CLAMP(delta, -TCP_CUBIC_MAX_DELTA_MS, TCP_CUBIC_MAX_DELTA_MS);
+	target = cubic->origin +
+		 (TCP_CUBIC_C * delta * delta * delta * mss) / (10LL * NSEC_PER_SEC);
+
+	/* Reno friendly region, alpha_cubic = 3 * (1 - beta) / (1 + beta) */
+	cubic->w_est = MIN(cubic->w_est +
+			   DIV_ROUND_UP(3U * (10 - TCP_CUBIC_BETA) * win_inc * mss,
+					(10 + TCP_CUBIC_BETA) * cwnd),
+			   UINT16_MAX);
+	target = MAX(target, (int64_t)cubic->w_est);
+
+	if (target > cwnd) {
+		/* Reach the target in about one RTT */
+		cwnd += MAX(1, (uint32_t)((target - cwnd) * win_inc / cwnd));
+		conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+	}
+
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+
+/* A lightweight take on BBR: the window follows the measured bandwidth
+ * delay product instead of reacting to every loss. Startup grows the
+ * window like slow start until the bandwidth stops growing by 25% for
+ * three rounds, after which the window is kept at twice the BDP.
+ */
+#define TCP_BBR_CWND_GAIN 2
+#define TCP_BBR_MIN_CWND_SEGMENTS 4
+#define TCP_BBR_FULL_BW_ROUNDS 3
+#define TCP_BBR_BW_FILTER_ROUNDS 10
+
+static uint32_t tcp_bbr_max_bw(struct tcp *conn)
+{
+	return MAX(conn->ca.bbr.max_bw, conn->ca.bbr.prev_max_bw);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
 {
 	tcp_new_reno_init(conn);
+	memset(&conn->ca.bbr, 0, sizeof(conn->ca.bbr));
+	conn->ca.ssthresh = UINT16_MAX;
+}
+
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	/* Losses are not a congestion signal for the model */
+	tcp_ca_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void tcp_bbr_round(struct tcp *conn, uint32_t now)
+{
+	struct tcp_collision_avoidance_bbr *bbr = &conn->ca.bbr;
+	uint32_t elapsed = now - bbr->round_start;
+	uint32_t bw;
+
+	bw = (uint32_t)MIN((uint64_t)bbr->round_delivered * MSEC_PER_SEC / elapsed,
+			   UINT32_MAX);
+
+	/* Windowed max filter over two windows of rounds */
+	bbr->max_bw = MAX(bbr->max_bw, bw);
+	if (++bbr->rounds >= TCP_BBR_BW_FILTER_ROUNDS) {
+		bbr->prev_max_bw = bbr->max_bw;
+		bbr->max_bw = bw;
+		bbr->rounds = 0;
+	}
+
+	if (!bbr->filled_pipe) {
+		if (tcp_bbr_max_bw(conn) >= bbr->full_bw + bbr->full_bw / 4) {
+			bbr->full_bw = tcp_bbr_max_bw(conn);
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= TCP_BBR_FULL_BW_ROUNDS) {
+			bbr->filled_pipe = true;
+		}
+	}
+
+	bbr->round_start = now;
+	bbr->round_delivered = 0;
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_collision_avoidance_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	uint32_t mss = conn_mss(conn);
+	uint64_t cwnd;
+
+	if (bbr->round_start == 0) {
+		bbr->round_start = now;
+	}
+
+	bbr->round_delivered += acked_len;
+
+	if (conn->ca.min_rtt > 0 &&
+	    (now - bbr->round_start) >= conn->ca.min_rtt) {
+		tcp_bbr_round(conn, now);
+	}
+
+	if (!bbr->filled_pipe) {
+		cwnd = (uint64_t)conn->ca.cwnd + acked_len;
+	} else {
+		cwnd = (uint64_t)tcp_bbr_max_bw(conn) * conn->ca.min_rtt *
+		       TCP_BBR_CWND_GAIN / MSEC_PER_SEC;
+		cwnd = MAX(cwnd, TCP_BBR_MIN_CWND_SEGMENTS * mss);
+	}
+
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_bbr = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.dup_ack = tcp_bbr_dup_ack,
+	.pkts_acked = tcp_bbr_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_BBR */
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_ca_cubic,
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+	&tcp_ca_bbr,
+#endif
+};
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+	return &tcp_ca_cubic;
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+	return &tcp_ca_bbr;
+#else
+	return &tcp_ca_new_reno;
+#endif
+}
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	len = strnlen(name, len);
+
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		if (strlen(tcp_ca_algorithms[i]->name) == len &&
+		    strncmp(tcp_ca_algorithms[i]->name, name, len) == 0) {
+			return tcp_ca_algorithms[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_ca_init(struct tcp *conn)
+{
+	conn->ca.srtt = 0;
+	conn->ca.min_rtt = 0;
+	conn->rtt_pending = false;
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->pkts_acked(conn, acked_len);
+}
+
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca_ops = from->ca_ops;
+}
+
+/* Time one segment at a time to get RTT samples for the congestion
+ * control algorithms.
+ */
+static void tcp_rtt_start(struct tcp *conn)
+{
+	if (conn->rtt_pending) {
+		return;
+	}
+
+	conn->rtt_pending = true;
+	conn->rtt_seq = conn->seq + conn->unacked_len;
+	conn->rtt_start = k_uptime_get_32();
+}
+
+/* Karn's algorithm, never take samples of retransmitted segments */
+static void tcp_rtt_invalidate(struct tcp *conn)
+{
+	conn->rtt_pending = false;
+}
+
+static void tcp_rtt_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t rtt;
+
+	if (!conn->rtt_pending || net_tcp_seq_cmp(ack, conn->rtt_seq) < 0) {
+		return;
+	}
+
+	conn->rtt_pending = false;
+	rtt = MIN(k_uptime_get_32() - conn->rtt_start, UINT16_MAX);
+
+	if (conn->ca.srtt == 0) {
+		conn->ca.srtt = MAX(rtt, 1);
+	} else {
+		conn->ca.srtt = (7 * conn->ca.srtt + rtt) / 8;
+	}
+
+	if (conn->ca.min_rtt == 0 || rtt < conn->ca.min_rtt) {
+		conn->ca.min_rtt = MAX(rtt, 1);
+	}
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	ops = tcp_ca_find(value, MIN(len, TCP_CA_NAME_MAX));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops == conn->ca_ops) {
+		return 0;
+	}
+
+	conn->ca_ops = ops;
+
+	/* Switch the algorithm of a live connection, keeping its window */
+	if (conn->state >= TCP_ESTABLISHED) {
+		uint16_t cwnd = conn->ca.cwnd;
+		uint16_t ssthresh = conn->ca.ssthresh;
+
+		ops->init(conn);
+		conn->ca.cwnd = cwnd;
+		conn->ca.ssthresh = ssthresh;
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca_ops->name) + 1;
+
+	if (value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca_ops->name, name_len);
+	((char *)value)[name_len - 1] = '\0';
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -549,8 +939,203 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from) { }
+
+static void tcp_rtt_start(struct tcp *conn) { }
+
+static void tcp_rtt_invalidate(struct tcp *conn) { }
+
+static void tcp_rtt_update(struct tcp *conn, uint32_t ack) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	return -ENOTSUP;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	return -ENOTSUP;
+}
+
+#endif
+
+#if defined(CONFIG_NET_TCP_PACING)
+
+static int tcp_send_queued_data(struct tcp *conn);
+
+static int64_t tcp_pacing_now_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+/* Pacing rate in bytes per second, UINT32_MAX if the connection is not
+ * paced. Without a limit from SO_MAX_PACING_RATE the rate is derived from
+ * the congestion window and the smoothed RTT as soon as a sample exists.
+ */
+static uint32_t tcp_pacing_rate(struct tcp *conn)
+{
+	uint64_t rate;
+	uint32_t gain;
+
+	if (conn->ca.srtt == 0) {
+		return conn->max_pacing_rate;
+	}
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		gain = CONFIG_NET_TCP_PACING_SS_RATIO;
+	} else {
+		gain = CONFIG_NET_TCP_PACING_CA_RATIO;
+	}
+
+	/* cwnd bytes per srtt ms, scaled by gain percent */
+	rate = (uint64_t)conn->ca.cwnd * gain * (MSEC_PER_SEC / 100U) / conn->ca.srtt;
+
+	return MIN(rate, conn->max_pacing_rate);
+}
+
+/* Return true if the next segment must wait, the pacing timer will then
+ * resume the transmission.
+ */
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	int64_t now = tcp_pacing_now_us();
+
+	if (conn->pacing_next_us <= now) {
+		return false;
+	}
+
+	(void)k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+					K_USEC(conn->pacing_next_us - now));
+
+	return true;
+}
+
+static void tcp_pacing_sent(struct tcp *conn, uint32_t len)
+{
+	uint32_t rate = tcp_pacing_rate(conn);
+	int64_t now;
+
+	if (rate == UINT32_MAX || len == 0) {
+		return;
+	}
+
+	/* Let a late timer catch up for up to one tick, so that intervals
+	 * shorter than the tick period do not cap the rate at one segment
+	 * per tick.
+	 */
+	now = tcp_pacing_now_us() - k_ticks_to_us_ceil64(1);
+	conn->pacing_next_us = MAX(conn->pacing_next_us, now) +
+			       (uint64_t)len * USEC_PER_SEC / MAX(rate, 1);
+}
+
+static void tcp_pacing_stats_update(struct tcp *conn, uint16_t burst)
+{
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	struct net_buf_pool *tx_data;
 #endif
 
+	if (burst == 0) {
+		return;
+	}
+
+	conn->tx_burst_max = MAX(conn->tx_burst_max, burst);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	net_pkt_get_info(NULL, NULL, NULL, &tx_data);
+	conn->tx_buf_low_water = MIN(conn->tx_buf_low_water,
+				     (uint16_t)atomic_get(&tx_data->avail_count));
+#endif
+
+	NET_DBG("conn: %p burst=%u max_burst=%u tx_buf_low_water=%u", conn,
+		burst, conn->tx_burst_max, conn->tx_buf_low_water);
+}
+
+static void tcp_pacing_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		/* A failure is recovered by the retransmission timer */
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+
+static void tcp_pacing_init(struct tcp *conn)
+{
+	conn->max_pacing_rate = UINT32_MAX;
+	conn->pacing_next_us = 0;
+	conn->tx_burst_max = 0;
+	conn->tx_buf_low_water = UINT16_MAX;
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_timeout);
+}
+
+static void tcp_pacing_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->max_pacing_rate = from->max_pacing_rate;
+}
+
+static void tcp_pacing_stop(struct tcp *conn)
+{
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+}
+
+static int set_tcp_max_pacing_rate(struct tcp *conn, const void *value, size_t len)
+{
+	uint32_t rate;
+
+	if (conn == NULL || value == NULL || len != sizeof(uint32_t)) {
+		return -EINVAL;
+	}
+
+	rate = *(const uint32_t *)value;
+	if (rate == 0) {
+		return -EINVAL;
+	}
+
+	conn->max_pacing_rate = rate;
+
+	return 0;
+}
+
+static int get_tcp_max_pacing_rate(struct tcp *conn, void *value, size_t *len)
+{
+	if (conn == NULL || value == NULL || len == NULL ||
+	    *len != sizeof(uint32_t)) {
+		return -EINVAL;
+	}
+
+	*((uint32_t *)value) = conn->max_pacing_rate;
+
+	return 0;
+}
+
+#else /* CONFIG_NET_TCP_PACING */
+
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	return false;
+}
+
+static void tcp_pacing_sent(struct tcp *conn, uint32_t len) { }
+
+static void tcp_pacing_stats_update(struct tcp *conn, uint16_t burst) { }
+
+static void tcp_pacing_init(struct tcp *conn) { }
+
+static void tcp_pacing_param_copy(struct tcp *to, struct tcp *from) { }
+
+static void tcp_pacing_stop(struct tcp *conn) { }
+
+#define set_tcp_max_pacing_rate(...) (-ENOPROTOOPT)
+#define get_tcp_max_pacing_rate(...) (-ENOPROTOOPT)
+
+#endif /* CONFIG_NET_TCP_PACING */
+
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 
 static void tcp_send_keepalive_probe(struct k_work *work);
@@ -805,6 +1390,7 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
 	keep_alive_timer_stop(conn);
+	tcp_pacing_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
 
@@ -1098,6 +1684,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+	recv_options->sack_perm_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_num = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1146,6 +1736,37 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0 ||
+			    opt_len == 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_num = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						     NET_TCP_SACK_MAX_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_num; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].end =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+				NET_DBG("SACK block %u-%u", recv_options->sack[i].start,
+					recv_options->sack[i].end);
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1336,6 +1957,31 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static size_t tcp_send_options_len(struct tcp *conn)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		len += NET_TCP_MSS_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Both SACK options are preceded by two NOPs so that all the
+	 * options stay 32-bit aligned.
+	 */
+	if (conn->send_options.sack_perm_found) {
+		len += 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (conn->send_options.sack_num > 0) {
+		len += 2 * NET_TCP_NOP_SIZE + 2 +
+		       conn->send_options.sack_num * NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	return len;
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1351,11 +1997,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + tcp_send_options_len(conn) / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1435,6 +2077,289 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcp_options *options = &conn->send_options;
+	uint8_t opt[2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE +
+		    2 * NET_TCP_NOP_SIZE + 2 +
+		    NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	size_t len = 0;
+
+	if (options->sack_perm_found) {
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_SACK_PERM_OPT;
+		opt[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (options->sack_num > 0) {
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_NOP_OPT;
+		opt[len++] = NET_TCP_SACK_OPT;
+		opt[len++] = 2 + options->sack_num * NET_TCP_SACK_BLOCK_SIZE;
+
+		for (int i = 0; i < options->sack_num; i++) {
+			sys_put_be32(options->sack[i].start, &opt[len]);
+			len += sizeof(uint32_t);
+			sys_put_be32(options->sack[i].end, &opt[len]);
+			len += sizeof(uint32_t);
+		}
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	return net_pkt_write(pkt, opt, len);
+}
+
+/* Report the out-of-order data held in the receive queue to the peer.
+ * Only pure ACKs carry the SACK option, so that the option space never
+ * eats into a full sized data segment.
+ */
+static void tcp_sack_blocks_prepare(struct tcp *conn, uint8_t flags,
+				    struct net_pkt *data)
+{
+	struct net_buf *first, *last;
+	uint32_t start, end;
+
+	conn->send_options.sack_num = 0;
+
+	if (!conn->sack_permitted || data != NULL || !(flags & ACK) ||
+	    (flags & (SYN | RST)) || conn->queue_recv_data == NULL ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return;
+	}
+
+	/* The receive queue only ever holds one contiguous range of data,
+	 * see tcp_queue_recv_data(), so it maps to a single SACK block.
+	 */
+	first = conn->queue_recv_data->buffer;
+	last = net_buf_frag_last(first);
+	start = tcp_get_seq(first);
+	end = tcp_get_seq(last) + last->len;
+
+	if (!net_tcp_seq_greater(start, conn->ack) ||
+	    !net_tcp_seq_greater(end, start)) {
+		return;
+	}
+
+	conn->send_options.sack[0].start = start;
+	conn->send_options.sack[0].end = end;
+	conn->send_options.sack_num = 1;
+}
+
+/* Merge the SACK blocks received from the peer into the scoreboard. Only
+ * blocks covering sent but not yet cumulatively acknowledged data are
+ * taken into account.
+ */
+static void tcp_sack_scoreboard_update(struct tcp *conn,
+				       struct tcp_options *recv_options)
+{
+	struct tcp_sack_block *sb = conn->sack_scoreboard;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	for (int i = 0; i < recv_options->sack_num; i++) {
+		struct tcp_sack_block block = recv_options->sack[i];
+		int pos = 0;
+
+		if (!net_tcp_seq_greater(block.end, block.start) ||
+		    !net_tcp_seq_greater(block.end, conn->seq) ||
+		    net_tcp_seq_greater(block.end, snd_max)) {
+			NET_DBG("conn: %p ignoring SACK block %u-%u", conn,
+				block.start, block.end);
+			continue;
+		}
+
+		if (net_tcp_seq_greater(conn->seq, block.start)) {
+			block.start = conn->seq;
+		}
+
+		/* Absorb every overlapping or adjacent block */
+		while (pos < conn->sack_scoreboard_num) {
+			if (net_tcp_seq_greater(block.start, sb[pos].end)) {
+				pos++;
+				continue;
+			}
+
+			if (net_tcp_seq_greater(sb[pos].start, block.end)) {
+				break;
+			}
+
+			if (net_tcp_seq_greater(block.start, sb[pos].start)) {
+				block.start = sb[pos].start;
+			}
+
+			if (net_tcp_seq_greater(sb[pos].end, block.end)) {
+				block.end = sb[pos].end;
+			}
+
+			conn->sack_scoreboard_num--;
+			memmove(&sb[pos], &sb[pos + 1],
+				(conn->sack_scoreboard_num - pos) * sizeof(*sb));
+		}
+
+		if (pos >= CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE) {
+			/* Scoreboard is full, the highest block is the least
+			 * useful one for the recovery so drop it.
+			 */
+			continue;
+		}
+
+		if (conn->sack_scoreboard_num == CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE) {
+			conn->sack_scoreboard_num--;
+		}
+
+		memmove(&sb[pos + 1], &sb[pos],
+			(conn->sack_scoreboard_num - pos) * sizeof(*sb));
+		sb[pos] = block;
+		conn->sack_scoreboard_num++;
+	}
+}
+
+/* Drop the parts of the scoreboard covered by the cumulative ACK */
+static void tcp_sack_scoreboard_trim(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sack_scoreboard;
+	int acked = 0;
+
+	while (acked < conn->sack_scoreboard_num &&
+	       !net_tcp_seq_greater(sb[acked].end, conn->seq)) {
+		acked++;
+	}
+
+	if (acked > 0) {
+		conn->sack_scoreboard_num -= acked;
+		memmove(&sb[0], &sb[acked], conn->sack_scoreboard_num * sizeof(*sb));
+	}
+
+	if (conn->sack_scoreboard_num > 0 &&
+	    net_tcp_seq_greater(conn->seq, sb[0].start)) {
+		sb[0].start = conn->seq;
+	}
+}
+
+static void tcp_sack_scoreboard_clear(struct tcp *conn)
+{
+	conn->sack_scoreboard_num = 0;
+}
+
+/* Number of bytes selectively acknowledged above the cumulative ACK */
+static uint32_t tcp_sack_scoreboard_bytes(struct tcp *conn)
+{
+	uint32_t bytes = 0;
+
+	for (int i = 0; i < conn->sack_scoreboard_num; i++) {
+		bytes += conn->sack_scoreboard[i].end - conn->sack_scoreboard[i].start;
+	}
+
+	return bytes;
+}
+
+/* RFC 6675 IsLost(): the first unacknowledged segment is considered lost
+ * once at least DupThresh segments worth of data above it got SACKed.
+ */
+static bool tcp_sack_is_lost(struct tcp *conn)
+{
+	if (!conn->sack_permitted) {
+		return false;
+	}
+
+	return tcp_sack_scoreboard_bytes(conn) >=
+		(DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * conn_mss(conn));
+}
+
+/* Skip over send_data already held by the peer */
+static void tcp_sack_skip_acked(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sack_scoreboard;
+
+	for (int i = 0; i < conn->sack_scoreboard_num; i++) {
+		uint32_t next_seq = conn->seq + conn->unacked_len;
+
+		if (net_tcp_seq_greater(sb[i].start, next_seq)) {
+			break;
+		}
+
+		if (net_tcp_seq_greater(sb[i].end, next_seq)) {
+			NET_DBG("conn: %p skipping SACKed %u-%u", conn,
+				next_seq, sb[i].end);
+			conn->unacked_len = sb[i].end - conn->seq;
+		}
+	}
+}
+
+/* Limit the next segment so that it does not run into a SACKed block */
+static int tcp_sack_segment_len(struct tcp *conn, int len)
+{
+	uint32_t next_seq = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sack_scoreboard_num; i++) {
+		if (net_tcp_seq_greater(conn->sack_scoreboard[i].start, next_seq)) {
+			return MIN(len, conn->sack_scoreboard[i].start - next_seq);
+		}
+	}
+
+	return len;
+}
+
+/* Retransmit the holes below the highest SACKed block which were not
+ * retransmitted yet during the current loss recovery. Returns false if the
+ * scoreboard gives no hint about what to retransmit.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn, bool new_recovery)
+{
+	int temp_unacked_len = conn->unacked_len;
+	uint32_t high_seq;
+
+	if (conn->sack_scoreboard_num == 0) {
+		return false;
+	}
+
+	if (new_recovery || net_tcp_seq_greater(conn->seq, conn->sack_rexmit_seq)) {
+		conn->sack_rexmit_seq = conn->seq;
+	}
+
+	high_seq = conn->sack_scoreboard[conn->sack_scoreboard_num - 1].start;
+
+	conn->unacked_len = conn->sack_rexmit_seq - conn->seq;
+	conn->data_mode = TCP_DATA_MODE_RESEND;
+
+	while (net_tcp_seq_greater(high_seq, conn->seq + conn->unacked_len)) {
+		if (tcp_send_data(conn) < 0) {
+			break;
+		}
+	}
+
+	conn->data_mode = TCP_DATA_MODE_SEND;
+	conn->sack_rexmit_seq = conn->seq + conn->unacked_len;
+
+	/* Restore the current transmission */
+	conn->unacked_len = MAX(temp_unacked_len, conn->unacked_len);
+
+	return true;
+}
+
+#else
+
+static void tcp_sack_blocks_prepare(struct tcp *conn, uint8_t flags,
+				    struct net_pkt *data) { }
+
+static void tcp_sack_scoreboard_trim(struct tcp *conn) { }
+
+static void tcp_sack_scoreboard_clear(struct tcp *conn) { }
+
+static bool tcp_sack_is_lost(struct tcp *conn) { return false; }
+
+static void tcp_sack_skip_acked(struct tcp *conn) { }
+
+static int tcp_sack_segment_len(struct tcp *conn, int len) { return len; }
+
+static bool tcp_sack_retransmit(struct tcp *conn, bool new_recovery) { return false; }
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1543,9 +2468,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
+	tcp_sack_blocks_prepare(conn, flags, data);
+
+	alloc_len += tcp_send_options_len(conn);
 
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
@@ -1579,6 +2504,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	ret = net_tcp_set_sack_opt(conn, pkt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+#endif
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1740,11 +2673,15 @@ static int tcp_send_data(struct tcp *conn)
 	int len;
 	struct net_pkt *pkt;
 
+	tcp_sack_skip_acked(conn);
+
 	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
 	}
+
+	len = tcp_sack_segment_len(conn, len);
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
@@ -1796,6 +2733,8 @@ static int tcp_send_queued_data(struct tcp *conn)
 {
 	int ret = 0;
 	bool subscribe = false;
+	uint16_t burst = 0;
+	int len;
 
 	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 		goto out;
@@ -1815,12 +2754,24 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_wait(conn)) {
+			break;
+		}
+
+		len = conn->unacked_len;
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
 		}
+
+		tcp_rtt_start(conn);
+		tcp_pacing_sent(conn, conn->unacked_len - len);
+		burst++;
 	}
 
+	tcp_pacing_stats_update(conn, burst);
+
 	if (conn->send_data_total) {
 		subscribe = true;
 	}
@@ -1881,6 +2832,12 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+	/* The peer is allowed to discard data it has SACKed (RFC 2018), so
+	 * do not trust the scoreboard anymore after a retransmission timeout.
+	 */
+	tcp_sack_scoreboard_clear(conn);
+	tcp_rtt_invalidate(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -2138,6 +3095,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca_ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2156,6 +3114,7 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
+	tcp_pacing_init(conn);
 
 	tcp_conn_ref(conn);
 
@@ -2924,11 +3883,17 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			/* Only agree on SACK if the peer offered it */
+			conn->sack_permitted = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+				tcp_options_len && conn->recv_options.sack_perm_found;
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			conn->send_options.sack_perm_found = conn->sack_permitted;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
+			conn->send_options.sack_perm_found = false;
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2940,12 +3905,14 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+			conn->send_options.sack_perm_found = IS_ENABLED(CONFIG_NET_TCP_SACK);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
 				close_status = ret;
 			} else {
 				conn->send_options.mss_found = false;
+				conn->send_options.sack_perm_found = false;
 				conn_seq(conn, + 1);
 				next = TCP_SYN_SENT;
 				tcp_conn_ref(conn);
@@ -2962,6 +3929,8 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
+				tcp_pacing_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3052,6 +4021,8 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			conn->sack_permitted = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+				tcp_options_len && conn->recv_options.sack_perm_found;
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
 				if (verdict == NET_OK) {
@@ -3134,6 +4105,14 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th && tcp_options_len && conn->sack_permitted &&
+		    conn->recv_options.sack_num > 0 &&
+		    net_tcp_seq_cmp(th_ack(th), conn->seq) >= 0) {
+			tcp_sack_scoreboard_update(conn, &conn->recv_options);
+		}
+#endif
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3151,19 +4130,33 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
+			/* Enough SACKed data above the first unacknowledged segment
+			 * is as good a loss indication as the duplicate ACK count.
+			 */
+			if ((conn->dup_ack_cnt > 0) &&
+			    (conn->dup_ack_cnt < DUPLICATE_ACK_RETRANSMIT_TRHESHOLD) &&
+			    tcp_sack_is_lost(conn)) {
+				conn->dup_ack_cnt = DUPLICATE_ACK_RETRANSMIT_TRHESHOLD;
+			}
+
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Retransmit only the holes reported by SACK, or apply
+				 * a plain fast retransmit without SACK information.
+				 */
+				if (!tcp_sack_retransmit(conn, true)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
+				tcp_rtt_invalidate(conn);
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
@@ -3198,6 +4191,7 @@ next_state:
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
+			tcp_rtt_update(conn, th_ack(th));
 			tcp_ca_pkts_acked(conn, len_acked);
 
 			conn->send_data_total -= len_acked;
@@ -3213,6 +4207,7 @@ next_state:
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
+			tcp_sack_scoreboard_trim(conn);
 
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
@@ -3233,6 +4228,13 @@ next_state:
 					    K_MSEC(TCP_RTO_MS));
 			}
 
+			/* A partial ACK during SACK based recovery, the next holes
+			 * can be filled right away.
+			 */
+			if (tcp_sack_is_lost(conn)) {
+				(void)tcp_sack_retransmit(conn, false);
+			}
+
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
 				tcp_send_timer_cancel(conn);
@@ -4470,6 +5472,12 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
+	case TCP_OPT_MAX_PACING_RATE:
+		ret = set_tcp_max_pacing_rate(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4507,6 +5515,12 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
+	case TCP_OPT_MAX_PACING_RATE:
+		ret = get_tcp_max_pacing_rate(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
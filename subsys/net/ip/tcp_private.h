@@ -227,30 +227,92 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* At most 4 SACK blocks fit into the 40 bytes of TCP option space */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start; /* first sequence number of the block */
+	uint32_t end;   /* sequence number following the block */
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_num;
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+#endif
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+/* Maximum length of a congestion control algorithm name, including the
+ * terminating NUL, as passed with the TCP_CONGESTION socket option.
+ */
+#define TCP_CA_NAME_MAX 16
+
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+struct tcp_collision_avoidance_cubic {
+	uint32_t epoch_start; /* ms, 0 if no congestion avoidance epoch */
+	uint32_t k;           /* ms to reach w_max again */
+	uint16_t w_max;       /* window before the last reduction */
+	uint16_t origin;      /* window the cubic function is centered on */
+	uint16_t w_est;       /* window a Reno flow would have */
+};
+
+struct tcp_collision_avoidance_bbr {
+	uint32_t max_bw;          /* bytes per second */
+	uint32_t prev_max_bw;     /* max_bw of the previous filter window */
+	uint32_t round_start;     /* ms */
+	uint32_t round_delivered; /* bytes acked during the current round */
+	uint32_t full_bw;         /* bandwidth of the last startup plateau check */
+	uint8_t full_bw_cnt;      /* rounds without significant bw growth */
+	uint8_t rounds;           /* rounds in the current max_bw filter window */
+	bool filled_pipe : 1;     /* startup finished */
+};
+
 struct tcp_collision_avoidance_reno {
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+	uint16_t srtt;    /* ms, smoothed round trip time, 0 if unknown */
+	uint16_t min_rtt; /* ms, 0 if unknown */
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_collision_avoidance_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_collision_avoidance_bbr bbr;
+#endif
+		uint8_t unused;
+	};
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -323,7 +385,29 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	const struct tcp_ca_ops *ca_ops;
 	struct tcp_collision_avoidance_reno ca;
+	/* RTT measurement of one segment at a time (Karn's algorithm) */
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
+#endif
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+	int64_t pacing_next_us;   /* earliest uptime (us) for the next segment */
+	uint32_t max_pacing_rate; /* bytes per second, UINT32_MAX if unlimited */
+	uint16_t tx_burst_max;    /* longest run of back to back segments */
+	uint16_t tx_buf_low_water; /* fewest free TX data buffers seen */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Ranges of send_data selectively acknowledged by the peer,
+	 * sorted by sequence number and never overlapping.
+	 */
+	struct tcp_sack_block sack_scoreboard[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	/* Sequence number up to which holes have been retransmitted
+	 * during the current loss recovery.
+	 */
+	uint32_t sack_rexmit_seq;
+	uint8_t sack_scoreboard_num;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -338,6 +422,10 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+	bool sack_permitted : 1;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	bool rtt_pending : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
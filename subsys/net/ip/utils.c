@@ -526,11 +526,16 @@ static uint16_t offset_based_swap8(const uint8_t *data)
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ * On 64-bit targets the data is loaded 64 bits at a time and both halves are added to the
+ * accumulator, which halves the number of loads without needing carry handling.
  */
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
 	uint32_t *p;
+#if defined(CONFIG_64BIT)
+	uint64_t *q;
+#endif
 	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
@@ -555,6 +560,28 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CONFIG_64BIT)
+	if ((((uintptr_t)data & 0x04) != 0) && (pending >= sizeof(uint32_t))) {
+		pending -= sizeof(uint32_t);
+		sum = sum + *((uint32_t *)data);
+		data += sizeof(uint32_t);
+	}
+	q = (uint64_t *)data;
+
+	while (pending >= sizeof(uint64_t) * 4) {
+		uint64_t sum_a = (q[i] & UINT32_MAX) + (q[i] >> 32);
+		uint64_t sum_b = (q[i + 1] & UINT32_MAX) + (q[i + 1] >> 32);
+
+		pending -= sizeof(uint64_t) * 4;
+		sum_a += (q[i + 2] & UINT32_MAX) + (q[i + 2] >> 32);
+		sum_b += (q[i + 3] & UINT32_MAX) + (q[i + 3] >> 32);
+		i += 4;
+		sum += sum_a + sum_b;
+	}
+	data = (uint8_t *)(q + i);
+	i = 0;
+#endif
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -597,6 +624,28 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	const uint8_t *old_ptr = old_data;
+	const uint8_t *new_ptr = new_data;
+	uint32_t sum = (uint16_t)~chksum;
+
+	NET_ASSERT((len % 2) == 0, "Odd length %zu", len);
+
+	for (size_t i = 0; i < len; i += sizeof(uint16_t)) {
+		sum += (uint16_t)~UNALIGNED_GET((uint16_t *)&old_ptr[i]);
+		sum += UNALIGNED_GET((uint16_t *)&new_ptr[i]);
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~sum;
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
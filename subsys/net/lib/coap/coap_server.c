@@ -35,6 +35,9 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_ZVFS_POLL_MAX
 
+/* Header and token of a notification, the part that differs per observer */
+#define NOTIFY_HDR_LEN (4 + COAP_TOKEN_MAX_LEN)
+
 BUILD_ASSERT(CONFIG_ZVFS_POLL_MAX > 0, "CONFIG_ZVFS_POLL_MAX can't be 0");
 
 static K_MUTEX_DEFINE(lock);
@@ -714,6 +717,136 @@ int coap_resource_remove_observer_by_token(struct coap_resource *resource,
 	return coap_resource_remove_observer(resource, NULL, token, token_len);
 }
 
+static int coap_service_notify_con(const struct coap_service *service,
+				   const struct coap_observer *observer,
+				   const uint8_t *hdr, size_t hdr_len,
+				   const uint8_t *body, size_t body_len,
+				   const struct coap_transmission_parameters *params)
+{
+	/* Confirmable notifications need a contiguous copy for retransmission */
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet cpkt = {
+		.data = buf,
+		.offset = hdr_len + body_len,
+		.max_len = sizeof(buf),
+		.hdr_len = hdr_len,
+	};
+
+	if (hdr_len + body_len > sizeof(buf)) {
+		return -EMSGSIZE;
+	}
+
+	memcpy(buf, hdr, hdr_len);
+	memcpy(buf + hdr_len, body, body_len);
+
+	return coap_service_send(service, &cpkt, &observer->addr, ADDRLEN(&observer->addr),
+				 params);
+}
+
+static int coap_service_notify_one(const struct coap_service *service,
+				   const struct coap_observer *observer,
+				   uint8_t *hdr, const uint8_t *body, size_t body_len,
+				   const struct coap_transmission_parameters *params)
+{
+	size_t hdr_len = 4 + observer->tkl;
+	uint16_t id = coap_next_id();
+	struct iovec io_vector[2];
+	struct msghdr msg = { 0 };
+	ssize_t ret;
+
+	hdr[0] = (hdr[0] & 0xF0) | observer->tkl;
+	hdr[2] = id >> 8;
+	hdr[3] = id & 0xFF;
+	memcpy(hdr + 4, observer->token, observer->tkl);
+
+	if (((hdr[0] >> 4) & 0x03) == COAP_TYPE_CON) {
+		return coap_service_notify_con(service, observer, hdr, hdr_len, body, body_len,
+					       params);
+	}
+
+	/* Non-confirmable notifications are sent straight from the shared body */
+	io_vector[0].iov_base = hdr;
+	io_vector[0].iov_len = hdr_len;
+	io_vector[1].iov_base = (void *)body;
+	io_vector[1].iov_len = body_len;
+
+	msg.msg_name = (void *)&observer->addr;
+	msg.msg_namelen = ADDRLEN(&observer->addr);
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	ret = zsock_sendmsg(service->data->sock_fd, &msg, 0);
+	if (ret < 0) {
+		LOG_ERR("Failed to send CoAP notification (%d)", -errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+int coap_resource_notify_all(struct coap_resource *resource, const struct coap_packet *cpkt,
+			     const struct coap_transmission_parameters *params)
+{
+	const struct coap_service *service = NULL;
+	struct coap_observer *observer;
+	uint8_t hdr[NOTIFY_HDR_LEN];
+	const uint8_t *body;
+	size_t body_len;
+	uint8_t type;
+	int count = 0;
+	int ret;
+
+	type = coap_header_get_type(cpkt);
+	if (type != COAP_TYPE_CON && type != COAP_TYPE_NON_CON) {
+		return -EINVAL;
+	}
+
+	if (cpkt->hdr_len < 4 || cpkt->offset < cpkt->hdr_len) {
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	/* Options and payload are shared by all observers, only the header is patched */
+	memcpy(hdr, cpkt->data, 4);
+	body = cpkt->data + cpkt->hdr_len;
+	body_len = cpkt->offset - cpkt->hdr_len;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		ret = -EBADF;
+		goto unlock;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, observer, list) {
+		ret = coap_service_notify_one(service, observer, hdr, body, body_len, params);
+		if (ret < 0) {
+			LOG_WRN("Failed to notify observer (%d)", ret);
+			continue;
+		}
+
+		count++;
+	}
+
+	ret = count;
+
+unlock:
+	(void)k_mutex_unlock(&lock);
+
+	return ret;
+}
+
 static void coap_server_thread(void *p1, void *p2, void *p3)
 {
 	struct zsock_pollfd sock_fds[MAX_POLL_FD];
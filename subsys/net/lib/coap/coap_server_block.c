@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
+
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_service.h>
+#include <zephyr/sys/__assert.h>
+
+/* Room for the header, the longest token, the Content-Format, Block2 and Size2 options and the
+ * payload marker.
+ */
+#define BLOCK_RESPONSE_OVERHEAD 32
+
+#define SERVER_BLOCK_SIZE coap_bytes_to_block_size(CONFIG_COAP_SERVER_BLOCK_SIZE)
+
+static int coap_block_response_init(struct coap_packet *response, const struct coap_packet *request,
+				    uint8_t *data, uint16_t max_len, uint8_t code)
+{
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t tkl;
+
+	if (coap_header_get_type(request) == COAP_TYPE_CON) {
+		return coap_ack_init(response, request, data, max_len, code);
+	}
+
+	tkl = coap_header_get_token(request, token);
+
+	return coap_packet_init(response, data, max_len, COAP_VERSION_1, COAP_TYPE_NON_CON,
+				tkl, token, code, coap_next_id());
+}
+
+static inline unsigned int coap_block_option_value(uint32_t num, bool more,
+						   enum coap_block_size szx)
+{
+	return (num << 4) | (more ? 0x08 : 0) | szx;
+}
+
+int coap_resource_reply_block2(struct coap_resource *resource, const struct coap_packet *request,
+			       const struct sockaddr *addr, socklen_t addr_len,
+			       const struct coap_block_source *source)
+{
+	/* One extra byte is read to find out whether more blocks follow */
+	uint8_t data[CONFIG_COAP_SERVER_BLOCK_SIZE + BLOCK_RESPONSE_OVERHEAD + 1];
+	enum coap_block_size szx = SERVER_BLOCK_SIZE;
+	struct coap_packet response;
+	uint8_t *payload;
+	size_t block_len;
+	size_t offset = 0;
+	uint32_t num;
+	bool more;
+	int block;
+	int len;
+	int ret;
+
+	if (source == NULL || source->read == NULL) {
+		return -EINVAL;
+	}
+
+	block = coap_get_option_int(request, COAP_OPTION_BLOCK2);
+	if (block >= 0) {
+		enum coap_block_size req_szx = MIN(GET_BLOCK_SIZE(block), COAP_BLOCK_1024);
+
+		/* Blocks larger than ours are served as several smaller ones */
+		offset = (size_t)GET_BLOCK_NUM(block) << (req_szx + 4);
+		szx = MIN(szx, req_szx);
+	}
+
+	block_len = coap_block_size_to_bytes(szx);
+	num = offset / block_len;
+	offset = (size_t)num * block_len;
+
+	/* The block is read straight into the tail of the response buffer and moved in place once
+	 * the options are written, so no intermediate copy is needed.
+	 */
+	payload = data + sizeof(data) - (block_len + 1);
+
+	len = source->read(resource, addr, offset, payload, block_len + 1, source->user_data);
+	if (len < 0) {
+		LOG_ERR("Failed to read block %u (%d)", num, len);
+		return COAP_RESPONSE_CODE_INTERNAL_ERROR;
+	}
+
+	if (len == 0 && num > 0) {
+		/* RFC7959 section 2.2 - Block number out of range */
+		return COAP_RESPONSE_CODE_BAD_OPTION;
+	}
+
+	more = (size_t)len > block_len;
+	if (more) {
+		len = block_len;
+	}
+
+	ret = coap_block_response_init(&response, request, data, sizeof(data),
+				       COAP_RESPONSE_CODE_CONTENT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (source->content_format >= 0) {
+		ret = coap_append_option_int(&response, COAP_OPTION_CONTENT_FORMAT,
+					     source->content_format);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = coap_append_option_int(&response, COAP_OPTION_BLOCK2,
+				     coap_block_option_value(num, more, szx));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (num == 0 && source->size > 0) {
+		ret = coap_append_option_int(&response, COAP_OPTION_SIZE2, source->size);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (len > 0) {
+		ret = coap_packet_append_payload_marker(&response);
+		if (ret < 0) {
+			return ret;
+		}
+
+		__ASSERT_NO_MSG(response.data + response.offset <= payload);
+
+		memmove(response.data + response.offset, payload, len);
+		response.offset += len;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+int coap_resource_receive_block1(struct coap_resource *resource, const struct coap_packet *request,
+				 const struct sockaddr *addr, socklen_t addr_len,
+				 const struct coap_block_sink *sink)
+{
+	uint8_t data[BLOCK_RESPONSE_OVERHEAD];
+	struct coap_packet response;
+	const uint8_t *payload;
+	enum coap_block_size szx = SERVER_BLOCK_SIZE;
+	uint16_t payload_len;
+	size_t offset = 0;
+	uint32_t num = 0;
+	bool more = false;
+	uint8_t code;
+	int block;
+	int ret;
+
+	if (sink == NULL || sink->write == NULL) {
+		return -EINVAL;
+	}
+
+	block = coap_get_option_int(request, COAP_OPTION_BLOCK1);
+	if (block >= 0) {
+		szx = MIN(GET_BLOCK_SIZE(block), COAP_BLOCK_1024);
+		num = GET_BLOCK_NUM(block);
+		more = GET_MORE(block);
+		offset = (size_t)num << (szx + 4);
+	}
+
+	payload = coap_packet_get_payload(request, &payload_len);
+
+	if (more && payload_len != coap_block_size_to_bytes(szx)) {
+		/* RFC7959 section 2.3 - Only the last block may be shorter */
+		return COAP_RESPONSE_CODE_BAD_REQUEST;
+	}
+
+	ret = sink->write(resource, addr, offset, payload, payload_len, !more, sink->user_data);
+	switch (ret) {
+	case 0:
+		break;
+	case -EFBIG:
+		return COAP_RESPONSE_CODE_REQUEST_TOO_LARGE;
+	case -EINVAL:
+		return COAP_RESPONSE_CODE_BAD_REQUEST;
+	default:
+		LOG_ERR("Failed to write block %u (%d)", num, ret);
+		return COAP_RESPONSE_CODE_INTERNAL_ERROR;
+	}
+
+	if (more) {
+		code = COAP_RESPONSE_CODE_CONTINUE;
+	} else {
+		code = sink->code > 0 ? sink->code : COAP_RESPONSE_CODE_CHANGED;
+	}
+
+	ret = coap_block_response_init(&response, request, data, sizeof(data), code);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (block >= 0) {
+		ret = coap_append_option_int(&response, COAP_OPTION_BLOCK1,
+					     coap_block_option_value(num, more, szx));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
@@ -5,18 +5,124 @@
  */
 
 #include <zephyr/net/dns_resolve.h>
+#include <zephyr/sys/crc.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static int dns_cache_check_query(char const *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static inline uint16_t dns_cache_hash(char const *query)
+{
+	return crc16_ansi((const uint8_t *)query, strlen(query));
+}
+
+static inline sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint16_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+	sys_dlist_remove(&entry->lru_node);
+	sys_slist_prepend(&cache->free, &entry->node);
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	sys_snode_t *node;
+
+	node = sys_slist_get(&cache->free);
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct dns_cache_entry, node);
+	}
+
+	if (cache->next_unused < cache->size) {
+		return &cache->entries[cache->next_unused++];
+	}
+
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru), struct dns_cache_entry, lru_node);
+
+	NET_DBG("Overwrite \"%s\"", entry->query);
+
+	dns_cache_release(cache, entry);
+
+	return CONTAINER_OF(sys_slist_get(&cache->free), struct dns_cache_entry, node);
+}
+
+/* Needs to be called when lock is already acquired. Removes the expired
+ * entries sharing the bucket of the query on the way.
+ */
+static void dns_cache_remove_matching(struct dns_cache *cache, char const *query, uint16_t hash,
+				      sa_family_t family, bool negative_only)
+{
+	struct dns_cache_entry *entry, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, node) {
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
+			continue;
+		}
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (negative_only && !entry->negative) {
+			continue;
+		}
+
+		/* A nonexistent name entry is replaced by any newer answer */
+		if (family == AF_UNSPEC || entry->data.ai_family == family ||
+		    entry->data.ai_family == AF_UNSPEC) {
+			dns_cache_release(cache, entry);
+		}
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query, uint16_t hash,
+			     struct dns_addrinfo const *addrinfo, bool negative, uint32_t ttl)
+{
+	struct dns_cache_entry *entry = dns_cache_alloc(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->data = *addrinfo;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->hash = hash;
+	entry->negative = negative;
+
+	/* Appending keeps the addresses of a query in the order they were received */
+	sys_slist_append(dns_cache_bucket(cache, hash), &entry->node);
+	sys_dlist_prepend(&cache->lru, &entry->lru_node);
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
-		cache->entries[i].in_use = false;
+		sys_slist_init(&cache->buckets[i]);
 	}
+
+	sys_dlist_init(&cache->lru);
+	sys_slist_init(&cache->free);
+	cache->next_unused = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,47 +131,54 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	uint16_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	/* A positive answer replaces an earlier negative one */
+	dns_cache_remove_matching(cache, query, hash, addrinfo->ai_family, true);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	dns_cache_insert(cache, query, hash, addrinfo, false, ttl);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, sa_family_t family,
+			   uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = {.ai_family = family};
+	uint16_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" family %d with TTL %" PRIu32, query, family, ttl);
+
+	dns_cache_remove_matching(cache, query, hash, family, false);
+	dns_cache_insert(cache, query, hash, &addrinfo, true, ttl);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,60 +188,68 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_remove_matching(cache, query, dns_cache_hash(query), AF_UNSPEC, false);
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
-		   size_t addrinfo_array_len)
+static int dns_cache_lookup(struct dns_cache *cache, const char *query, sa_family_t family,
+			    struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry, *next;
+	bool negative = false;
+	bool nonexistent = false;
 	size_t found = 0;
+	uint16_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = dns_cache_hash(query);
 
-	dns_cache_clean(cache);
+	k_mutex_lock(cache->lock, K_FOREVER);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, node) {
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, entry);
+			continue;
+		}
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (family != AF_UNSPEC && entry->data.ai_family != family &&
+		    entry->data.ai_family != AF_UNSPEC) {
 			continue;
 		}
-		if (found >= addrinfo_array_len) {
+
+		sys_dlist_remove(&entry->lru_node);
+		sys_dlist_prepend(&cache->lru, &entry->lru_node);
+
+		if (entry->negative) {
+			if (entry->data.ai_family == AF_UNSPEC) {
+				nonexistent = true;
+			} else {
+				negative = true;
+			}
+		} else if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -142,21 +263,26 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 
 	if (found == 0) {
 		NET_DBG("Could not find \"%s\"", query);
+
+		if (nonexistent && family != AF_UNSPEC) {
+			return -ENOENT;
+		}
+
+		if (negative && family != AF_UNSPEC) {
+			return -ENODATA;
+		}
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
+		   size_t addrinfo_array_len)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	return dns_cache_lookup(cache, query, AF_UNSPEC, addrinfo, addrinfo_array_len);
+}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
-		}
-	}
+int dns_cache_find_family(struct dns_cache *cache, const char *query, sa_family_t family,
+			  struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
+{
+	return dns_cache_lookup(cache, query, family, addrinfo, addrinfo_array_len);
 }
@@ -17,17 +17,33 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
 
 struct dns_cache_entry {
+	/** Hash bucket or free list node */
+	sys_snode_t node;
+	/** Position in the least recently used list */
+	sys_dnode_t lru_node;
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
-	bool in_use;
+	uint16_t hash;
+	/** The name has no records of data.ai_family, or does not exist at all
+	 * if that is AF_UNSPEC (RFC 2308)
+	 */
+	bool negative;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	sys_slist_t *buckets;
+	/** Entries in use, most recently used first */
+	sys_dlist_t lru;
+	/** Released entries below next_unused */
+	sys_slist_t free;
+	size_t next_unused;
 	struct k_mutex *lock;
 };
 
@@ -43,8 +59,13 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries,                                                         \
+		.buckets = name##_buckets,                                                         \
+		.size = cache_size,                                                                \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru),                                           \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +77,8 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing the least recently used
+ * one if no free space is available.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +92,24 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Records that the query has no records of the given address family.
+ *
+ * Until the entry expires, dns_cache_find_family() reports the negative
+ * answer instead of a cache miss. Cached addresses of the same family are
+ * removed.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param family Address family which was queried, or AF_UNSPEC if the name
+ * does not exist (NXDOMAIN). In that case all cached addresses are removed.
+ * @param ttl Time to live for the entry in seconds, see RFC 2308.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, sa_family_t family,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,7 +133,24 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find cached addresses of one address family for the query.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param family Address family of the addresses to return.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval -ENOENT if the name is known not to exist.
+ * @retval -ENODATA if the query is known to have no addresses of the family.
+ * @retval On error another negative value is returned, see dns_cache_find().
+ */
+int dns_cache_find_family(struct dns_cache *cache, const char *query, sa_family_t family,
+			  struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
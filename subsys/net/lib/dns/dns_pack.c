@@ -177,6 +177,54 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	uint16_t rem_size;
+	uint32_t minimum;
+	int dname_len;
+	int rdata;
+	uint16_t len;
+	uint8_t *soa;
+
+	if (dns_header_ancount(dns_msg->msg) != 0 ||
+	    dns_header_nscount(dns_msg->msg) < 1 ||
+	    dns_msg->answer_offset >= dns_msg->msg_size) {
+		return -ENOENT;
+	}
+
+	/* The authority section follows the empty answer section */
+	soa = dns_msg->msg + dns_msg->answer_offset;
+	rem_size = dns_msg->msg_size - dns_msg->answer_offset;
+
+	dname_len = skip_fqdn(soa, rem_size);
+	if (dname_len < 0) {
+		return dname_len;
+	}
+
+	/* See RFC-1035 4.1.3. Resource record format */
+	rdata = dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+		DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+	if (rdata > rem_size) {
+		return -EINVAL;
+	}
+
+	if (dns_answer_type(dname_len, soa) != DNS_RR_TYPE_SOA) {
+		return -ENOENT;
+	}
+
+	/* MINIMUM is the last field of the SOA RDATA, RFC 1035 ch. 3.3.13 */
+	len = dns_answer_rdlength(dname_len, soa);
+	if (len < DNS_TTL_LEN || rdata + len > rem_size) {
+		return -EINVAL;
+	}
+
+	minimum = ntohl(UNALIGNED_GET((uint32_t *)(soa + rdata + len - DNS_TTL_LEN)));
+
+	*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, soa), minimum);
+
+	return 0;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
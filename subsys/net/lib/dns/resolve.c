@@ -239,6 +239,8 @@ static int dispatcher_cb(void *my_ctx, int sock,
 			goto free_buf;
 		}
 
+		ctx->queries[i].servers_pending = 0U;
+
 		for (j = 0; j < SERVER_COUNT; j++) {
 			if (ctx->servers[j].sock < 0) {
 				continue;
@@ -249,6 +251,8 @@ static int dispatcher_cb(void *my_ctx, int sock,
 					dns_cname, 0);
 			if (ret < 0) {
 				failure++;
+			} else {
+				ctx->queries[i].servers_pending++;
 			}
 		}
 
@@ -270,6 +274,12 @@ quit:
 		goto free_buf;
 	}
 
+	if (ret == DNS_EAI_FAIL && ctx->queries[i].servers_pending > 1) {
+		/* Some other server may still be able to answer */
+		ctx->queries[i].servers_pending--;
+		goto free_buf;
+	}
+
 	invoke_query_callback(ret, NULL, &ctx->queries[i]);
 
 	/* Marks the end of the results */
@@ -639,6 +649,88 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+static inline sa_family_t dns_query_family(enum dns_query_type type)
+{
+	return type == DNS_QUERY_TYPE_AAAA ? AF_INET6 : AF_INET;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+/* A "no such name" (NXDOMAIN) or "no such record" (NODATA) answer to a
+ * unicast query, see RFC 2308.
+ */
+static bool dns_msg_is_negative(struct dns_msg_t *dns_msg, uint16_t dns_id)
+{
+	uint8_t *header = dns_msg->msg;
+
+	if (dns_id == 0 || dns_msg->msg_size < DNS_MSG_HEADER_SIZE ||
+	    dns_header_opcode(header) != DNS_QUERY || dns_header_tc(header) ||
+	    dns_header_qdcount(header) != 1) {
+		return false;
+	}
+
+	if (dns_header_rcode(header) == DNS_HEADER_NAMEERROR) {
+		return true;
+	}
+
+	return dns_header_rcode(header) == DNS_HEADER_NOERROR &&
+	       dns_header_ancount(header) == 0;
+}
+
+/* Must be invoked with context lock held */
+static int dns_validate_negative(struct dns_resolve_context *ctx,
+				 struct dns_msg_t *dns_msg,
+				 uint16_t dns_id,
+				 int *query_idx,
+				 uint16_t *query_hash)
+{
+	const uint8_t *query_name = dns_msg->msg + DNS_MSG_HEADER_SIZE;
+	size_t max_len = dns_msg->msg_size - DNS_MSG_HEADER_SIZE;
+	size_t len = strnlen((const char *)query_name, max_len);
+
+	if (len + 1 + DNS_QTYPE_LEN + DNS_QCLASS_LEN > max_len) {
+		return DNS_EAI_FAIL;
+	}
+
+	/* Add \0 and query type (A or AAAA) to the hash */
+	*query_hash = crc16_ansi(query_name, len + 1 + DNS_QTYPE_LEN);
+
+	*query_idx = get_slot_by_id(ctx, dns_id, *query_hash);
+	if (*query_idx < 0) {
+		return DNS_EAI_SYSTEM;
+	}
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	struct dns_pending_query *pending_query = &ctx->queries[*query_idx];
+	uint32_t ttl;
+
+	dns_msg->query_offset = DNS_MSG_HEADER_SIZE;
+	dns_msg->answer_offset = DNS_MSG_HEADER_SIZE + len + 1 +
+				 DNS_QTYPE_LEN + DNS_QCLASS_LEN;
+
+	if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0 &&
+	    dns_unpack_negative_ttl(dns_msg, &ttl) == 0 && ttl > 0) {
+		ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+
+		if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+			/* The name has no records of any type */
+			dns_cache_add_negative(&dns_cache, pending_query->query,
+					       AF_UNSPEC, ttl);
+		} else {
+			dns_cache_add_negative(&dns_cache, pending_query->query,
+					       dns_query_family(pending_query->query_type),
+					       ttl);
+		}
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+	if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		return DNS_EAI_NONAME;
+	}
+
+	return DNS_EAI_NODATA;
+}
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -688,6 +780,12 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	if (dns_msg_is_negative(dns_msg, *dns_id)) {
+		ret = dns_validate_negative(ctx, dns_msg, *dns_id, query_idx,
+					    query_hash);
+		goto quit;
+	}
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		ret = DNS_EAI_FAIL;
@@ -1300,7 +1398,15 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, ARRAY_SIZE(cached_info));
+	ret = dns_cache_find_family(&dns_cache, query, dns_query_family(type),
+				    cached_info, ARRAY_SIZE(cached_info));
+	if (ret == -ENOENT || ret == -ENODATA) {
+		/* The name is known not to exist or to have no such address */
+		cb(ret == -ENOENT ? DNS_EAI_NONAME : DNS_EAI_NODATA, NULL, user_data);
+
+		return 0;
+	}
+
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1334,6 +1440,7 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].servers_pending = 0U;
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
@@ -1416,17 +1523,21 @@ try_resolve:
 			continue;
 		}
 
-		/* Do one concurrent query only for each name resolve.
-		 * TODO: Change the i (query index) to do multiple concurrent
-		 *       to each server.
+		ctx->queries[i].servers_pending++;
+
+		/* Unless asked otherwise, the query is sent to one server
+		 * only. In parallel mode the first answer received wins and
+		 * the late ones no longer find the query.
 		 */
-		break;
+		if (!IS_ENABLED(CONFIG_DNS_RESOLVER_PARALLEL_QUERIES)) {
+			break;
+		}
 	}
 
 	if (failure) {
 		NET_DBG("DNS query failed %d times", failure);
 
-		if (failure == j) {
+		if (ctx->queries[i].servers_pending == 0U) {
 			ret = -ENOENT;
 			goto quit;
 		}
@@ -16,6 +16,16 @@
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/http/frame.h>
 
+/* Content encodings accepted by the client, see http_client_ctx::accept_encoding */
+#define HTTP_SERVER_ACCEPT_GZIP BIT(0)
+#define HTTP_SERVER_ACCEPT_BR   BIT(1)
+
+/* Length of an entity tag as sent, quotes included */
+#define HTTP_SERVER_ETAG_LEN (sizeof("\"01234567\"") - 1)
+#define HTTP_SERVER_ETAG_FMT "\"%08x\""
+
+struct fs_file_t;
+
 /* HTTP1/HTTP2 state handling */
 int handle_http_frame_rst_stream(struct http_client_ctx *client);
 int handle_http_frame_goaway(struct http_client_ctx *client);
@@ -39,9 +49,24 @@ int enter_http_done_state(struct http_client_ctx *client);
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_flush(struct http_client_ctx *client);
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client);
+bool http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
-int http_server_find_file(char *fname, size_t fname_size, size_t *file_size, bool *gzipped);
+int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
+			  uint8_t accept_encoding, const char **content_encoding);
+int http_server_send_file(struct http_client_ctx *client, struct fs_file_t *file, size_t len);
+void http_server_parse_accept_encoding(struct http_client_ctx *client, const char *value,
+				       size_t len);
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+uint32_t http_server_static_etag(struct http_resource_detail_static *static_detail);
+void http_server_parse_if_none_match(struct http_client_ctx *client, const char *value,
+				     size_t len);
+bool http_server_etag_match(struct http_client_ctx *client, uint32_t etag);
+#endif
 void http_client_timer_restart(struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
@@ -26,70 +26,75 @@ static inline bool http_hpack_key_is_dynamic(uint32_t key)
 struct hpack_table_entry {
 	const char *name;
 	const char *value;
+	uint8_t name_len;
+	uint8_t value_len;
 };
 
+#define HPACK_NAME(_name) { _name, NULL, sizeof(_name) - 1, 0 }
+#define HPACK_ENTRY(_name, _value) { _name, _value, sizeof(_name) - 1, sizeof(_value) - 1 }
+
 static const struct hpack_table_entry http_hpack_table_static[] = {
-	[HTTP_SERVER_HPACK_AUTHORITY] = { ":authority", NULL },
-	[HTTP_SERVER_HPACK_METHOD_GET] = { ":method", "GET" },
-	[HTTP_SERVER_HPACK_METHOD_POST] = { ":method", "POST" },
-	[HTTP_SERVER_HPACK_PATH_ROOT] = { ":path", "/" },
-	[HTTP_SERVER_HPACK_PATH_INDEX] = { ":path", "/index.html" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTP] = { ":scheme", "http" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = { ":scheme", "https" },
-	[HTTP_SERVER_HPACK_STATUS_200] = { ":status", "200" },
-	[HTTP_SERVER_HPACK_STATUS_204] = { ":status", "204" },
-	[HTTP_SERVER_HPACK_STATUS_206] = { ":status", "206" },
-	[HTTP_SERVER_HPACK_STATUS_304] = { ":status", "304" },
-	[HTTP_SERVER_HPACK_STATUS_400] = { ":status", "400" },
-	[HTTP_SERVER_HPACK_STATUS_404] = { ":status", "404" },
-	[HTTP_SERVER_HPACK_STATUS_500] = { ":status", "500" },
-	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = { "accept-charset", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = { "accept-encoding", "gzip, deflate" },
-	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = { "accept-language", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = { "accept-ranges", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT] = { "accept", NULL },
-	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = { "access-control-allow-origin", NULL },
-	[HTTP_SERVER_HPACK_AGE] = { "age", NULL },
-	[HTTP_SERVER_HPACK_ALLOW] = { "allow", NULL },
-	[HTTP_SERVER_HPACK_AUTHORIZATION] = { "authorization", NULL },
-	[HTTP_SERVER_HPACK_CACHE_CONTROL] = { "cache-control", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = { "content-disposition", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = { "content-encoding", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = { "content-language", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = { "content-length", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = { "content-location", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_RANGE] = { "content-range", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_TYPE] = { "content-type", NULL },
-	[HTTP_SERVER_HPACK_COOKIE] = { "cookie", NULL },
-	[HTTP_SERVER_HPACK_DATE] = { "date", NULL },
-	[HTTP_SERVER_HPACK_ETAG] = { "etag", NULL },
-	[HTTP_SERVER_HPACK_EXPECT] = { "expect", NULL },
-	[HTTP_SERVER_HPACK_EXPIRES] = { "expires", NULL },
-	[HTTP_SERVER_HPACK_FROM] = { "from", NULL },
-	[HTTP_SERVER_HPACK_HOST] = { "host", NULL },
-	[HTTP_SERVER_HPACK_IF_MATCH] = { "if-match", NULL },
-	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = { "if-modified-since", NULL },
-	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = { "if-none-match", NULL },
-	[HTTP_SERVER_HPACK_IF_RANGE] = { "if-range", NULL },
-	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = { "if-unmodified-since", NULL },
-	[HTTP_SERVER_HPACK_LAST_MODIFIED] = { "last-modified", NULL },
-	[HTTP_SERVER_HPACK_LINK] = { "link", NULL },
-	[HTTP_SERVER_HPACK_LOCATION] = { "location", NULL },
-	[HTTP_SERVER_HPACK_MAX_FORWARDS] = { "max-forwards", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = { "proxy-authenticate", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = { "proxy-authorization", NULL },
-	[HTTP_SERVER_HPACK_RANGE] = { "range", NULL },
-	[HTTP_SERVER_HPACK_REFERER] = { "referer", NULL },
-	[HTTP_SERVER_HPACK_REFRESH] = { "refresh", NULL },
-	[HTTP_SERVER_HPACK_RETRY_AFTER] = { "retry-after", NULL },
-	[HTTP_SERVER_HPACK_SERVER] = { "server", NULL },
-	[HTTP_SERVER_HPACK_SET_COOKIE] = { "set-cookie", NULL },
-	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = { "strict-transport-security", NULL },
-	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = { "transfer-encoding", NULL },
-	[HTTP_SERVER_HPACK_USER_AGENT] = { "user-agent", NULL },
-	[HTTP_SERVER_HPACK_VARY] = { "vary", NULL },
-	[HTTP_SERVER_HPACK_VIA] = { "via", NULL },
-	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = { "www-authenticate", NULL },
+	[HTTP_SERVER_HPACK_AUTHORITY] = HPACK_NAME(":authority"),
+	[HTTP_SERVER_HPACK_METHOD_GET] = HPACK_ENTRY(":method", "GET"),
+	[HTTP_SERVER_HPACK_METHOD_POST] = HPACK_ENTRY(":method", "POST"),
+	[HTTP_SERVER_HPACK_PATH_ROOT] = HPACK_ENTRY(":path", "/"),
+	[HTTP_SERVER_HPACK_PATH_INDEX] = HPACK_ENTRY(":path", "/index.html"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTP] = HPACK_ENTRY(":scheme", "http"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = HPACK_ENTRY(":scheme", "https"),
+	[HTTP_SERVER_HPACK_STATUS_200] = HPACK_ENTRY(":status", "200"),
+	[HTTP_SERVER_HPACK_STATUS_204] = HPACK_ENTRY(":status", "204"),
+	[HTTP_SERVER_HPACK_STATUS_206] = HPACK_ENTRY(":status", "206"),
+	[HTTP_SERVER_HPACK_STATUS_304] = HPACK_ENTRY(":status", "304"),
+	[HTTP_SERVER_HPACK_STATUS_400] = HPACK_ENTRY(":status", "400"),
+	[HTTP_SERVER_HPACK_STATUS_404] = HPACK_ENTRY(":status", "404"),
+	[HTTP_SERVER_HPACK_STATUS_500] = HPACK_ENTRY(":status", "500"),
+	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = HPACK_NAME("accept-charset"),
+	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = HPACK_ENTRY("accept-encoding", "gzip, deflate"),
+	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = HPACK_NAME("accept-language"),
+	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = HPACK_NAME("accept-ranges"),
+	[HTTP_SERVER_HPACK_ACCEPT] = HPACK_NAME("accept"),
+	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = HPACK_NAME("access-control-allow-origin"),
+	[HTTP_SERVER_HPACK_AGE] = HPACK_NAME("age"),
+	[HTTP_SERVER_HPACK_ALLOW] = HPACK_NAME("allow"),
+	[HTTP_SERVER_HPACK_AUTHORIZATION] = HPACK_NAME("authorization"),
+	[HTTP_SERVER_HPACK_CACHE_CONTROL] = HPACK_NAME("cache-control"),
+	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = HPACK_NAME("content-disposition"),
+	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = HPACK_NAME("content-encoding"),
+	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = HPACK_NAME("content-language"),
+	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = HPACK_NAME("content-length"),
+	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = HPACK_NAME("content-location"),
+	[HTTP_SERVER_HPACK_CONTENT_RANGE] = HPACK_NAME("content-range"),
+	[HTTP_SERVER_HPACK_CONTENT_TYPE] = HPACK_NAME("content-type"),
+	[HTTP_SERVER_HPACK_COOKIE] = HPACK_NAME("cookie"),
+	[HTTP_SERVER_HPACK_DATE] = HPACK_NAME("date"),
+	[HTTP_SERVER_HPACK_ETAG] = HPACK_NAME("etag"),
+	[HTTP_SERVER_HPACK_EXPECT] = HPACK_NAME("expect"),
+	[HTTP_SERVER_HPACK_EXPIRES] = HPACK_NAME("expires"),
+	[HTTP_SERVER_HPACK_FROM] = HPACK_NAME("from"),
+	[HTTP_SERVER_HPACK_HOST] = HPACK_NAME("host"),
+	[HTTP_SERVER_HPACK_IF_MATCH] = HPACK_NAME("if-match"),
+	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = HPACK_NAME("if-modified-since"),
+	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = HPACK_NAME("if-none-match"),
+	[HTTP_SERVER_HPACK_IF_RANGE] = HPACK_NAME("if-range"),
+	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = HPACK_NAME("if-unmodified-since"),
+	[HTTP_SERVER_HPACK_LAST_MODIFIED] = HPACK_NAME("last-modified"),
+	[HTTP_SERVER_HPACK_LINK] = HPACK_NAME("link"),
+	[HTTP_SERVER_HPACK_LOCATION] = HPACK_NAME("location"),
+	[HTTP_SERVER_HPACK_MAX_FORWARDS] = HPACK_NAME("max-forwards"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = HPACK_NAME("proxy-authenticate"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = HPACK_NAME("proxy-authorization"),
+	[HTTP_SERVER_HPACK_RANGE] = HPACK_NAME("range"),
+	[HTTP_SERVER_HPACK_REFERER] = HPACK_NAME("referer"),
+	[HTTP_SERVER_HPACK_REFRESH] = HPACK_NAME("refresh"),
+	[HTTP_SERVER_HPACK_RETRY_AFTER] = HPACK_NAME("retry-after"),
+	[HTTP_SERVER_HPACK_SERVER] = HPACK_NAME("server"),
+	[HTTP_SERVER_HPACK_SET_COOKIE] = HPACK_NAME("set-cookie"),
+	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = HPACK_NAME("strict-transport-security"),
+	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = HPACK_NAME("transfer-encoding"),
+	[HTTP_SERVER_HPACK_USER_AGENT] = HPACK_NAME("user-agent"),
+	[HTTP_SERVER_HPACK_VARY] = HPACK_NAME("vary"),
+	[HTTP_SERVER_HPACK_VIA] = HPACK_NAME("via"),
+	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = HPACK_NAME("www-authenticate"),
 };
 
 const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
@@ -101,41 +106,100 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
+#define HPACK_HASH_INIT 2166136261U
+#define HPACK_STATIC_HASH_BUCKETS 64
+
+/* FNV-1a */
+static uint32_t hpack_hash(const char *str, size_t len, uint32_t hash)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash ^= (uint8_t)str[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/* First static table entry whose name falls into each bucket, indexed with
+ * hpack_hash() of the name modulo HPACK_STATIC_HASH_BUCKETS. The index is
+ * written out by hand, tests/net/lib/http_server/hpack rebuilds it from the
+ * static table and compares, so update both tables when changing the hash,
+ * the bucket count or the static table.
+ */
+static const uint8_t static_hash_head[HPACK_STATIC_HASH_BUCKETS] = {
+	34,  0, 61, 36,  0, 59,  0,  0,  2,  0, 30,  0, 57, 24,  0,  0,
+	 0,  0, 50, 27,  0, 31, 17,  8, 35, 16,  0,  0, 21, 28,  1,  0,
+	 0, 56,  0,  0,  0,  0, 18,  0, 15, 19,  6, 44, 20,  0,  4, 38,
+	 0,  0, 22,  0, 52, 37, 53, 41, 55,  0,  0, 49,  0,  0, 23, 32,
+};
+
+/* Next static table entry with another name in the same bucket. Entries
+ * sharing a name are adjacent in the table and only the first one is chained.
+ */
+static const uint8_t static_hash_next[HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1] = {
+	 0,  0, 26,  0, 29,  0, 39,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	33, 47, 46, 40,  0, 25,  0, 42,  0,  0,  0, 60,  0, 58, 43,  0,
+	 0,  0,  0,  0,  0,  0, 48,  0, 45,  0,  0,  0,  0,  0, 51,  0,
+	 0,  0, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static bool hpack_static_name_equal(int index, const char *name, size_t name_len)
+{
+	const struct hpack_table_entry *entry = &http_hpack_table_static[index];
+
+	return entry->name_len == name_len && memcmp(entry->name, name, name_len) == 0;
+}
+
 static int http_hpack_find_index(struct http_hpack_header_buf *header,
-				 bool *name_only)
+				 uint32_t name_hash, bool *name_only)
 {
 	const struct hpack_table_entry *entry;
-	int candidate = -1;
+	int candidate;
 
-	for (int i = HTTP_SERVER_HPACK_AUTHORITY;
-	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
-		entry = &http_hpack_table_static[i];
+	candidate = static_hash_head[name_hash % HPACK_STATIC_HASH_BUCKETS];
+	while (candidate != 0 &&
+	       !hpack_static_name_equal(candidate, header->name, header->name_len)) {
+		candidate = static_hash_next[candidate];
+	}
 
-		if (entry->name != NULL &&
-		    strlen(entry->name) == header->name_len &&
-		    memcmp(entry->name, header->name, header->name_len) == 0) {
-			if (entry->value != NULL &&
-			    strlen(entry->value) == header->value_len &&
-			    memcmp(entry->value, header->value, header->value_len) == 0) {
-				/* Got exact match. */
-				*name_only = false;
-				return i;
-			}
+	if (candidate == 0) {
+		return -ENOENT;
+	}
 
-			if (candidate < 0) {
-				candidate = i;
-			}
+	for (int i = candidate; i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE &&
+	     hpack_static_name_equal(i, header->name, header->name_len); i++) {
+		entry = &http_hpack_table_static[i];
+
+		if (entry->value != NULL &&
+		    entry->value_len == header->value_len &&
+		    memcmp(entry->value, header->value, header->value_len) == 0) {
+			/* Got exact match. */
+			*name_only = false;
+			return i;
 		}
 	}
 
-	if (candidate > 0) {
-		/* Matched name only. */
-		*name_only = true;
-		return candidate;
-	}
+	/* Matched name only. */
+	*name_only = true;
+
+	return candidate;
+}
 
-	return -ENOENT;
+#if defined(CONFIG_ZTEST)
+/* Let the tests rebuild the static table hash index and compare it. */
+uint32_t http_hpack_static_hash_bucket(const char *name, size_t name_len)
+{
+	return hpack_hash(name, name_len, HPACK_HASH_INIT) % HPACK_STATIC_HASH_BUCKETS;
+}
+
+const uint8_t *http_hpack_static_hash_index(size_t *buckets, const uint8_t **next)
+{
+	*buckets = ARRAY_SIZE(static_hash_head);
+	*next = static_hash_next;
+
+	return static_hash_head;
 }
+#endif /* CONFIG_ZTEST */
 
 #define HPACK_INTEGER_CONTINUATION_FLAG            0x80
 #define HPACK_STRING_HUFFMAN_FLAG                  0x80
@@ -313,9 +377,9 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 	}
 
 	header->name = entry->name;
-	header->name_len = strlen(entry->name);
+	header->name_len = entry->name_len;
 	header->value = entry->value;
-	header->value_len = strlen(entry->value);
+	header->value_len = entry->value_len;
 
 	return ret;
 }
@@ -363,7 +427,7 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		}
 
 		header->name = entry->name;
-		header->name_len = strlen(entry->name);
+		header->name_len = entry->name_len;
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -470,7 +534,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -534,14 +598,16 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+/* Literal header field, with the name taken from the table entry at index,
+ * or sent literally as well when index is 0.
+ */
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -550,14 +616,16 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
-	if (ret < 0) {
-		return ret;
-	}
+	if (index == 0) {
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
 
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
@@ -569,43 +637,224 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
+static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
+{
+	return hpack_integer_encode(buf, buflen, index, HPACK_PREFIX_INDEXED,
+				    HPACK_PREFIX_LEN_INDEXED);
+}
+
+static bool hpack_header_is_sensitive(int static_index, bool name_match)
+{
+	/* RFC 7541 ch 7.1.3, keep credentials out of the table. */
+	return name_match && (static_index == HTTP_SERVER_HPACK_AUTHORIZATION ||
+			      static_index == HTTP_SERVER_HPACK_COOKIE ||
+			      static_index == HTTP_SERVER_HPACK_PROXY_AUTHORIZATION ||
+			      static_index == HTTP_SERVER_HPACK_SET_COOKIE);
+}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+static inline int hpack_dynamic_index(struct http_hpack_dynamic_table *table, int position)
+{
+	/* The newest entry comes first, right after the static table. */
+	return HTTP_SERVER_HPACK_WWW_AUTHENTICATE + table->count - position;
+}
+
+static int hpack_dynamic_find_index(struct http_hpack_dynamic_table *table,
+				    struct http_hpack_header_buf *header,
+				    uint32_t name_hash, uint32_t field_hash,
+				    bool *name_only)
+{
+	const uint8_t *name = table->data;
+	int candidate = -ENOENT;
+
+	for (int i = 0; i < table->count; i++) {
+		struct http_hpack_dynamic_entry *entry = &table->entries[i];
+
+		if (entry->name_hash == (uint16_t)name_hash &&
+		    entry->name_len == header->name_len &&
+		    memcmp(name, header->name, header->name_len) == 0) {
+			if (entry->field_hash == (uint16_t)field_hash &&
+			    entry->value_len == header->value_len &&
+			    memcmp(name + entry->name_len, header->value,
+				   header->value_len) == 0) {
+				*name_only = false;
+				return hpack_dynamic_index(table, i);
+			}
+
+			candidate = hpack_dynamic_index(table, i);
+		}
+
+		name += entry->name_len + entry->value_len;
+	}
+
+	*name_only = true;
+
+	return candidate;
+}
+
+static void hpack_dynamic_evict(struct http_hpack_dynamic_table *table)
+{
+	struct http_hpack_dynamic_entry *oldest = &table->entries[0];
+	size_t len = oldest->name_len + oldest->value_len;
+	size_t used = table->size - table->count * HTTP_HPACK_ENTRY_OVERHEAD;
+
+	memmove(table->data, table->data + len, used - len);
+	table->size -= len + HTTP_HPACK_ENTRY_OVERHEAD;
+	table->count--;
+	memmove(&table->entries[0], &table->entries[1],
+		table->count * sizeof(table->entries[0]));
+}
+
+static void hpack_dynamic_add(struct http_hpack_dynamic_table *table,
+			      struct http_hpack_header_buf *header,
+			      uint32_t name_hash, uint32_t field_hash)
+{
+	size_t entry_size = header->name_len + header->value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+	struct http_hpack_dynamic_entry *entry;
+	uint8_t *data;
+
+	while (table->size + entry_size > table->max_size) {
+		hpack_dynamic_evict(table);
+	}
+
+	data = table->data + table->size - table->count * HTTP_HPACK_ENTRY_OVERHEAD;
+	memcpy(data, header->name, header->name_len);
+	memcpy(data + header->name_len, header->value, header->value_len);
+
+	entry = &table->entries[table->count];
+	entry->name_hash = (uint16_t)name_hash;
+	entry->field_hash = (uint16_t)field_hash;
+	entry->name_len = header->name_len;
+	entry->value_len = header->value_len;
+
+	table->count++;
+	table->size += entry_size;
+}
+
+static int hpack_encode_size_update(uint8_t *buf, size_t buflen,
+				    struct http_hpack_dynamic_table *table)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	/* The decoder has to see the smallest size the table went through,
+	 * RFC 7541 ch 4.2.
+	 */
+	if (table->min_size < table->max_size) {
+		ret = hpack_integer_encode(buf, buflen, table->min_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	}
+
+	ret = hpack_integer_encode(buf + len, buflen - len, table->max_size,
+				   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
 	if (ret < 0) {
 		return ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
+	return len + ret;
+}
+#endif /* HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0 */
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table)
+{
+	table->size = 0;
+	table->count = 0;
+	table->max_size = HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE;
+	table->min_size = table->max_size;
+	table->size_update = false;
+}
+
+void http_hpack_dynamic_table_set_max_size(struct http_hpack_dynamic_table *table,
+					   uint32_t max_size)
+{
+	max_size = MIN(max_size, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+
+	if (max_size == table->max_size) {
+		return;
 	}
 
-	len += ret;
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	while (table->size > max_size) {
+		hpack_dynamic_evict(table);
+	}
+#endif
 
-	return len;
+	table->min_size = table->size_update ? MIN(table->min_size, max_size) : max_size;
+	table->max_size = max_size;
+	table->size_update = true;
 }
 
-static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
+/* Encode a header field, without the dynamic table size update */
+static int hpack_encode_field(uint8_t *buf, size_t buflen,
+			      struct http_hpack_header_buf *header,
+			      struct http_hpack_dynamic_table *table)
 {
-	return hpack_integer_encode(buf, buflen, index, HPACK_PREFIX_INDEXED,
-				    HPACK_PREFIX_LEN_INDEXED);
+	uint32_t name_hash;
+	bool name_only;
+	int index;
+	int ret;
+
+	name_hash = hpack_hash(header->name, header->name_len, HPACK_HASH_INIT);
+
+	index = http_hpack_find_index(header, name_hash, &name_only);
+	if (index > 0 && !name_only) {
+		/* Indexed */
+		return hpack_encode_indexed(buf, buflen, index);
+	}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	if (table != NULL && !hpack_header_is_sensitive(index, index > 0) &&
+	    header->name_len + header->value_len + HTTP_HPACK_ENTRY_OVERHEAD <=
+	    table->max_size) {
+		uint32_t field_hash = hpack_hash(header->value, header->value_len, name_hash);
+		bool dynamic_name_only;
+		int dynamic_index;
+
+		dynamic_index = hpack_dynamic_find_index(table, header, name_hash,
+							 field_hash, &dynamic_name_only);
+		if (dynamic_index > 0 && !dynamic_name_only) {
+			return hpack_encode_indexed(buf, buflen, dynamic_index);
+		}
+
+		if (index < 0 && dynamic_index > 0) {
+			index = dynamic_index;
+		}
+
+		/* Literal with incremental indexing, the next occurrence is
+		 * sent indexed.
+		 */
+		ret = hpack_encode_literal(buf, buflen, MAX(index, 0),
+					   HPACK_PREFIX_LITERAL_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_INDEXING, header);
+		if (ret < 0) {
+			return ret;
+		}
+
+		hpack_dynamic_add(table, header, name_hash, field_hash);
+
+		return ret;
+	}
+#else
+	ARG_UNUSED(table);
+#endif
+
+	/* Literal value, with the name indexed if possible */
+	return hpack_encode_literal(buf, buflen, MAX(index, 0),
+				    HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+				    HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED, header);
 }
 
-int http_hpack_encode_header(uint8_t *buf, size_t buflen,
-			     struct http_hpack_header_buf *header)
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header,
+				   struct http_hpack_dynamic_table *table)
 {
 	int ret, len = 0;
-	bool name_only;
 
 	if (buf == NULL || header == NULL ||
 	    header->name == NULL || header->name_len == 0 ||
@@ -617,17 +866,40 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
-	ret = http_hpack_find_index(header, &name_only);
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/* A size update has to come first in a header block. */
+	if (table != NULL && table->size_update) {
+		ret = hpack_encode_size_update(buf, buflen, table);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+#endif
+
+	ret = hpack_encode_field(buf, buflen, header, table);
 	if (ret < 0) {
-		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
-	} else if (name_only) {
-		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
-	} else {
-		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		return ret;
 	}
 
-	return len;
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/* The update is only sent once the whole field fits, otherwise it is
+	 * repeated with the next attempt.
+	 */
+	if (len > 0) {
+		table->size_update = false;
+		table->min_size = table->max_size;
+	}
+#endif
+
+	return len + ret;
+}
+
+int http_hpack_encode_header(uint8_t *buf, size_t buflen,
+			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_encode_header_table(buf, buflen, header, NULL);
 }
@@ -283,41 +283,76 @@ static const struct decode_elem eos = {
 
 #define UINT32_BITLEN 32
 
-#define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
-#define LSB_MASK(len) ((1UL << len) - 1UL)
+#define LSB_MASK(len) ((1UL << (len)) - 1UL)
 
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
+/* The codes are canonical: codes of the same length are consecutive numbers
+ * and sorted in decode_table, so a code is decoded with one comparison per
+ * code length rather than one per symbol.
+ */
+struct decode_group {
+	uint8_t bitlen;
+	uint8_t count;
+	uint16_t index;
+	uint32_t first;
+};
 
-	if (code == (bits & mask)) {
-		return true;
-	}
+static const struct decode_group decode_groups[] = {
+	{  5, 10,   0,          0 },
+	{  6, 26,  10,         20 },
+	{  7, 32,  36,         92 },
+	{  8,  6,  68,        248 },
+	{ 10,  5,  74,       1016 },
+	{ 11,  3,  79,       2042 },
+	{ 12,  2,  82,       4090 },
+	{ 13,  6,  84,       8184 },
+	{ 14,  2,  90,      16380 },
+	{ 15,  3,  92,      32764 },
+	{ 19,  3,  95,     524272 },
+	{ 20,  8,  98,    1048550 },
+	{ 21, 13, 106,    2097116 },
+	{ 22, 26, 119,    4194258 },
+	{ 23, 29, 145,    8388568 },
+	{ 24, 12, 174,   16777194 },
+	{ 25,  4, 186,   33554412 },
+	{ 26, 15, 190,   67108832 },
+	{ 27, 19, 205,  134217694 },
+	{ 28, 29, 224,  268435426 },
+	{ 30,  4, 253, 1073741820 },
+};
 
-	return false;
-}
+/* Position of each symbol in decode_table */
+static const uint8_t encode_index[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241, 242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,  65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108, 163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182, 114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220, 221, 222, 223, 204,
+};
 
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	ARRAY_FOR_EACH_PTR(decode_groups, group) {
+		uint32_t code = bits >> (UINT32_BITLEN - group->bitlen);
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
-	}
+		if (code - group->first < group->count) {
+			uint16_t index = group->index + (code - group->first);
 
-	return NULL;
-}
+			if (index < ARRAY_SIZE(decode_table)) {
+				return &decode_table[index];
+			}
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+			return &eos;
 		}
 	}
 
@@ -330,49 +365,29 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
 	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
 	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint8_t acc_len = 0;
+	uint64_t acc = 0;
+	uint32_t bits;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
 	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
+		/* Refill the bit accumulator a byte at a time */
+		while (acc_len <= 56 && encoded_len > 0) {
+			acc |= (uint64_t)*encoded_buf << (56 - acc_len);
+			acc_len += 8;
+			encoded_buf++;
+			encoded_len--;
+		}
 
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
-				encoded_len--;
-				bits_in_byte_left = 8;
-			}
+		bits = (uint32_t)(acc >> UINT32_BITLEN);
+		if (acc_len < UINT32_BITLEN) {
+			/* Pad with ones */
+			bits |= LSB_MASK(UINT32_BITLEN - acc_len);
 		}
 
 		/* Pass to decoder */
@@ -396,8 +411,9 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			return -EBADMSG;
 		}
 
-		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
+		/* Remove consumed bits from the accumulator. */
+		acc <<= decoded->bitlen;
+		acc_len -= decoded->bitlen;
 		encoded_bits_len -= decoded->bitlen;
 
 		/* Store decoded symbol */
@@ -420,7 +436,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 {
 	const struct decode_elem *entry;
 	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint8_t acc_len = 0;
+	uint64_t acc = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,41 +445,22 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
+		entry = &decode_table[encode_index[*str]];
 
 		if (entry->bitlen > buflen_bits) {
 			return -ENOBUFS;
 		}
 
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
-
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
-			}
-
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
+		/* Less than a byte is pending, so the code always fits. */
+		acc |= (uint64_t)sys_get_be32(entry->code) << (UINT32_BITLEN - acc_len);
+		acc_len += entry->bitlen;
 
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+		while (acc_len >= 8) {
+			*buf = (uint8_t)(acc >> 56);
+			acc <<= 8;
+			acc_len -= 8;
+			buf++;
+			len++;
 		}
 
 		buflen_bits -= entry->bitlen;
@@ -471,8 +469,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
+	if (acc_len > 0) {
+		*buf = (uint8_t)(acc >> 56) | LSB_MASK((8 - acc_len));
 		len++;
 	}
 
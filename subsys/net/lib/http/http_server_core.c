@@ -14,6 +14,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/fs/fs.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
@@ -38,23 +39,64 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define HTTP_SERVER_WORKERS      CONFIG_HTTP_SERVER_WORKERS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
+/* Value written to the eventfd to stop the server. Workers handing a client
+ * back to the server thread write 1, which keeps the two apart.
+ */
+#define HTTP_SERVER_STOP_EVENT ((eventfd_t)1 << 32)
+
+/* Client slot states. A non-negative value is the index of the client socket
+ * in the pollfd array.
+ */
+#define CLIENT_SLOT_FREE -1
+#define CLIENT_SLOT_BUSY -2
+
 struct http_server_ctx {
 	int num_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
+	int num_fds;    /* pollfds in use */
+	int num_busy;   /* clients handed over to a worker */
 
 	/* First pollfd is eventfd that can be used to stop the server,
 	 * then we have the server listen sockets,
-	 * and then the accepted sockets.
+	 * and then the accepted sockets waiting for data. The accepted sockets
+	 * are kept packed at the start of the remaining space, and a client is
+	 * taken out of the array while its data is processed, so poll() is
+	 * only ever given the sockets it actually has to watch.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
+	struct http_client_ctx *fd_clients[HTTP_SERVER_SOCK_COUNT];
+	int client_slots[HTTP_SERVER_MAX_CLIENTS];
+#if defined(CONFIG_HTTP_SERVER_EVICT_IDLE_CLIENTS)
+	uint32_t client_activity[HTTP_SERVER_MAX_CLIENTS];
+#endif
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
+static struct k_spinlock resource_lock;
+
+#if HTTP_SERVER_WORKERS > 0
+struct http_server_work {
+	struct http_client_ctx *client;
+	short revents;
+};
+
+/* Each client is queued at most once, so neither queue can overflow. */
+K_MSGQ_DEFINE(http_server_work_q, sizeof(struct http_server_work),
+	      HTTP_SERVER_MAX_CLIENTS, 4);
+K_MSGQ_DEFINE(http_server_done_q, sizeof(struct http_client_ctx *),
+	      HTTP_SERVER_MAX_CLIENTS, 4);
+static K_MUTEX_DEFINE(http_server_done_lock);
+
+static K_THREAD_STACK_ARRAY_DEFINE(http_server_worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread http_server_workers[HTTP_SERVER_WORKERS];
+#endif
 
 static void close_client_connection(struct http_client_ctx *client);
 
@@ -86,11 +128,16 @@ int http_server_init(struct http_server_ctx *ctx)
 	/* Initialize fds */
 	memset(ctx->fds, 0, sizeof(ctx->fds));
 	memset(ctx->clients, 0, sizeof(ctx->clients));
+	memset(ctx->fd_clients, 0, sizeof(ctx->fd_clients));
 
 	for (i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
 		ctx->fds[i].fd = INVALID_SOCK;
 	}
 
+	for (i = 0; i < ARRAY_SIZE(ctx->client_slots); i++) {
+		ctx->client_slots[i] = CLIENT_SLOT_FREE;
+	}
+
 	/* Create an eventfd that can be used to trigger events during polling */
 	fd = eventfd(0, 0);
 	if (fd < 0) {
@@ -235,7 +282,9 @@ int http_server_init(struct http_server_ctx *ctx)
 	}
 
 	ctx->listen_fds = count;
+	ctx->num_fds = count;
 	ctx->num_clients = 0;
+	ctx->num_busy = 0;
 
 	return 0;
 }
@@ -263,29 +312,6 @@ static int accept_new_client(int server_fd)
 	return new_socket;
 }
 
-static void close_all_sockets(struct http_server_ctx *ctx)
-{
-	zsock_close(ctx->fds[0].fd); /* close eventfd */
-	ctx->fds[0].fd = -1;
-
-	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-		if (ctx->fds[i].fd < 0) {
-			continue;
-		}
-
-		if (i < ctx->listen_fds) {
-			zsock_close(ctx->fds[i].fd);
-		} else {
-			struct http_client_ctx *client =
-				&server_ctx.clients[i - ctx->listen_fds];
-
-			close_client_connection(client);
-		}
-
-		ctx->fds[i].fd = -1;
-	}
-}
-
 static void client_release_resources(struct http_client_ctx *client)
 {
 	struct http_resource_detail *detail;
@@ -302,17 +328,12 @@ static void client_release_resources(struct http_client_ctx *client)
 
 			dynamic_detail = (struct http_resource_detail_dynamic *)detail;
 
-			if (dynamic_detail->holder != client) {
-				continue;
-			}
-
 			/* If the client still holds the resource at this point,
 			 * it means the transaction was not complete. Release
 			 * the resource and notify application.
 			 */
-			dynamic_detail->holder = NULL;
-
-			if (dynamic_detail->cb == NULL) {
+			if (!http_server_release_resource(dynamic_detail, client) ||
+			    dynamic_detail->cb == NULL) {
 				continue;
 			}
 
@@ -322,25 +343,60 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool claimed = false;
+
+	key = k_spin_lock(&resource_lock);
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		claimed = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return claimed;
+}
+
+/* The resource lock is needed as the server thread releases the resources
+ * of a closed client while workers may claim them for other clients.
+ */
+bool http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool released = false;
+
+	key = k_spin_lock(&resource_lock);
+
+	if (dynamic_detail->holder == client) {
+		dynamic_detail->holder = NULL;
+		released = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return released;
+}
+
+/* The client slot itself is only freed by the server thread, once the client
+ * is handed back to it (see client_done()), so this is safe to call from a
+ * worker.
+ */
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
 	struct k_work_sync sync;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
+	(void)http_server_flush(client);
+
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
-
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
-			break;
-		}
-	}
-
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
 }
@@ -395,6 +451,10 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	}
 
 	client->current_stream = NULL;
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	http_hpack_dynamic_table_init(&client->hpack_table);
+#endif
 }
 
 static int handle_http_preface(struct http_client_ctx *client)
@@ -502,20 +562,320 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
-static int http_server_run(struct http_server_ctx *ctx)
+static int client_slot(struct http_server_ctx *ctx, struct http_client_ctx *client)
+{
+	return ARRAY_INDEX(ctx->clients, client);
+}
+
+static void client_poll_add(struct http_server_ctx *ctx, struct http_client_ctx *client)
+{
+	int idx = ctx->num_fds++;
+
+	ctx->fds[idx].fd = client->fd;
+	ctx->fds[idx].events = ZSOCK_POLLIN;
+	ctx->fds[idx].revents = 0;
+	ctx->fd_clients[idx] = client;
+	ctx->client_slots[client_slot(ctx, client)] = idx;
+
+#if defined(CONFIG_HTTP_SERVER_EVICT_IDLE_CLIENTS)
+	ctx->client_activity[client_slot(ctx, client)] = k_uptime_get_32();
+#endif
+}
+
+/* Move the last pollfd into the place of the removed one, so that the array
+ * stays packed. Callers walking the array do so from the end, so the moved
+ * entry has already been looked at.
+ */
+static void client_poll_remove(struct http_server_ctx *ctx, struct http_client_ctx *client)
+{
+	int idx = ctx->client_slots[client_slot(ctx, client)];
+	int last = --ctx->num_fds;
+
+	__ASSERT_NO_MSG(idx >= ctx->listen_fds && idx <= last);
+
+	if (idx != last) {
+		ctx->fds[idx] = ctx->fds[last];
+		ctx->fd_clients[idx] = ctx->fd_clients[last];
+		ctx->client_slots[client_slot(ctx, ctx->fd_clients[idx])] = idx;
+	}
+
+	ctx->fds[last].fd = INVALID_SOCK;
+	ctx->fd_clients[last] = NULL;
+	ctx->client_slots[client_slot(ctx, client)] = CLIENT_SLOT_BUSY;
+}
+
+static void client_slot_free(struct http_server_ctx *ctx, struct http_client_ctx *client)
+{
+	ctx->client_slots[client_slot(ctx, client)] = CLIENT_SLOT_FREE;
+	ctx->num_clients--;
+}
+
+/* Called in the server thread once a client has been processed. */
+static void client_done(struct http_server_ctx *ctx, struct http_client_ctx *client)
+{
+	if (client->fd == INVALID_SOCK) {
+		/* Connection was closed or handed over (websocket). */
+		client_slot_free(ctx, client);
+		return;
+	}
+
+	client_poll_add(ctx, client);
+}
+
+static void client_process(struct http_client_ctx *client, short revents)
+{
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+	int ret;
+
+	if (revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client %p has disconnected", client);
+		close_client_connection(client);
+		return;
+	}
+
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR,
+				       &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client %p", client);
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret == 0 || ret == -EAGAIN) {
+		ret = http_server_flush(client);
+	}
+
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+#if HTTP_SERVER_WORKERS > 0
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	struct http_server_work work;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&http_server_work_q, &work, K_FOREVER);
+
+		client_process(work.client, work.revents);
+
+		/* The server thread does not close the eventfd until every
+		 * client handed out has come back, hold the lock until the
+		 * wakeup is sent so that it cannot do so in between.
+		 */
+		k_mutex_lock(&http_server_done_lock, K_FOREVER);
+		(void)k_msgq_put(&http_server_done_q, &work.client, K_NO_WAIT);
+		(void)eventfd_write(server_ctx.fds[0].fd, 1);
+		k_mutex_unlock(&http_server_done_lock);
+	}
+}
+
+static void http_server_start_workers(void)
+{
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		k_thread_create(&http_server_workers[i], http_server_worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(http_server_worker_stacks[i]),
+				http_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&http_server_workers[i], "http_server_worker");
+	}
+}
+
+static void collect_done_clients(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
+
+	while (k_msgq_get(&http_server_done_q, &client, K_NO_WAIT) == 0) {
+		ctx->num_busy--;
+		client_done(ctx, client);
+	}
+}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
+static void dispatch_client(struct http_server_ctx *ctx, struct http_client_ctx *client,
+			    short revents)
+{
+#if HTTP_SERVER_WORKERS > 0
+	struct http_server_work work = {
+		.client = client,
+		.revents = revents,
+	};
+	int ret;
+
+	client_poll_remove(ctx, client);
+
+	ret = k_msgq_put(&http_server_work_q, &work, K_NO_WAIT);
+	__ASSERT_NO_MSG(ret == 0);
+	ARG_UNUSED(ret);
+
+	ctx->num_busy++;
+#else
+	client_poll_remove(ctx, client);
+	client_process(client, revents);
+	client_done(ctx, client);
+#endif
+}
+
+#if defined(CONFIG_HTTP_SERVER_EVICT_IDLE_CLIENTS)
+static struct http_client_ctx *find_idle_client(struct http_server_ctx *ctx)
+{
+	struct http_client_ctx *oldest = NULL;
+	uint32_t now = k_uptime_get_32();
+	uint32_t oldest_age = 0;
+
+	for (int i = ctx->listen_fds; i < ctx->num_fds; i++) {
+		struct http_client_ctx *client = ctx->fd_clients[i];
+		uint32_t age;
+
+		/* Only clients waiting for a new HTTP/1 request. */
+		if (client->server_state != HTTP_SERVER_PREFACE_STATE ||
+		    client->data_len > 0 || ctx->fds[i].revents != 0) {
+			continue;
+		}
+
+		age = now - ctx->client_activity[client_slot(ctx, client)];
+		if (oldest == NULL || age > oldest_age) {
+			oldest = client;
+			oldest_age = age;
+		}
+	}
+
+	return oldest;
+}
+#endif
+
+static void add_new_client(struct http_server_ctx *ctx, int new_socket)
+{
+	struct http_client_ctx *client = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->clients); i++) {
+		if (ctx->client_slots[i] == CLIENT_SLOT_FREE) {
+			client = &ctx->clients[i];
+			break;
+		}
+	}
+
+#if defined(CONFIG_HTTP_SERVER_EVICT_IDLE_CLIENTS)
+	if (client == NULL) {
+		client = find_idle_client(ctx);
+		if (client != NULL) {
+			LOG_DBG("Evicting idle client %p", client);
+
+			client_poll_remove(ctx, client);
+			close_client_connection(client);
+			client_slot_free(ctx, client);
+		}
+	}
+#endif
+
+	if (client == NULL) {
+		LOG_DBG("No free slot found.");
+		zsock_close(new_socket);
+		return;
+	}
+
+	LOG_DBG("Init client #%d", client_slot(ctx, client));
+
+	ctx->num_clients++;
+	init_client_ctx(client, new_socket);
+	client_poll_add(ctx, client);
+}
+
+static void close_all_sockets(struct http_server_ctx *ctx)
+{
+	struct http_client_ctx *client;
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		zsock_close(ctx->fds[i].fd);
+		ctx->fds[i].fd = INVALID_SOCK;
+	}
+
+	while (ctx->num_fds > ctx->listen_fds) {
+		client = ctx->fd_clients[ctx->num_fds - 1];
+
+		client_poll_remove(ctx, client);
+		close_client_connection(client);
+		client_slot_free(ctx, client);
+	}
+
+#if HTTP_SERVER_WORKERS > 0
+	/* Wait for the clients being processed to be handed back. */
+	while (ctx->num_busy > 0) {
+		(void)k_msgq_get(&http_server_done_q, &client, K_FOREVER);
+		ctx->num_busy--;
+
+		if (client->fd != INVALID_SOCK) {
+			close_client_connection(client);
+		}
+
+		client_slot_free(ctx, client);
+	}
+
+	k_mutex_lock(&http_server_done_lock, K_FOREVER);
+#endif
+
+	zsock_close(ctx->fds[0].fd); /* close eventfd */
+	ctx->fds[0].fd = INVALID_SOCK;
+	ctx->num_fds = 0;
+
+#if HTTP_SERVER_WORKERS > 0
+	k_mutex_unlock(&http_server_done_lock);
+#endif
+}
+
+static int http_server_run(struct http_server_ctx *ctx)
+{
 	eventfd_t value;
-	bool found_slot;
 	int new_socket;
-	int ret, i, j;
+	int ret, i;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
 
 	value = 0;
 
 	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+		ret = zsock_poll(ctx->fds, ctx->num_fds, -1);
 		if (ret < 0) {
 			ret = -errno;
 			LOG_DBG("poll failed (%d)", ret);
@@ -527,128 +887,57 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+		if (ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
-		}
-
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
-				continue;
+			if (value >= HTTP_SERVER_STOP_EVENT) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
-
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
-
-				continue;
-			}
+#if HTTP_SERVER_WORKERS > 0
+			collect_done_clients(ctx);
+#endif
+		}
 
+		for (i = 1; i < ctx->listen_fds; i++) {
 			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
 				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
 						       SO_ERROR, &sock_error, &optlen);
 				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
-
 				/* Listening socket error, abort. */
 				LOG_ERR("Listening socket error, aborting.");
 				ret = -sock_error;
 				goto closing;
-
 			}
 
 			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
 				continue;
 			}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
-
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
-
-					ctx->num_clients++;
-
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
-
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds],
-							new_socket);
-					found_slot = true;
-					break;
-				}
-
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
-
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
 				continue;
 			}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+			add_new_client(ctx, new_socket);
+		}
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+		/* Walk the client sockets from the end, dispatching a client
+		 * moves the last entry into its place. Clients added back in
+		 * the meantime are appended with no pending events.
+		 */
+		for (i = ctx->num_fds - 1; i >= ctx->listen_fds; i--) {
+			short revents = ctx->fds[i].revents;
 
-				close_client_connection(client);
+			if (revents == 0) {
 				continue;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+			dispatch_client(ctx, ctx->fd_clients[i], revents);
 		}
 	}
 
@@ -730,28 +1019,264 @@ struct http_resource_detail *get_resource_detail(const char *path,
 	return NULL;
 }
 
-int http_server_find_file(char *fname, size_t fname_size, size_t *file_size, bool *gzipped)
+int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
+			  uint8_t accept_encoding, const char **content_encoding)
 {
+	static const struct {
+		const char *ext;
+		const char *encoding;
+		uint8_t flag;
+	} variants[] = {
+		{ ".br", "br", HTTP_SERVER_ACCEPT_BR },
+		{ ".gz", "gzip", HTTP_SERVER_ACCEPT_GZIP },
+	};
 	struct fs_dirent dirent;
 	size_t len;
 	int ret;
 
-	ret = fs_stat(fname, &dirent);
-	if (ret < 0) {
-		len = strlen(fname);
-		snprintk(fname + len, fname_size - len, ".gz");
+	len = strlen(fname);
+	*content_encoding = NULL;
+
+	/* Prefer a precompressed variant the client accepts. */
+	ARRAY_FOR_EACH(variants, i) {
+		if (!(accept_encoding & variants[i].flag)) {
+			continue;
+		}
+
+		snprintk(fname + len, fname_size - len, "%s", variants[i].ext);
 		ret = fs_stat(fname, &dirent);
-		*gzipped = (ret == 0);
+		if (ret == 0) {
+			*content_encoding = variants[i].encoding;
+			goto found;
+		}
+	}
+
+	fname[len] = '\0';
+	ret = fs_stat(fname, &dirent);
+	if (ret == 0) {
+		goto found;
 	}
 
+	/* Only a compressed copy may be stored, serve it anyway. */
+	snprintk(fname + len, fname_size - len, ".gz");
+	ret = fs_stat(fname, &dirent);
 	if (ret == 0) {
-		*file_size = dirent.size;
-		return ret;
+		*content_encoding = "gzip";
+		goto found;
 	}
 
 	return -ENOENT;
+
+found:
+	*file_size = dirent.size;
+
+	return 0;
+}
+
+int http_server_send_file(struct http_client_ctx *client, struct fs_file_t *file, size_t len)
+{
+	ssize_t rd;
+	int ret;
+
+#if HTTP_SERVER_CLIENT_TX_BUFFER_SIZE > 0
+	/* Read straight into the output buffer, so that the file content is
+	 * copied only once on its way to the socket.
+	 */
+	while (len > 0) {
+		size_t space = sizeof(client->tx_buffer) - client->tx_len;
+
+		if (space == 0) {
+			ret = http_server_flush(client);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		}
+
+		rd = fs_read(file, client->tx_buffer + client->tx_len, MIN(space, len));
+		if (rd <= 0) {
+			return rd < 0 ? (int)rd : -EIO;
+		}
+
+		client->tx_len += rd;
+		len -= rd;
+	}
+#else
+	uint8_t chunk[CONFIG_HTTP_SERVER_STATIC_FS_CHUNK_SIZE];
+
+	while (len > 0) {
+		rd = fs_read(file, chunk, MIN(sizeof(chunk), len));
+		if (rd <= 0) {
+			return rd < 0 ? (int)rd : -EIO;
+		}
+
+		ret = http_server_sendall(client, chunk, rd);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len -= rd;
+	}
+#endif
+
+	return 0;
+}
+
+static bool is_q_zero(const char *params, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i + 1 < len; i++) {
+		if ((params[i] == 'q' || params[i] == 'Q') && params[i + 1] == '=') {
+			break;
+		}
+	}
+
+	if (i + 1 >= len) {
+		return false;
+	}
+
+	/* q=0, q=0.0 and so on */
+	for (i += 2; i < len && params[i] != ';' && params[i] != ' '; i++) {
+		if (params[i] != '0' && params[i] != '.') {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void http_server_parse_accept_encoding(struct http_client_ctx *client, const char *value,
+				       size_t len)
+{
+	const char *end = value + len;
+
+	client->accept_encoding = 0;
+
+	while (value < end) {
+		const char *item_end = memchr(value, ',', end - value);
+		const char *params;
+		const char *name_end;
+		size_t name_len;
+
+		if (item_end == NULL) {
+			item_end = end;
+		}
+
+		while (value < item_end && (*value == ' ' || *value == '\t')) {
+			value++;
+		}
+
+		params = memchr(value, ';', item_end - value);
+		name_end = (params != NULL) ? params : item_end;
+
+		while (name_end > value && (name_end[-1] == ' ' || name_end[-1] == '\t')) {
+			name_end--;
+		}
+
+		name_len = name_end - value;
+
+		if (params == NULL || !is_q_zero(params, item_end - params)) {
+			if (name_len == 4 && strncasecmp(value, "gzip", 4) == 0) {
+				client->accept_encoding |= HTTP_SERVER_ACCEPT_GZIP;
+			} else if (name_len == 2 && strncasecmp(value, "br", 2) == 0) {
+				client->accept_encoding |= HTTP_SERVER_ACCEPT_BR;
+			} else if (name_len == 1 && value[0] == '*') {
+				client->accept_encoding |= HTTP_SERVER_ACCEPT_GZIP |
+							   HTTP_SERVER_ACCEPT_BR;
+			}
+		}
+
+		value = (item_end < end) ? item_end + 1 : end;
+	}
+}
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+uint32_t http_server_static_etag(struct http_resource_detail_static *static_detail)
+{
+	const uint8_t *data = static_detail->static_data;
+	uint32_t hash = 2166136261U;
+
+	if (static_detail->etag != 0) {
+		return static_detail->etag;
+	}
+
+	/* FNV-1a over the content */
+	for (size_t i = 0; i < static_detail->static_data_len; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+
+	/* Zero marks a tag not computed yet. */
+	if (hash == 0) {
+		hash = 1;
+	}
+
+	static_detail->etag = hash;
+
+	return hash;
+}
+
+/* Only the first entity tag of the list is considered, which is all that
+ * browsers send to revalidate a cached resource.
+ */
+void http_server_parse_if_none_match(struct http_client_ctx *client, const char *value,
+				     size_t len)
+{
+	const char *end = value + len;
+	uint32_t etag = 0;
+
+	client->has_if_none_match = false;
+	client->if_none_match_any = false;
+
+	while (value < end && *value == ' ') {
+		value++;
+	}
+
+	if (value < end && *value == '*') {
+		client->if_none_match_any = true;
+		return;
+	}
+
+	/* If-None-Match uses the weak comparison. */
+	if (end - value >= 2 && value[0] == 'W' && value[1] == '/') {
+		value += 2;
+	}
+
+	if ((size_t)(end - value) < HTTP_SERVER_ETAG_LEN || value[0] != '"' ||
+	    value[HTTP_SERVER_ETAG_LEN - 1] != '"') {
+		return;
+	}
+
+	for (size_t i = 1; i < HTTP_SERVER_ETAG_LEN - 1; i++) {
+		char c = value[i];
+		uint8_t nibble;
+
+		if (c >= '0' && c <= '9') {
+			nibble = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			nibble = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			nibble = c - 'A' + 10;
+		} else {
+			return;
+		}
+
+		etag = (etag << 4) | nibble;
+	}
+
+	client->if_none_match = etag;
+	client->has_if_none_match = true;
 }
 
+bool http_server_etag_match(struct http_client_ctx *client, uint32_t etag)
+{
+	return client->if_none_match_any ||
+	       (client->has_if_none_match && client->if_none_match == etag);
+}
+#endif /* CONFIG_HTTP_SERVER_ETAG */
+
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size)
 {
@@ -767,13 +1292,51 @@ void http_server_get_content_type_from_extension(char *url, char *content_type,
 	}
 }
 
-int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
+static int client_wait_writable(struct http_client_ctx *client)
 {
+	struct zsock_pollfd pfd = {
+		.fd = client->fd,
+		.events = ZSOCK_POLLOUT,
+	};
+	int ret;
+
+	ret = zsock_poll(&pfd, 1, CONFIG_HTTP_SERVER_CLIENT_INACTIVITY_TIMEOUT * MSEC_PER_SEC);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (ret == 0) {
+		return -ETIMEDOUT;
+	}
+
+	if (pfd.revents & (ZSOCK_POLLERR | ZSOCK_POLLNVAL)) {
+		return -ENOTCONN;
+	}
+
+	return 0;
+}
+
+/* Sockets are written without blocking, so that a peer which stops reading
+ * holds the thread sending to it for at most the inactivity timeout.
+ */
+static int sendall_direct(struct http_client_ctx *client, const void *buf, size_t len)
+{
+	int ret;
+
 	while (len) {
-		ssize_t out_len = zsock_send(client->fd, buf, len, 0);
+		ssize_t out_len = zsock_send(client->fd, buf, len, ZSOCK_MSG_DONTWAIT);
 
 		if (out_len < 0) {
-			return -errno;
+			if (errno != EAGAIN) {
+				return -errno;
+			}
+
+			ret = client_wait_writable(client);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
 		}
 
 		buf = (const char *)buf + out_len;
@@ -785,6 +1348,48 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+int http_server_flush(struct http_client_ctx *client)
+{
+#if HTTP_SERVER_CLIENT_TX_BUFFER_SIZE > 0
+	size_t len = client->tx_len;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	client->tx_len = 0;
+
+	return sendall_direct(client, client->tx_buffer, len);
+#else
+	ARG_UNUSED(client);
+
+	return 0;
+#endif
+}
+
+int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
+{
+#if HTTP_SERVER_CLIENT_TX_BUFFER_SIZE > 0
+	int ret;
+
+	if (len > sizeof(client->tx_buffer) - client->tx_len) {
+		ret = http_server_flush(client);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (len <= sizeof(client->tx_buffer) - client->tx_len) {
+		memcpy(client->tx_buffer + client->tx_len, buf, len);
+		client->tx_len += len;
+
+		return 0;
+	}
+#endif
+
+	return sendall_direct(client, buf, len);
+}
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status)
 {
 	if (status != HTTP_SERVER_DATA_FINAL) {
@@ -832,7 +1437,7 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
-	eventfd_write(server_ctx.fds[0].fd, 1);
+	eventfd_write(server_ctx.fds[0].fd, HTTP_SERVER_STOP_EVENT);
 
 	LOG_DBG("Stopping HTTP server");
 
@@ -847,6 +1452,10 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if HTTP_SERVER_WORKERS > 0
+	http_server_start_workers();
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -50,8 +50,10 @@ static int handle_http1_static_resource(
 	char http_response[sizeof(RESPONSE_TEMPLATE) +
 			   sizeof("Content-Encoding: 01234567890123456789\r\n") +
 			   sizeof("Content-Type: \r\n") + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
-			   sizeof("xxxx") +
+			   sizeof("4294967295") +
+			   sizeof("ETag: \r\n") + HTTP_SERVER_ETAG_LEN +
 			   sizeof("\r\n")];
+	char etag_header[sizeof("ETag: \r\n") + HTTP_SERVER_ETAG_LEN] = "";
 	const char *data;
 	int len;
 	int ret;
@@ -60,21 +62,37 @@ static int handle_http1_static_resource(
 		data = static_detail->static_data;
 		len = static_detail->static_data_len;
 
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+		uint32_t etag = http_server_static_etag(static_detail);
+
+		if (http_server_etag_match(client, etag)) {
+			snprintk(http_response, sizeof(http_response),
+				 "HTTP/1.1 304 Not Modified\r\n"
+				 "ETag: " HTTP_SERVER_ETAG_FMT "\r\n\r\n", etag);
+
+			return http_server_sendall(client, http_response,
+						   strlen(http_response));
+		}
+
+		snprintk(etag_header, sizeof(etag_header),
+			 "ETag: " HTTP_SERVER_ETAG_FMT "\r\n", etag);
+#endif
+
 		if (static_detail->common.content_encoding != NULL &&
 		    static_detail->common.content_encoding[0] != '\0') {
 			snprintk(http_response, sizeof(http_response),
-				 RESPONSE_TEMPLATE "Content-Encoding: %s\r\n\r\n",
+				 RESPONSE_TEMPLATE "%sContent-Encoding: %s\r\n\r\n",
 				 "Content-Type: ",
 				 static_detail->common.content_type == NULL ?
 				 "text/html" : static_detail->common.content_type,
-				 len, static_detail->common.content_encoding);
+				 len, etag_header, static_detail->common.content_encoding);
 		} else {
 			snprintk(http_response, sizeof(http_response),
-				 RESPONSE_TEMPLATE "\r\n",
+				 RESPONSE_TEMPLATE "%s\r\n",
 				 "Content-Type: ",
 				 static_detail->common.content_type == NULL ?
 				 "text/html" : static_detail->common.content_type,
-				 len);
+				 len, etag_header);
 		}
 
 		ret = http_server_sendall(client, http_response,
@@ -285,7 +303,7 @@ static int dynamic_get_req(struct http_resource_detail_dynamic *dynamic_detail,
 		len = 0;
 	} while (!http_response_is_final(&response_ctx, status));
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_release_resource(dynamic_detail, client);
 
 	ret = http_server_sendall(client, final_chunk,
 				  sizeof(final_chunk) - 1);
@@ -365,7 +383,7 @@ static int dynamic_post_req(struct http_resource_detail_dynamic *dynamic_detail,
 			return ret;
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 	return 0;
@@ -378,12 +396,12 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 {
 #define RESPONSE_TEMPLATE_STATIC_FS                                                                \
 	"HTTP/1.1 200 OK\r\n"                                                                      \
-	"Content-Type: %s%s\r\n\r\n"
-#define CONTENT_ENCODING_GZIP "\r\nContent-Encoding: gzip"
+	"Content-Type: %s\r\n"                                                                     \
+	"Content-Length: %zu\r\n%s%s%s\r\n"
+#define CONTENT_ENCODING_HEADER "Content-Encoding: "
 
-	bool gzipped = false;
+	const char *content_encoding;
 	int len;
-	int remaining;
 	int ret;
 	size_t file_size;
 	struct fs_file_t file;
@@ -393,7 +411,7 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	 * for the content type and encoding
 	 */
 	char http_response[sizeof(RESPONSE_TEMPLATE_STATIC_FS) + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
-			   sizeof(CONTENT_ENCODING_GZIP)];
+			   sizeof("4294967295") + sizeof(CONTENT_ENCODING_HEADER "gzip\r\n")];
 
 	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
 		ret = http_server_sendall(client, not_allowed_response,
@@ -417,7 +435,8 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	}
 
 	/* open file, if it exists */
-	ret = http_server_find_file(fname, sizeof(fname), &file_size, &gzipped);
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, client->accept_encoding,
+				    &content_encoding);
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 		ret = http_server_sendall(client, not_found_response,
@@ -440,23 +459,17 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	/* send HTTP header */
 	len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
-		       content_type, gzipped ? CONTENT_ENCODING_GZIP : "");
+		       content_type, file_size,
+		       content_encoding != NULL ? CONTENT_ENCODING_HEADER : "",
+		       content_encoding != NULL ? content_encoding : "",
+		       content_encoding != NULL ? "\r\n" : "");
 	ret = http_server_sendall(client, http_response, len);
 	if (ret < 0) {
 		goto close;
 	}
 
 	/* read and send file */
-	remaining = file_size;
-	while (remaining > 0) {
-		len = fs_read(&file, http_response, sizeof(http_response));
-		ret = http_server_sendall(client, http_response, len);
-		if (ret < 0) {
-			goto close;
-		}
-		remaining -= len;
-	}
-	ret = http_server_sendall(client, "\r\n\r\n", 4);
+	ret = http_server_send_file(client, &file, file_size);
 
 close:
 	/* close file */
@@ -483,7 +496,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = http_server_sendall(client, conflict_response,
 					  sizeof(conflict_response) - 1);
 		if (ret < 0) {
@@ -494,8 +507,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -505,7 +516,7 @@ static int handle_http1_dynamic_resource(
 				return ret;
 			}
 
-			dynamic_detail->holder = NULL;
+			(void)http_server_release_resource(dynamic_detail, client);
 
 			return 0;
 		}
@@ -601,10 +612,20 @@ static int on_header_field(struct http_parser *parser, const char *at,
 			check_user_request_headers(&ctx->header_capture_ctx, ctx->header_buffer);
 #endif /* defined(CONFIG_HTTP_SERVER_CAPTURE_HEADERS) */
 
+			/* A previous value may have been too long to be seen */
+			ctx->accept_encoding_next = false;
+			IF_ENABLED(CONFIG_HTTP_SERVER_ETAG, (ctx->if_none_match_next = false));
+
 			if (strcasecmp(ctx->header_buffer, "Upgrade") == 0) {
 				ctx->has_upgrade_header = true;
 			} else if (strcasecmp(ctx->header_buffer, "Sec-WebSocket-Key") == 0) {
 				ctx->websocket_sec_key_next = true;
+			} else if (strcasecmp(ctx->header_buffer, "Accept-Encoding") == 0) {
+				ctx->accept_encoding_next = true;
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+			} else if (strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
+#endif
 			}
 
 			ctx->header_buffer[0] = '\0';
@@ -693,6 +714,18 @@ static int on_header_value(struct http_parser *parser,
 				ctx->websocket_sec_key_next = false;
 			}
 
+			if (ctx->accept_encoding_next) {
+				http_server_parse_accept_encoding(ctx, ctx->header_buffer, offset);
+				ctx->accept_encoding_next = false;
+			}
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+			if (ctx->if_none_match_next) {
+				http_server_parse_if_none_match(ctx, ctx->header_buffer, offset);
+				ctx->if_none_match_next = false;
+			}
+#endif
+
 			ctx->header_buffer[0] = '\0';
 		}
 	}
@@ -771,6 +804,14 @@ int enter_http1_request(struct http_client_ctx *client)
 	client->parser_settings.on_message_complete = on_message_complete;
 	client->parser_state = HTTP1_INIT_HEADER_STATE;
 	client->http1_headers_sent = false;
+	client->accept_encoding = 0;
+	client->accept_encoding_next = false;
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	client->has_if_none_match = false;
+	client->if_none_match_any = false;
+	client->if_none_match_next = false;
+#endif
 
 #if defined(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)
 	client->header_capture_ctx.store_next_value = false;
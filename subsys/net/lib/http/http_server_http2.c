@@ -20,6 +20,9 @@ LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #include "headers/server_internal.h"
 
+/* Initial value of SETTINGS_MAX_FRAME_SIZE, RFC 9113 section 6.5.2 */
+#define HTTP2_DEFAULT_MAX_FRAME_SIZE 16384
+
 static const char content_404[] = {
 #ifdef INCLUDE_HTML_CONTENT
 #include "not_found_page.html.gz.inc"
@@ -113,7 +116,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	ret = http_hpack_encode_header_table(*buf, *buflen, &client->header_field,
+					     &client->hpack_table);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -367,8 +375,37 @@ static int handle_http2_static_resource(
 	content_200 = static_detail->static_data;
 	content_len = static_detail->static_data_len;
 
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	char etag_str[HTTP_SERVER_ETAG_LEN + 1];
+	const struct http_header etag_header = {
+		.name = "etag",
+		.value = etag_str,
+	};
+	uint32_t etag = http_server_static_etag(static_detail);
+
+	snprintk(etag_str, sizeof(etag_str), HTTP_SERVER_ETAG_FMT, etag);
+
+	if (http_server_etag_match(client, etag)) {
+		ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED,
+					 frame->stream_identifier, NULL,
+					 HTTP2_FLAG_END_STREAM, &etag_header, 1);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			goto out;
+		}
+
+		client->current_stream->headers_sent = true;
+		client->current_stream->end_stream_sent = true;
+
+		goto out;
+	}
+
+	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier,
+				 &static_detail->common, 0, &etag_header, 1);
+#else
 	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier,
 				 &static_detail->common, 0, NULL, 0);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		goto out;
@@ -376,13 +413,21 @@ static int handle_http2_static_resource(
 
 	client->current_stream->headers_sent = true;
 
-	ret = send_data_frame(client, content_200, content_len,
-			      frame->stream_identifier,
-			      HTTP2_FLAG_END_STREAM);
-	if (ret < 0) {
-		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
-	}
+	/* Peer has not been asked to accept larger frames than the default. */
+	do {
+		size_t frame_len = MIN(content_len, HTTP2_DEFAULT_MAX_FRAME_SIZE);
+
+		content_len -= frame_len;
+		ret = send_data_frame(client, content_200, frame_len,
+				      frame->stream_identifier,
+				      content_len == 0 ? HTTP2_FLAG_END_STREAM : 0);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			goto out;
+		}
+
+		content_200 += frame_len;
+	} while (content_len > 0);
 
 	client->current_stream->end_stream_sent = true;
 
@@ -405,10 +450,10 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.path_len = static_fs_detail->common.path_len,
 		.type = static_fs_detail->common.type,
 	};
-	bool gzipped;
+	const char *content_encoding;
+	size_t remaining;
+	size_t frame_len;
 	int len;
-	int remaining;
-	char tmp[64];
 
 	if (!(static_fs_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
 		return -ENOTSUP;
@@ -431,7 +476,8 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	}
 
 	/* open file, if it exists */
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len, &gzipped);
+	ret = http_server_find_file(fname, sizeof(fname), &client->data_len,
+				    client->accept_encoding, &content_encoding);
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 
@@ -452,9 +498,7 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	}
 
 	/* send headers */
-	if (gzipped) {
-		res_detail.content_encoding = "gzip";
-	}
+	res_detail.content_encoding = content_encoding;
 	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, &res_detail, 0,
 				 NULL, 0);
 	if (ret < 0) {
@@ -464,19 +508,26 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 
 	client->current_stream->headers_sent = true;
 
-	/* read and send file */
+	/* read and send file, with an output buffer the content is read
+	 * straight into it behind each frame header
+	 */
 	remaining = client->data_len;
-	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
+	do {
+		frame_len = MIN(remaining, CONFIG_HTTP_SERVER_STATIC_FS_CHUNK_SIZE);
+		remaining -= frame_len;
 
-		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
+		ret = send_data_frame(client, NULL, frame_len, frame->stream_identifier,
 				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
 		if (ret < 0) {
-			LOG_DBG("Cannot write to socket (%d)", ret);
 			goto out;
 		}
-	}
+
+		ret = http_server_send_file(client, &file, frame_len);
+		if (ret < 0) {
+			LOG_DBG("Cannot send file (%d)", ret);
+			goto out;
+		}
+	} while (remaining > 0);
 
 	client->current_stream->end_stream_sent = true;
 
@@ -594,7 +645,7 @@ static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detai
 		}
 	}
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_release_resource(dynamic_detail, client);
 
 	return ret;
 }
@@ -680,7 +731,7 @@ static int dynamic_post_req_v2(struct http_resource_detail_dynamic *dynamic_deta
 		}
 
 		client->current_stream->end_stream_sent = true;
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 	return ret;
@@ -703,7 +754,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -712,8 +763,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
@@ -826,6 +875,12 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 	}
 
 	client->current_stream = stream;
+	client->accept_encoding = 0;
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	client->has_if_none_match = false;
+	client->if_none_match_any = false;
+#endif
 
 	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_END_HEADERS)) {
 		client->expect_continuation = true;
@@ -1271,6 +1326,14 @@ static int process_header(struct http_client_ctx *client,
 		}
 
 		client->content_len = (size_t)len;
+	} else if (header->name_len == (sizeof("accept-encoding") - 1) &&
+		   memcmp(header->name, "accept-encoding", header->name_len) == 0) {
+		http_server_parse_accept_encoding(client, header->value, header->value_len);
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+	} else if (header->name_len == (sizeof("if-none-match") - 1) &&
+		   memcmp(header->name, "if-none-match", header->name_len) == 0) {
+		http_server_parse_if_none_match(client, header->value, header->value_len);
+#endif
 	} else {
 		/* Just ignore for now. */
 		LOG_DBG("Ignoring field %.*s", (int)header->name_len, header->name);
@@ -1357,7 +1420,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 		ret = dynamic_detail->cb(client, HTTP_SERVER_DATA_FINAL, NULL, 0, &response_ctx,
 					 dynamic_detail->user_data);
 		if (ret < 0) {
-			dynamic_detail->holder = NULL;
+			(void)http_server_release_resource(dynamic_detail, client);
 			goto out;
 		}
 
@@ -1366,7 +1429,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 
 		ret = http2_dynamic_response(client, frame, &response_ctx, HTTP_SERVER_DATA_FINAL,
 					     dynamic_detail);
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 
 		if (ret < 0) {
 			goto out;
@@ -1582,6 +1645,22 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		const size_t field_len = sizeof(struct http2_settings_field);
+
+		for (size_t i = 0; i + field_len <= frame->length; i += field_len) {
+			const uint8_t *field = client->cursor + i;
+
+			/* The encoder table must not outgrow the peer's decoder table. */
+			if (sys_get_be16(field) == HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+				http_hpack_dynamic_table_set_max_size(&client->hpack_table,
+								      sys_get_be32(field + 2));
+			}
+		}
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -192,6 +192,11 @@ struct lwm2m_engine_obj {
 	/* object list */
 	sys_snode_t node;
 
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	/* path index bucket */
+	sys_snode_t index_node;
+#endif
+
 	/* object field definitions */
 	struct lwm2m_engine_obj_field *fields;
 
@@ -412,6 +417,11 @@ struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
 
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	/* path index bucket */
+	sys_snode_t index_node;
+#endif
+
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
 
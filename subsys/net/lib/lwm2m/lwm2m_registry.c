@@ -94,6 +94,24 @@ sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
 sys_slist_t *lwm2m_engine_obj_inst_list(void) { return &engine_obj_inst_list; }
 
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+/* Objects and object instances are also kept in hash buckets keyed by their
+ * IDs, so that resolving a path does not walk every registered instance.
+ */
+static sys_slist_t obj_index[CONFIG_LWM2M_ENGINE_PATH_INDEX_BUCKETS];
+static sys_slist_t obj_inst_index[CONFIG_LWM2M_ENGINE_PATH_INDEX_BUCKETS];
+
+static inline sys_slist_t *obj_index_bucket(uint16_t obj_id)
+{
+	return &obj_index[obj_id % ARRAY_SIZE(obj_index)];
+}
+
+static inline sys_slist_t *obj_inst_index_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	return &obj_inst_index[((uint32_t)obj_id * 31U + obj_inst_id) % ARRAY_SIZE(obj_inst_index)];
+}
+#endif /* CONFIG_LWM2M_ENGINE_PATH_INDEX */
+
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 static void lwm2m_engine_cache_write(const struct lwm2m_engine_obj_field *obj_field,
 				     const struct lwm2m_obj_path *path, const void *value,
@@ -113,6 +131,9 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	sys_slist_append(obj_index_bucket(obj->obj_id), &obj->index_node);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +145,9 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	sys_slist_find_and_remove(obj_index_bucket(obj->obj_id), &obj->index_node);
+#endif
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,11 +155,23 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	if (obj_id < 0 || obj_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_index_bucket(obj_id), obj, index_node) {
+		if (obj->obj_id == obj_id) {
+			return obj;
+		}
+	}
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
 	}
+#endif
 
 	return NULL;
 }
@@ -145,6 +181,12 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Most objects list their fields in resource ID order, starting at 0 */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +218,10 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	sys_slist_append(obj_inst_index_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,17 +231,35 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	sys_slist_find_and_remove(obj_inst_index_bucket(obj_inst->obj->obj_id,
+							obj_inst->obj_inst_id),
+				  &obj_inst->index_node);
+#endif
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
+#if defined(CONFIG_LWM2M_ENGINE_PATH_INDEX)
+	if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_index_bucket(obj_id, obj_inst_id), obj_inst,
+				     index_node) {
+		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
+			return obj_inst;
+		}
+	}
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
 	}
+#endif
 
 	return NULL;
 }
@@ -395,10 +459,15 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
+	/* Resources are usually laid out in resource ID order as well */
+	if (path->res_id < oi->resource_count &&
+	    oi->resources[path->res_id].res_id == path->res_id) {
+		r = &oi->resources[path->res_id];
+	}
+
+	for (i = 0; r == NULL && i < oi->resource_count; i++) {
 		if (oi->resources[i].res_id == path->res_id) {
 			r = &oi->resources[i];
-			break;
 		}
 	}
 
@@ -412,10 +481,14 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < r->res_inst_count; i++) {
+	if (path->res_inst_id < r->res_inst_count &&
+	    r->res_instances[path->res_inst_id].res_inst_id == path->res_inst_id) {
+		ri = &r->res_instances[path->res_inst_id];
+	}
+
+	for (i = 0; ri == NULL && i < r->res_inst_count; i++) {
 		if (r->res_instances[i].res_inst_id == path->res_inst_id) {
 			ri = &r->res_instances[i];
-			break;
 		}
 	}
 
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <inttypes.h>
 #include <ctype.h>
 #include <time.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 
@@ -35,6 +36,29 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define SENML_MAX_NAME_SIZE sizeof("/65535/65535/")
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+struct cbor_out_fmt_data {
+	/* Fields of the record being formed, written out along with its value */
+	char basename[SENML_MAX_NAME_SIZE];
+	char name[SENML_MAX_NAME_SIZE];
+	uint8_t basename_len;
+	uint8_t name_len;
+	time_t bt;
+	int64_t t;
+	bool bn_present;
+	bool bt_present;
+	bool n_present;
+	bool t_present;
+
+	/* Basetime for Cached data timestamp */
+	time_t basetime;
+
+	/* Location of the SenML array head in the output buffer */
+	uint16_t array_offset;
+	uint8_t array_head_len;
+	uint16_t record_cnt;
+};
+#else
 struct cbor_out_fmt_data {
 	/* Data */
 	struct lwm2m_senml input;
@@ -56,6 +80,7 @@ struct cbor_out_fmt_data {
 		uint8_t objlnk_cnt;
 	};
 };
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
 
 struct cbor_in_fmt_data {
 	/* Decoded data */
@@ -98,9 +123,11 @@ static void setup_out_fmt_data(struct lwm2m_message *msg)
 
 	(void)memset(fd, 0, sizeof(*fd));
 	engine_set_out_user_data(&msg->out, fd);
-	fd->name_sz = SENML_MAX_NAME_SIZE;
 	fd->basetime = 0;
+#if !defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+	fd->name_sz = SENML_MAX_NAME_SIZE;
 	fd->objlnk_sz = sizeof("65535:65535");
+#endif
 }
 
 static void clear_out_fmt_data(struct lwm2m_message *msg)
@@ -127,6 +154,358 @@ static void clear_in_fmt_data(struct lwm2m_message *msg)
 	k_mutex_unlock(&fd_mtx);
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+/* Records are encoded straight into the output buffer, in the same canonical
+ * form as cbor_encode_lwm2m_senml() produces: definite length array and maps
+ * with the shortest heads, record fields in bn, bt, n, t, value order.
+ */
+
+#define CBOR_MAJOR_UINT 0
+#define CBOR_MAJOR_NINT 1
+#define CBOR_MAJOR_BSTR 2
+#define CBOR_MAJOR_TSTR 3
+#define CBOR_MAJOR_LIST 4
+#define CBOR_MAJOR_MAP  5
+
+#define CBOR_FALSE   0xF4
+#define CBOR_TRUE    0xF5
+#define CBOR_FLOAT64 0xFB
+
+/* SenML labels */
+#define SENML_KEY_BN 0x21 /* -2 */
+#define SENML_KEY_BT 0x22 /* -3 */
+#define SENML_KEY_N  0x00
+#define SENML_KEY_T  0x06
+#define SENML_KEY_VI 0x02
+#define SENML_KEY_VF 0x02
+#define SENML_KEY_VS 0x03
+#define SENML_KEY_VB 0x04
+#define SENML_KEY_VD 0x08
+
+/* Longest CBOR head: initial byte followed by a 64-bit argument */
+#define CBOR_HEAD_MAX_LEN 9
+
+/* Map head, bn, bt, n and t fields, value key and value head */
+#define RECORD_HEAD_MAX_LEN                                                                        \
+	(1 + 2 * (2 + SENML_MAX_NAME_SIZE) + 2 * (1 + CBOR_HEAD_MAX_LEN) + sizeof("vlo") +      \
+	 CBOR_HEAD_MAX_LEN)
+
+static uint8_t cbor_head_len(uint64_t value)
+{
+	if (value < 24) {
+		return 1;
+	} else if (value <= UINT8_MAX) {
+		return 2;
+	} else if (value <= UINT16_MAX) {
+		return 3;
+	} else if (value <= UINT32_MAX) {
+		return 5;
+	}
+
+	return 9;
+}
+
+/* Write a CBOR head of the given length, which must fit the value */
+static uint8_t cbor_put_head(uint8_t *buf, uint8_t major, uint64_t value, uint8_t len)
+{
+	switch (len) {
+	case 1:
+		buf[0] = (major << 5) | (uint8_t)value;
+		break;
+	case 2:
+		buf[0] = (major << 5) | 24;
+		buf[1] = (uint8_t)value;
+		break;
+	case 3:
+		buf[0] = (major << 5) | 25;
+		sys_put_be16((uint16_t)value, &buf[1]);
+		break;
+	case 5:
+		buf[0] = (major << 5) | 26;
+		sys_put_be32((uint32_t)value, &buf[1]);
+		break;
+	default:
+		buf[0] = (major << 5) | 27;
+		sys_put_be64(value, &buf[1]);
+		break;
+	}
+
+	return len;
+}
+
+static uint8_t cbor_put_uint(uint8_t *buf, uint8_t major, uint64_t value)
+{
+	return cbor_put_head(buf, major, value, cbor_head_len(value));
+}
+
+static uint8_t cbor_put_int(uint8_t *buf, int64_t value)
+{
+	if (value < 0) {
+		return cbor_put_uint(buf, CBOR_MAJOR_NINT, (uint64_t)(-(value + 1)));
+	}
+
+	return cbor_put_uint(buf, CBOR_MAJOR_UINT, (uint64_t)value);
+}
+
+static uint8_t cbor_put_tstr(uint8_t *buf, const char *str, size_t len)
+{
+	uint8_t head_len = cbor_put_uint(buf, CBOR_MAJOR_TSTR, len);
+
+	memcpy(buf + head_len, str, len);
+
+	return head_len + len;
+}
+
+/* Make room for the array head when the record count needs a longer one */
+static int grow_array_head(struct lwm2m_output_context *out, struct cbor_out_fmt_data *fd)
+{
+	uint8_t zeros[CBOR_HEAD_MAX_LEN] = { 0 };
+	uint8_t len;
+	int ret;
+
+	if (fd->array_head_len == 0) {
+		fd->array_offset = out->out_cpkt->offset;
+	}
+
+	len = cbor_head_len(fd->record_cnt + 1);
+	if (len <= fd->array_head_len) {
+		return 0;
+	}
+
+	ret = buf_insert(CPKT_BUF_WRITE(out->out_cpkt), fd->array_offset, zeros,
+			 len - fd->array_head_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	fd->array_head_len = len;
+
+	return 0;
+}
+
+/* Give back the room taken by grow_array_head() for a record that did not fit */
+static void shrink_array_head(struct lwm2m_output_context *out, struct cbor_out_fmt_data *fd,
+			      uint8_t len)
+{
+	uint8_t *head = out->out_cpkt->data + fd->array_offset;
+	uint8_t extra = fd->array_head_len - len;
+
+	if (extra == 0) {
+		return;
+	}
+
+	memmove(head + len, head + fd->array_head_len,
+		out->out_cpkt->offset - fd->array_offset - fd->array_head_len);
+	out->out_cpkt->offset -= extra;
+	fd->array_head_len = len;
+}
+
+static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t empty = (CBOR_MAJOR_LIST << 5); /* 80 # array(0) */
+	int ret;
+
+	if (fd->record_cnt == 0) {
+		ret = buf_append(CPKT_BUF_WRITE(out->out_cpkt), &empty, sizeof(empty));
+		if (ret < 0) {
+			return ret;
+		}
+
+		return sizeof(empty);
+	}
+
+	(void)cbor_put_head(out->out_cpkt->data + fd->array_offset, CBOR_MAJOR_LIST,
+			    fd->record_cnt, fd->array_head_len);
+
+	return out->out_cpkt->offset - fd->array_offset;
+}
+
+static int put_begin_oi(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t tmp = path->level;
+	int len;
+
+	/* In case path level is set to 'none' or 'object' and we have only default oi */
+	path->level = LWM2M_PATH_LEVEL_OBJECT_INST;
+
+	len = path_to_string(fd->basename, sizeof(fd->basename), path,
+			     LWM2M_PATH_LEVEL_OBJECT_INST);
+	path->level = tmp;
+
+	if (len < 0) {
+		return len;
+	}
+
+	if ((len < sizeof("/0/0") - 1) || (len >= SENML_MAX_NAME_SIZE)) {
+		__ASSERT_NO_MSG(false);
+		return -EINVAL;
+	}
+
+	fd->basename_len = len;
+	fd->bn_present = true;
+
+	return 0;
+}
+
+static int put_begin_r(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	int len;
+
+	/* Write resource name */
+	len = snprintk(fd->name, sizeof(fd->name), "%" PRIu16 "", path->res_id);
+
+	if (len < sizeof("0") - 1) {
+		__ASSERT_NO_MSG(false);
+		return -EINVAL;
+	}
+
+	fd->name_len = len;
+	fd->n_present = true;
+
+	return 0;
+}
+
+static int put_begin_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	int len;
+
+	/* Forms name from resource id and resource instance id */
+	len = snprintk(fd->name, sizeof(fd->name), "%" PRIu16 "/%" PRIu16 "", path->res_id,
+		       path->res_inst_id);
+
+	if (len < sizeof("0/0") - 1) {
+		__ASSERT_NO_MSG(false);
+		return -EINVAL;
+	}
+
+	fd->name_len = len;
+	fd->n_present = true;
+
+	return 0;
+}
+
+static int put_data_timestamp(struct lwm2m_output_context *out, time_t value)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+
+	if (fd->basetime) {
+		fd->t = value - fd->basetime;
+		fd->t_present = true;
+	} else {
+		fd->basetime = value;
+		fd->bt = value;
+		fd->bt_present = true;
+	}
+
+	return 0;
+}
+
+static int put_name_nth_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	int ret = 0;
+
+	/* With the first ri the resource name (and ri name) are already in place*/
+	if (path->res_inst_id > 0) {
+		ret = put_begin_ri(out, path);
+	} else if (fd->t_present) {
+		/* Name need to be add for each time serialized record */
+		ret = put_begin_r(out, path);
+	}
+
+	return ret;
+}
+
+/* Write the record formed so far, completed with the given value */
+static int put_record(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
+		      const uint8_t *key, size_t key_len, const uint8_t *head, size_t head_len,
+		      const void *data, size_t data_len)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t buf[RECORD_HEAD_MAX_LEN];
+	uint8_t prev_array_head_len = fd->array_head_len;
+	uint16_t start;
+	size_t len = 0;
+	int ret;
+
+	ret = put_name_nth_ri(out, path);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = grow_array_head(out, fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += cbor_put_uint(&buf[len], CBOR_MAJOR_MAP,
+			     fd->bn_present + fd->bt_present + fd->n_present + fd->t_present + 1);
+
+	if (fd->bn_present) {
+		buf[len++] = SENML_KEY_BN;
+		len += cbor_put_tstr(&buf[len], fd->basename, fd->basename_len);
+	}
+
+	if (fd->bt_present) {
+		buf[len++] = SENML_KEY_BT;
+		len += cbor_put_int(&buf[len], fd->bt);
+	}
+
+	if (fd->n_present) {
+		buf[len++] = SENML_KEY_N;
+		len += cbor_put_tstr(&buf[len], fd->name, fd->name_len);
+	}
+
+	if (fd->t_present) {
+		buf[len++] = SENML_KEY_T;
+		len += cbor_put_int(&buf[len], fd->t);
+	}
+
+	memcpy(&buf[len], key, key_len);
+	len += key_len;
+	memcpy(&buf[len], head, head_len);
+	len += head_len;
+
+	start = out->out_cpkt->offset;
+
+	ret = buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, len);
+	if (ret == 0 && data_len > 0) {
+		ret = buf_append(CPKT_BUF_WRITE(out->out_cpkt), data, data_len);
+	}
+
+	if (ret < 0) {
+		/* Leave the output as it was, so that put_end() writes the
+		 * shortest array head for the records already in place.
+		 */
+		out->out_cpkt->offset = start;
+		shrink_array_head(out, fd, prev_array_head_len);
+		return ret;
+	}
+
+	/* Consume the record */
+	fd->bn_present = false;
+	fd->bt_present = false;
+	fd->n_present = false;
+	fd->t_present = false;
+	fd->record_cnt++;
+
+	return 0;
+}
+
+static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int64_t value)
+{
+	const uint8_t key = SENML_KEY_VI;
+	uint8_t head[CBOR_HEAD_MAX_LEN];
+
+	return put_record(out, path, &key, sizeof(key), head, cbor_put_int(head, value), NULL, 0);
+}
+
+#else /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
+
 static int fmt_range_check(struct cbor_out_fmt_data *fd)
 {
 	if (fd->name_cnt >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
@@ -379,6 +758,8 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	return 0;
 }
 
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
+
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
 {
 	return put_value(out, path, value);
@@ -399,6 +780,72 @@ static int put_s64(struct lwm2m_output_context *out, struct lwm2m_obj_path *path
 	return put_value(out, path, value);
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, time_t value)
+{
+	return put_value(out, path, (int64_t)value);
+}
+
+static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
+{
+	const uint8_t key = SENML_KEY_VF;
+	uint8_t head[1 + sizeof(uint64_t)] = { CBOR_FLOAT64 };
+	uint64_t bits;
+
+	memcpy(&bits, value, sizeof(bits));
+	sys_put_be64(bits, &head[1]);
+
+	return put_record(out, path, &key, sizeof(key), head, sizeof(head), NULL, 0);
+}
+
+static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
+		      size_t buflen)
+{
+	const uint8_t key = SENML_KEY_VS;
+	uint8_t head[CBOR_HEAD_MAX_LEN];
+
+	return put_record(out, path, &key, sizeof(key), head,
+			  cbor_put_uint(head, CBOR_MAJOR_TSTR, buflen), buf, buflen);
+}
+
+static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
+{
+	const uint8_t key = SENML_KEY_VB;
+	const uint8_t head = value ? CBOR_TRUE : CBOR_FALSE;
+
+	return put_record(out, path, &key, sizeof(key), &head, sizeof(head), NULL, 0);
+}
+
+static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
+		      size_t buflen)
+{
+	const uint8_t key = SENML_KEY_VD;
+	uint8_t head[CBOR_HEAD_MAX_LEN];
+
+	return put_record(out, path, &key, sizeof(key), head,
+			  cbor_put_uint(head, CBOR_MAJOR_BSTR, buflen), buf, buflen);
+}
+
+static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
+		      struct lwm2m_objlnk *value)
+{
+	const uint8_t key[] = { (CBOR_MAJOR_TSTR << 5) | 3, 'v', 'l', 'o' };
+	char objlnk[sizeof("65535:65535")];
+	uint8_t head[CBOR_HEAD_MAX_LEN];
+	int len;
+
+	/* Format object link */
+	len = snprintk(objlnk, sizeof(objlnk), "%u:%u", value->obj_id, value->obj_inst);
+	if (len < 0) {
+		return -EINVAL;
+	}
+
+	return put_record(out, path, key, sizeof(key), head,
+			  cbor_put_uint(head, CBOR_MAJOR_TSTR, len), objlnk, len);
+}
+
+#else /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
+
 static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, time_t value)
 {
 	int ret = put_name_nth_ri(out, path);
@@ -531,6 +978,7 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 
 	return 0;
 }
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
 
 static int get_opaque(struct lwm2m_input_context *in,
 			 uint8_t *value, size_t buflen,
@@ -25,6 +25,10 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE)) {
+		mqtt_tx_queue_reset(client);
+	}
 }
 
 /** @brief Initialize tx buffer. */
@@ -132,7 +136,24 @@ static int client_write(struct mqtt_client *client, const uint8_t *data,
 
 	NET_DBG("[%p]: Transport writing %d bytes.", client, datalen);
 
-	err_code = mqtt_transport_write(client, data, datalen);
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE)) {
+		struct iovec io_vector = {
+			.iov_base = (void *)data,
+			.iov_len = datalen,
+		};
+		struct msghdr msg = {
+			.msg_iov = &io_vector,
+			.msg_iovlen = 1,
+		};
+
+		/* Control packets go out right away, behind anything
+		 * queued before them.
+		 */
+		err_code = mqtt_tx_queue_write_msg(client, &msg, true);
+	} else {
+		err_code = mqtt_transport_write(client, data, datalen);
+	}
+
 	if (err_code < 0) {
 		NET_ERR("Transport write failed, err_code = %d, "
 			 "closing connection", err_code);
@@ -153,7 +174,12 @@ static int client_write_msg(struct mqtt_client *client,
 
 	NET_DBG("[%p]: Transport writing message.", client);
 
-	err_code = mqtt_transport_write_msg(client, message);
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE)) {
+		err_code = mqtt_tx_queue_write_msg(client, message, false);
+	} else {
+		err_code = mqtt_transport_write_msg(client, message);
+	}
+
 	if (err_code < 0) {
 		NET_ERR("Transport write failed, err_code = %d, "
 			 "closing connection", err_code);
@@ -167,6 +193,34 @@ static int client_write_msg(struct mqtt_client *client,
 	return 0;
 }
 
+static int client_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	err_code = mqtt_tx_queue_flush(client);
+	if (err_code < 0) {
+		NET_ERR("Transport write failed, err_code = %d, "
+			 "closing connection", err_code);
+		client_disconnect(client, err_code, true);
+	}
+
+	return err_code;
+}
+
+static int client_retransmit(struct mqtt_client *client)
+{
+	int err_code;
+
+	err_code = mqtt_inflight_retransmit(client, false);
+	if (err_code < 0) {
+		NET_ERR("Retransmission failed, err_code = %d, "
+			 "closing connection", err_code);
+		client_disconnect(client, err_code, true);
+	}
+
+	return err_code;
+}
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -266,15 +320,42 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
-
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) &&
+	    param->message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE) {
+		const uint8_t *data;
+		size_t len;
+
+		/* Send the copy kept for retransmission. */
+		err_code = mqtt_inflight_store(client, param, packet.cur,
+					       packet.end - packet.cur,
+					       &data, &len);
+		if (err_code == -EBUSY && IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE)) {
+			/* Let queued messages out, so they can be acknowledged. */
+			int flush_err = client_flush(client);
+
+			if (flush_err < 0) {
+				err_code = flush_err;
+			}
+		}
+
+		if (err_code < 0) {
+			goto error;
+		}
+
+		io_vector[0].iov_base = (void *)data;
+		io_vector[0].iov_len = len;
+		msg.msg_iovlen = 1;
+	} else {
+		io_vector[0].iov_base = packet.cur;
+		io_vector[0].iov_len = packet.end - packet.cur;
+		io_vector[1].iov_base = param->message.payload.data;
+		io_vector[1].iov_len = param->message.payload.len;
+		msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	}
 
 	err_code = client_write_msg(client, &msg);
 
@@ -382,6 +463,12 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 		goto error;
 	}
 
+	/* Already released by the inflight window. */
+	if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) &&
+	    mqtt_inflight_released(client, param->message_id)) {
+		goto error;
+	}
+
 	err_code = publish_release_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -609,8 +696,22 @@ int mqtt_live(struct mqtt_client *client)
 		ping_sent = true;
 	}
 
+	if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) && err_code == 0 &&
+	    MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		err_code = client_retransmit(client);
+	}
+
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE) && err_code == 0 &&
+	    MQTT_HAS_STATE(client, MQTT_STATE_TCP_CONNECTED)) {
+		err_code = client_flush(client);
+	}
+
 	mqtt_mutex_unlock(client);
 
+	if (err_code < 0) {
+		return err_code;
+	}
+
 	if (ping_sent) {
 		return err_code;
 	} else {
@@ -618,7 +719,7 @@ int mqtt_live(struct mqtt_client *client)
 	}
 }
 
-int mqtt_keepalive_time_left(const struct mqtt_client *client)
+static int keepalive_time_left(const struct mqtt_client *client)
 {
 	uint32_t elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
@@ -636,6 +737,27 @@ int mqtt_keepalive_time_left(const struct mqtt_client *client)
 	return keepalive_ms - elapsed_time;
 }
 
+int mqtt_keepalive_time_left(const struct mqtt_client *client)
+{
+	int time_left = keepalive_time_left(client);
+
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE) &&
+	    mqtt_tx_queue_pending(client)) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT)) {
+		int retransmit_left = mqtt_inflight_time_left(client);
+
+		if (retransmit_left >= 0 &&
+		    (time_left < 0 || retransmit_left < time_left)) {
+			time_left = retransmit_left;
+		}
+	}
+
+	return time_left;
+}
+
 int mqtt_input(struct mqtt_client *client)
 {
 	int err_code = 0;
@@ -652,6 +774,37 @@ int mqtt_input(struct mqtt_client *client)
 		err_code = -ENOTCONN;
 	}
 
+	/* Write out anything queued so far, including acknowledgments
+	 * generated while handling the received packet.
+	 */
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE) && err_code == 0 &&
+	    MQTT_HAS_STATE(client, MQTT_STATE_TCP_CONNECTED)) {
+		err_code = client_flush(client);
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_flush(struct mqtt_client *client)
+{
+	int err_code = 0;
+
+	NULL_PARAM_CHECK(client);
+
+	if (!IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE)) {
+		return 0;
+	}
+
+	mqtt_mutex_lock(client);
+
+	if (MQTT_HAS_STATE(client, MQTT_STATE_TCP_CONNECTED)) {
+		err_code = client_flush(client);
+	} else {
+		err_code = -ENOTCONN;
+	}
+
 	mqtt_mutex_unlock(client);
 
 	return err_code;
@@ -393,6 +393,88 @@ int subscribe_ack_decode(struct buf_ctx *buf,
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param);
 
+/**@brief Write out the packets waiting in the outbound queue.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_tx_queue_flush(struct mqtt_client *client);
+
+/**@brief Append a packet to the outbound queue.
+ *
+ * @details The queue is flushed first if the packet does not fit, and packets
+ *          larger than the queue are written to the transport directly.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] message Packet to append.
+ * @param[in] flush Write out the queue once the packet has been appended.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_tx_queue_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message, bool flush);
+
+/**@brief Drop the packets waiting in the outbound queue. */
+void mqtt_tx_queue_reset(struct mqtt_client *client);
+
+/**@brief Check if any packets wait in the outbound queue. */
+bool mqtt_tx_queue_pending(const struct mqtt_client *client);
+
+/**@brief Store a QoS 1 or QoS 2 PUBLISH packet in the inflight window.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] param Publish parameters, including the payload.
+ * @param[in] hdr Encoded fixed and variable header of the packet.
+ * @param[in] hdr_len Length of the encoded header.
+ * @param[out] data Stored packet, to be sent by the caller.
+ * @param[out] len Length of the stored packet.
+ *
+ * @retval 0 if the procedure is successful.
+ * @retval -EBUSY if the inflight window is full.
+ * @retval -EMSGSIZE if the packet does not fit a slot of the window.
+ */
+int mqtt_inflight_store(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			const uint8_t *hdr, size_t hdr_len,
+			const uint8_t **data, size_t *len);
+
+/**@brief Update the inflight window on PUBACK, PUBREC or PUBCOMP.
+ *
+ * @details PUBREC is answered with PUBREL, which is then kept in the window
+ *          until PUBCOMP arrives.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] type Type of the received packet.
+ * @param[in] message_id Message id carried by the received packet.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id);
+
+/**@brief Check if the library already sent PUBREL for the message. */
+bool mqtt_inflight_released(const struct mqtt_client *client,
+			    uint16_t message_id);
+
+/**@brief Send the tracked messages again.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] all Resend all messages, not only those past the retransmission
+ *                timeout.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_retransmit(struct mqtt_client *client, bool all);
+
+/**@brief Time in milliseconds until the next retransmission, or -1 if none is
+ *        scheduled.
+ */
+int mqtt_inflight_time_left(const struct mqtt_client *client);
+
+/**@brief Forget all tracked messages. */
+void mqtt_inflight_reset(struct mqtt_client *client);
+
 #ifdef __cplusplus
 }
 #endif
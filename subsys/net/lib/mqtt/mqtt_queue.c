@@ -0,0 +1,366 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file mqtt_queue.c
+ *
+ * @brief MQTT outbound queue and QoS 1/QoS 2 inflight window.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_mqtt_queue, CONFIG_MQTT_LOG_LEVEL);
+
+#include "mqtt_internal.h"
+#include "mqtt_transport.h"
+#include "mqtt_os.h"
+
+#if defined(CONFIG_MQTT_LIB_TX_QUEUE)
+
+int mqtt_tx_queue_flush(struct mqtt_client *client)
+{
+	uint32_t len = client->internal.tx_queue_len;
+	int err_code;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	NET_DBG("[%p]: Flushing %u queued bytes.", client, len);
+
+	client->internal.tx_queue_len = 0U;
+
+	err_code = mqtt_transport_write(client, client->internal.tx_queue, len);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+int mqtt_tx_queue_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message, bool flush)
+{
+	size_t len = 0;
+	int err_code;
+
+	for (size_t i = 0; i < message->msg_iovlen; i++) {
+		len += message->msg_iov[i].iov_len;
+	}
+
+	if (client->internal.tx_queue_len + len >
+	    sizeof(client->internal.tx_queue)) {
+		err_code = mqtt_tx_queue_flush(client);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	if (len > sizeof(client->internal.tx_queue)) {
+		/* Too big to be queued, the queue is empty at this point. */
+		err_code = mqtt_transport_write_msg(client, message);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+		return 0;
+	}
+
+	for (size_t i = 0; i < message->msg_iovlen; i++) {
+		memcpy(client->internal.tx_queue + client->internal.tx_queue_len,
+		       message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+		client->internal.tx_queue_len += message->msg_iov[i].iov_len;
+	}
+
+	if (flush) {
+		return mqtt_tx_queue_flush(client);
+	}
+
+	return 0;
+}
+
+void mqtt_tx_queue_reset(struct mqtt_client *client)
+{
+	client->internal.tx_queue_len = 0U;
+}
+
+bool mqtt_tx_queue_pending(const struct mqtt_client *client)
+{
+	return client->internal.tx_queue_len > 0U;
+}
+
+#endif /* CONFIG_MQTT_LIB_TX_QUEUE */
+
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+
+/**@brief Acknowledgment a tracked message waits for. */
+enum mqtt_inflight_state {
+	MQTT_INFLIGHT_FREE = 0,
+	MQTT_INFLIGHT_AWAIT_PUBACK,
+	MQTT_INFLIGHT_AWAIT_PUBREC,
+	MQTT_INFLIGHT_AWAIT_PUBCOMP,
+};
+
+#define RETRANSMIT_TIMEOUT CONFIG_MQTT_LIB_INFLIGHT_RETRANSMIT_TIMEOUT
+
+static struct mqtt_inflight_msg *inflight_find(struct mqtt_client *client,
+					       uint16_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		struct mqtt_inflight_msg *msg = &client->internal.inflight[i];
+
+		if (msg->state != MQTT_INFLIGHT_FREE &&
+		    msg->message_id == message_id) {
+			return msg;
+		}
+	}
+
+	return NULL;
+}
+
+static int inflight_send(struct mqtt_client *client,
+			 struct mqtt_inflight_msg *msg)
+{
+	msg->timestamp = mqtt_sys_tick_in_ms_get();
+
+#if defined(CONFIG_MQTT_LIB_TX_QUEUE)
+	struct iovec io_vector = {
+		.iov_base = msg->data,
+		.iov_len = msg->len,
+	};
+	struct msghdr message = {
+		.msg_iov = &io_vector,
+		.msg_iovlen = 1,
+	};
+
+	/* Queued packets are written out by mqtt_input() and mqtt_live(). */
+	return mqtt_tx_queue_write_msg(client, &message, false);
+#else
+	int err_code;
+
+	err_code = mqtt_transport_write(client, msg->data, msg->len);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	client->internal.last_activity = msg->timestamp;
+
+	return 0;
+#endif
+}
+
+int mqtt_inflight_store(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			const uint8_t *hdr, size_t hdr_len,
+			const uint8_t **data, size_t *len)
+{
+	size_t payload_len = param->message.payload.len;
+	struct mqtt_inflight_msg *msg;
+
+	if (hdr_len + payload_len > sizeof(msg->data)) {
+		NET_ERR("[%p]: PUBLISH of %zu bytes exceeds inflight slot size.",
+			client, hdr_len + payload_len);
+		return -EMSGSIZE;
+	}
+
+	/* A message id still in the window is a retransmission by the
+	 * application, reuse its slot.
+	 */
+	msg = inflight_find(client, param->message_id);
+	if (msg == NULL) {
+		for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+			if (client->internal.inflight[i].state == MQTT_INFLIGHT_FREE) {
+				msg = &client->internal.inflight[i];
+				break;
+			}
+		}
+	}
+
+	if (msg == NULL) {
+		return -EBUSY;
+	}
+
+	memcpy(msg->data, hdr, hdr_len);
+	if (payload_len > 0) {
+		memcpy(msg->data + hdr_len, param->message.payload.data,
+		       payload_len);
+	}
+
+	msg->message_id = param->message_id;
+	msg->len = hdr_len + payload_len;
+	msg->timestamp = mqtt_sys_tick_in_ms_get();
+	msg->state = (param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) ?
+		     MQTT_INFLIGHT_AWAIT_PUBACK : MQTT_INFLIGHT_AWAIT_PUBREC;
+
+	*data = msg->data;
+	*len = msg->len;
+
+	return 0;
+}
+
+static int inflight_release(struct mqtt_client *client,
+			    struct mqtt_inflight_msg *msg)
+{
+	const struct mqtt_pubrel_param param = {
+		.message_id = msg->message_id,
+	};
+	struct buf_ctx packet = {
+		.cur = msg->data,
+		.end = msg->data + sizeof(msg->data),
+	};
+	int err_code;
+
+	/* The PUBLISH is acknowledged, keep the PUBREL for retransmission
+	 * instead.
+	 */
+	err_code = publish_release_encode(&param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	msg->len = packet.end - packet.cur;
+	memmove(msg->data, packet.cur, msg->len);
+	msg->state = MQTT_INFLIGHT_AWAIT_PUBCOMP;
+
+	return inflight_send(client, msg);
+}
+
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id)
+{
+	struct mqtt_inflight_msg *msg;
+
+	msg = inflight_find(client, message_id);
+	if (msg == NULL) {
+		NET_DBG("[%p]: Message id 0x%04x not in inflight window.",
+			client, message_id);
+		return 0;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (msg->state == MQTT_INFLIGHT_AWAIT_PUBACK) {
+			msg->state = MQTT_INFLIGHT_FREE;
+		}
+
+		break;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		if (msg->state == MQTT_INFLIGHT_AWAIT_PUBREC) {
+			return inflight_release(client, msg);
+		}
+
+		/* Duplicate PUBREC, our PUBREL was likely lost. */
+		if (msg->state == MQTT_INFLIGHT_AWAIT_PUBCOMP) {
+			return inflight_send(client, msg);
+		}
+
+		break;
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (msg->state == MQTT_INFLIGHT_AWAIT_PUBCOMP) {
+			msg->state = MQTT_INFLIGHT_FREE;
+		}
+
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+bool mqtt_inflight_released(const struct mqtt_client *client,
+			    uint16_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		const struct mqtt_inflight_msg *msg = &client->internal.inflight[i];
+
+		if (msg->state == MQTT_INFLIGHT_AWAIT_PUBCOMP &&
+		    msg->message_id == message_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int mqtt_inflight_retransmit(struct mqtt_client *client, bool all)
+{
+	int err_code;
+
+	if (!all && RETRANSMIT_TIMEOUT == 0) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		struct mqtt_inflight_msg *msg = &client->internal.inflight[i];
+
+		if (msg->state == MQTT_INFLIGHT_FREE) {
+			continue;
+		}
+
+		if (!all && mqtt_elapsed_time_in_ms_get(msg->timestamp) <
+			    RETRANSMIT_TIMEOUT) {
+			continue;
+		}
+
+		NET_DBG("[%p]: Retransmitting message id 0x%04x.", client,
+			msg->message_id);
+
+		if (msg->state != MQTT_INFLIGHT_AWAIT_PUBCOMP) {
+			msg->data[0] |= MQTT_HEADER_DUP_MASK;
+		}
+
+		err_code = inflight_send(client, msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	return 0;
+}
+
+int mqtt_inflight_time_left(const struct mqtt_client *client)
+{
+	int time_left = -1;
+
+	if (RETRANSMIT_TIMEOUT == 0) {
+		return -1;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		const struct mqtt_inflight_msg *msg = &client->internal.inflight[i];
+		uint32_t elapsed;
+		int left;
+
+		if (msg->state == MQTT_INFLIGHT_FREE) {
+			continue;
+		}
+
+		elapsed = mqtt_elapsed_time_in_ms_get(msg->timestamp);
+		left = (elapsed >= RETRANSMIT_TIMEOUT) ?
+		       0 : RETRANSMIT_TIMEOUT - elapsed;
+
+		if (time_left < 0 || left < time_left) {
+			time_left = left;
+		}
+	}
+
+	return time_left;
+}
+
+void mqtt_inflight_reset(struct mqtt_client *client)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(client->internal.inflight); i++) {
+		client->internal.inflight[i].state = MQTT_INFLIGHT_FREE;
+	}
+}
+
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
@@ -16,6 +16,21 @@ LOG_MODULE_REGISTER(net_mqtt_rx, CONFIG_MQTT_LOG_LEVEL);
  * @brief MQTT Received data handling.
  */
 
+static int inflight_resume(struct mqtt_client *client,
+			   const struct mqtt_connack_param *connack)
+{
+	/* A resumed session expects unacknowledged PUBLISH and PUBREL
+	 * packets to be sent again, a new one knows nothing about them.
+	 */
+	if (connack->session_present_flag) {
+		return mqtt_inflight_retransmit(client, true);
+	}
+
+	mqtt_inflight_reset(client);
+
+	return 0;
+}
+
 static int mqtt_handle_packet(struct mqtt_client *client,
 			      uint8_t type_and_flags,
 			      uint32_t var_length,
@@ -42,6 +57,11 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+				if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT)) {
+					err_code = inflight_resume(
+						client, &evt.param.connack);
+				}
 			} else {
 				err_code = -ECONNREFUSED;
 			}
@@ -77,6 +97,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) && err_code == 0) {
+			err_code = mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBACK,
+						     evt.param.puback.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -85,6 +111,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBREC;
 		err_code = publish_receive_decode(buf, &evt.param.pubrec);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) && err_code == 0) {
+			err_code = mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBREC,
+						     evt.param.pubrec.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -101,6 +133,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+		if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT) && err_code == 0) {
+			err_code = mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBCOMP,
+						     evt.param.pubcomp.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
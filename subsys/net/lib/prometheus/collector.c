@@ -42,6 +42,30 @@ int prometheus_collector_register_metric(struct prometheus_collector *collector,
 	return -ENOMEM;
 }
 
+int prometheus_collector_set_scrape_cb(struct prometheus_collector *collector,
+				       prometheus_scrape_cb_t cb, void *user_data)
+{
+	if (!collector) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	collector->user_data = user_data;
+	collector->scrape_cb = cb;
+
+	return 0;
+}
+
+prometheus_scrape_cb_t prometheus_collector_get_scrape_cb(
+	const struct prometheus_collector *collector)
+{
+	if (!collector) {
+		return NULL;
+	}
+
+	return collector->scrape_cb;
+}
+
 const struct prometheus_counter *prometheus_get_counter_metric(const char *name)
 {
 	STRUCT_SECTION_FOREACH(prometheus_counter, entry) {
@@ -14,15 +14,113 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_counter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-int prometheus_counter_inc(struct prometheus_counter *counter)
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+/* Each CPU adds to its own shard, the lock only ever contends with a scrape or
+ * with a thread that migrated between picking the shard and taking the lock.
+ */
+static inline struct prometheus_counter_shard *counter_shard(struct prometheus_counter *counter)
 {
+	return &counter->shards[arch_curr_cpu()->id];
+}
+
+int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
+{
+	struct prometheus_counter_shard *shard;
+	k_spinlock_key_t key;
+
 	if (!counter) {
 		return -EINVAL;
 	}
 
-	if (counter) {
-		counter->value++;
+	shard = counter_shard(counter);
+
+	key = k_spin_lock(&shard->lock);
+	shard->value += value;
+	k_spin_unlock(&shard->lock, key);
+
+	return 0;
+}
+
+int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
+{
+	if (!counter) {
+		return -EINVAL;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(counter->shards); i++) {
+		struct prometheus_counter_shard *shard = &counter->shards[i];
+		k_spinlock_key_t key = k_spin_lock(&shard->lock);
+
+		shard->value = (i == 0) ? value : 0;
+		k_spin_unlock(&shard->lock, key);
 	}
 
 	return 0;
 }
+
+uint64_t prometheus_counter_get(struct prometheus_counter *counter)
+{
+	uint64_t value = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(counter->shards); i++) {
+		struct prometheus_counter_shard *shard = &counter->shards[i];
+		k_spinlock_key_t key = k_spin_lock(&shard->lock);
+
+		value += shard->value;
+		k_spin_unlock(&shard->lock, key);
+	}
+
+	return value;
+}
+#else
+/* A 64-bit value cannot be updated with a native word atomic on 32-bit
+ * targets, so the update is done under a spinlock, which is no more than an
+ * interrupt lock on uniprocessor systems.
+ */
+int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
+{
+	k_spinlock_key_t key;
+
+	if (!counter) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&counter->lock);
+	counter->value += value;
+	k_spin_unlock(&counter->lock, key);
+
+	return 0;
+}
+
+int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
+{
+	k_spinlock_key_t key;
+
+	if (!counter) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&counter->lock);
+	counter->value = value;
+	k_spin_unlock(&counter->lock, key);
+
+	return 0;
+}
+
+uint64_t prometheus_counter_get(struct prometheus_counter *counter)
+{
+	k_spinlock_key_t key;
+	uint64_t value;
+
+	key = k_spin_lock(&counter->lock);
+	value = counter->value;
+	k_spin_unlock(&counter->lock, key);
+
+	return value;
+}
+#endif /* CONFIG_PROMETHEUS_PERCPU_METRICS */
+
+int prometheus_counter_inc(struct prometheus_counter *counter)
+{
+	return prometheus_counter_add(counter, 1);
+}
@@ -12,7 +12,6 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/counter.h>
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <stddef.h>
@@ -23,214 +22,256 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+/* Lines of a metric are numbered HELP, TYPE and then one per sample */
+enum {
+	LINE_HELP,
+	LINE_TYPE,
+	LINE_SAMPLES,
+};
+
+static const char *metric_type_str(enum prometheus_metric_type type)
 {
-	/* helper function to write formatted metric to buffer */
-	va_list args;
-	size_t len = strlen(buffer);
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
+	default:
+		return "untyped";
+	}
+}
 
-	if (len >= buffer_size) {
-		return -ENOMEM;
+/* Read the values of the metric once, while writing its TYPE line, so that
+ * the sum and the count lines of a histogram or a summary are consistent even
+ * when observations keep coming in while the metric is being sent.
+ */
+static int take_snapshot(struct prometheus_format_ctx *ctx, const struct prometheus_metric *metric)
+{
+	ctx->entry = prometheus_collector_get_metric(ctx->collector, metric->name);
+	if (ctx->entry == NULL) {
+		return -EINVAL;
 	}
-	buffer += len;
-	buffer_size -= len;
 
-	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
-	va_end(args);
-	if (len >= buffer_size) {
-		return -ENOMEM;
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER:
+		ctx->snapshot.counter =
+			prometheus_counter_get((struct prometheus_counter *)ctx->entry);
+		LOG_DBG("counter->value: %llu", (unsigned long long)ctx->snapshot.counter);
+		break;
+	case PROMETHEUS_GAUGE:
+		ctx->snapshot.gauge = prometheus_gauge_get((struct prometheus_gauge *)ctx->entry);
+		LOG_DBG("gauge->value: %f", ctx->snapshot.gauge);
+		break;
+	case PROMETHEUS_HISTOGRAM:
+		prometheus_histogram_get((struct prometheus_histogram *)ctx->entry,
+					 &ctx->snapshot.observed.sum,
+					 &ctx->snapshot.observed.count);
+		LOG_DBG("histogram->count: %lu", ctx->snapshot.observed.count);
+		break;
+	case PROMETHEUS_SUMMARY:
+		prometheus_summary_get((struct prometheus_summary *)ctx->entry,
+				       &ctx->snapshot.observed.sum, &ctx->snapshot.observed.count);
+		LOG_DBG("summary->count: %lu", ctx->snapshot.observed.count);
+		break;
+	default:
+		/* should not happen */
+		LOG_ERR("Unsupported metric type %d", metric->type);
+		return -EINVAL;
 	}
 
 	return 0;
 }
 
-int prometheus_format_exposition(const struct prometheus_collector *collector, char *buffer,
-				 size_t buffer_size)
+/* Format sample line number n of a metric. Returns the length of the line as
+ * snprintf() does, or -ENOENT once the metric has no more samples.
+ */
+static int format_sample(const struct prometheus_format_ctx *ctx,
+			 const struct prometheus_metric *metric, size_t n, char *buffer,
+			 size_t buffer_size)
 {
-	int ret;
-	int written = 0;
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER:
+		if (metric->num_labels == 0 && n == 0) {
+			return snprintf(buffer, buffer_size, "%s %llu\n", metric->name,
+					(unsigned long long)ctx->snapshot.counter);
+		}
 
-	if (collector == NULL || buffer == NULL || buffer_size == 0) {
-		LOG_ERR("Invalid arguments");
-		return -EINVAL;
+		if (n < metric->num_labels) {
+			return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %llu\n", metric->name,
+					metric->labels[n].key, metric->labels[n].value,
+					(unsigned long long)ctx->snapshot.counter);
+		}
+
+		return -ENOENT;
+	case PROMETHEUS_GAUGE:
+		if (metric->num_labels == 0 && n == 0) {
+			return snprintf(buffer, buffer_size, "%s %f\n", metric->name,
+					ctx->snapshot.gauge);
+		}
+
+		if (n < metric->num_labels) {
+			return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %f\n", metric->name,
+					metric->labels[n].key, metric->labels[n].value,
+					ctx->snapshot.gauge);
+		}
+
+		return -ENOENT;
+	case PROMETHEUS_HISTOGRAM: {
+		const struct prometheus_histogram *histogram = ctx->entry;
+
+		if (n < histogram->num_buckets) {
+			return snprintf(buffer, buffer_size, "%s_bucket{le=\"%f\"} %lu\n",
+					metric->name, histogram->buckets[n].upper_bound,
+					(unsigned long)atomic_get(
+						(const atomic_t *)&histogram->buckets[n].count));
+		}
+
+		n -= histogram->num_buckets;
+		break;
+	}
+	case PROMETHEUS_SUMMARY: {
+		const struct prometheus_summary *summary = ctx->entry;
+
+		if (n < summary->num_quantiles) {
+			return snprintf(buffer, buffer_size, "%s{%s=\"%f\"} %f\n", metric->name,
+					"quantile", summary->quantiles[n].quantile,
+					summary->quantiles[n].value);
+		}
+
+		n -= summary->num_quantiles;
+		break;
+	}
+	default:
+		return -ENOENT;
 	}
 
-	/* iterate through each metric in the collector */
-	for (size_t ind = 0; ind < collector->size; ind++) {
+	/* histogram and summary totals */
+	switch (n) {
+	case 0:
+		return snprintf(buffer, buffer_size, "%s_sum %f\n", metric->name,
+				ctx->snapshot.observed.sum);
+	case 1:
+		return snprintf(buffer, buffer_size, "%s_count %lu\n", metric->name,
+				ctx->snapshot.observed.count);
+	default:
+		return -ENOENT;
+	}
+}
 
-		const struct prometheus_metric *metric = collector->metric[ind];
+/* Format the current line. Returns its length as snprintf() does, or -ENOENT
+ * once the current metric is complete.
+ */
+static int format_line(struct prometheus_format_ctx *ctx, char *buffer, size_t buffer_size)
+{
+	const struct prometheus_metric *metric = ctx->collector->metric[ctx->metric];
+	int ret;
 
-		/* write HELP line if available */
+	if (ctx->line == LINE_HELP) {
 		if (metric->description[0] != '\0') {
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# HELP %s %s\n", metric->name,
-						     metric->description);
-			if (ret < 0) {
-				LOG_ERR("Error writing to buffer");
-				return ret;
-			}
+			return snprintf(buffer, buffer_size, "# HELP %s %s\n", metric->name,
+					metric->description);
 		}
 
-		/* write TYPE line */
-		switch (metric->type) {
-		case PROMETHEUS_COUNTER:
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# TYPE %s counter\n", metric->name);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				return ret;
-			}
-			break;
-		case PROMETHEUS_GAUGE:
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# TYPE %s gauge\n", metric->name);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				return ret;
-			}
-			break;
-		case PROMETHEUS_HISTOGRAM:
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# TYPE %s histogram\n", metric->name);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				return ret;
-			}
-			break;
-		case PROMETHEUS_SUMMARY:
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# TYPE %s summary\n", metric->name);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				return ret;
-			}
-			break;
-		default:
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "# TYPE %s untyped\n", metric->name);
-			if (ret < 0) {
-				LOG_ERR("Error writing untyped");
-				return ret;
-			}
-			break;
+		ctx->line = LINE_TYPE;
+	}
+
+	if (ctx->line == LINE_TYPE) {
+		ret = take_snapshot(ctx, metric);
+		if (ret < 0) {
+			return ret;
 		}
 
-		/* write metric-specific fields */
-		switch (metric->type) {
-		case PROMETHEUS_COUNTER: {
-			const struct prometheus_counter *counter =
-				(const struct prometheus_counter *)prometheus_collector_get_metric(
-					collector, metric->name);
-
-			LOG_DBG("counter->value: %llu", counter->value);
-
-			for (int i = 0; i < metric->num_labels; ++i) {
-				ret = write_metric_to_buffer(
-					buffer + written, buffer_size - written,
-					"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-					metric->labels[i].value, counter->value);
-				if (ret < 0) {
-					LOG_ERR("Error writing counter");
-					return ret;
-				}
-			}
-			break;
+		return snprintf(buffer, buffer_size, "# TYPE %s %s\n", metric->name,
+				metric_type_str(metric->type));
+	}
+
+	return format_sample(ctx, metric, ctx->line - LINE_SAMPLES, buffer, buffer_size);
+}
+
+void prometheus_format_init(struct prometheus_format_ctx *ctx,
+			    const struct prometheus_collector *collector)
+{
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->collector = collector;
+
+	if (collector->scrape_cb != NULL) {
+		collector->scrape_cb(collector, collector->user_data);
+	}
+}
+
+int prometheus_format_next(struct prometheus_format_ctx *ctx, char *buffer, size_t buffer_size)
+{
+	size_t written = 0;
+	int ret;
+
+	if (ctx == NULL || ctx->collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	buffer[0] = '\0';
+
+	while (!prometheus_format_done(ctx)) {
+		ret = format_line(ctx, buffer + written, buffer_size - written);
+		if (ret == -ENOENT) {
+			ctx->metric++;
+			ctx->line = LINE_HELP;
+			continue;
 		}
-		case PROMETHEUS_GAUGE: {
-			const struct prometheus_gauge *gauge =
-				(const struct prometheus_gauge *)prometheus_collector_get_metric(
-					collector, metric->name);
-
-			LOG_DBG("gauge->value: %f", gauge->value);
-
-			for (int i = 0; i < metric->num_labels; ++i) {
-				ret = write_metric_to_buffer(
-					buffer + written, buffer_size - written,
-					"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-					metric->labels[i].value, gauge->value);
-				if (ret < 0) {
-					LOG_ERR("Error writing gauge");
-					return ret;
-				}
-			}
-			break;
+
+		if (ret < 0) {
+			LOG_ERR("Error formatting %s (%d)", ctx->collector->metric[ctx->metric]->name,
+				ret);
+			return ret;
 		}
-		case PROMETHEUS_HISTOGRAM: {
-			const struct prometheus_histogram *histogram =
-				(const struct prometheus_histogram *)
-					prometheus_collector_get_metric(collector, metric->name);
-
-			LOG_DBG("histogram->count: %lu", histogram->count);
-
-			for (int i = 0; i < histogram->num_buckets; ++i) {
-				ret = write_metric_to_buffer(
-					buffer + written, buffer_size - written,
-					"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-					histogram->buckets[i].upper_bound,
-					histogram->buckets[i].count);
-				if (ret < 0) {
-					LOG_ERR("Error writing histogram");
-					return ret;
-				}
-			}
 
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "%s_sum %f\n", metric->name, histogram->sum);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				return ret;
-			}
+		if ((size_t)ret >= buffer_size - written) {
+			/* Only whole lines are sent, the line is written again
+			 * into the next buffer.
+			 */
+			buffer[written] = '\0';
 
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "%s_count %lu\n", metric->name,
-						     histogram->count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				return ret;
+			if (written == 0) {
+				LOG_ERR("Buffer too small for %s",
+					ctx->collector->metric[ctx->metric]->name);
+				return -ENOMEM;
 			}
+
 			break;
 		}
-		case PROMETHEUS_SUMMARY: {
-			const struct prometheus_summary *summary =
-				(const struct prometheus_summary *)prometheus_collector_get_metric(
-					collector, metric->name);
-
-			LOG_DBG("summary->count: %lu", summary->count);
-
-			for (int i = 0; i < summary->num_quantiles; ++i) {
-				ret = write_metric_to_buffer(
-					buffer + written, buffer_size - written,
-					"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-					summary->quantiles[i].quantile,
-					summary->quantiles[i].value);
-				if (ret < 0) {
-					LOG_ERR("Error writing summary");
-					return ret;
-				}
-			}
 
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "%s_sum %f\n", metric->name, summary->sum);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				return ret;
-			}
+		written += ret;
+		ctx->line++;
+	}
 
-			ret = write_metric_to_buffer(buffer + written, buffer_size - written,
-						     "%s_count %lu\n", metric->name,
-						     summary->count);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				return ret;
-			}
-			break;
-		}
-		default:
-			/* should not happen */
-			LOG_ERR("Unsupported metric type %d", metric->type);
-			return -EINVAL;
-		}
+	return written;
+}
+
+int prometheus_format_exposition(const struct prometheus_collector *collector, char *buffer,
+				 size_t buffer_size)
+{
+	struct prometheus_format_ctx ctx;
+	int ret;
+
+	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	prometheus_format_init(&ctx, collector);
+
+	ret = prometheus_format_next(&ctx, buffer, buffer_size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!prometheus_format_done(&ctx)) {
+		LOG_ERR("Error writing to buffer");
+		return -ENOMEM;
 	}
 
 	return 0;
@@ -22,8 +22,23 @@ int prometheus_gauge_set(struct prometheus_gauge *gauge, double value)
 	}
 
 	if (gauge) {
+		k_spinlock_key_t key = k_spin_lock(&gauge->lock);
+
 		gauge->value = value;
+		k_spin_unlock(&gauge->lock, key);
 	}
 
 	return 0;
 }
+
+double prometheus_gauge_get(struct prometheus_gauge *gauge)
+{
+	k_spinlock_key_t key;
+	double value;
+
+	key = k_spin_lock(&gauge->lock);
+	value = gauge->value;
+	k_spin_unlock(&gauge->lock, key);
+
+	return value;
+}
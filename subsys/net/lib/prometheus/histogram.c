@@ -14,11 +14,18 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_histogram, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
+static void histogram_account(struct prometheus_histogram *histogram, double value)
 {
-	if (!histogram) {
-		return -EINVAL;
-	}
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+	struct prometheus_histogram_shard *shard = &histogram->shards[arch_curr_cpu()->id];
+	k_spinlock_key_t key = k_spin_lock(&shard->lock);
+
+	shard->count++;
+	shard->sum += value;
+
+	k_spin_unlock(&shard->lock, key);
+#else
+	k_spinlock_key_t key = k_spin_lock(&histogram->lock);
 
 	/* increment count */
 	histogram->count++;
@@ -26,11 +33,25 @@ int prometheus_histogram_observe(struct prometheus_histogram *histogram, double
 	/* update sum */
 	histogram->sum += value;
 
+	k_spin_unlock(&histogram->lock, key);
+#endif
+}
+
+int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
+{
+	if (!histogram) {
+		return -EINVAL;
+	}
+
+	histogram_account(histogram, value);
+
 	/* find appropriate bucket */
 	for (size_t i = 0; i < histogram->num_buckets; ++i) {
 		if (value <= histogram->buckets[i].upper_bound) {
-			/* increment count for the bucket */
-			histogram->buckets[i].count++;
+			/* increment count for the bucket, a word sized counter
+			 * does not need a lock
+			 */
+			atomic_inc((atomic_t *)&histogram->buckets[i].count);
 
 			LOG_DBG("value: %f, bucket: %f, count: %lu", value,
 				histogram->buckets[i].upper_bound, histogram->buckets[i].count);
@@ -41,3 +62,29 @@ int prometheus_histogram_observe(struct prometheus_histogram *histogram, double
 
 	return 0;
 }
+
+void prometheus_histogram_get(struct prometheus_histogram *histogram, double *sum,
+			      unsigned long *count)
+{
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+	*sum = 0;
+	*count = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(histogram->shards); i++) {
+		struct prometheus_histogram_shard *shard = &histogram->shards[i];
+		k_spinlock_key_t key = k_spin_lock(&shard->lock);
+
+		*sum += shard->sum;
+		*count += shard->count;
+
+		k_spin_unlock(&shard->lock, key);
+	}
+#else
+	k_spinlock_key_t key = k_spin_lock(&histogram->lock);
+
+	*sum = histogram->sum;
+	*count = histogram->count;
+
+	k_spin_unlock(&histogram->lock, key);
+#endif
+}
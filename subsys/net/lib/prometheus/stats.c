@@ -0,0 +1,160 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/stats.h>
+
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/metric.h>
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(pm_stats, CONFIG_PROMETHEUS_LOG_LEVEL);
+
+#define STATS_COUNTER_DEFINE(_name, _description)                                                 \
+	static struct prometheus_metric _name##_metric = {                                         \
+		.type = PROMETHEUS_COUNTER,                                                        \
+		.name = #_name,                                                                    \
+		.description = _description,                                                       \
+	};                                                                                         \
+	PROMETHEUS_COUNTER_DEFINE(_name, &_name##_metric)
+
+#if defined(CONFIG_PROMETHEUS_NET_STATS)
+STATS_COUNTER_DEFINE(net_sent_bytes_total, "Bytes sent on all interfaces");
+STATS_COUNTER_DEFINE(net_received_bytes_total, "Bytes received on all interfaces");
+STATS_COUNTER_DEFINE(net_processing_errors_total, "Malformed or unhandled packets");
+#if defined(CONFIG_NET_STATISTICS_IPV4)
+STATS_COUNTER_DEFINE(net_ipv4_sent_total, "IPv4 packets sent");
+STATS_COUNTER_DEFINE(net_ipv4_received_total, "IPv4 packets received");
+STATS_COUNTER_DEFINE(net_ipv4_dropped_total, "IPv4 packets dropped");
+#endif
+#if defined(CONFIG_NET_STATISTICS_IPV6)
+STATS_COUNTER_DEFINE(net_ipv6_sent_total, "IPv6 packets sent");
+STATS_COUNTER_DEFINE(net_ipv6_received_total, "IPv6 packets received");
+STATS_COUNTER_DEFINE(net_ipv6_dropped_total, "IPv6 packets dropped");
+#endif
+#endif /* CONFIG_PROMETHEUS_NET_STATS */
+
+#if defined(CONFIG_PROMETHEUS_THREAD_STATS)
+STATS_COUNTER_DEFINE(cpu_execution_cycles_total, "Cycles elapsed on all CPUs");
+STATS_COUNTER_DEFINE(cpu_idle_cycles_total, "Cycles all CPUs spent idle");
+#endif
+
+static struct prometheus_counter *const stats_counters[] = {
+#if defined(CONFIG_PROMETHEUS_NET_STATS)
+	&net_sent_bytes_total,
+	&net_received_bytes_total,
+	&net_processing_errors_total,
+#if defined(CONFIG_NET_STATISTICS_IPV4)
+	&net_ipv4_sent_total,
+	&net_ipv4_received_total,
+	&net_ipv4_dropped_total,
+#endif
+#if defined(CONFIG_NET_STATISTICS_IPV6)
+	&net_ipv6_sent_total,
+	&net_ipv6_received_total,
+	&net_ipv6_dropped_total,
+#endif
+#endif /* CONFIG_PROMETHEUS_NET_STATS */
+#if defined(CONFIG_PROMETHEUS_THREAD_STATS)
+	&cpu_execution_cycles_total,
+	&cpu_idle_cycles_total,
+#endif
+};
+
+#if defined(CONFIG_PROMETHEUS_NET_STATS)
+static void net_stats_update(void)
+{
+	struct net_stats data;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &data, sizeof(data));
+	if (ret < 0) {
+		LOG_DBG("Cannot get network statistics (%d)", ret);
+		return;
+	}
+
+	prometheus_counter_set(&net_sent_bytes_total, data.bytes.sent);
+	prometheus_counter_set(&net_received_bytes_total, data.bytes.received);
+	prometheus_counter_set(&net_processing_errors_total, data.processing_error);
+
+#if defined(CONFIG_NET_STATISTICS_IPV4)
+	prometheus_counter_set(&net_ipv4_sent_total, data.ipv4.sent);
+	prometheus_counter_set(&net_ipv4_received_total, data.ipv4.recv);
+	prometheus_counter_set(&net_ipv4_dropped_total, data.ipv4.drop);
+#endif
+
+#if defined(CONFIG_NET_STATISTICS_IPV6)
+	prometheus_counter_set(&net_ipv6_sent_total, data.ipv6.sent);
+	prometheus_counter_set(&net_ipv6_received_total, data.ipv6.recv);
+	prometheus_counter_set(&net_ipv6_dropped_total, data.ipv6.drop);
+#endif
+}
+#endif /* CONFIG_PROMETHEUS_NET_STATS */
+
+#if defined(CONFIG_PROMETHEUS_THREAD_STATS)
+static void thread_stats_update(void)
+{
+	k_thread_runtime_stats_t stats;
+	int ret;
+
+	ret = k_thread_runtime_stats_all_get(&stats);
+	if (ret < 0) {
+		LOG_DBG("Cannot get runtime statistics (%d)", ret);
+		return;
+	}
+
+	prometheus_counter_set(&cpu_execution_cycles_total, stats.execution_cycles);
+	prometheus_counter_set(&cpu_idle_cycles_total, stats.idle_cycles);
+}
+#endif /* CONFIG_PROMETHEUS_THREAD_STATS */
+
+void prometheus_stats_update(void)
+{
+#if defined(CONFIG_PROMETHEUS_NET_STATS)
+	net_stats_update();
+#endif
+#if defined(CONFIG_PROMETHEUS_THREAD_STATS)
+	thread_stats_update();
+#endif
+}
+
+static void stats_scrape_cb(const struct prometheus_collector *collector, void *user_data)
+{
+	ARG_UNUSED(collector);
+	ARG_UNUSED(user_data);
+
+	prometheus_stats_update();
+}
+
+int prometheus_stats_register(struct prometheus_collector *collector)
+{
+	int ret;
+
+	if (!collector) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats_counters); i++) {
+		ret = prometheus_collector_register_metric(collector, stats_counters[i]->base);
+		if (ret < 0) {
+			LOG_ERR("Cannot register %s (%d)", stats_counters[i]->base->name, ret);
+			return ret;
+		}
+	}
+
+	if (prometheus_collector_get_scrape_cb(collector) == NULL) {
+		return prometheus_collector_set_scrape_cb(collector, stats_scrape_cb, NULL);
+	}
+
+	return 0;
+}
@@ -20,11 +20,26 @@ int prometheus_summary_observe(struct prometheus_summary *summary, double value)
 		return -EINVAL;
 	}
 
+	k_spinlock_key_t key = k_spin_lock(&summary->lock);
+
 	/* increment count */
 	summary->count++;
 
 	/* update sum */
 	summary->sum += value;
 
+	k_spin_unlock(&summary->lock, key);
+
 	return 0;
 }
+
+void prometheus_summary_get(struct prometheus_summary *summary, double *sum,
+			    unsigned long *count)
+{
+	k_spinlock_key_t key = k_spin_lock(&summary->lock);
+
+	*sum = summary->sum;
+	*count = summary->count;
+
+	k_spin_unlock(&summary->lock, key);
+}
@@ -153,6 +153,12 @@ static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 		   conn->in_retransmission, conn->in_connect, conn->in_close,
 		   sys_slist_is_empty(&conn->send_queue) ? "empty" : "data");
 
+#if defined(CONFIG_NET_TCP_PACING)
+		PR("           Max pacing rate %u Max burst %u TX buf low water %u\n",
+		   conn->max_pacing_rate, conn->tx_burst_max,
+		   conn->tx_buf_low_water);
+#endif
+
 		details->count++;
 	}
 
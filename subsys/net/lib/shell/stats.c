@@ -583,6 +583,26 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 }
 #endif /* CONFIG_NET_STATISTICS */
 
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_RX_STEERING)
+static void print_rx_steering_stats(const struct shell *sh)
+{
+	struct net_rx_steering_stats stats;
+
+	PR("\nRX steering queue statistics:\n");
+	PR("Queue\tRecv pkts\tbytes\tdepth\tmax depth\n");
+
+	for (int i = 0; i < net_rx_steering_queue_count(); i++) {
+		if (net_rx_steering_stats_get(i, &stats) < 0) {
+			continue;
+		}
+
+		PR("[%d]\t%ld\t\t%ld\t%ld\t%ld\n", i,
+		   atomic_get(&stats.pkts), atomic_get(&stats.bytes),
+		   atomic_get(&stats.depth), atomic_get(&stats.max_depth));
+	}
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_RX_STEERING */
+
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
 static void net_shell_print_statistics_all(struct net_shell_user_data *data)
 {
@@ -601,6 +621,10 @@ int cmd_net_stats_all(const struct shell *sh, size_t argc, char *argv[])
 
 	/* Print global network statistics */
 	net_shell_print_statistics_all(&user_data);
+
+#if defined(CONFIG_NET_RX_STEERING)
+	print_rx_steering_stats(sh);
+#endif
 #else
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
@@ -52,34 +52,62 @@ struct getaddrinfo_state {
 	uint16_t port;
 	uint16_t dns_id;
 	struct zsock_addrinfo *ai_arr;
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+	/* AAAA query sent along with the A query, its addresses are stored
+	 * in ai_arr as well.
+	 */
+	struct k_sem sem6;
+	int status6;
+	uint16_t dns_id6;
+#endif
 };
 
-static void dns_resolve_cb(enum dns_resolve_status status,
-			   struct dns_addrinfo *info, void *user_data)
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+/* The A and AAAA answers may be delivered from different threads, for
+ * instance when one of them is cached.
+ */
+static struct k_spinlock ai_lock;
+#endif
+
+static void dns_resolve_add(struct getaddrinfo_state *state,
+			    struct dns_addrinfo *info)
 {
-	struct getaddrinfo_state *state = user_data;
 	struct zsock_addrinfo *ai;
 	int socktype = SOCK_STREAM;
+	int idx;
 
-	NET_DBG("dns status: %d", status);
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+	k_spinlock_key_t key = k_spin_lock(&ai_lock);
+#endif
 
-	if (info == NULL) {
-		if (status == DNS_EAI_ALLDONE) {
-			status = 0;
+	idx = state->idx;
+
+	if (idx >= AI_ARR_MAX) {
+		/* IPv4 addresses take precedence, as they do when the
+		 * queries are done one after the other.
+		 */
+		idx = -1;
+
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS) &&
+		    info->ai_family == AF_INET) {
+			for (idx = state->idx - 1; idx >= 0; idx--) {
+				if (state->ai_arr[idx].ai_family == AF_INET6) {
+					break;
+				}
+			}
 		}
-		state->status = status;
-		k_sem_give(&state->sem);
-		return;
-	}
 
-	if (state->idx >= AI_ARR_MAX) {
-		NET_DBG("getaddrinfo entries overflow");
-		return;
+		if (idx < 0) {
+			NET_DBG("getaddrinfo entries overflow");
+			goto out;
+		}
+	} else {
+		state->idx++;
 	}
 
-	ai = &state->ai_arr[state->idx];
-	if (state->idx > 0) {
-		state->ai_arr[state->idx - 1].ai_next = ai;
+	ai = &state->ai_arr[idx];
+	if (idx > 0) {
+		state->ai_arr[idx - 1].ai_next = ai;
 	}
 
 	memcpy(&ai->_ai_addr, &info->ai_addr, info->ai_addrlen);
@@ -100,9 +128,53 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 	ai->ai_socktype = socktype;
 	ai->ai_protocol = (socktype == SOCK_DGRAM) ? IPPROTO_UDP : IPPROTO_TCP;
 
-	state->idx++;
+out:
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+	k_spin_unlock(&ai_lock, key);
+#endif
+	return;
 }
 
+static void dns_resolve_cb(enum dns_resolve_status status,
+			   struct dns_addrinfo *info, void *user_data)
+{
+	struct getaddrinfo_state *state = user_data;
+
+	NET_DBG("dns status: %d", status);
+
+	if (info == NULL) {
+		if (status == DNS_EAI_ALLDONE) {
+			status = 0;
+		}
+		state->status = status;
+		k_sem_give(&state->sem);
+		return;
+	}
+
+	dns_resolve_add(state, info);
+}
+
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+static void dns_resolve_cb6(enum dns_resolve_status status,
+			    struct dns_addrinfo *info, void *user_data)
+{
+	struct getaddrinfo_state *state = user_data;
+
+	NET_DBG("dns AAAA status: %d", status);
+
+	if (info == NULL) {
+		if (status == DNS_EAI_ALLDONE) {
+			status = 0;
+		}
+		state->status6 = status;
+		k_sem_give(&state->sem6);
+		return;
+	}
+
+	dns_resolve_add(state, info);
+}
+#endif /* CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS */
+
 static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
 {
 	k_timepoint_t new_timepoint;
@@ -179,6 +251,101 @@ again:
 	return st;
 }
 
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+/* The answers are stored as they arrive, put the IPv4 addresses first like
+ * sequential queries do.
+ */
+static void sort_ipv4_first(struct getaddrinfo_state *state)
+{
+	struct zsock_addrinfo tmp;
+	struct zsock_addrinfo *ai;
+	uint16_t ipv4 = 0U;
+
+	for (uint16_t idx = 0; idx < state->idx; idx++) {
+		if (state->ai_arr[idx].ai_family != AF_INET) {
+			continue;
+		}
+
+		if (idx != ipv4) {
+			tmp = state->ai_arr[idx];
+			memmove(&state->ai_arr[ipv4 + 1], &state->ai_arr[ipv4],
+				(idx - ipv4) * sizeof(tmp));
+			state->ai_arr[ipv4] = tmp;
+		}
+
+		ipv4++;
+	}
+
+	for (uint16_t idx = 0; idx < state->idx; idx++) {
+		ai = &state->ai_arr[idx];
+		ai->ai_addr = &ai->_ai_addr;
+		ai->ai_canonname = ai->_ai_canonname;
+		ai->ai_next = (idx + 1 < state->idx) ? ai + 1 : NULL;
+	}
+}
+
+/* Resolve the IPv4 and IPv6 addresses at the same time, RFC 8305 ch. 3. */
+static int exec_query_both(const char *host, struct getaddrinfo_state *ai_state,
+			   int *st1, int *st2)
+{
+	int timeout_ms = MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
+			     CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL);
+	k_timeout_t delay;
+	bool sequential;
+	int ret;
+
+	k_sem_init(&ai_state->sem6, 0, K_SEM_MAX_LIMIT);
+
+	ret = dns_get_addr_info(host, DNS_QUERY_TYPE_AAAA, &ai_state->dns_id6,
+				dns_resolve_cb6, ai_state, timeout_ms);
+	if (ret < 0) {
+		/* Typically no free query slot, query one family at a time */
+		return ret;
+	}
+
+	*st1 = exec_query(host, AF_INET, ai_state);
+
+	/* Other lookups may hold the remaining query slots, in which case the
+	 * A query is sent once the AAAA query has completed.
+	 */
+	sequential = (*st1 == DNS_EAI_SYSTEM && errno == EAGAIN);
+
+	/* With IPv4 addresses at hand, the IPv6 query only gets a short while
+	 * to catch up. Otherwise it runs until its own timeout.
+	 */
+	if (*st1 == 0) {
+		delay = K_MSEC(CONFIG_NET_SOCKETS_DNS_RESOLUTION_DELAY);
+	} else {
+		delay = K_MSEC(timeout_ms + 100);
+	}
+
+	if (k_sem_take(&ai_state->sem6, delay) == -EAGAIN) {
+		/* The resolver either calls back with the cancel or has
+		 * completed the query already, so the state is no longer used
+		 * by the AAAA query once this returns.
+		 */
+		(void)dns_cancel_addr_info(ai_state->dns_id6);
+		(void)k_sem_take(&ai_state->sem6, K_NO_WAIT);
+		ai_state->status6 = DNS_EAI_CANCELED;
+	}
+
+	*st2 = ai_state->status6;
+
+	if (sequential) {
+		*st1 = exec_query(host, AF_INET, ai_state);
+	}
+
+	if (*st2 == DNS_EAI_CANCELED && *st1 != 0 && *st1 != DNS_EAI_AGAIN) {
+		/* No IPv4 addresses either, give IPv6 the full retry period */
+		*st2 = exec_query(host, AF_INET6, ai_state);
+	}
+
+	sort_ipv4_first(ai_state);
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS */
+
 static int getaddrinfo_null_host(int port, const struct zsock_addrinfo *hints,
 				struct zsock_addrinfo *res)
 {
@@ -225,6 +392,7 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	int st1 = DNS_EAI_ADDRFAMILY, st2 = DNS_EAI_ADDRFAMILY;
 	struct sockaddr *ai_addr;
 	struct getaddrinfo_state ai_state;
+	bool resolved = false;
 
 	if (hints) {
 		family = hints->ai_family;
@@ -266,10 +434,16 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	ai_state.dns_id = 0;
 	k_sem_init(&ai_state.sem, 0, K_SEM_MAX_LIMIT);
 
+#if defined(CONFIG_NET_SOCKETS_DNS_HAPPY_EYEBALLS)
+	if (family == AF_UNSPEC) {
+		resolved = exec_query_both(host, &ai_state, &st1, &st2) == 0;
+	}
+#endif
+
 	/* If family is AF_UNSPEC, then we query IPv4 address first
 	 * if IPv4 is enabled in the config.
 	 */
-	if ((family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4)) {
+	if (!resolved && (family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4)) {
 		st1 = exec_query(host, AF_INET, &ai_state);
 		if (st1 == DNS_EAI_AGAIN) {
 			return st1;
@@ -279,7 +453,7 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	/* If family is AF_UNSPEC, the IPv4 query has been already done
 	 * so we can do IPv6 query next if IPv6 is enabled in the config.
 	 */
-	if ((family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6)) {
+	if (!resolved && (family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6)) {
 		st2 = exec_query(host, AF_INET6, &ai_state);
 		if (st2 == DNS_EAI_AGAIN) {
 			return st2;
@@ -1597,6 +1597,8 @@ static enum tcp_conn_option get_tcp_option(int optname)
 		return TCP_OPT_KEEPINTVL;
 	case TCP_KEEPCNT:
 		return TCP_OPT_KEEPCNT;
+	case TCP_CONGESTION:
+		return TCP_OPT_CONGESTION;
 	}
 
 	return -EINVAL;
@@ -1746,6 +1748,22 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_MAX_PACING_RATE:
+			if (IS_ENABLED(CONFIG_NET_TCP_PACING) &&
+			    net_context_get_proto(ctx) == IPPROTO_TCP) {
+				ret = net_tcp_get_option(ctx,
+							 TCP_OPT_MAX_PACING_RATE,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_TIMESTAMPING:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
 				ret = net_context_get_option(ctx,
@@ -1788,6 +1806,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2277,6 +2310,22 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_MAX_PACING_RATE:
+			if (IS_ENABLED(CONFIG_NET_TCP_PACING) &&
+			    net_context_get_proto(ctx) == IPPROTO_TCP) {
+				ret = net_tcp_set_option(ctx,
+							 TCP_OPT_MAX_PACING_RATE,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_TIMESTAMPING:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMPING)) {
 				ret = net_context_set_option(ctx,
@@ -2320,6 +2369,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
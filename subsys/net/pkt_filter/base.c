@@ -11,6 +11,8 @@ LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 #include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/spinlock.h>
 
+#include "npf_private.h"
+
 /*
  * Our actual rule lists for supported test points
  */
@@ -121,8 +123,15 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
-	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+	k_spinlock_key_t key;
+	enum net_verdict result;
+
+	if (npf_prog_evaluate(rules, pkt, &result)) {
+		return result;
+	}
+
+	key = k_spin_lock(&rules->lock);
+	result = evaluate(&rules->rule_head, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
@@ -179,6 +188,8 @@ void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	sys_slist_prepend(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+
+	npf_rules_update(rules);
 }
 
 void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
@@ -192,6 +203,8 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	sys_slist_append(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+
+	npf_rules_update(rules);
 }
 
 bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
@@ -201,6 +214,11 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	k_spin_unlock(&rules->lock, key);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
+
+	if (result) {
+		npf_rules_update(rules);
+	}
+
 	return result;
 }
 
@@ -215,6 +233,11 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 	}
 
 	k_spin_unlock(&rules->lock, key);
+
+	if (result) {
+		npf_rules_update(rules);
+	}
+
 	return result;
 }
 
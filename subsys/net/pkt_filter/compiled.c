@@ -0,0 +1,393 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt_filter.h>
+#include <zephyr/spinlock.h>
+
+#include "npf_private.h"
+
+/*
+ * Rule lists are compiled into a flat program that is run without taking
+ * the rule list lock. The well known conditions are evaluated inline, large
+ * address sets are looked up in a hash table, other conditions are called
+ * through their test function as before.
+ */
+
+enum npf_op {
+	NPF_OP_RET,
+	NPF_OP_CALL,
+	NPF_OP_IFACE,
+	NPF_OP_ORIG_IFACE,
+	NPF_OP_SIZE,
+	NPF_OP_IP_SRC_HASH,
+	NPF_OP_ETH_TYPE,
+	NPF_OP_ETH_SRC_HASH,
+	NPF_OP_ETH_DST_HASH,
+};
+
+/* Serializes program rebuilds, rule list updates are rare */
+static K_MUTEX_DEFINE(npf_update_lock);
+
+/* Packet fields that are costly to get are only computed once per packet */
+struct npf_ctx {
+	size_t len;
+	bool len_valid;
+};
+
+/* FNV-1a, addresses are short and the set sizes are small */
+static uint32_t addr_hash(const uint8_t *addr, size_t len)
+{
+	uint32_t hash = 0x811c9dc5U;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= addr[i];
+		hash *= 0x01000193U;
+	}
+
+	return hash;
+}
+
+static bool hash_lookup(const struct npf_prog *prog, const struct npf_insn *insn,
+			const void *addr, size_t len)
+{
+	const void *const *slots = &prog->hash_slots[insn->hash_first];
+	uint32_t idx = addr_hash(addr, len);
+
+	for (int i = 0; i <= insn->hash_mask; i++, idx++) {
+		const void *entry = slots[idx & insn->hash_mask];
+
+		if (entry == NULL) {
+			return false;
+		}
+
+		if (memcmp(entry, addr, len) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Index an address set in the program, entries are referenced in place */
+static int hash_build(struct npf_prog *prog, struct npf_insn *insn,
+		      const uint8_t *addrs, size_t count, size_t len)
+{
+	const void **slots;
+	size_t size = 1;
+
+	if (count < CONFIG_NET_PKT_FILTER_COMPILED_HASH_MIN) {
+		return -EINVAL;
+	}
+
+	/* Keep the load factor at or below one half */
+	while (size < count * 2) {
+		size <<= 1;
+	}
+
+	if (prog->hash_used + size > ARRAY_SIZE(prog->hash_slots)) {
+		return -ENOMEM;
+	}
+
+	insn->hash_first = prog->hash_used;
+	insn->hash_mask = size - 1;
+	prog->hash_used += size;
+
+	slots = &prog->hash_slots[insn->hash_first];
+	memset(slots, 0, size * sizeof(slots[0]));
+
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t *addr = addrs + i * len;
+		uint32_t idx = addr_hash(addr, len);
+
+		while (slots[idx & insn->hash_mask] != NULL) {
+			idx++;
+		}
+
+		slots[idx & insn->hash_mask] = addr;
+	}
+
+	return 0;
+}
+
+static void emit_ip_src(struct npf_prog *prog, struct npf_insn *insn)
+{
+	struct npf_test_ip *test_ip = CONTAINER_OF(insn->test, struct npf_test_ip, test);
+	size_t len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && test_ip->addr_family == AF_INET) {
+		len = sizeof(struct in_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && test_ip->addr_family == AF_INET6) {
+		len = sizeof(struct in6_addr);
+	} else {
+		return;
+	}
+
+	if (hash_build(prog, insn, test_ip->ipaddr, test_ip->ipaddr_num, len) == 0) {
+		insn->op = NPF_OP_IP_SRC_HASH;
+		insn->negate = (insn->test->fn == npf_ip_src_addr_unmatch);
+	}
+}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+static void emit_eth_addr(struct npf_prog *prog, struct npf_insn *insn, bool src)
+{
+	struct npf_test_eth_addr *test_eth =
+			CONTAINER_OF(insn->test, struct npf_test_eth_addr, test);
+
+	/* Only exact matches can be hashed */
+	for (int i = 0; i < sizeof(test_eth->mask.addr); i++) {
+		if (test_eth->mask.addr[i] != 0xff) {
+			return;
+		}
+	}
+
+	if (hash_build(prog, insn, (const uint8_t *)test_eth->addresses,
+		       test_eth->nb_addresses, sizeof(struct net_eth_addr)) == 0) {
+		insn->op = src ? NPF_OP_ETH_SRC_HASH : NPF_OP_ETH_DST_HASH;
+		insn->negate = (insn->test->fn == npf_eth_src_addr_unmatch ||
+				insn->test->fn == npf_eth_dst_addr_unmatch);
+	}
+}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
+static int emit_test(struct npf_prog *prog, struct npf_test *test)
+{
+	struct npf_insn *insn;
+	npf_test_fn_t *fn = test->fn;
+
+	if (prog->len >= ARRAY_SIZE(prog->insns)) {
+		return -ENOMEM;
+	}
+
+	insn = &prog->insns[prog->len++];
+	insn->op = NPF_OP_CALL;
+	insn->negate = 0U;
+	insn->test = test;
+
+	if (fn == npf_iface_match || fn == npf_iface_unmatch) {
+		insn->op = NPF_OP_IFACE;
+		insn->negate = (fn == npf_iface_unmatch);
+	} else if (fn == npf_orig_iface_match || fn == npf_orig_iface_unmatch) {
+		insn->op = NPF_OP_ORIG_IFACE;
+		insn->negate = (fn == npf_orig_iface_unmatch);
+	} else if (fn == npf_size_inbounds) {
+		insn->op = NPF_OP_SIZE;
+	} else if (fn == npf_ip_src_addr_match || fn == npf_ip_src_addr_unmatch) {
+		emit_ip_src(prog, insn);
+#if defined(CONFIG_NET_L2_ETHERNET)
+	} else if (fn == npf_eth_type_match || fn == npf_eth_type_unmatch) {
+		insn->op = NPF_OP_ETH_TYPE;
+		insn->negate = (fn == npf_eth_type_unmatch);
+	} else if (fn == npf_eth_src_addr_match || fn == npf_eth_src_addr_unmatch) {
+		emit_eth_addr(prog, insn, true);
+	} else if (fn == npf_eth_dst_addr_match || fn == npf_eth_dst_addr_unmatch) {
+		emit_eth_addr(prog, insn, false);
+#endif
+	}
+
+	return 0;
+}
+
+static int emit_ret(struct npf_prog *prog, enum net_verdict verdict)
+{
+	struct npf_insn *insn;
+
+	if (prog->len >= ARRAY_SIZE(prog->insns)) {
+		return -ENOMEM;
+	}
+
+	insn = &prog->insns[prog->len++];
+	insn->op = NPF_OP_RET;
+	insn->verdict = verdict;
+
+	return 0;
+}
+
+static int prog_build(struct npf_prog *prog, sys_slist_t *rule_head)
+{
+	struct npf_rule *rule;
+	int ret;
+
+	prog->len = 0U;
+	prog->hash_used = 0U;
+
+	/* Same semantics as the interpreter: no rules means accept */
+	if (sys_slist_is_empty(rule_head)) {
+		return emit_ret(prog, NET_OK);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
+		uint16_t first = prog->len;
+
+		for (uint32_t i = 0; i < rule->nb_tests; i++) {
+			ret = emit_test(prog, rule->tests[i]);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		ret = emit_ret(prog, rule->result);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* A failed condition continues with the next rule */
+		for (uint16_t pc = first; pc < prog->len - 1; pc++) {
+			prog->insns[pc].jf = prog->len;
+		}
+
+		/* Rules after an unconditional one can never be reached */
+		if (rule->nb_tests == 0U) {
+			return 0;
+		}
+	}
+
+	return emit_ret(prog, NET_DROP);
+}
+
+static enum net_verdict prog_run(const struct npf_prog *prog, struct net_pkt *pkt)
+{
+	struct npf_ctx ctx = { 0 };
+	uint16_t pc = 0U;
+
+	while (true) {
+		const struct npf_insn *insn = &prog->insns[pc];
+		bool match;
+
+		switch (insn->op) {
+		case NPF_OP_RET:
+			return insn->verdict;
+		case NPF_OP_IFACE:
+			match = CONTAINER_OF(insn->test, struct npf_test_iface, test)->iface ==
+				net_pkt_iface(pkt);
+			break;
+		case NPF_OP_ORIG_IFACE:
+			match = CONTAINER_OF(insn->test, struct npf_test_iface, test)->iface ==
+				net_pkt_orig_iface(pkt);
+			break;
+		case NPF_OP_SIZE: {
+			struct npf_test_size_bounds *bounds =
+				CONTAINER_OF(insn->test, struct npf_test_size_bounds, test);
+
+			if (!ctx.len_valid) {
+				ctx.len = net_pkt_get_len(pkt);
+				ctx.len_valid = true;
+			}
+
+			match = ctx.len >= bounds->min && ctx.len <= bounds->max;
+			break;
+		}
+		case NPF_OP_IP_SRC_HASH: {
+			struct npf_test_ip *test_ip =
+				CONTAINER_OF(insn->test, struct npf_test_ip, test);
+
+			if (net_pkt_family(pkt) != test_ip->addr_family) {
+				match = false;
+			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+				   test_ip->addr_family == AF_INET) {
+				match = hash_lookup(prog, insn, NET_IPV4_HDR(pkt)->src,
+						    sizeof(struct in_addr));
+			} else {
+				match = hash_lookup(prog, insn, NET_IPV6_HDR(pkt)->src,
+						    sizeof(struct in6_addr));
+			}
+			break;
+		}
+#if defined(CONFIG_NET_L2_ETHERNET)
+		case NPF_OP_ETH_TYPE:
+			match = NET_ETH_HDR(pkt)->type ==
+				CONTAINER_OF(insn->test, struct npf_test_eth_type, test)->type;
+			break;
+		case NPF_OP_ETH_SRC_HASH:
+			match = hash_lookup(prog, insn, &NET_ETH_HDR(pkt)->src,
+					    sizeof(struct net_eth_addr));
+			break;
+		case NPF_OP_ETH_DST_HASH:
+			match = hash_lookup(prog, insn, &NET_ETH_HDR(pkt)->dst,
+					    sizeof(struct net_eth_addr));
+			break;
+#endif
+		default:
+			match = insn->test->fn(insn->test, pkt);
+			break;
+		}
+
+		pc = (match != (bool)insn->negate) ? pc + 1 : insn->jf;
+	}
+}
+
+bool npf_prog_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt,
+		       enum net_verdict *result)
+{
+	struct npf_prog *prog;
+
+	/* The reader count keeps the program from being rebuilt while we
+	 * run it. A program that got replaced after we picked it up is
+	 * released again and the new one is used instead.
+	 */
+	while (true) {
+		prog = atomic_ptr_get(&rules->prog);
+		if (prog == NULL) {
+			return false;
+		}
+
+		atomic_inc(&prog->readers);
+
+		if (prog == atomic_ptr_get(&rules->prog)) {
+			break;
+		}
+
+		atomic_dec(&prog->readers);
+	}
+
+	*result = prog_run(prog, pkt);
+
+	atomic_dec(&prog->readers);
+
+	return true;
+}
+
+void npf_rules_update(struct npf_rule_list *rules)
+{
+	struct npf_prog *active;
+	struct npf_prog *next;
+	k_spinlock_key_t key;
+	int ret;
+
+	k_mutex_lock(&npf_update_lock, K_FOREVER);
+
+	active = atomic_ptr_get(&rules->prog);
+	next = (active == &rules->progs[0]) ? &rules->progs[1] : &rules->progs[0];
+
+	/* Let readers that still run the program previously built in this
+	 * storage finish before overwriting it.
+	 */
+	while (atomic_get(&next->readers) != 0) {
+		k_msleep(1);
+	}
+
+	key = k_spin_lock(&rules->lock);
+	ret = prog_build(next, &rules->rule_head);
+	k_spin_unlock(&rules->lock, key);
+
+	if (ret < 0) {
+		NET_WARN("Rule list %p does not fit in %d instructions, "
+			 "interpreting it", rules,
+			 CONFIG_NET_PKT_FILTER_COMPILED_MAX_INSNS);
+		next = NULL;
+	} else {
+		NET_DBG("Rule list %p compiled to %u instructions, %u hash slots",
+			rules, next->len, next->hash_used);
+	}
+
+	atomic_ptr_set(&rules->prog, next);
+
+	k_mutex_unlock(&npf_update_lock);
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NPF_PRIVATE_H
+#define __NPF_PRIVATE_H
+
+#include <zephyr/net/net_pkt_filter.h>
+
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+/* Run the compiled program of the rule list. Returns false if the list
+ * has no program and must be interpreted.
+ */
+bool npf_prog_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt,
+		       enum net_verdict *result);
+#else
+static inline bool npf_prog_evaluate(struct npf_rule_list *rules,
+				     struct net_pkt *pkt,
+				     enum net_verdict *result)
+{
+	ARG_UNUSED(rules);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(result);
+
+	return false;
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
+#endif /* __NPF_PRIVATE_H */
@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+static bool valid_stack(uintptr_t addr, k_tid_t current)
+{
+	return current->stack_info.start <= addr &&
+		addr < current->stack_info.start + current->stack_info.size;
+}
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	extern uintptr_t __text_region_start, __text_region_end;
+
+	return (addr >= (uintptr_t)&__text_region_start) && (addr < (uintptr_t)&__text_region_end);
+}
+
+/*
+ * This function use frame pointers to unwind stack and get trace of return addresses.
+ * Return addresses are translated in corresponding function's names using .elf file.
+ * So we get function call trace
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size, bool *truncated)
+{
+	*truncated = false;
+
+	if (size < 2U) {
+		return 0;
+	}
+
+	size_t idx = 0;
+
+	/*
+	 * In arm64 (arch/arm64/core/vector_table.S) x0-x18, lr, spsr, elr and,
+	 * with CONFIG_FRAME_POINTER, fp(x29) are saved on the thread stack in
+	 * a struct arch_esf on exception entry. Then _isr_wrapper switches $sp
+	 * to _current_cpu->irq_stack and pushes the thread $sp, which points
+	 * to the esf, with offset -16.
+	 */
+	const struct arch_esf * const esf =
+		*((struct arch_esf **)(((uintptr_t)_current_cpu->irq_stack) - 16));
+
+	/*
+	 * x29 is used as frame pointer, it points to the frame record.
+	 *
+	 * stack frame in memory:
+	 * (addresses growth up)
+	 *  ....
+	 *  lr
+	 *  x29 (next) <- x29 (curr)
+	 *  ....
+	 */
+	void **fp = (void **)esf->fp;
+
+	buf[idx++] = (uintptr_t)esf->elr;
+
+	/*
+	 * Leaf functions and functions in their prologue or epilogue have no
+	 * frame record of their own, lr is the only trace of their caller.
+	 */
+	if (in_text_region((uintptr_t)esf->lr)) {
+		buf[idx++] = (uintptr_t)esf->lr;
+	}
+
+	while (valid_stack((uintptr_t)fp, _current)) {
+		if (idx >= size) {
+			*truncated = true;
+			break;
+		}
+
+		if (!in_text_region((uintptr_t)fp[1])) {
+			break;
+		}
+
+		buf[idx++] = (uintptr_t)fp[1];
+		void **new_fp = (void **)fp[0];
+
+		/*
+		 * anti-infinity-loop if
+		 * new_fp can't be smaller than fp, cause the stack is growing down
+		 * and trace moves deeper into the stack
+		 */
+		if (new_fp <= fp) {
+			break;
+		}
+		fp = new_fp;
+	}
+
+	return idx;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <cmsis_core.h>
+
+static bool valid_stack(uintptr_t addr, k_tid_t current)
+{
+	return current->stack_info.start <= addr &&
+		addr < current->stack_info.start + current->stack_info.size;
+}
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	extern uintptr_t __text_region_start, __text_region_end;
+
+	return (addr >= (uintptr_t)&__text_region_start) && (addr < (uintptr_t)&__text_region_end);
+}
+
+/*
+ * Thumb code does not keep a chain of frame records, r7 points anywhere in
+ * the frame of a function, so the stack cannot be unwound with it. The trace
+ * holds the interrupted address and the return address only, which is enough
+ * to tell which functions and their callers the time is spent in.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size, bool *truncated)
+{
+	*truncated = false;
+
+	if (size < 2U) {
+		return 0;
+	}
+
+	size_t idx = 0;
+
+	/*
+	 * Threads run on the process stack. On exception entry the core pushes
+	 * r0-r3, r12, lr, pc and xpsr there, in the order of struct __basic_sf,
+	 * and the handler runs on the main stack, so $psp still points to the
+	 * frame of the interrupted thread.
+	 */
+	const struct arch_esf * const esf = (const struct arch_esf *)__get_PSP();
+
+	if (!valid_stack((uintptr_t)esf, _current)) {
+		/* Thread is in a system call, or has no stack info yet */
+		buf[idx++] = 0;
+		return idx;
+	}
+
+	buf[idx++] = (uintptr_t)esf->basic.pc;
+
+	/* Bit 0 of lr only selects the Thumb state */
+	uintptr_t ra = (uintptr_t)esf->basic.lr & ~1UL;
+
+	if (in_text_region(ra)) {
+		buf[idx++] = ra;
+	}
+
+	return idx;
+}
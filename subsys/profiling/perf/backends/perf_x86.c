@@ -34,8 +34,10 @@ struct isf {
  * Return addresses are translated in corresponding function's names using .elf file.
  * So we get function call trace
  */
-size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size, bool *truncated)
 {
+	*truncated = false;
+
 	if (size < 1U) {
 		return 0;
 	}
@@ -69,7 +71,8 @@ size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
 	buf[idx++] = (uintptr_t)isf->eip;
 	while (valid_stack((uintptr_t)fp, _current)) {
 		if (idx >= size) {
-			return 0;
+			*truncated = true;
+			break;
 		}
 
 		if (!in_text_region((uintptr_t)fp[1])) {
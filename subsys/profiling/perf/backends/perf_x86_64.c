@@ -25,8 +25,10 @@ static inline bool in_text_region(uintptr_t addr)
  * Return addresses are translated in corresponding function's names using .elf file.
  * So we get function call trace
  */
-size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size, bool *truncated)
 {
+	*truncated = false;
+
 	if (size < 1U) {
 		return 0;
 	}
@@ -55,7 +57,8 @@ size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
 	 */
 	while (valid_stack((uintptr_t)fp, _current)) {
 		if (idx >= size) {
-			return 0;
+			*truncated = true;
+			break;
 		}
 
 		if (!in_text_region((uintptr_t)fp[1])) {
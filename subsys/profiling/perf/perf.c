@@ -12,8 +12,12 @@
 #include <zephyr/shell/shell_uart.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
+/* Unwind the interrupted call chain into buf, innermost frame first. Returns
+ * the number of frames stored and sets truncated if the chain did not fit.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size, bool *truncated);
 
 struct perf_data_t {
 	struct k_timer timer;
@@ -40,14 +44,17 @@ static void perf_tracer(struct k_timer *timer)
 		(struct perf_data_t *)k_timer_user_data_get(timer);
 
 	size_t trace_length = 0;
+	bool truncated = false;
 
 	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
 		trace_length = arch_perf_current_stack_trace(
 					perf_data_ptr->buf + perf_data_ptr->idx,
-					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx);
+					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx,
+					&truncated);
 	}
 
-	if (trace_length != 0) {
+	/* A trace cut by the end of the buffer means the buffer is full */
+	if (trace_length != 0 && !truncated) {
 		perf_data_ptr->buf[perf_data_ptr->idx - 1] = trace_length;
 		perf_data_ptr->idx += trace_length;
 	} else {
@@ -70,6 +77,289 @@ static void perf_dwork_handler(struct k_work *work)
 	}
 }
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+#define PERF_AGG_ENTRIES CONFIG_PROFILING_PERF_AGGREGATE_ENTRIES
+#define PERF_AGG_DEPTH   CONFIG_PROFILING_PERF_AGGREGATE_DEPTH
+/* Slots probed before a new call chain is given up on */
+#define PERF_AGG_PROBES  MIN(16, PERF_AGG_ENTRIES)
+
+/* One distinct call chain of a thread, frames[0] is the sampled address */
+struct perf_chain {
+	uint32_t hash;
+	/* Number of samples, 0 for an unused slot */
+	uint32_t count;
+	k_tid_t thread;
+	uint8_t cpu;
+	uint8_t depth;
+	uintptr_t frames[PERF_AGG_DEPTH];
+};
+
+struct perf_agg_t {
+	struct k_timer timer;
+	struct k_spinlock lock;
+	bool running;
+
+	uint32_t samples;
+	uint32_t used;
+	/* Samples without a call chain, or of new ones that found no free slot */
+	uint32_t dropped;
+	/* Samples whose call chain was cut to its PERF_AGG_DEPTH innermost frames */
+	uint32_t truncated;
+
+	uintptr_t scratch[PERF_AGG_DEPTH];
+	struct perf_chain chains[PERF_AGG_ENTRIES];
+};
+
+static void perf_sampler(struct k_timer *timer);
+static struct perf_agg_t perf_agg = {
+	.timer = Z_TIMER_INITIALIZER(perf_agg.timer, perf_sampler, NULL),
+};
+
+static uint32_t perf_hash_word(uint32_t hash, uint64_t word)
+{
+	/* FNV-1a over both halves of the word */
+	hash = (hash ^ (uint32_t)word) * 16777619U;
+
+	return (hash ^ (uint32_t)(word >> 32)) * 16777619U;
+}
+
+static uint32_t perf_chain_hash(k_tid_t thread, uint8_t cpu, const uintptr_t *frames,
+				size_t depth)
+{
+	uint32_t hash = 2166136261U;
+
+	hash = perf_hash_word(hash, (uintptr_t)thread);
+	hash = perf_hash_word(hash, cpu);
+
+	for (size_t i = 0; i < depth; i++) {
+		hash = perf_hash_word(hash, frames[i]);
+	}
+
+	return hash;
+}
+
+static void perf_sampler(struct k_timer *timer)
+{
+	struct perf_chain *chain;
+	k_spinlock_key_t key;
+	k_tid_t thread = _current;
+	uint8_t cpu = _current_cpu->id;
+	uint32_t hash;
+	size_t depth;
+	bool truncated;
+
+	ARG_UNUSED(timer);
+
+	key = k_spin_lock(&perf_agg.lock);
+
+	perf_agg.samples++;
+
+	/* Deeper call chains are still counted, with their innermost frames */
+	depth = arch_perf_current_stack_trace(perf_agg.scratch, PERF_AGG_DEPTH, &truncated);
+	if (truncated) {
+		perf_agg.truncated++;
+	}
+
+	if (depth == 0) {
+		perf_agg.dropped++;
+		goto out;
+	}
+
+	hash = perf_chain_hash(thread, cpu, perf_agg.scratch, depth);
+
+	for (size_t i = 0; i < PERF_AGG_PROBES; i++) {
+		chain = &perf_agg.chains[(hash + i) % PERF_AGG_ENTRIES];
+
+		if (chain->count == 0) {
+			chain->hash = hash;
+			chain->count = 1;
+			chain->thread = thread;
+			chain->cpu = cpu;
+			chain->depth = depth;
+			memcpy(chain->frames, perf_agg.scratch, depth * sizeof(uintptr_t));
+			perf_agg.used++;
+			goto out;
+		}
+
+		if (chain->hash == hash && chain->thread == thread && chain->cpu == cpu &&
+		    chain->depth == depth &&
+		    memcmp(chain->frames, perf_agg.scratch, depth * sizeof(uintptr_t)) == 0) {
+			if (chain->count < UINT32_MAX) {
+				chain->count++;
+			}
+			goto out;
+		}
+	}
+
+	perf_agg.dropped++;
+
+out:
+	k_spin_unlock(&perf_agg.lock, key);
+}
+
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_NAME)
+struct perf_thread_lookup {
+	k_tid_t thread;
+	char *buf;
+	size_t size;
+	bool found;
+};
+
+static void perf_thread_match(const struct k_thread *thread, void *user_data)
+{
+	struct perf_thread_lookup *lookup = user_data;
+	const char *name;
+
+	if (thread != lookup->thread) {
+		return;
+	}
+
+	name = k_thread_name_get((k_tid_t)thread);
+	if (name == NULL || name[0] == '\0') {
+		return;
+	}
+
+	strncpy(lookup->buf, name, lookup->size - 1);
+	lookup->buf[lookup->size - 1] = '\0';
+	lookup->found = true;
+}
+#endif
+
+/* Name of the thread, or its address if it has none or has exited since */
+static const char *perf_thread_label(k_tid_t thread, char *buf, size_t size)
+{
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_NAME)
+	struct perf_thread_lookup lookup = {
+		.thread = thread,
+		.buf = buf,
+		.size = size,
+	};
+
+	k_thread_foreach_unlocked(perf_thread_match, &lookup);
+	if (lookup.found) {
+		/* Separators of the collapsed format cannot be part of a name */
+		for (char *c = buf; *c != '\0'; c++) {
+			if (*c == ';' || *c == ' ') {
+				*c = '_';
+			}
+		}
+
+		return buf;
+	}
+#endif
+
+	snprintf(buf, size, "0x%lx", (unsigned long)(uintptr_t)thread);
+
+	return buf;
+}
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char **argv)
+{
+	long frequency = strtol(argv[1], NULL, 10);
+
+	if (frequency <= 0) {
+		shell_error(sh, "Invalid frequency");
+		return -EINVAL;
+	}
+
+	if (perf_agg.running) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	perf_agg.running = true;
+	k_timer_start(&perf_agg.timer, K_NO_WAIT, K_NSEC(1000000000 / frequency));
+
+	shell_print(sh, "Enabled continuous perf");
+
+	return 0;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	k_timer_stop(&perf_agg.timer);
+	perf_agg.running = false;
+
+	shell_print(sh, "Perf stopped");
+
+	return 0;
+}
+
+static int cmd_perf_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_agg.lock);
+
+	memset(perf_agg.chains, 0, sizeof(perf_agg.chains));
+	perf_agg.samples = 0;
+	perf_agg.used = 0;
+	perf_agg.dropped = 0;
+	perf_agg.truncated = 0;
+
+	k_spin_unlock(&perf_agg.lock, key);
+
+	shell_print(sh, "Perf call chains cleared");
+
+	return 0;
+}
+
+static int cmd_perf_collapse(const struct shell *sh, size_t argc, char **argv)
+{
+	struct perf_chain chain;
+	k_spinlock_key_t key;
+	char label[32];
+
+	shell_print(sh, "Perf collapsed %u samples", perf_agg.samples);
+
+	for (size_t i = 0; i < PERF_AGG_ENTRIES; i++) {
+		/* Sampling goes on while printing, copy one chain at a time */
+		key = k_spin_lock(&perf_agg.lock);
+		chain = perf_agg.chains[i];
+		k_spin_unlock(&perf_agg.lock, key);
+
+		if (chain.count == 0) {
+			continue;
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL, "cpu%u;%s", chain.cpu,
+			      perf_thread_label(chain.thread, label, sizeof(label)));
+
+		/* Collapsed stacks start at the outermost function */
+		for (size_t f = chain.depth; f > 0; f--) {
+			shell_fprintf(sh, SHELL_NORMAL, ";0x%lx", (unsigned long)chain.frames[f - 1]);
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL, " %u\n", chain.count);
+	}
+
+	return 0;
+}
+
+static void perf_agg_info_print(const struct shell *sh)
+{
+	if (perf_agg.running) {
+		shell_print(sh, "Continuous perf is running");
+	}
+
+	shell_print(sh, "Perf call chains: %u/%d, %u samples, %u dropped, %u truncated",
+		    perf_agg.used, PERF_AGG_ENTRIES, perf_agg.samples, perf_agg.dropped,
+		    perf_agg.truncated);
+}
+
+#define PERF_AGG_SUBCMD &m_sub_perf_agg
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf_agg,
+	SHELL_CMD_ARG(start, NULL, "Sample continuously on <frequency> Hz\n"
+		      "Usage: start <frequency>", cmd_perf_start, 2, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_perf_stop, 1, 0),
+	SHELL_CMD_ARG(collapse, NULL, "Print the call chains as collapsed stacks",
+		      cmd_perf_collapse, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear the call chains", cmd_perf_reset, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+#else
+#define PERF_AGG_SUBCMD NULL
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
+
 static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 {
 	if (k_work_delayable_is_pending(&perf_data.dwork)) {
@@ -122,6 +412,10 @@ static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
 		    perf_data.buf_full ? "(full)" : "");
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	perf_agg_info_print(sh);
+#endif
+
 	return 0;
 }
 
@@ -151,6 +445,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
+	SHELL_COND_CMD(CONFIG_PROFILING_PERF_AGGREGATE, continuous, PERF_AGG_SUBCMD,
+		       "Aggregate samples into call chain counts"),
 	SHELL_SUBCMD_SET_END
 );
 SHELL_CMD_ARG_REGISTER(perf, &m_sub_perf, "Lightweight profiler", NULL, 0, 0);
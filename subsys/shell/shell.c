@@ -563,6 +563,10 @@ static int exec_cmd(const struct shell *sh, size_t argc, const char **argv,
 		/* Bring back mutex to shell thread. */
 		k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
 		z_flag_cmd_ctx_set(sh, false);
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+		/* Restore the colors the command left set */
+		z_transport_buffer_flush(sh);
+#endif
 	}
 
 	return ret_val;
@@ -1209,6 +1213,10 @@ static int instance_init(const struct shell *sh,
 			(sh->shell_flag == SHELL_FLAG_OLF_CRLF));
 
 	memset(sh->ctx, 0, sizeof(*sh->ctx));
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	ring_buf_init(&sh->ctx->out_ring, sizeof(sh->ctx->out_ring_buff),
+		      sh->ctx->out_ring_buff);
+#endif
 	if (CONFIG_SHELL_CMD_ROOT[0]) {
 		sh->ctx->selected_cmd = root_cmd_find(CONFIG_SHELL_CMD_ROOT);
 	}
@@ -1345,8 +1353,12 @@ void shell_thread(void *shell_handle, void *arg_log_backend,
 	}
 
 	while (true) {
-		/* waiting for all signals except SHELL_SIGNAL_TXDONE */
-		err = k_poll(sh->ctx->events, SHELL_SIGNAL_TXDONE,
+		/* waiting for all signals except SHELL_SIGNAL_TXDONE, unless
+		 * buffered output is written out on it
+		 */
+		err = k_poll(sh->ctx->events,
+			     IS_ENABLED(CONFIG_SHELL_OUTPUT_BUFFER) ?
+			     SHELL_SIGNALS : SHELL_SIGNAL_TXDONE,
 			     K_FOREVER);
 
 		if (err != 0) {
@@ -1366,6 +1378,11 @@ void shell_thread(void *shell_handle, void *arg_log_backend,
 					    shell_log_process);
 		}
 
+		if (IS_ENABLED(CONFIG_SHELL_OUTPUT_BUFFER)) {
+			shell_signal_handle(sh, SHELL_SIGNAL_TXDONE,
+					    z_shell_output_resume);
+		}
+
 		if (sh->iface->api->update) {
 			sh->iface->api->update(sh->iface);
 		}
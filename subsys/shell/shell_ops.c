@@ -427,11 +427,92 @@ static void shell_pend_on_txdone(const struct shell *sh)
 	}
 }
 
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+/* Hand buffered output to the transport straight from the ring buffer. Unless
+ * wait is set, stop as soon as the transport is busy, the shell thread picks
+ * up the rest on TXDONE.
+ */
+static void output_drain(const struct shell *sh, bool wait)
+{
+	struct ring_buf *rb = &sh->ctx->out_ring;
+	uint8_t *data;
+	uint32_t length;
+	size_t tmp_cnt;
+
+	while ((length = ring_buf_get_claim(rb, &data, sizeof(sh->ctx->out_ring_buff))) > 0) {
+		int err = sh->iface->api->write(sh->iface, data, length, &tmp_cnt);
+		(void)err;
+		__ASSERT_NO_MSG(err == 0);
+		__ASSERT_NO_MSG(length >= tmp_cnt);
+		ring_buf_get_finish(rb, tmp_cnt);
+
+		if (tmp_cnt == 0) {
+			if (!wait) {
+				break;
+			}
+
+			if (sh->ctx->state != SHELL_STATE_PANIC_MODE_ACTIVE) {
+				shell_pend_on_txdone(sh);
+			}
+		}
+	}
+}
+
+static void output_put(const struct shell *sh, const uint8_t *data, size_t length)
+{
+	while (length) {
+		uint32_t put = ring_buf_put(&sh->ctx->out_ring, data, length);
+
+		data += put;
+		length -= put;
+
+		if (length) {
+			/* Backpressure, let the transport catch up */
+			output_drain(sh, true);
+		}
+	}
+
+	if (sh->ctx->state == SHELL_STATE_PANIC_MODE_ACTIVE) {
+		output_drain(sh, true);
+	}
+}
+
+void z_shell_output_flush(const struct shell *sh)
+{
+	/* Prints of a command share the colors until the command ends */
+	if (!z_flag_cmd_ctx_get(sh)) {
+		z_shell_vt100_colors_settle(sh);
+	}
+
+	output_drain(sh, false);
+}
+
+void z_shell_output_resume(const struct shell *sh)
+{
+	output_drain(sh, false);
+}
+
+void z_shell_vt100_colors_settle(const struct shell *sh)
+{
+	if (!sh->ctx->out_col_pending) {
+		return;
+	}
+
+	sh->ctx->out_col_pending = false;
+	z_shell_vt100_colors_restore(sh, &sh->ctx->out_col);
+	z_shell_fprintf_buffer_flush(sh->fprintf_ctx);
+}
+#endif /* CONFIG_SHELL_OUTPUT_BUFFER */
+
 void z_shell_write(const struct shell *sh, const void *data,
 		 size_t length)
 {
 	__ASSERT_NO_MSG(sh && data);
 
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	z_shell_vt100_colors_settle(sh);
+	output_put(sh, data, length);
+#else
 	size_t offset = 0;
 	size_t tmp_cnt;
 
@@ -449,12 +530,18 @@ void z_shell_write(const struct shell *sh, const void *data,
 			shell_pend_on_txdone(sh);
 		}
 	}
+#endif
 }
 
 /* Function shall be only used by the fprintf module. */
 void z_shell_print_stream(const void *user_ctx, const char *data, size_t len)
 {
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	/* Colors are settled by the caller, the text may be colored */
+	output_put((const struct shell *) user_ctx, data, len);
+#else
 	z_shell_write((const struct shell *) user_ctx, data, len);
+#endif
 }
 
 static void vt100_bgcolor_set(const struct shell *sh,
@@ -518,6 +605,20 @@ void z_shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 	if (IS_ENABLED(CONFIG_SHELL_VT100_COLORS) &&
 	    z_flag_use_colors_get(sh)	  &&
 	    (color != sh->ctx->vt100_ctx.col.col)) {
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+		/* Keep the color for following prints, it is only restored
+		 * before output that is not colored.
+		 */
+		if (!sh->ctx->out_col_pending) {
+			z_shell_vt100_colors_store(sh, &sh->ctx->out_col);
+		}
+
+		sh->ctx->out_col_pending = false;
+		z_shell_vt100_color_set(sh, color);
+		sh->ctx->out_col_pending = true;
+
+		z_shell_fprintf_fmt(sh->fprintf_ctx, fmt, args);
+#else
 		struct shell_vt100_colors col;
 
 		z_shell_vt100_colors_store(sh, &col);
@@ -526,6 +627,7 @@ void z_shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 		z_shell_fprintf_fmt(sh->fprintf_ctx, fmt, args);
 
 		z_shell_vt100_colors_restore(sh, &col);
+#endif
 	} else {
 		z_shell_fprintf_fmt(sh->fprintf_ctx, fmt, args);
 	}
@@ -15,11 +15,18 @@
 extern "C" {
 #endif
 
+/* Restore the colors left set by colored prints, see z_shell_vfprintf(). */
+void z_shell_vt100_colors_settle(const struct shell *sh);
+
 static inline void z_shell_raw_fprintf(const struct shell_fprintf *const ctx,
 				       const char *fmt, ...)
 {
 	va_list args;
 
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	z_shell_vt100_colors_settle((const struct shell *)ctx->user_ctx);
+#endif
+
 	va_start(args, fmt);
 	z_shell_fprintf_fmt(ctx, fmt, args);
 	va_end(args);
@@ -83,9 +83,18 @@ void z_shell_cmd_trim(const struct shell *sh);
 
 const struct shell_static_entry *root_cmd_find(const char *syntax);
 
+/* Write out the buffered output the transport accepts without blocking. */
+void z_shell_output_flush(const struct shell *sh);
+
+/* Continue writing buffered output once the transport is ready. */
+void z_shell_output_resume(const struct shell *sh);
+
 static inline void z_transport_buffer_flush(const struct shell *sh)
 {
 	z_shell_fprintf_buffer_flush(sh->fprintf_ctx);
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	z_shell_output_flush(sh);
+#endif
 }
 
 static inline bool z_shell_in_select_mode(const struct shell *sh)
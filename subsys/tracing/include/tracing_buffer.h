@@ -113,6 +113,31 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_PERCPU_BUFFERS
+/**
+ * @brief Append a CTF event to the packet of the current CPU.
+ *
+ * Only interrupts of the current CPU are masked, other CPUs write to
+ * their own buffers in parallel.
+ *
+ * @param data Address of the event.
+ * @param size Event size (in bytes).
+ *
+ * @return true if the event was stored, or false if it was discarded.
+ */
+bool tracing_percpu_put(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Hand the complete packets of all CPUs to the backend.
+ *
+ * @param flush Also close the packets being filled so that they are
+ *              output, if they hold any event.
+ *
+ * @return Number of bytes handed to the backend.
+ */
+uint32_t tracing_percpu_drain(bool flush);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+#define PACKET_MAGIC 0xC1FC1FC1
+#define PACKET_SIZE  CONFIG_TRACING_PERCPU_PACKET_SIZE
+#define PACKET_COUNT CONFIG_TRACING_PERCPU_PACKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PACKET_COUNT),
+	     "CONFIG_TRACING_PERCPU_PACKETS must be a power of two");
+
+/* Who may access the packet being filled */
+enum {
+	OWNER_NONE,
+	OWNER_CPU,
+	OWNER_DRAIN,
+};
+
+/* Layout of struct packet_header followed by struct packet_context in the
+ * metadata. Sizes are given in bits, and the events discarded count is
+ * cumulative for the CPU as required by CTF.
+ */
+struct ctf_packet_header {
+	uint32_t magic;
+	uint32_t stream_id;
+	uint32_t timestamp_begin;
+	uint32_t timestamp_end;
+	uint32_t content_size;
+	uint32_t packet_size;
+	uint32_t events_discarded;
+	uint32_t cpu_id;
+};
+
+BUILD_ASSERT(PACKET_SIZE > sizeof(struct ctf_packet_header));
+
+struct percpu_packet {
+	union {
+		struct ctf_packet_header hdr;
+		uint8_t data[PACKET_SIZE];
+	};
+	/* Bytes used, 0 until the first event opens the packet */
+	uint32_t len;
+};
+
+/* Only the owning CPU appends to its buffer. The tracing thread hands the
+ * closed packets to the backend and reuses them afterwards, both counters only
+ * ever grow. The packet being filled is packets[closed % PACKET_COUNT].
+ */
+struct percpu_buffer {
+	struct percpu_packet packets[PACKET_COUNT];
+	atomic_t closed;
+	atomic_t drained;
+	atomic_t owner;
+	atomic_t discarded;
+};
+
+static struct percpu_buffer percpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline uint32_t timestamp_get(void)
+{
+	return k_cyc_to_ns_floor64(k_cycle_get_32());
+}
+
+static inline uint32_t event_timestamp_get(const uint8_t *data)
+{
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+	uint32_t ts;
+
+	/* Every event starts with its timestamp, no need to read the clock again */
+	memcpy(&ts, data, sizeof(ts));
+
+	return ts;
+#else
+	ARG_UNUSED(data);
+
+	return timestamp_get();
+#endif
+}
+
+static struct percpu_packet *packet_current(struct percpu_buffer *buf)
+{
+	unsigned long closed = atomic_get(&buf->closed);
+
+	if (closed - (unsigned long)atomic_get(&buf->drained) >= PACKET_COUNT) {
+		return NULL;
+	}
+
+	return &buf->packets[closed % PACKET_COUNT];
+}
+
+static void packet_close(struct percpu_buffer *buf, struct percpu_packet *pkt, uint32_t cpu)
+{
+	pkt->hdr.magic = PACKET_MAGIC;
+	pkt->hdr.stream_id = 0;
+	pkt->hdr.content_size = pkt->len * 8;
+	/* Only the used part is sent, there is no padding */
+	pkt->hdr.packet_size = pkt->len * 8;
+	pkt->hdr.events_discarded = atomic_get(&buf->discarded);
+	pkt->hdr.cpu_id = cpu;
+
+	if (!IS_ENABLED(CONFIG_TRACING_CTF_TIMESTAMP)) {
+		pkt->hdr.timestamp_end = timestamp_get();
+	}
+
+	atomic_inc(&buf->closed);
+}
+
+bool tracing_percpu_put(const uint8_t *data, uint32_t size)
+{
+	struct percpu_buffer *buf;
+	struct percpu_packet *pkt;
+	unsigned int key;
+	uint32_t cpu;
+	bool stored = false;
+
+	/* Masking local interrupts keeps us on this CPU and keeps ISRs of
+	 * this CPU out of the packet, other CPUs are not involved.
+	 */
+	key = arch_irq_lock();
+	cpu = _current_cpu->id;
+	buf = &percpu_buffers[cpu];
+
+	/* The buffer is only taken by someone else while the tracing thread
+	 * closes a partially filled packet. Do not wait for it.
+	 */
+	if (!atomic_cas(&buf->owner, OWNER_NONE, OWNER_CPU)) {
+		atomic_inc(&buf->discarded);
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	pkt = NULL;
+	if (size <= PACKET_SIZE - sizeof(struct ctf_packet_header)) {
+		pkt = packet_current(buf);
+		if (pkt != NULL && pkt->len + size > PACKET_SIZE) {
+			packet_close(buf, pkt, cpu);
+			pkt = packet_current(buf);
+		}
+	}
+
+	if (pkt != NULL) {
+		if (pkt->len == 0) {
+			pkt->hdr.timestamp_begin = event_timestamp_get(data);
+			pkt->len = sizeof(struct ctf_packet_header);
+		}
+
+		memcpy(&pkt->data[pkt->len], data, size);
+		pkt->len += size;
+
+		if (IS_ENABLED(CONFIG_TRACING_CTF_TIMESTAMP)) {
+			pkt->hdr.timestamp_end = event_timestamp_get(data);
+		}
+
+		stored = true;
+	} else {
+		atomic_inc(&buf->discarded);
+	}
+
+	atomic_set(&buf->owner, OWNER_NONE);
+	arch_irq_unlock(key);
+
+	return stored;
+}
+
+uint32_t tracing_percpu_drain(bool flush)
+{
+	uint32_t total = 0;
+
+	for (uint32_t cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct percpu_buffer *buf = &percpu_buffers[cpu];
+		struct percpu_packet *pkt;
+
+		if (flush && atomic_cas(&buf->owner, OWNER_NONE, OWNER_DRAIN)) {
+			pkt = packet_current(buf);
+			if (pkt != NULL && pkt->len > 0) {
+				packet_close(buf, pkt, cpu);
+			}
+
+			atomic_set(&buf->owner, OWNER_NONE);
+		}
+
+		while (atomic_get(&buf->drained) != atomic_get(&buf->closed)) {
+			unsigned long drained = atomic_get(&buf->drained);
+
+			pkt = &buf->packets[drained % PACKET_COUNT];
+			tracing_buffer_handle(pkt->data, pkt->len);
+			total += pkt->len;
+
+			/* Hand the packet back to the CPU */
+			pkt->len = 0;
+			atomic_inc(&buf->drained);
+		}
+	}
+
+	return total;
+}
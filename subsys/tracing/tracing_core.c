@@ -65,7 +65,18 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	while (true) {
 		if (tracing_buffer_is_empty()) {
+#ifdef CONFIG_TRACING_PERCPU_BUFFERS
+			/* CTF events bypass the shared buffer and nobody
+			 * wakes us up for them, signaling from the scheduler
+			 * hooks would take scheduler locks. Collect the
+			 * per-CPU packets periodically instead.
+			 */
+			k_sem_take(&tracing_thread_sem,
+				   K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD));
+			tracing_percpu_drain(true);
+#else
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
+#endif
 		} else {
 			transferring_length =
 				tracing_buffer_get_claim(
@@ -43,6 +43,14 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length)
 		return;
 	}
 
+#ifdef CONFIG_TRACING_PERCPU_BUFFERS
+	if (!tracing_percpu_put(data, length)) {
+		tracing_packet_drop_handle();
+	}
+
+	return;
+#endif
+
 	TRACING_LOCK();
 	before_put_is_empty = tracing_buffer_is_empty();
 	put_success = tracing_format_raw_data_put(data, length);
@@ -0,0 +1,73 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how long the log processing thread takes to hand messages to the
+ * file system backend and how often it stalls on the file system, together
+ * with the number of file system writes and syncs per kilobyte of output.
+ * Build with CONFIG_LOG_BACKEND_FS_ASYNC on and off to compare writing from
+ * the log thread with writing from the backend work queue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend_fs.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define BATCH  64
+#define ROUNDS 32
+
+ZTEST(log_backend_fs_perf, test_throughput)
+{
+	struct log_backend_fs_stats stats;
+	uint32_t start, cycles = 0;
+	uint64_t ns, kb;
+	int messages = ROUNDS * BATCH;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < BATCH; i++) {
+			LOG_INF("Sensor %d sample %u ready in %d us", i & 7,
+				round * BATCH + i, 250 + i);
+		}
+
+		start = k_cycle_get_32();
+
+		while (log_process()) {
+		}
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	log_backend_fs_flush();
+	log_backend_fs_stats_get(&stats);
+
+	ns = k_cyc_to_ns_floor64(cycles);
+	kb = MAX(stats.bytes_logged / 1024, 1);
+
+	TC_PRINT("%8llu ns per message in the log thread\n",
+		 (unsigned long long)(ns / messages));
+	TC_PRINT("%8llu bytes logged, %llu bytes written\n",
+		 (unsigned long long)stats.bytes_logged,
+		 (unsigned long long)stats.bytes_written);
+	TC_PRINT("%8llu writes per KiB, %llu syncs per KiB, %u rotations\n",
+		 (unsigned long long)(stats.writes / kb),
+		 (unsigned long long)(stats.syncs / kb), stats.rotations);
+	TC_PRINT("%8u stalls, %u us max, %llu us total\n", stats.stalls, stats.stall_max_us,
+		 (unsigned long long)stats.stall_total_us);
+
+	zassert_true(stats.bytes_written > 0, "Nothing was written");
+}
+
+static void *setup(void)
+{
+	TC_PRINT("async: %s\n", IS_ENABLED(CONFIG_LOG_BACKEND_FS_ASYNC) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_backend_fs_perf, NULL, setup, NULL, NULL, NULL);
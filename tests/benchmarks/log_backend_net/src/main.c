@@ -0,0 +1,144 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the bandwidth and the CPU time the network log backend needs per
+ * message when sending to a UDP socket on the loopback interface. Build with
+ * CONFIG_LOG_BACKEND_NET_OUTPUT_DICTIONARY on and off to compare batched
+ * binary frames with one syslog datagram per message.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_net.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define SINK_PORT  5140
+#define BATCH      64
+#define ROUNDS     16
+#define TIMEOUT_MS 1000
+
+static int sink_sock = -1;
+static atomic_t received_bytes;
+static atomic_t received_datagrams;
+
+K_THREAD_STACK_DEFINE(sink_stack, 2048);
+static struct k_thread sink_thread;
+
+static void sink_fn(void *p1, void *p2, void *p3)
+{
+	static uint8_t buf[1500];
+	int len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while ((len = zsock_recv(sink_sock, buf, sizeof(buf), 0)) >= 0) {
+		atomic_add(&received_bytes, len);
+		atomic_inc(&received_datagrams);
+	}
+}
+
+static void wait_for_sink(void)
+{
+	atomic_val_t bytes;
+
+	/* Wait until nothing more arrives */
+	do {
+		bytes = atomic_get(&received_bytes);
+		k_msleep(50);
+	} while (atomic_get(&received_bytes) != bytes);
+}
+
+static void bench(const char *what, bool with_args)
+{
+	uint32_t start, cycles = 0;
+	uint64_t ns;
+	int messages = ROUNDS * BATCH;
+
+	atomic_set(&received_bytes, 0);
+	atomic_set(&received_datagrams, 0);
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int i = 0; i < BATCH; i++) {
+			if (with_args) {
+				LOG_INF("Sensor %d sample %u ready in %d us", i & 7,
+					round * BATCH + i, 250 + i);
+			} else {
+				LOG_INF("Sensor sample ready");
+			}
+		}
+
+		start = k_cycle_get_32();
+
+		while (log_process()) {
+		}
+
+		cycles += k_cycle_get_32() - start;
+
+		/* Let the loopback interface drain before the next batch */
+		wait_for_sink();
+	}
+
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-8s %8llu ns per message, %4ld bytes per message, %4ld datagrams\n",
+		 what, (unsigned long long)(ns / messages),
+		 (long)(atomic_get(&received_bytes) / messages),
+		 (long)atomic_get(&received_datagrams));
+}
+
+ZTEST(log_backend_net_perf, test_literal)
+{
+	bench("literal", false);
+}
+
+ZTEST(log_backend_net_perf, test_args)
+{
+	bench("args", true);
+}
+
+static void *setup(void)
+{
+	const struct log_backend *backend = log_backend_net_get();
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SINK_PORT),
+	};
+	int ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	sink_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sink_sock >= 0, "Cannot create sink socket (%d)", -errno);
+
+	ret = zsock_bind(sink_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "Cannot bind sink socket (%d)", -errno);
+
+	k_thread_create(&sink_thread, sink_stack, K_THREAD_STACK_SIZEOF(sink_stack),
+			sink_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	log_backend_init(backend);
+	log_backend_enable(backend, backend->cb->ctx, LOG_LEVEL_INF);
+
+	/* Flush whatever the network stack logged while starting up */
+	while (log_process()) {
+	}
+
+	wait_for_sink();
+
+	TC_PRINT("output: %s\n",
+		 IS_ENABLED(CONFIG_LOG_BACKEND_NET_OUTPUT_DICTIONARY) ? "dictionary" : "text");
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_backend_net_perf, NULL, setup, NULL, NULL, NULL);
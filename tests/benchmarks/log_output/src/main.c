@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how many messages per second log_output_process() formats with the
+ * flags the UART and network backends use. The output is discarded, so only
+ * the formatting is timed. Build with CONFIG_LOG_OUTPUT_PREFIX_CACHE on and
+ * off to compare formatting every prefix with copying the cached one.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/ztest.h>
+
+#define MESSAGES 2000
+#define FREQ     1000000
+
+#define SNAME "bench_module"
+#define DNAME "app"
+
+/* Flags set by the UART backend with the default configuration */
+#define UART_FLAGS (LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | \
+		    LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP | LOG_OUTPUT_FLAG_COLORS)
+
+/* Flags set by the network backend when syslog output is disabled */
+#define NET_FLAGS (LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | \
+		   LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP | LOG_OUTPUT_FLAG_CRLF_LFONLY)
+
+static uint8_t uart_buf[32];
+static uint8_t net_buf[256];
+static size_t discarded;
+
+static int discard(uint8_t *buf, size_t size, void *ctx)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(ctx);
+
+	discarded += size;
+
+	return size;
+}
+
+/* Buffer sizes of the asynchronous UART backend and of the network backend,
+ * which sends a whole message at a time.
+ */
+LOG_OUTPUT_DEFINE(uart_output, discard, uart_buf, sizeof(uart_buf));
+LOG_OUTPUT_DEFINE(net_output, discard, net_buf, sizeof(net_buf));
+
+static uint8_t literal_pkg[64];
+static uint8_t args_pkg[128];
+static uint8_t hexdump[16];
+
+static void bench(const char *what, const struct log_output *output, const uint8_t *package,
+		  const uint8_t *data, size_t data_len, uint32_t flags)
+{
+	uint32_t start, cycles;
+	uint64_t ns;
+
+	discarded = 0;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < MESSAGES; i++) {
+		/* Ten messages per millisecond, all from the same source */
+		log_output_process(output, i * (FREQ / 10000), DNAME, SNAME, NULL,
+				   LOG_LEVEL_INF, package, (uint8_t *)data, data_len, flags);
+		log_output_flush(output);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-5s %-8s %8llu messages/s (%zu bytes per message)\n",
+		 output == &uart_output ? "uart" : "net", what,
+		 (unsigned long long)(ns ? (uint64_t)MESSAGES * NSEC_PER_SEC / ns : 0),
+		 discarded / MESSAGES);
+}
+
+static void bench_backend(const struct log_output *output, uint32_t flags)
+{
+	bench("literal", output, literal_pkg, NULL, 0, flags);
+	bench("args", output, args_pkg, NULL, 0, flags);
+	bench("hexdump", output, literal_pkg, hexdump, sizeof(hexdump), flags);
+}
+
+ZTEST(log_output_perf, test_uart)
+{
+	bench_backend(&uart_output, UART_FLAGS);
+}
+
+ZTEST(log_output_perf, test_net)
+{
+	bench_backend(&net_output, NET_FLAGS);
+}
+
+static void *setup(void)
+{
+	int len;
+
+	log_output_timestamp_freq_set(FREQ);
+
+	len = cbprintf_package(literal_pkg, sizeof(literal_pkg), 0,
+			       "Sensor sample ready");
+	zassert_true(len > 0);
+
+	len = cbprintf_package(args_pkg, sizeof(args_pkg), 0,
+			       "Sensor %d sample %u ready in %d us", 3, 1024U, 250);
+	zassert_true(len > 0);
+
+	for (int i = 0; i < sizeof(hexdump); i++) {
+		hexdump[i] = i * 17;
+	}
+
+	TC_PRINT("prefix cache: %s\n",
+		 IS_ENABLED(CONFIG_LOG_OUTPUT_PREFIX_CACHE) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_output_perf, NULL, setup, NULL, NULL, NULL);
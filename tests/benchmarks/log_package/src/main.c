@@ -0,0 +1,84 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of a deferred LOG_INF() call with 0 to 6 integer
+ * arguments and with a string argument. Messages go to a backend which drops
+ * them, the buffer is drained between batches outside of the measurement.
+ * Compare the default static message creation with CONFIG_LOG_ALWAYS_RUNTIME,
+ * built with CONFIG_LOG_RUNTIME_ARG_DESC off to package by parsing the format
+ * string and on to package using the argument types resolved at compile time.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define BATCH  32
+#define ROUNDS 50
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, backend_api, true);
+
+static void report(const char *what, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-10s %6llu ns per log call\n", what,
+		 (unsigned long long)(ns / (BATCH * ROUNDS)));
+}
+
+/* Time ROUNDS batches of BATCH log calls, processing the messages in between */
+#define MEASURE(what, ...) do { \
+	uint32_t _cycles = 0; \
+	for (int _r = 0; _r < ROUNDS; _r++) { \
+		uint32_t _start = k_cycle_get_32(); \
+		for (int i = 0; i < BATCH; i++) { \
+			LOG_INF(__VA_ARGS__); \
+		} \
+		_cycles += k_cycle_get_32() - _start; \
+		while (log_process()) { \
+		} \
+	} \
+	report(what, _cycles); \
+} while (false)
+
+ZTEST(log_package_perf, test_log_inf)
+{
+	char name[] = "sensor";
+
+	MEASURE("0 args", "Sensor ready");
+	MEASURE("1 arg", "Sample %d", i);
+	MEASURE("2 args", "Sample %d: %d", i, 2 * i);
+	MEASURE("3 args", "Sample %d: %d, %u", i, 2 * i, 3U);
+	MEASURE("4 args", "Sample %d: %d, %u, 0x%08x", i, 2 * i, 3U, 4U);
+	MEASURE("5 args", "Sample %d: %d, %u, 0x%08x, %d", i, 2 * i, 3U, 4U, -5);
+	MEASURE("6 args", "Sample %d: %d, %u, 0x%08x, %d, %d", i, 2 * i, 3U, 4U, -5, 6);
+	MEASURE("string", "Sample %d from %s", i, name);
+}
+
+static void *setup(void)
+{
+	TC_PRINT("runtime packaging: %s, argument descriptors: %s\n",
+		 IS_ENABLED(CONFIG_LOG_ALWAYS_RUNTIME) ? "on" : "off",
+		 IS_ENABLED(CONFIG_LOG_RUNTIME_ARG_DESC) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_package_perf, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of a deferred log call while an increasing number of CPUs
+ * log at the same time. Build with CONFIG_LOG_PERCPU_BUFFERS on and off to
+ * compare per-CPU message buffers with the single shared buffer.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define ROUNDS     2000
+#define STACK_SIZE 2048
+#define PRIORITY   K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t ready;
+static atomic_t go;
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, backend_api, true);
+
+static void logger(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t start;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start logging on all CPUs at the same time */
+	atomic_inc(&ready);
+	while (!atomic_get(&go)) {
+		arch_spin_relax();
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		LOG_INF("cpu %d round %d", id, i);
+	}
+
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void log_concurrently(int cpus)
+{
+	uint64_t total = 0;
+
+	atomic_set(&ready, 0);
+	atomic_set(&go, 0);
+
+	for (int i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger, INT_TO_POINTER(i),
+				NULL, NULL, PRIORITY, 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&threads[i], i));
+		k_thread_start(&threads[i]);
+	}
+
+	while (atomic_get(&ready) < cpus) {
+		k_msleep(1);
+	}
+
+	atomic_set(&go, 1);
+
+	for (int i = 0; i < cpus; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+		total += k_cyc_to_ns_floor64(cycles[i]);
+	}
+
+	TC_PRINT("%d CPUs logging: %6llu ns per log call\n", cpus,
+		 (unsigned long long)(total / ((uint64_t)cpus * ROUNDS)));
+
+	/* Let the processing thread drain the buffers before the next run */
+	while (log_data_pending()) {
+		k_msleep(10);
+	}
+}
+
+ZTEST(log_percpu_perf, test_concurrent_logging)
+{
+	for (int cpus = 1; cpus <= arch_num_cpus(); cpus++) {
+		log_concurrently(cpus);
+	}
+
+	for (int i = 0; i < arch_num_cpus(); i++) {
+		uint32_t dropped;
+
+		if (log_cpu_dropped_get(i, &dropped) == 0) {
+			TC_PRINT("CPU %d dropped %u messages\n", i, dropped);
+		}
+	}
+}
+
+static void *setup(void)
+{
+	TC_PRINT("per-CPU log buffers: %s\n",
+		 IS_ENABLED(CONFIG_LOG_PERCPU_BUFFERS) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_percpu_perf, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,91 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the allocation and free throughput of the different net_buf pool
+ * types, allocating and freeing buffers one at a time versus in bulk with
+ * the whole fragment chain freed at once.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+
+#define ITERATIONS 500
+#define BATCH 6
+#define BUF_SIZE 128
+
+NET_BUF_POOL_FIXED_DEFINE(fixed_pool, BATCH, BUF_SIZE, 0, NULL);
+NET_BUF_POOL_VAR_DEFINE(var_pool, BATCH, BATCH * BUF_SIZE * 2, 0, NULL);
+NET_BUF_POOL_HEAP_DEFINE(heap_pool, BATCH, 0, NULL);
+
+static uint32_t run_single(struct net_buf_pool *pool)
+{
+	struct net_buf *bufs[BATCH];
+	uint32_t start;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			bufs[j] = net_buf_alloc_len(pool, BUF_SIZE, K_NO_WAIT);
+			zassert_not_null(bufs[j], "Allocation failed");
+		}
+
+		for (int j = 0; j < BATCH; j++) {
+			net_buf_unref(bufs[j]);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t run_bulk(struct net_buf_pool *pool)
+{
+	struct net_buf *bufs[BATCH];
+	uint32_t start;
+	int ret;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = net_buf_alloc_len_bulk(pool, BUF_SIZE, bufs, BATCH,
+					     K_NO_WAIT);
+		zassert_equal(ret, 0, "Bulk allocation failed");
+
+		for (int j = 1; j < BATCH; j++) {
+			bufs[j - 1]->frags = bufs[j];
+		}
+
+		net_buf_unref(bufs[0]);
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void run_pool(const char *name, struct net_buf_pool *pool)
+{
+	uint32_t single = run_single(pool);
+	uint32_t bulk = run_bulk(pool);
+
+	TC_PRINT("%-6s pool: single %5u cycles/buf, bulk %5u cycles/buf\n",
+		 name, single / (ITERATIONS * BATCH), bulk / (ITERATIONS * BATCH));
+}
+
+ZTEST(net_buf_perf, test_fixed_pool)
+{
+	run_pool("fixed", &fixed_pool);
+}
+
+ZTEST(net_buf_perf, test_var_pool)
+{
+	run_pool("var", &var_pool);
+}
+
+ZTEST(net_buf_perf, test_heap_pool)
+{
+	run_pool("heap", &heap_pool);
+}
+
+ZTEST_SUITE(net_buf_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,142 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare the throughput of the Internet checksum routine against a plain
+ * byte-at-a-time reference implementation, and the cost of the RFC 1624
+ * incremental update against a full IPv4 header checksum.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+
+#define ITERATIONS 100
+#define BUF_SIZE 1500
+
+static uint8_t buf[BUF_SIZE + sizeof(uint64_t)];
+
+static const size_t sizes[] = { 20, 64, 256, 576, 1500 };
+
+static uint16_t ref_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+{
+	uint32_t sum = sum_in;
+	size_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += (data[i] << 8) | data[i + 1];
+	}
+
+	if (i < len) {
+		sum += data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static uint32_t cycles_to_bytes_per_kcycle(size_t len, uint32_t cycles)
+{
+	if (cycles == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)len * ITERATIONS * 1000U) / cycles);
+}
+
+static void run_size(size_t len, size_t offset)
+{
+	const uint8_t *data = buf + offset;
+	volatile uint16_t sink = 0U;
+	uint32_t start, ref_cycles, opt_cycles;
+	int i;
+
+	zassert_equal(ref_chksum(0, data, len), calc_chksum(0, data, len),
+		      "Checksum mismatch (len %zu offset %zu)", len, offset);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		sink += ref_chksum(0, data, len);
+	}
+	ref_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		sink += calc_chksum(0, data, len);
+	}
+	opt_cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("len %4zu offset %zu: reference %6u B/kcycle, "
+		 "calc_chksum %6u B/kcycle\n", len, offset,
+		 cycles_to_bytes_per_kcycle(len, ref_cycles),
+		 cycles_to_bytes_per_kcycle(len, opt_cycles));
+}
+
+static void *setup(void)
+{
+	sys_rand_get(buf, sizeof(buf));
+
+	return NULL;
+}
+
+ZTEST(net_chksum, test_chksum_throughput)
+{
+	ARRAY_FOR_EACH(sizes, i) {
+		run_size(sizes[i], 0);
+		run_size(sizes[i], 1);
+		run_size(sizes[i], 3);
+	}
+}
+
+ZTEST(net_chksum, test_chksum_incremental)
+{
+	struct net_ipv4_hdr hdr;
+	uint32_t start, full_cycles, incr_cycles;
+	uint16_t old_len;
+	int i;
+
+	memcpy(&hdr, buf, sizeof(hdr));
+	hdr.chksum = 0;
+	hdr.chksum = ~htons(calc_chksum(0, (uint8_t *)&hdr, sizeof(hdr)));
+
+	/* Verify that the updated checksum is still valid */
+	old_len = hdr.len;
+	hdr.len = htons(ntohs(old_len) + 8);
+	hdr.chksum = net_chksum_update_u16(hdr.chksum, old_len, hdr.len);
+	zassert_equal(calc_chksum(0, (uint8_t *)&hdr, sizeof(hdr)), 0xffff,
+		      "Invalid incremental checksum");
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		old_len = hdr.len;
+		hdr.len = htons(ntohs(old_len) + 1);
+		hdr.chksum = 0;
+		hdr.chksum = ~htons(calc_chksum(0, (uint8_t *)&hdr,
+						sizeof(hdr)));
+	}
+	full_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		old_len = hdr.len;
+		hdr.len = htons(ntohs(old_len) + 1);
+		hdr.chksum = net_chksum_update_u16(hdr.chksum, old_len,
+						   hdr.len);
+	}
+	incr_cycles = k_cycle_get_32() - start;
+
+	zassert_equal(calc_chksum(0, (uint8_t *)&hdr, sizeof(hdr)), 0xffff,
+		      "Invalid incremental checksum");
+
+	TC_PRINT("IPv4 header update: full %u cycles, incremental %u cycles "
+		 "(%d iterations)\n", full_cycles, incr_cycles, ITERATIONS);
+}
+
+ZTEST_SUITE(net_chksum, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,155 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how many header fields per second the HPACK coder handles: encoding
+ * the response headers of a small RPC-style API, with and without the dynamic
+ * table, decoding the matching request headers, and the Huffman coder alone.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/hpack.h>
+#include <zephyr/ztest.h>
+
+#define ITERATIONS 1000
+
+struct bench_header {
+	const char *name;
+	const char *value;
+};
+
+static const struct bench_header response_headers[] = {
+	{ ":status", "200" },
+	{ "content-type", "application/grpc" },
+	{ "grpc-encoding", "identity" },
+	{ "grpc-accept-encoding", "gzip" },
+	{ "server", "zephyr" },
+	{ "cache-control", "no-store" },
+};
+
+static const struct bench_header request_headers[] = {
+	{ ":method", "POST" },
+	{ ":scheme", "http" },
+	{ ":path", "/sensor.v1.Sensors/Read" },
+	{ ":authority", "192.0.2.1:8080" },
+	{ "content-type", "application/grpc" },
+	{ "te", "trailers" },
+	{ "user-agent", "grpc-c/1.60.0 (linux; chttp2)" },
+};
+
+static uint8_t block[512];
+static struct http_hpack_header_buf header;
+static struct http_hpack_dynamic_table table;
+
+static size_t encode_block(const struct bench_header *headers, size_t count,
+			   struct http_hpack_dynamic_table *dyn_table)
+{
+	size_t offset = 0;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		header.name = headers[i].name;
+		header.name_len = strlen(headers[i].name);
+		header.value = headers[i].value;
+		header.value_len = strlen(headers[i].value);
+
+		ret = http_hpack_encode_header_table(block + offset, sizeof(block) - offset,
+						     &header, dyn_table);
+		zassert_true(ret > 0, "Cannot encode header (%d)", ret);
+		offset += ret;
+	}
+
+	return offset;
+}
+
+static void report(const char *what, size_t fields, uint32_t cycles, size_t block_len)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-28s %8llu headers/s, %3zu bytes per block\n", what,
+		 (unsigned long long)(ns ? (uint64_t)fields * NSEC_PER_SEC / ns : 0),
+		 block_len);
+}
+
+ZTEST(net_http_hpack_perf, test_encode)
+{
+	size_t count = ARRAY_SIZE(response_headers);
+	uint32_t start, cycles;
+	size_t len = 0;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		len = encode_block(response_headers, count, NULL);
+	}
+	cycles = k_cycle_get_32() - start;
+	report("encode, static table only", count * ITERATIONS, cycles, len);
+
+	/* Every block after the first one is sent on the same connection. */
+	http_hpack_dynamic_table_init(&table);
+	(void)encode_block(response_headers, count, &table);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		len = encode_block(response_headers, count, &table);
+	}
+	cycles = k_cycle_get_32() - start;
+	report("encode, dynamic table", count * ITERATIONS, cycles, len);
+}
+
+ZTEST(net_http_hpack_perf, test_decode)
+{
+	size_t count = ARRAY_SIZE(request_headers);
+	uint32_t start, cycles;
+	size_t offset;
+	size_t len;
+	int ret;
+
+	/* Literal fields, Huffman coded when shorter, like most clients send. */
+	len = encode_block(request_headers, count, NULL);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		offset = 0;
+
+		while (offset < len) {
+			ret = http_hpack_decode_header(block + offset, len - offset, &header);
+			zassert_true(ret > 0, "Cannot decode header (%d)", ret);
+			offset += ret;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+	report("decode", count * ITERATIONS, cycles, len);
+}
+
+ZTEST(net_http_hpack_perf, test_huffman)
+{
+	static const char str[] = "grpc-c/1.60.0 (linux; chttp2)";
+	static uint8_t decoded[sizeof(str)];
+	uint32_t start, cycles;
+	int len;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		len = http_hpack_huffman_encode((const uint8_t *)str, sizeof(str) - 1,
+						block, sizeof(block));
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_true(len > 0, "Cannot encode string (%d)", len);
+	report("Huffman encode", ITERATIONS, cycles, len);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		len = http_hpack_huffman_decode(block, len, decoded, sizeof(decoded));
+		zassert_equal(len, sizeof(str) - 1, "Cannot decode string (%d)", len);
+		len = http_hpack_huffman_encode((const uint8_t *)str, sizeof(str) - 1,
+						block, sizeof(block));
+	}
+	cycles = k_cycle_get_32() - start;
+	report("Huffman decode and encode", ITERATIONS, cycles, len);
+}
+
+ZTEST_SUITE(net_http_hpack_perf, NULL, NULL, NULL, NULL, NULL);
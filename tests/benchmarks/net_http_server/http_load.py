@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host side HTTP/1.1 load generator for the HTTP server benchmark.
+
+Opens a number of keep-alive connections to the server and keeps one
+request outstanding on each of them for the given duration, then prints
+the request rate and latency percentiles.
+"""
+
+import argparse
+import asyncio
+import time
+
+REQUEST = b"GET / HTTP/1.1\r\nHost: {host}\r\n\r\n"
+
+
+async def read_response(reader):
+    header = await reader.readuntil(b"\r\n\r\n")
+    length = 0
+    for line in header.split(b"\r\n"):
+        name, _, value = line.partition(b":")
+        if name.strip().lower() == b"content-length":
+            length = int(value)
+    if length:
+        await reader.readexactly(length)
+
+
+async def client(args, deadline, latencies):
+    reader, writer = await asyncio.open_connection(args.host, args.port)
+    request = REQUEST.replace(b"{host}", args.host.encode())
+
+    while time.monotonic() < deadline:
+        start = time.perf_counter()
+        writer.write(request)
+        await writer.drain()
+        await read_response(reader)
+        latencies.append(time.perf_counter() - start)
+
+    writer.close()
+    await writer.wait_closed()
+
+
+def percentile(values, pct):
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--host", default="192.0.2.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("-c", "--connections", type=int, default=8)
+    parser.add_argument("-d", "--duration", type=float, default=10.0)
+    args = parser.parse_args()
+
+    latencies = []
+    start = time.monotonic()
+    deadline = start + args.duration
+
+    await asyncio.gather(*(client(args, deadline, latencies)
+                           for _ in range(args.connections)))
+
+    elapsed = time.monotonic() - start
+    latencies.sort()
+
+    print(f"{len(latencies)} requests in {elapsed:.1f} s over "
+          f"{args.connections} connections: "
+          f"{len(latencies) / elapsed:.0f} req/s")
+    if latencies:
+        print(f"latency p50 {percentile(latencies, 50) * 1e6:.0f} us, "
+              f"p99 {percentile(latencies, 99) * 1e6:.0f} us, "
+              f"max {latencies[-1] * 1e6:.0f} us")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,287 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Load the HTTP server with a number of keep-alive HTTP/1.1 connections over
+ * the loopback interface. Every round sends one request on each connection
+ * and then collects all the responses, so the server always has several
+ * clients ready at once. The time from sending a request to receiving the
+ * complete response is recorded for every request.
+ *
+ * A second test repeatedly loads a larger asset the way a browser reloading a
+ * page does, revalidating its cached copy when the server provides an ETag.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+#define SERVER_PORT   8080
+#define PAYLOAD_SIZE  1024
+#define ASSET_SIZE    (32 * 1024)
+#define NUM_CLIENTS   CONFIG_BENCHMARK_NUM_CLIENTS
+#define NUM_ROUNDS    CONFIG_BENCHMARK_NUM_ROUNDS
+#define NUM_REQUESTS  (NUM_CLIENTS * NUM_ROUNDS)
+
+BUILD_ASSERT(NUM_CLIENTS <= CONFIG_HTTP_SERVER_MAX_CLIENTS,
+	     "Not enough client slots in the server");
+
+static uint16_t bench_http_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(bench_http_service, "0.0.0.0", &bench_http_service_port,
+		    NUM_CLIENTS, NUM_CLIENTS, NULL);
+
+static uint8_t payload[PAYLOAD_SIZE];
+static uint8_t asset[ASSET_SIZE];
+
+static struct http_resource_detail_static static_resource_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+	},
+	.static_data = payload,
+	.static_data_len = sizeof(payload),
+};
+
+HTTP_RESOURCE_DEFINE(static_resource, bench_http_service, "/",
+		     &static_resource_detail);
+
+static struct http_resource_detail_static asset_resource_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "text/javascript",
+	},
+	.static_data = asset,
+	.static_data_len = sizeof(asset),
+};
+
+HTTP_RESOURCE_DEFINE(asset_resource, bench_http_service, "/app.js",
+		     &asset_resource_detail);
+
+static const char request[] =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"\r\n";
+
+static const char response_header[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Type: text/html\r\n"
+	"Content-Length: " STRINGIFY(PAYLOAD_SIZE) "\r\n"
+	"\r\n";
+
+#define RESPONSE_SIZE (sizeof(response_header) - 1 + PAYLOAD_SIZE)
+
+static uint32_t latency[NUM_REQUESTS];
+static uint8_t buf[RESPONSE_SIZE + 1];
+
+static int connect_client(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval optval = {
+		.tv_sec = 5,
+	};
+	int fd, ret;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "Cannot create socket (%d)", errno);
+
+	ret = zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+	zassert_ok(ret, "Cannot set timeout (%d)", errno);
+
+	zassert_equal(zsock_inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr), 1);
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "Cannot connect (%d)", errno);
+
+	return fd;
+}
+
+static void recv_response(int fd)
+{
+	size_t offset = 0;
+	int ret;
+
+	while (offset < RESPONSE_SIZE) {
+		ret = zsock_recv(fd, buf + offset, RESPONSE_SIZE - offset, 0);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		offset += ret;
+	}
+
+	zassert_mem_equal(buf, response_header, sizeof(response_header) - 1,
+			  "Unexpected response");
+}
+
+/* Receive a response of unknown header length, return its status code. */
+static int recv_asset_response(int fd, char *etag, size_t etag_size)
+{
+	size_t offset = 0;
+	size_t body_len;
+	char *hdr_end;
+	char *tag;
+	int ret;
+
+	do {
+		zassert_true(offset < sizeof(buf) - 1, "Response header too long");
+
+		ret = zsock_recv(fd, buf + offset, sizeof(buf) - 1 - offset, 0);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		offset += ret;
+		buf[offset] = '\0';
+
+		hdr_end = strstr((char *)buf, "\r\n\r\n");
+	} while (hdr_end == NULL);
+
+	tag = strstr((char *)buf, "ETag: ");
+	if (tag != NULL && tag < hdr_end) {
+		tag += sizeof("ETag: ") - 1;
+		strncpy(etag, tag, MIN(etag_size - 1, (size_t)(hdr_end - tag)));
+	}
+
+	ret = strtol((char *)buf + sizeof("HTTP/1.1 ") - 1, NULL, 10);
+	if (ret != 200) {
+		return ret;
+	}
+
+	/* Discard the body. */
+	body_len = offset - ((uint8_t *)hdr_end + 4 - buf);
+	while (body_len < ASSET_SIZE) {
+		ret = zsock_recv(fd, buf, MIN(sizeof(buf), ASSET_SIZE - body_len), 0);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		body_len += ret;
+	}
+
+	return 200;
+}
+
+static int latency_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+ZTEST(net_http_server_perf, test_http1_keepalive_load)
+{
+	uint32_t sent[NUM_CLIENTS];
+	int fds[NUM_CLIENTS];
+	uint32_t start, cycles;
+	uint64_t ns;
+	int count = 0;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_BENCHMARK_EXTERNAL_LOAD)) {
+		TC_PRINT("Serving on port %d, run http_load.py on the host\n",
+			 SERVER_PORT);
+		k_sleep(K_FOREVER);
+	}
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		fds[i] = connect_client();
+	}
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		for (int i = 0; i < NUM_CLIENTS; i++) {
+			sent[i] = k_cycle_get_32();
+			ret = zsock_send(fds[i], request, sizeof(request) - 1, 0);
+			zassert_equal(ret, sizeof(request) - 1, "send() failed (%d)", errno);
+		}
+
+		for (int i = 0; i < NUM_CLIENTS; i++) {
+			recv_response(fds[i]);
+			latency[count++] = k_cycle_get_32() - sent[i];
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		(void)zsock_close(fds[i]);
+	}
+
+	qsort(latency, NUM_REQUESTS, sizeof(latency[0]), latency_cmp);
+
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%d workers, %d clients: %llu req/s, "
+		 "latency p50 %llu us, p99 %llu us, max %llu us\n",
+		 CONFIG_HTTP_SERVER_WORKERS, NUM_CLIENTS,
+		 (unsigned long long)(ns ? (uint64_t)NUM_REQUESTS * NSEC_PER_SEC / ns : 0),
+		 (unsigned long long)k_cyc_to_us_floor64(latency[NUM_REQUESTS / 2]),
+		 (unsigned long long)k_cyc_to_us_floor64(latency[NUM_REQUESTS * 99 / 100]),
+		 (unsigned long long)k_cyc_to_us_floor64(latency[NUM_REQUESTS - 1]));
+}
+
+ZTEST(net_http_server_perf, test_http1_asset_reload)
+{
+	static const char asset_request[] =
+		"GET /app.js HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Accept-Encoding: gzip, br\r\n";
+	char etag[16] = "";
+	uint64_t total_us[2] = { 0 };
+	int count[2] = { 0 };
+	uint32_t start;
+	int status;
+	int fd;
+
+	Z_TEST_SKIP_IFDEF(CONFIG_BENCHMARK_EXTERNAL_LOAD);
+
+	fd = connect_client();
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		start = k_cycle_get_32();
+
+		(void)zsock_send(fd, asset_request, sizeof(asset_request) - 1, 0);
+		if (etag[0] != '\0') {
+			(void)zsock_send(fd, "If-None-Match: ", sizeof("If-None-Match: ") - 1, 0);
+			(void)zsock_send(fd, etag, strlen(etag), 0);
+		}
+		(void)zsock_send(fd, "\r\n\r\n", etag[0] != '\0' ? 4 : 2, 0);
+
+		status = recv_asset_response(fd, etag, sizeof(etag));
+		zassert_true(status == 200 || status == 304, "Unexpected status %d", status);
+
+		total_us[status == 304] += k_cyc_to_us_floor64(k_cycle_get_32() - start);
+		count[status == 304]++;
+	}
+
+	(void)zsock_close(fd);
+
+	TC_PRINT("%d KiB asset: full load %llu us, revalidation %llu us (%d of %d)\n",
+		 ASSET_SIZE / 1024,
+		 (unsigned long long)(count[0] ? total_us[0] / count[0] : 0),
+		 (unsigned long long)(count[1] ? total_us[1] / count[1] : 0),
+		 count[1], NUM_ROUNDS);
+}
+
+static void *setup(void)
+{
+	memset(payload, 'x', sizeof(payload));
+	memset(asset, 'a', sizeof(asset));
+
+	zassert_ok(http_server_start(), "Cannot start the server");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+}
+
+ZTEST_SUITE(net_http_server_perf, NULL, setup, NULL, NULL, teardown);
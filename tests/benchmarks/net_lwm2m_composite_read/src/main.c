@@ -0,0 +1,157 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how long the LwM2M engine takes to resolve resource paths and to
+ * answer a SenML CBOR composite read covering many object instances. Build
+ * with CONFIG_LWM2M_ENGINE_PATH_INDEX and CONFIG_LWM2M_RW_SENML_CBOR_STREAMING
+ * on and off to compare the hashed lookup and the streaming encoder with the
+ * list walk and the buffered encoder.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_observation.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_util.h"
+
+#define OBJ_COUNT    40
+#define RES_COUNT    10
+#define OBJ_ID_FIRST 32768
+#define ROUNDS       50
+
+static struct lwm2m_engine_obj objs[OBJ_COUNT];
+static struct lwm2m_engine_obj_field fields[RES_COUNT];
+static struct lwm2m_engine_obj_inst insts[OBJ_COUNT];
+static struct lwm2m_engine_res res[OBJ_COUNT][RES_COUNT];
+static struct lwm2m_engine_res_inst res_inst[OBJ_COUNT][RES_COUNT];
+static int32_t values[OBJ_COUNT][RES_COUNT];
+
+/* Object being created, the create callback is shared by all objects */
+static int creating;
+
+static struct lwm2m_obj_path_list path_buf[OBJ_COUNT];
+static sys_slist_t path_list;
+static sys_slist_t path_free_list;
+
+static struct lwm2m_message msg;
+
+static struct lwm2m_engine_obj_inst *obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	init_res_instance(res_inst[creating], RES_COUNT);
+
+	for (int r = 0; r < RES_COUNT; r++) {
+		values[creating][r] = creating * 1000 + r;
+		INIT_OBJ_RES_DATA(r, res[creating], i, res_inst[creating], j,
+				  &values[creating][r], sizeof(values[creating][r]));
+	}
+
+	insts[creating].resources = res[creating];
+	insts[creating].resource_count = i;
+
+	return &insts[creating];
+}
+
+static uint16_t obj_id(int idx)
+{
+	/* Spread the IDs like a real registry with a few standard objects */
+	return OBJ_ID_FIRST + idx * 7;
+}
+
+static void msg_reset(void)
+{
+	memset(&msg, 0, sizeof(msg));
+
+	msg.out.writer = &senml_cbor_writer;
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.cpkt.data = msg.msg_data;
+	msg.cpkt.max_len = sizeof(msg.msg_data);
+}
+
+static void report(const char *what, uint32_t cycles, int count)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-16s %8llu ns per operation\n", what,
+		 (unsigned long long)(ns / count));
+}
+
+ZTEST(net_lwm2m_composite_read_perf, test_resolve)
+{
+	uint32_t start, cycles;
+	int32_t value;
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < ROUNDS; round++) {
+		for (int o = 0; o < OBJ_COUNT; o++) {
+			for (int r = 0; r < RES_COUNT; r++) {
+				zassert_ok(lwm2m_get_s32(&LWM2M_OBJ(obj_id(o), 0, r), &value));
+			}
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(value, (OBJ_COUNT - 1) * 1000 + RES_COUNT - 1);
+	report("resource get", cycles, ROUNDS * OBJ_COUNT * RES_COUNT);
+}
+
+ZTEST(net_lwm2m_composite_read_perf, test_composite_read)
+{
+	uint32_t start, cycles = 0;
+	int ret;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		msg_reset();
+
+		start = k_cycle_get_32();
+		ret = do_composite_read_op_for_parsed_path_senml_cbor(&msg, &path_list);
+		cycles += k_cycle_get_32() - start;
+
+		zassert_ok(ret, "Composite read failed (%d)", ret);
+	}
+
+	TC_PRINT("%d records, %u bytes\n", OBJ_COUNT * RES_COUNT, msg.cpkt.offset);
+	report("composite read", cycles, ROUNDS);
+}
+
+static void *setup(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+
+	for (int r = 0; r < RES_COUNT; r++) {
+		fields[r] = (struct lwm2m_engine_obj_field)OBJ_FIELD_DATA(r, RW, S32);
+	}
+
+	lwm2m_engine_path_list_init(&path_list, &path_free_list, path_buf, ARRAY_SIZE(path_buf));
+
+	for (int o = 0; o < OBJ_COUNT; o++) {
+		objs[o].obj_id = obj_id(o);
+		objs[o].version_major = 1;
+		objs[o].fields = fields;
+		objs[o].field_count = RES_COUNT;
+		objs[o].max_instance_count = 1U;
+		objs[o].create_cb = obj_create;
+		lwm2m_register_obj(&objs[o]);
+
+		creating = o;
+		zassert_ok(lwm2m_create_obj_inst(obj_id(o), 0, &obj_inst));
+		zassert_ok(lwm2m_engine_add_path_to_list(&path_list, &path_free_list,
+							 &LWM2M_OBJ(obj_id(o), 0)));
+	}
+
+	TC_PRINT("path index: %s, streaming SenML CBOR: %s\n",
+		 IS_ENABLED(CONFIG_LWM2M_ENGINE_PATH_INDEX) ? "on" : "off",
+		 IS_ENABLED(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_lwm2m_composite_read_perf, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,372 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how many PUBLISH messages per second the MQTT client delivers to a
+ * broker stand-in on the loopback interface, for each QoS level. Without the
+ * inflight window the application waits for every acknowledgment before
+ * publishing the next message; with it, up to CONFIG_MQTT_LIB_INFLIGHT_WINDOW
+ * messages are on the wire at once.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#define BROKER_PORT    1883
+#define MESSAGES       1000
+#define PAYLOAD_SIZE   32
+#define TIMEOUT_MS     1000
+#define BROKER_BUF_LEN 2048
+
+#define PKT_TYPE_CONNECT    0x10
+#define PKT_TYPE_CONNACK    0x20
+#define PKT_TYPE_PUBLISH    0x30
+#define PKT_TYPE_PUBACK     0x40
+#define PKT_TYPE_PUBREC     0x50
+#define PKT_TYPE_PUBREL     0x60
+#define PKT_TYPE_PUBCOMP    0x70
+#define PKT_TYPE_DISCONNECT 0xE0
+
+static uint8_t rx_buffer[256];
+static uint8_t tx_buffer[256];
+static uint8_t payload[PAYLOAD_SIZE];
+static struct mqtt_client client_ctx;
+static struct sockaddr_in broker_addr;
+static struct zsock_pollfd client_fd;
+
+static atomic_t broker_published;
+static atomic_t client_acked;
+static int listen_sock = -1;
+
+K_THREAD_STACK_DEFINE(broker_stack, 2048);
+static struct k_thread broker_thread;
+
+static uint8_t broker_buf[BROKER_BUF_LEN];
+static uint8_t reply_buf[BROKER_BUF_LEN];
+
+static size_t add_reply(size_t offset, uint8_t type, const uint8_t *id)
+{
+	reply_buf[offset++] = type;
+	reply_buf[offset++] = 2;
+	reply_buf[offset++] = id[0];
+	reply_buf[offset++] = id[1];
+
+	return offset;
+}
+
+/* Parse complete packets, answer them in a single write. Returns the number
+ * of bytes consumed, or -1 once the client disconnected.
+ */
+static int broker_handle(int sock, size_t len)
+{
+	size_t offset = 0;
+	size_t reply_len = 0;
+	bool disconnect = false;
+
+	while (len - offset >= 2) {
+		uint8_t type = broker_buf[offset] & 0xF0;
+		uint8_t qos = (broker_buf[offset] >> 1) & 0x03;
+		uint32_t pkt_len = 0;
+		size_t hdr_len = 1;
+		uint8_t *body;
+
+		do {
+			if (offset + hdr_len >= len) {
+				goto out;
+			}
+
+			pkt_len |= (broker_buf[offset + hdr_len] & 0x7F) << (7 * (hdr_len - 1));
+		} while (broker_buf[offset + hdr_len++] & 0x80);
+
+		if (offset + hdr_len + pkt_len > len) {
+			break;
+		}
+
+		body = broker_buf + offset + hdr_len;
+
+		switch (type) {
+		case PKT_TYPE_CONNECT:
+			reply_buf[reply_len++] = PKT_TYPE_CONNACK;
+			reply_buf[reply_len++] = 2;
+			reply_buf[reply_len++] = 0;
+			reply_buf[reply_len++] = 0;
+			break;
+		case PKT_TYPE_PUBLISH:
+			/* Retransmissions are acknowledged, but not counted. */
+			if (!(broker_buf[offset] & 0x08)) {
+				atomic_inc(&broker_published);
+			}
+
+			if (qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+				reply_len = add_reply(reply_len, PKT_TYPE_PUBACK,
+						      body + 2 + sys_get_be16(body));
+			} else if (qos == MQTT_QOS_2_EXACTLY_ONCE) {
+				reply_len = add_reply(reply_len, PKT_TYPE_PUBREC,
+						      body + 2 + sys_get_be16(body));
+			}
+			break;
+		case PKT_TYPE_PUBREL:
+			reply_len = add_reply(reply_len, PKT_TYPE_PUBCOMP, body);
+			break;
+		case PKT_TYPE_DISCONNECT:
+			disconnect = true;
+			break;
+		default:
+			break;
+		}
+
+		offset += hdr_len + pkt_len;
+	}
+
+out:
+	if (reply_len > 0) {
+		size_t sent = 0;
+
+		while (sent < reply_len) {
+			ssize_t ret = zsock_send(sock, reply_buf + sent, reply_len - sent, 0);
+
+			if (ret < 0) {
+				return -1;
+			}
+
+			sent += ret;
+		}
+	}
+
+	return disconnect ? -1 : offset;
+}
+
+static void broker_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		size_t len = 0;
+		int sock;
+
+		sock = zsock_accept(listen_sock, NULL, NULL);
+		if (sock < 0) {
+			return;
+		}
+
+		while (true) {
+			ssize_t ret;
+
+			ret = zsock_recv(sock, broker_buf + len, sizeof(broker_buf) - len, 0);
+			if (ret <= 0) {
+				break;
+			}
+
+			len += ret;
+
+			ret = broker_handle(sock, len);
+			if (ret < 0) {
+				break;
+			}
+
+			len -= ret;
+			memmove(broker_buf, broker_buf + ret, len);
+		}
+
+		zsock_close(sock);
+	}
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const client,
+			     const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_PUBACK:
+	case MQTT_EVT_PUBCOMP:
+		atomic_inc(&client_acked);
+		break;
+
+	case MQTT_EVT_PUBREC: {
+		const struct mqtt_pubrel_param rel_param = {
+			.message_id = evt->param.pubrec.message_id,
+		};
+
+		/* Does nothing if the inflight window released it already. */
+		(void)mqtt_publish_qos2_release(client, &rel_param);
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+static void client_input(int timeout)
+{
+	int ret;
+
+	ret = zsock_poll(&client_fd, 1, timeout);
+	zassert_true(ret >= 0, "poll() error (%d)", -errno);
+
+	if (ret > 0) {
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT input failed (%d)", ret);
+	}
+}
+
+static void client_connect(void)
+{
+	int ret;
+
+	mqtt_client_init(&client_ctx);
+
+	client_ctx.broker = &broker_addr;
+	client_ctx.evt_cb = mqtt_evt_handler;
+	client_ctx.client_id.utf8 = (uint8_t *)"zephyr_bench";
+	client_ctx.client_id.size = strlen("zephyr_bench");
+	client_ctx.protocol_version = MQTT_VERSION_3_1_1;
+	client_ctx.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client_ctx.rx_buf = rx_buffer;
+	client_ctx.rx_buf_size = sizeof(rx_buffer);
+	client_ctx.tx_buf = tx_buffer;
+	client_ctx.tx_buf_size = sizeof(tx_buffer);
+
+	ret = mqtt_connect(&client_ctx);
+	zassert_ok(ret, "MQTT connect failed (%d)", ret);
+
+	client_fd.fd = client_ctx.transport.tcp.sock;
+	client_fd.events = ZSOCK_POLLIN;
+
+	client_input(TIMEOUT_MS);
+}
+
+static void publish_all(enum mqtt_qos qos, const char *what)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = qos,
+		.message.topic.topic.utf8 = (uint8_t *)"sensors/bench",
+		.message.topic.topic.size = strlen("sensors/bench"),
+		.message.payload.data = payload,
+		.message.payload.len = sizeof(payload),
+	};
+	uint32_t start, cycles;
+	uint64_t ns;
+	int ret;
+
+	atomic_set(&broker_published, 0);
+	atomic_set(&client_acked, 0);
+
+	client_connect();
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < MESSAGES; ) {
+		param.message_id = i + 1;
+
+		ret = mqtt_publish(&client_ctx, &param);
+		if (ret == -EBUSY) {
+			/* Inflight window full, wait for acknowledgments. */
+			client_input(TIMEOUT_MS);
+			continue;
+		}
+
+		zassert_ok(ret, "MQTT publish failed (%d)", ret);
+		i++;
+
+		if (qos == MQTT_QOS_0_AT_MOST_ONCE) {
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_MQTT_LIB_INFLIGHT)) {
+			client_input(0);
+			continue;
+		}
+
+		/* Without the library tracking the message, wait for the
+		 * handshake to complete before sending the next one.
+		 */
+		ret = mqtt_flush(&client_ctx);
+		zassert_ok(ret, "MQTT flush failed (%d)", ret);
+
+		while (atomic_get(&client_acked) < i) {
+			client_input(TIMEOUT_MS);
+		}
+	}
+
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT flush failed (%d)", ret);
+
+	while ((qos > MQTT_QOS_0_AT_MOST_ONCE && atomic_get(&client_acked) < MESSAGES) ||
+	       atomic_get(&broker_published) < MESSAGES) {
+		client_input(10);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-6s %8llu messages/s\n", what,
+		 (unsigned long long)(ns ? (uint64_t)MESSAGES * NSEC_PER_SEC / ns : 0));
+
+	ret = mqtt_disconnect(&client_ctx);
+	zassert_ok(ret, "MQTT disconnect failed (%d)", ret);
+
+	/* Let the TCP workqueue release TCP contexts. */
+	k_msleep(10);
+}
+
+ZTEST(net_mqtt_publish_perf, test_qos0)
+{
+	publish_all(MQTT_QOS_0_AT_MOST_ONCE, "QoS 0");
+}
+
+ZTEST(net_mqtt_publish_perf, test_qos1)
+{
+	publish_all(MQTT_QOS_1_AT_LEAST_ONCE, "QoS 1");
+}
+
+ZTEST(net_mqtt_publish_perf, test_qos2)
+{
+	publish_all(MQTT_QOS_2_EXACTLY_ONCE, "QoS 2");
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in bind_addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BROKER_PORT),
+	};
+	int reuseaddr = 1;
+	int ret;
+
+	broker_addr.sin_family = AF_INET;
+	broker_addr.sin_port = htons(BROKER_PORT);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &broker_addr.sin_addr);
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_sock >= 0, "Cannot create broker socket (%d)", -errno);
+
+	(void)zsock_setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &reuseaddr,
+			       sizeof(reuseaddr));
+
+	ret = zsock_bind(listen_sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_ok(ret, "Cannot bind broker socket (%d)", -errno);
+
+	ret = zsock_listen(listen_sock, 1);
+	zassert_ok(ret, "Cannot listen on broker socket (%d)", -errno);
+
+	memset(payload, 'z', sizeof(payload));
+
+	k_thread_create(&broker_thread, broker_stack, K_THREAD_STACK_SIZEOF(broker_stack),
+			broker_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	TC_PRINT("tx queue: %s, inflight window: %d\n",
+		 IS_ENABLED(CONFIG_MQTT_LIB_TX_QUEUE) ? "on" : "off",
+		 COND_CODE_1(CONFIG_MQTT_LIB_INFLIGHT,
+			     (CONFIG_MQTT_LIB_INFLIGHT_WINDOW), (0)));
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_mqtt_publish_perf, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,86 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the time spent in the receive packet filter per packet depending
+ * on the number of installed rules. Every rule checks the Ethernet type and
+ * the packet size and none of them matches, so the whole list is evaluated
+ * before the final accept rule.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+#define ITERATIONS 1000
+#define MAX_RULES 64
+#define PKT_SIZE 200
+
+#define RULE_DEFINE(i, _)						\
+	static NPF_ETH_TYPE_MATCH(type_##i, 0x1000 + (i));		\
+	static NPF_SIZE_MAX(size_##i, 1500);				\
+	static NPF_RULE(rule_##i, NET_DROP, type_##i, size_##i)
+
+#define RULE_PTR(i, _) &rule_##i
+
+LISTIFY(MAX_RULES, RULE_DEFINE, (;));
+
+static struct npf_rule *rules[] = {
+	LISTIFY(MAX_RULES, RULE_PTR, (,))
+};
+
+static const int rule_counts[] = { 0, 1, 8, 16, 32, 64 };
+
+static struct net_pkt *build_pkt(void)
+{
+	struct net_eth_hdr hdr = {
+		.src = { { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 } },
+		.dst = { { 0x00, 0x66, 0x77, 0x88, 0x99, 0xaa } },
+		.type = htons(NET_ETH_PTYPE_IP),
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, PKT_SIZE, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+	zassert_ok(net_pkt_memset(pkt, 0, PKT_SIZE - sizeof(hdr)));
+
+	return pkt;
+}
+
+ZTEST(net_pkt_filter_perf, test_recv_filter)
+{
+	struct net_pkt *pkt = build_pkt();
+	int installed = 0;
+
+	npf_append_recv_rule(&npf_default_ok);
+
+	ARRAY_FOR_EACH(rule_counts, i) {
+		uint32_t start, cycles;
+
+		while (installed < rule_counts[i]) {
+			npf_insert_recv_rule(rules[installed++]);
+		}
+
+		start = k_cycle_get_32();
+
+		for (int j = 0; j < ITERATIONS; j++) {
+			zassert_true(net_pkt_filter_recv_ok(pkt), "Packet dropped");
+		}
+
+		cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("%2d rules: %6llu ns/packet\n", rule_counts[i],
+			 (unsigned long long)k_cyc_to_ns_floor64(cycles) / ITERATIONS);
+	}
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+	net_pkt_unref(pkt);
+}
+
+ZTEST_SUITE(net_pkt_filter_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,351 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the per-packet cost of the IPv4 stack for UDP and TCP over the
+ * loopback interface, and for UDP packets received from a dummy L2 interface.
+ *
+ * Each packet is split in two stages: the call handing the packet to the
+ * stack (zsock_sendto()/zsock_send(), or net_recv_data() for the dummy
+ * interface) and the rest of the path until zsock_recv() returns it. The
+ * test thread is cooperative, so the net_tc, IP, connection demux and socket
+ * delivery work all runs in the second stage.
+ *
+ * Enable CONFIG_NET_PKT_RXTIME_STATS_DETAIL (the .detail variant) to also
+ * report the receive time spent in L2, the net_tc queue, IP and connection
+ * demux and socket delivery. This split is not measured here but taken from
+ * the statistics of the stack, which uses k_cycle_get_32(). That counter does
+ * not advance while code runs on native_sim, so the variant excludes it.
+ *
+ * On native_sim the timing functions count host nanoseconds, see
+ * CONFIG_NATIVE_SIM_HOST_TIMING.
+ */
+
+#include <inttypes.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/socket.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define PACKETS      500
+#define WARMUP       16
+#define PAYLOAD_SIZE 64
+#define UDP_PORT     4242
+#define TCP_PORT     4243
+#define INJECT_PORT  4244
+
+static uint8_t payload[PAYLOAD_SIZE];
+static uint8_t rx_buf[PAYLOAD_SIZE];
+
+static const struct in_addr bench_addr = { { { 192, 0, 2, 1 } } };
+static const struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static const struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static struct net_if *bench_iface;
+
+static int tx_sock = -1;
+static int rx_sock = -1;
+static int listen_sock = -1;
+static struct sockaddr_in dst_addr;
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+	bench_iface = iface;
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_bench, "net_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL) && defined(CONFIG_NET_STATISTICS_USER_API)
+static const char *const rx_stages[] = {
+	"L2 receive",
+	"net_tc queue",
+	"IP + conn demux",
+	"socket delivery",
+};
+
+BUILD_ASSERT(ARRAY_SIZE(rx_stages) == NET_PKT_DETAIL_STATS_COUNT);
+
+static struct net_stats stats_start;
+
+static void detail_start(void)
+{
+	(void)net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats_start, sizeof(stats_start));
+}
+
+static void detail_report(void)
+{
+	static struct net_stats stats;
+
+	(void)net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats, sizeof(stats));
+
+	for (size_t i = 0; i < ARRAY_SIZE(rx_stages); i++) {
+		uint64_t sum = stats.rx_time_detail[i].sum - stats_start.rx_time_detail[i].sum;
+		uint32_t count = stats.rx_time_detail[i].count -
+				 stats_start.rx_time_detail[i].count;
+
+		TC_PRINT("  %-18s %8" PRIu64 " ns/pkt (stack stats, %u pkts)\n", rx_stages[i],
+			 count != 0U ? (sum * NSEC_PER_USEC) / count : 0U, count);
+	}
+}
+#else
+static void detail_start(void)
+{
+}
+
+static void detail_report(void)
+{
+}
+#endif
+
+/* Push one packet through the stack, filling in the timestamps taken before
+ * the packet is handed over, after the call handing it over returned and
+ * after it was received.
+ */
+typedef void (*packet_fn)(timing_t t[3]);
+
+static void run(const char *name, const char *const stages[2], packet_fn packet)
+{
+	uint64_t cycles[2] = { 0 };
+	uint64_t total, ns;
+	timing_t t[3];
+
+	for (int i = 0; i < WARMUP; i++) {
+		packet(t);
+	}
+
+	detail_start();
+
+	for (int i = 0; i < PACKETS; i++) {
+		packet(t);
+		cycles[0] += timing_cycles_get(&t[0], &t[1]);
+		cycles[1] += timing_cycles_get(&t[1], &t[2]);
+	}
+
+	total = cycles[0] + cycles[1];
+	ns = timing_cycles_to_ns(total);
+
+	TC_PRINT("%s: %" PRIu64 " cycles/pkt, %" PRIu64 " pkts/s\n", name, total / PACKETS,
+		 ns != 0U ? ((uint64_t)PACKETS * NSEC_PER_SEC) / ns : 0U);
+	for (int i = 0; i < 2; i++) {
+		TC_PRINT("  %-18s %8" PRIu64 " cycles/pkt\n", stages[i], cycles[i] / PACKETS);
+	}
+
+	detail_report();
+}
+
+static int socket_create(int type, int proto, uint16_t port)
+{
+	struct timeval timeo = { .tv_sec = 1 };
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+	};
+	int sock;
+
+	sock = zsock_socket(AF_INET, type, proto);
+	zassert_true(sock >= 0, "socket failed (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo)));
+
+	if (port != 0U) {
+		zassert_ok(zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)),
+			   "bind failed (%d)", errno);
+	}
+
+	return sock;
+}
+
+static void recv_timed(int sock, timing_t *t)
+{
+	ssize_t ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_WAITALL);
+
+	*t = timing_counter_get();
+	zassert_equal(ret, sizeof(rx_buf), "packet lost (%d, errno %d)", (int)ret, errno);
+}
+
+static void udp_packet(timing_t t[3])
+{
+	ssize_t ret;
+
+	t[0] = timing_counter_get();
+	ret = zsock_sendto(tx_sock, payload, sizeof(payload), 0, (struct sockaddr *)&dst_addr,
+			   sizeof(dst_addr));
+	t[1] = timing_counter_get();
+	zassert_equal(ret, sizeof(payload), "sendto failed (%d)", errno);
+
+	recv_timed(rx_sock, &t[2]);
+}
+
+ZTEST(net_stack, test_udp_loopback)
+{
+	static const char *const stages[] = { "zsock_sendto", "to zsock_recv" };
+
+	rx_sock = socket_create(SOCK_DGRAM, IPPROTO_UDP, UDP_PORT);
+	tx_sock = socket_create(SOCK_DGRAM, IPPROTO_UDP, 0);
+	dst_addr.sin_port = htons(UDP_PORT);
+
+	run("UDP loopback", stages, udp_packet);
+}
+
+static void tcp_packet(timing_t t[3])
+{
+	ssize_t ret;
+
+	t[0] = timing_counter_get();
+	ret = zsock_send(tx_sock, payload, sizeof(payload), 0);
+	t[1] = timing_counter_get();
+	zassert_equal(ret, sizeof(payload), "send failed (%d)", errno);
+
+	recv_timed(rx_sock, &t[2]);
+}
+
+ZTEST(net_stack, test_tcp_loopback)
+{
+	static const char *const stages[] = { "zsock_send", "to zsock_recv" };
+
+	listen_sock = socket_create(SOCK_STREAM, IPPROTO_TCP, TCP_PORT);
+	zassert_ok(zsock_listen(listen_sock, 1));
+
+	tx_sock = socket_create(SOCK_STREAM, IPPROTO_TCP, 0);
+	dst_addr.sin_port = htons(TCP_PORT);
+	zassert_ok(zsock_connect(tx_sock, (struct sockaddr *)&dst_addr, sizeof(dst_addr)),
+		   "connect failed (%d)", errno);
+
+	rx_sock = zsock_accept(listen_sock, NULL, NULL);
+	zassert_true(rx_sock >= 0, "accept failed (%d)", errno);
+
+	run("TCP loopback", stages, tcp_packet);
+}
+
+static struct net_pkt *inject_pkt_create(void)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(bench_iface, sizeof(payload), AF_INET, IPPROTO_UDP,
+					   K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &bench_addr) < 0 ||
+	    net_udp_create(pkt, htons(INJECT_PORT), htons(INJECT_PORT)) < 0 ||
+	    net_pkt_write(pkt, payload, sizeof(payload)) < 0) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static void inject_packet(timing_t t[3])
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	/* Building the packet stands for the driver filling it in and is not
+	 * part of the measurement.
+	 */
+	pkt = inject_pkt_create();
+	zassert_not_null(pkt, "out of packets");
+
+	t[0] = timing_counter_get();
+	ret = net_recv_data(bench_iface, pkt);
+	t[1] = timing_counter_get();
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+	zassert_ok(ret, "net_recv_data failed (%d)", ret);
+
+	recv_timed(rx_sock, &t[2]);
+}
+
+ZTEST(net_stack, test_udp_dummy_l2)
+{
+	static const char *const stages[] = { "net_recv_data", "to zsock_recv" };
+
+	rx_sock = socket_create(SOCK_DGRAM, IPPROTO_UDP, INJECT_PORT);
+
+	run("UDP dummy L2", stages, inject_packet);
+}
+
+static void *setup(void)
+{
+	struct net_if_addr *ifaddr;
+
+	zassert_not_null(bench_iface, "no benchmark interface");
+
+	ifaddr = net_if_ipv4_addr_add(bench_iface, (struct in_addr *)&bench_addr,
+				      NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "cannot add address");
+	net_if_ipv4_set_netmask_by_addr(bench_iface, &bench_addr, &netmask);
+
+	dst_addr.sin_family = AF_INET;
+	dst_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)i;
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void close_sock(int *sock)
+{
+	if (*sock >= 0) {
+		(void)zsock_close(*sock);
+		*sock = -1;
+	}
+}
+
+static void after(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	close_sock(&tx_sock);
+	close_sock(&rx_sock);
+	close_sock(&listen_sock);
+}
+
+static void teardown(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(net_stack, NULL, setup, NULL, after, teardown);
@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure how many bytes per second a command printing many lines gets
+ * through the shell, plain and colored, on the dummy backend and, when
+ * CONFIG_SHELL_BACKEND_SERIAL is enabled, on the UART backend. Build with
+ * CONFIG_SHELL_OUTPUT_BUFFER on and off to compare writing every print to the
+ * transport with writing from the output ring buffer. The time of each round
+ * lasts until the transport has sent all of the output.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/shell/shell_uart.h>
+#include <zephyr/ztest.h>
+
+#define LINES  64
+#define ROUNDS 20
+
+#define LINE "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnop"
+
+static int cmd_lines(const struct shell *sh, size_t argc, char **argv)
+{
+	bool color = (strcmp(argv[1], "color") == 0);
+
+	for (int i = 0; i < LINES; i++) {
+		if (color) {
+			shell_warn(sh, "%s", LINE);
+		} else {
+			shell_print(sh, "%s", LINE);
+		}
+	}
+
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(bench_lines, NULL, "Print lines, plain or color", cmd_lines, 2, 0);
+
+static void report(const char *what, uint32_t cycles, size_t bytes)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%-24s %8llu bytes/s\n", what,
+		 ns ? (unsigned long long)(bytes * NSEC_PER_SEC / ns) : 0ULL);
+}
+
+/* Wait until the output has left the device, not just reached a buffer on
+ * its way to the UART. Polling and asynchronous UART writes return once sent.
+ */
+static void drain(const struct shell *sh)
+{
+#if defined(CONFIG_SHELL_OUTPUT_BUFFER)
+	while (!ring_buf_is_empty(&sh->ctx->out_ring)) {
+		k_usleep(100);
+	}
+#endif
+
+#if defined(CONFIG_SHELL_BACKEND_SERIAL_API_INTERRUPT_DRIVEN)
+	if (sh == shell_backend_uart_get_ptr()) {
+		struct shell_uart_int_driven *sh_uart = sh->iface->ctx;
+
+		while (atomic_get(&sh_uart->tx_busy) != 0) {
+			k_usleep(100);
+		}
+	}
+#endif
+}
+
+static uint32_t run(const struct shell *sh, const char *cmd, size_t *out)
+{
+	uint32_t start, cycles = 0;
+	size_t size;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		if (sh == shell_backend_dummy_get_ptr()) {
+			shell_backend_dummy_clear_output(sh);
+		}
+
+		start = k_cycle_get_32();
+		zassert_ok(shell_execute_cmd(sh, cmd));
+		drain(sh);
+		cycles += k_cycle_get_32() - start;
+
+		if (sh == shell_backend_dummy_get_ptr()) {
+			(void)shell_backend_dummy_get_output(sh, &size);
+			*out += size;
+		}
+	}
+
+	return cycles;
+}
+
+static void bench(const struct shell *sh, const char *backend)
+{
+	size_t payload = ROUNDS * LINES * (sizeof(LINE) + 1);
+	size_t out_plain = 0;
+	size_t out_color = 0;
+	uint32_t cycles;
+	char what[32];
+
+	cycles = run(sh, "bench_lines plain", &out_plain);
+	snprintk(what, sizeof(what), "%s plain", backend);
+	report(what, cycles, payload);
+
+	cycles = run(sh, "bench_lines color", &out_color);
+	snprintk(what, sizeof(what), "%s color", backend);
+	report(what, cycles, payload);
+
+	if (out_color) {
+		TC_PRINT("%s output: %zu bytes plain, %zu bytes color\n", backend,
+			 out_plain, out_color);
+	}
+}
+
+ZTEST(shell_output_perf, test_dummy)
+{
+	bench(shell_backend_dummy_get_ptr(), "dummy");
+}
+
+ZTEST(shell_output_perf, test_uart)
+{
+#if defined(CONFIG_SHELL_BACKEND_SERIAL)
+	bench(shell_backend_uart_get_ptr(), "uart");
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void *setup(void)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+	WAIT_FOR(shell_ready(sh), 20000, k_msleep(1));
+	zassert_true(shell_ready(sh), "timed out waiting for dummy shell backend");
+
+	TC_PRINT("output buffer: %s\n",
+		 IS_ENABLED(CONFIG_SHELL_OUTPUT_BUFFER) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(shell_output_perf, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,100 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of emitting a CTF event while an increasing number of CPUs
+ * trace at the same time. Build with CONFIG_TRACING_PERCPU_BUFFERS on and off
+ * to compare per-CPU packet buffers with the shared, interrupt locked, ring
+ * buffer.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/tracing/tracing.h>
+
+#define ROUNDS     400
+#define STACK_SIZE 2048
+#define PRIORITY   K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t ready;
+static atomic_t go;
+
+static void tracer(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t start;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start tracing on all CPUs at the same time */
+	atomic_inc(&ready);
+	while (!atomic_get(&go)) {
+		arch_spin_relax();
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		sys_trace_named_event("bench", id, i);
+	}
+
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void trace_concurrently(int cpus)
+{
+	uint64_t total = 0;
+
+	atomic_set(&ready, 0);
+	atomic_set(&go, 0);
+
+	for (int i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, tracer, INT_TO_POINTER(i),
+				NULL, NULL, PRIORITY, 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&threads[i], i));
+		k_thread_start(&threads[i]);
+	}
+
+	while (atomic_get(&ready) < cpus) {
+		k_msleep(1);
+	}
+
+	atomic_set(&go, 1);
+
+	for (int i = 0; i < cpus; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+		total += cycles[i];
+	}
+
+	total /= (uint64_t)cpus * ROUNDS;
+
+	TC_PRINT("%d CPUs tracing: %6llu cycles, %6llu ns per event\n", cpus,
+		 (unsigned long long)total,
+		 (unsigned long long)k_cyc_to_ns_floor64(total));
+
+	/* Let the tracing thread drain the buffers before the next run */
+	k_msleep(2 * CONFIG_TRACING_THREAD_WAIT_THRESHOLD);
+}
+
+ZTEST(tracing_percpu_perf, test_concurrent_tracing)
+{
+	for (int cpus = 1; cpus <= arch_num_cpus(); cpus++) {
+		trace_concurrently(cpus);
+	}
+}
+
+static void *setup(void)
+{
+	TC_PRINT("per-CPU trace buffers: %s\n",
+		 IS_ENABLED(CONFIG_TRACING_PERCPU_BUFFERS) ? "on" : "off");
+
+	return NULL;
+}
+
+ZTEST_SUITE(tracing_percpu_perf, NULL, setup, NULL, NULL, NULL);
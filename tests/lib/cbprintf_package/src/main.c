@@ -936,6 +936,128 @@ ZTEST(cbprintf_package, test_cbprintf_package_convert_static)
 
 }
 
+#ifdef CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+static int package_desc(void *packaged, size_t len, uint32_t flags,
+			const uint8_t *arg_types, const char *fmt, ...)
+{
+	va_list ap;
+	int rc;
+
+	va_start(ap, fmt);
+	rc = cbvprintf_package_desc(packaged, len, flags, arg_types, fmt, ap);
+	va_end(ap);
+
+	return rc;
+}
+
+/* Package built from the argument types must be identical to the one built
+ * by parsing the format string.
+ */
+#define TEST_PACKAGING_DESC(flags, ...) do { \
+	static const uint8_t arg_types[] = CBPRINTF_PACKAGE_ARG_TYPES(__VA_ARGS__); \
+	int len = cbprintf_package(NULL, 0, flags, __VA_ARGS__); \
+	zassert_true(len > 0, "cbprintf_package() returned %d", len); \
+	zassert_equal(package_desc(NULL, 0, flags, arg_types, __VA_ARGS__), len); \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) exp_package[len]; \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) desc_package[len]; \
+	memset(exp_package, 0, len); \
+	memset(desc_package, 0, len); \
+	zassert_equal(cbprintf_package(exp_package, len, flags, __VA_ARGS__), len); \
+	zassert_equal(package_desc(desc_package, len, flags, arg_types, __VA_ARGS__), len); \
+	zassert_mem_equal(exp_package, desc_package, len); \
+} while (0)
+
+ZTEST(cbprintf_package, test_cbprintf_package_desc)
+{
+	static const char ro_str[] = "ro";
+	char rw_str[] = "rw";
+	short s = -300;
+	char c = 'a';
+	long li = -1111111111;
+	long long lli = 0x1122334455667788;
+	void *vp = &s;
+
+	TEST_PACKAGING_DESC(0, "no args");
+	TEST_PACKAGING_DESC(0, "test %d %hd %c", 100, s, c);
+	TEST_PACKAGING_DESC(0, "test %x %lx %llx %x", 0xb1b2b3b4, li, lli, 0xe4e3e2e1);
+	TEST_PACKAGING_DESC(0, "test %*d %p", 5, 10, vp);
+	TEST_PACKAGING_DESC(0, "test %s %s", ro_str, rw_str);
+	TEST_PACKAGING_DESC(CBPRINTF_PACKAGE_ADD_RW_STR_POS, "test %s %d %s", ro_str, 1, rw_str);
+	TEST_PACKAGING_DESC(CBPRINTF_PACKAGE_ADD_RO_STR_POS | CBPRINTF_PACKAGE_ADD_RW_STR_POS,
+			    "test %s %d %s", ro_str, 1, rw_str);
+	/* '*' arguments must not shift the string argument indexes. */
+	TEST_PACKAGING_DESC(CBPRINTF_PACKAGE_ADD_RW_STR_POS, "test %*s %.*s", 4, rw_str, 1, rw_str);
+	TEST_PACKAGING_DESC(CBPRINTF_PACKAGE_ADD_STRING_IDXS | CBPRINTF_PACKAGE_ADD_RW_STR_POS,
+			    "test %.*s %*d %s", 1, ro_str, 3, 10, rw_str);
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_FP_SUPPORT)) {
+		double d = 1.2333;
+
+		TEST_PACKAGING_DESC(0, "test %x %f %x", 0xb1b2b3b4, d, 0xe4e3e2e1);
+	}
+}
+#endif /* CONFIG_CBPRINTF_PACKAGE_ARG_DESC */
+
+#ifdef CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS
+/* Tagged arguments do not match the format string, so they cannot be passed to
+ * cbprintf_package() directly.
+ */
+static int package_tagged(void *packaged, size_t len, uint32_t flags, const char *fmt, ...)
+{
+	va_list ap;
+	int rc;
+
+	va_start(ap, fmt);
+	rc = cbvprintf_package(packaged, len, flags | CBPRINTF_PACKAGE_ARGS_ARE_TAGGED, fmt, ap);
+	va_end(ap);
+
+	return rc;
+}
+
+/* Tagged package must store the same string argument indexes as the one built
+ * by parsing the format string, which counts conversions and not arguments.
+ */
+ZTEST(cbprintf_package, test_cbprintf_package_tagged_str_idx)
+{
+	char rw_str[] = "rw";
+	uint32_t flags = CBPRINTF_PACKAGE_ADD_RW_STR_POS;
+
+#define TEST_FMT "test %*s %.*s %s"
+#define TEST_ARGS 4, rw_str, 1, rw_str, rw_str
+	int len = cbprintf_package(NULL, 0, flags, TEST_FMT, TEST_ARGS);
+	int tlen = package_tagged(NULL, 0, flags, TEST_FMT, Z_CBPRINTF_TAGGED_ARGS(5, TEST_ARGS));
+
+	zassert_true(len > 0);
+	zassert_true(tlen > 0);
+
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) package[len];
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) tpackage[tlen];
+
+	zassert_equal(cbprintf_package(package, len, flags, TEST_FMT, TEST_ARGS), len);
+	zassert_equal(package_tagged(tpackage, tlen, flags, TEST_FMT,
+				     Z_CBPRINTF_TAGGED_ARGS(5, TEST_ARGS)), tlen);
+#undef TEST_ARGS
+#undef TEST_FMT
+
+	struct cbprintf_package_desc *hdr = (struct cbprintf_package_desc *)package;
+	struct cbprintf_package_desc *thdr = (struct cbprintf_package_desc *)tpackage;
+
+	zassert_equal(hdr->rw_str_cnt, 3);
+	zassert_equal(thdr->rw_str_cnt, 3);
+
+	/* Read-write string locations follow the arguments as pairs of the
+	 * argument index and the pointer position.
+	 */
+	uint8_t *idx = &package[hdr->len * sizeof(int) + hdr->ro_str_cnt];
+	uint8_t *tidx = &tpackage[thdr->len * sizeof(int) + thdr->ro_str_cnt];
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(idx[2 * i], i);
+		zassert_equal(tidx[2 * i], i, "%d: unexpected index %d", i, tidx[2 * i]);
+	}
+}
+#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+
 /**
  * @brief Log information about variable sizes and alignment.
  *
@@ -71,6 +71,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, 6, FIXED_BUFFER_SIZE, USER_DATA_FIXED, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -980,5 +981,87 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 	net_buf_unref(buf);
 }
 
+ZTEST(net_buf_tests, test_net_buf_bulk)
+{
+	struct net_buf *bufs[6];
+	struct net_buf *extra[2];
+	struct net_buf *head;
+	int ret;
+
+	ret = net_buf_alloc_bulk(&bulk_pool, bufs, 4, K_NO_WAIT);
+	zassert_equal(ret, 0, "Bulk allocation failed (%d)", ret);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_not_null(bufs[i], "Missing buffer %d", i);
+		zassert_equal(bufs[i]->ref, 1, "Invalid ref count");
+		zassert_equal(bufs[i]->size, FIXED_BUFFER_SIZE, "Invalid size");
+		zassert_is_null(bufs[i]->frags, "Unexpected fragment");
+	}
+
+	/* Not enough buffers left, nothing must be taken from the pool */
+	ret = net_buf_alloc_bulk(&bulk_pool, extra, 3, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "Bulk allocation should fail");
+
+	ret = net_buf_alloc_bulk(&bulk_pool, extra, 2, K_NO_WAIT);
+	zassert_equal(ret, 0, "Bulk allocation failed (%d)", ret);
+
+	zassert_is_null(net_buf_alloc(&bulk_pool, K_NO_WAIT),
+			"Pool should be empty");
+
+	/* Free the whole chain in one go */
+	head = bufs[0];
+	for (int i = 1; i < 4; i++) {
+		net_buf_frag_add(head, bufs[i]);
+	}
+
+	net_buf_frag_add(head, extra[0]);
+	net_buf_frag_add(head, extra[1]);
+	net_buf_unref(head);
+
+	net_buf_pool_cache_flush(&bulk_pool);
+
+	ret = net_buf_alloc_bulk(&bulk_pool, bufs, ARRAY_SIZE(bufs), K_NO_WAIT);
+	zassert_equal(ret, 0, "Chain was not returned to the pool");
+
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
+ZTEST(net_buf_tests, test_net_buf_bulk_var)
+{
+	struct net_buf *bufs[10];
+	int destroy_count = destroy_called;
+	int ret;
+
+	ret = net_buf_alloc_len_bulk(&var_pool, 200, bufs, 4, K_NO_WAIT);
+	zassert_equal(ret, 0, "Bulk allocation failed (%d)", ret);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_true(bufs[i]->size >= 200, "Invalid size");
+		net_buf_add_mem(bufs[i], example_data, sizeof(example_data));
+	}
+
+	net_buf_frag_add(bufs[0], bufs[1]);
+	net_buf_frag_add(bufs[0], bufs[2]);
+	net_buf_frag_add(bufs[0], bufs[3]);
+
+	/* Custom destroy callbacks are still called for every fragment */
+	net_buf_unref(bufs[0]);
+	zassert_equal(destroy_called - destroy_count, 4,
+		      "Destroy callback not called for all fragments");
+
+	/* The data pool cannot fit these, no buffer may be leaked */
+	ret = net_buf_alloc_len_bulk(&var_pool, 1000, bufs, 2, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "Bulk allocation should fail");
+
+	ret = net_buf_alloc_len_bulk(&var_pool, 0, bufs, ARRAY_SIZE(bufs),
+				     K_NO_WAIT);
+	zassert_equal(ret, 0, "Buffers leaked after failed allocation");
+
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
 
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
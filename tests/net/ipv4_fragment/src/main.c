@@ -203,6 +203,7 @@ static void check_ipv4_fragment_header(struct net_pkt *pkt, const uint8_t *orig_
 {
 	uint16_t pkt_len;
 	uint16_t pkt_offset;
+	uint16_t chksum;
 	uint8_t pkt_flags;
 	const struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
 
@@ -235,6 +236,15 @@ static void check_ipv4_fragment_header(struct net_pkt *pkt, const uint8_t *orig_
 	zassert_equal(net_pkt_get_len(pkt), pkt_len, "IPv4 header length mismatch");
 	zassert_equal(pkt_offset, current_length, "IPv4 header length mismatch");
 	zassert_equal(net_calc_chksum_ipv4(pkt), 0, "IPv4 header checksum mismatch");
+
+	/* The checksum may have been updated incrementally, it must be the one
+	 * a full recompute gives.
+	 */
+	chksum = hdr->chksum;
+	NET_IPV4_HDR(pkt)->chksum = 0;
+	zassert_equal(chksum, net_calc_chksum_ipv4(pkt),
+		      "IPv4 header checksum differs from a full recompute");
+	NET_IPV4_HDR(pkt)->chksum = chksum;
 }
 
 static int sender_iface(const struct device *dev, struct net_pkt *pkt)
@@ -595,7 +605,7 @@ static void *test_setup(void)
 	return NULL;
 }
 
-ZTEST(net_ipv4_fragment, test_udp)
+static void udp_fragment_test(bool set_chksum)
 {
 	struct net_pkt *pkt;
 	int ret;
@@ -631,7 +641,9 @@ ZTEST(net_ipv4_fragment, test_udp)
 	/* Update IPv4 headers */
 	packet_len = net_pkt_get_len(pkt);
 	NET_IPV4_HDR(pkt)->len = htons(packet_len);
-	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+	if (set_chksum) {
+		NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+	}
 
 	net_pkt_cursor_init(pkt);
 	net_pkt_set_overwrite(pkt, true);
@@ -661,6 +673,19 @@ ZTEST(net_ipv4_fragment, test_udp)
 		      "Packet size mismatch");
 }
 
+ZTEST(net_ipv4_fragment, test_udp)
+{
+	udp_fragment_test(true);
+}
+
+/* The header checksum is left unset, e.g. by a raw socket, the fragments must
+ * still get a valid one.
+ */
+ZTEST(net_ipv4_fragment, test_udp_unset_chksum)
+{
+	udp_fragment_test(false);
+}
+
 ZTEST(net_ipv4_fragment, test_tcp)
 {
 	struct net_pkt *pkt;
@@ -0,0 +1,486 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVER_PORT 5683
+#define BODY_SIZE   1000
+#define UPLOAD_MAX  512
+#define TIMEOUT_MS  1000
+
+static uint8_t body[BODY_SIZE];
+static uint8_t upload[UPLOAD_MAX];
+static size_t upload_len;
+static bool upload_done;
+
+static int body_read(struct coap_resource *resource, const struct sockaddr *addr, size_t offset,
+		     uint8_t *buf, size_t len, void *user_data)
+{
+	ARG_UNUSED(resource);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(user_data);
+
+	if (offset >= sizeof(body)) {
+		return 0;
+	}
+
+	len = MIN(len, sizeof(body) - offset);
+	memcpy(buf, body + offset, len);
+
+	return len;
+}
+
+static int upload_write(struct coap_resource *resource, const struct sockaddr *addr,
+			size_t offset, const uint8_t *buf, size_t len, bool last, void *user_data)
+{
+	ARG_UNUSED(resource);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(user_data);
+
+	if (offset + len > sizeof(upload)) {
+		return -EFBIG;
+	}
+
+	memcpy(upload + offset, buf, len);
+	upload_len = offset + len;
+	upload_done = last;
+
+	return 0;
+}
+
+static const struct coap_block_source body_source = {
+	.read = body_read,
+	.content_format = COAP_CONTENT_FORMAT_APP_OCTET_STREAM,
+	.size = sizeof(body),
+};
+
+static const struct coap_block_sink upload_sink = {
+	.write = upload_write,
+};
+
+static int large_get(struct coap_resource *resource, struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	return coap_resource_reply_block2(resource, request, addr, addr_len, &body_source);
+}
+
+static int large_put(struct coap_resource *resource, struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	return coap_resource_receive_block1(resource, request, addr, addr_len, &upload_sink);
+}
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet response;
+	int ret;
+
+	ret = coap_resource_parse_observe(resource, request, addr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_ack_init(&response, request, data, sizeof(data), COAP_RESPONSE_CODE_CONTENT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_append_option_int(&response, COAP_OPTION_OBSERVE, resource->age);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+static const uint16_t test_service_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(test_service, "127.0.0.1", &test_service_port, COAP_SERVICE_AUTOSTART);
+
+static const char * const large_path[] = { "large", NULL };
+COAP_RESOURCE_DEFINE(large, test_service, {
+	.path = large_path,
+	.get = large_get,
+	.put = large_put,
+});
+
+static const char * const obs_path[] = { "obs", NULL };
+COAP_RESOURCE_DEFINE(obs, test_service, {
+	.path = obs_path,
+	.get = obs_get,
+});
+
+static struct sockaddr_in server_addr;
+static uint8_t rx_buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+static int client_socket(void)
+{
+	struct timeval timeo = {
+		.tv_sec = TIMEOUT_MS / MSEC_PER_SEC,
+		.tv_usec = (TIMEOUT_MS % MSEC_PER_SEC) * USEC_PER_MSEC,
+	};
+	int sock;
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", -errno);
+
+	ret = zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
+	zassert_ok(ret, "Cannot set receive timeout (%d)", -errno);
+
+	return sock;
+}
+
+static void request_init(struct coap_packet *request, uint8_t *buf, size_t len, uint8_t method,
+			 const char *path, uint8_t token)
+{
+	int ret;
+
+	ret = coap_packet_init(request, buf, len, COAP_VERSION_1, COAP_TYPE_CON, 1, &token,
+			       method, coap_next_id());
+	zassert_ok(ret);
+
+	ret = coap_packet_append_option(request, COAP_OPTION_URI_PATH, path, strlen(path));
+	zassert_ok(ret);
+}
+
+static void exchange(int sock, const struct coap_packet *request, struct coap_packet *response)
+{
+	ssize_t len;
+	int ret;
+
+	len = zsock_sendto(sock, request->data, request->offset, 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, request->offset, "Failed to send request (%d)", -errno);
+
+	len = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_true(len > 0, "No response (%d)", -errno);
+
+	ret = coap_packet_parse(response, rx_buf, len, NULL, 0);
+	zassert_ok(ret, "Invalid response (%d)", ret);
+	zassert_equal(coap_header_get_id(response), coap_header_get_id(request));
+}
+
+static int get_block(int sock, uint32_t num, enum coap_block_size szx,
+		     struct coap_packet *response)
+{
+	uint8_t buf[64];
+	struct coap_packet request;
+	int ret;
+
+	request_init(&request, buf, sizeof(buf), COAP_METHOD_GET, "large", 0x42);
+
+	ret = coap_append_option_int(&request, COAP_OPTION_BLOCK2, (num << 4) | szx);
+	zassert_ok(ret);
+
+	exchange(sock, &request, response);
+
+	return coap_get_option_int(response, COAP_OPTION_BLOCK2);
+}
+
+ZTEST(coap_service_transfer, test_block2_get)
+{
+	struct coap_packet response;
+	const uint8_t *payload;
+	uint16_t payload_len;
+	size_t offset = 0;
+	uint32_t num = 0;
+	int sock;
+	int block;
+
+	sock = client_socket();
+
+	do {
+		block = get_block(sock, num, COAP_BLOCK_64, &response);
+		zassert_true(block >= 0, "No Block2 option in block %u", num);
+		zassert_equal(coap_header_get_code(&response), COAP_RESPONSE_CODE_CONTENT);
+		zassert_equal(GET_BLOCK_NUM(block), num);
+		zassert_equal(GET_BLOCK_SIZE(block), COAP_BLOCK_64);
+		zassert_equal(coap_get_option_int(&response, COAP_OPTION_CONTENT_FORMAT),
+			      COAP_CONTENT_FORMAT_APP_OCTET_STREAM);
+
+		if (num == 0) {
+			zassert_equal(coap_get_option_int(&response, COAP_OPTION_SIZE2),
+				      BODY_SIZE);
+		} else {
+			zassert_equal(coap_get_option_int(&response, COAP_OPTION_SIZE2), -ENOENT);
+		}
+
+		payload = coap_packet_get_payload(&response, &payload_len);
+		zassert_not_null(payload);
+		zassert_equal(payload_len, MIN(64, BODY_SIZE - offset));
+		zassert_mem_equal(payload, body + offset, payload_len);
+
+		offset += payload_len;
+		num++;
+	} while (GET_MORE(block));
+
+	zassert_equal(offset, BODY_SIZE);
+
+	zsock_close(sock);
+}
+
+ZTEST(coap_service_transfer, test_block2_larger_request)
+{
+	struct coap_packet response;
+	const uint8_t *payload;
+	uint16_t payload_len;
+	int sock;
+	int block;
+
+	sock = client_socket();
+
+	/* Block 1 of 512 bytes is block 2 of the server's 256 bytes */
+	block = get_block(sock, 1, COAP_BLOCK_512, &response);
+	zassert_equal(GET_BLOCK_NUM(block), 2);
+	zassert_equal(GET_BLOCK_SIZE(block), COAP_BLOCK_256);
+	zassert_true(GET_MORE(block));
+
+	payload = coap_packet_get_payload(&response, &payload_len);
+	zassert_equal(payload_len, 256);
+	zassert_mem_equal(payload, body + 512, payload_len);
+
+	zsock_close(sock);
+}
+
+ZTEST(coap_service_transfer, test_block2_out_of_range)
+{
+	struct coap_packet response;
+	int sock;
+
+	sock = client_socket();
+
+	(void)get_block(sock, 100, COAP_BLOCK_64, &response);
+	zassert_equal(coap_header_get_code(&response), COAP_RESPONSE_CODE_BAD_OPTION);
+
+	zsock_close(sock);
+}
+
+static uint8_t put_block(int sock, uint32_t num, bool more, const uint8_t *data, size_t len)
+{
+	uint8_t buf[128];
+	struct coap_packet request;
+	struct coap_packet response;
+	int block;
+	int ret;
+
+	request_init(&request, buf, sizeof(buf), COAP_METHOD_PUT, "large", 0x43);
+
+	ret = coap_append_option_int(&request, COAP_OPTION_BLOCK1,
+				     (num << 4) | (more ? 0x08 : 0) | COAP_BLOCK_64);
+	zassert_ok(ret);
+
+	ret = coap_packet_append_payload_marker(&request);
+	zassert_ok(ret);
+
+	ret = coap_packet_append_payload(&request, data, len);
+	zassert_ok(ret);
+
+	exchange(sock, &request, &response);
+
+	block = coap_get_option_int(&response, COAP_OPTION_BLOCK1);
+	if (coap_header_get_code(&response) < COAP_RESPONSE_CODE_BAD_REQUEST) {
+		zassert_equal(GET_BLOCK_NUM(block), num);
+		zassert_equal(GET_MORE(block), more);
+	}
+
+	return coap_header_get_code(&response);
+}
+
+ZTEST(coap_service_transfer, test_block1_put)
+{
+	size_t offset = 0;
+	uint32_t num = 0;
+	int sock;
+
+	sock = client_socket();
+
+	upload_len = 0;
+	upload_done = false;
+
+	while (offset + 64 < 200) {
+		zassert_equal(put_block(sock, num, true, body + offset, 64),
+			      COAP_RESPONSE_CODE_CONTINUE);
+		zassert_false(upload_done);
+
+		offset += 64;
+		num++;
+	}
+
+	zassert_equal(put_block(sock, num, false, body + offset, 200 - offset),
+		      COAP_RESPONSE_CODE_CHANGED);
+	zassert_true(upload_done);
+	zassert_equal(upload_len, 200);
+	zassert_mem_equal(upload, body, 200);
+
+	zsock_close(sock);
+}
+
+ZTEST(coap_service_transfer, test_block1_too_large)
+{
+	int sock;
+
+	sock = client_socket();
+
+	zassert_equal(put_block(sock, UPLOAD_MAX / 64, true, body, 64),
+		      COAP_RESPONSE_CODE_REQUEST_TOO_LARGE);
+
+	/* Only the last block may be shorter than the block size */
+	zassert_equal(put_block(sock, 0, true, body, 10), COAP_RESPONSE_CODE_BAD_REQUEST);
+
+	zsock_close(sock);
+}
+
+static void observe(int sock, uint8_t token)
+{
+	uint8_t buf[64];
+	struct coap_packet request;
+	struct coap_packet response;
+	int ret;
+
+	/* The Observe option (6) has to precede Uri-Path (11) */
+	ret = coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON, 1,
+			       &token, COAP_METHOD_GET, coap_next_id());
+	zassert_ok(ret);
+
+	ret = coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0);
+	zassert_ok(ret);
+
+	ret = coap_packet_append_option(&request, COAP_OPTION_URI_PATH, "obs", strlen("obs"));
+	zassert_ok(ret);
+
+	exchange(sock, &request, &response);
+	zassert_equal(coap_header_get_code(&response), COAP_RESPONSE_CODE_CONTENT);
+}
+
+static void expect_notification(int sock, uint8_t token, int age, uint8_t type)
+{
+	struct coap_packet notification;
+	uint8_t rx_token[COAP_TOKEN_MAX_LEN];
+	const uint8_t *payload;
+	uint16_t payload_len;
+	ssize_t len;
+	int ret;
+
+	len = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_true(len > 0, "No notification (%d)", -errno);
+
+	ret = coap_packet_parse(&notification, rx_buf, len, NULL, 0);
+	zassert_ok(ret, "Invalid notification (%d)", ret);
+
+	zassert_equal(coap_header_get_type(&notification), type);
+	zassert_equal(coap_header_get_code(&notification), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(coap_header_get_token(&notification, rx_token), 1);
+	zassert_equal(rx_token[0], token);
+	zassert_equal(coap_get_option_int(&notification, COAP_OPTION_OBSERVE), age);
+
+	payload = coap_packet_get_payload(&notification, &payload_len);
+	zassert_equal(payload_len, 5);
+	zassert_mem_equal(payload, "hello", 5);
+
+	if (type == COAP_TYPE_CON) {
+		uint8_t buf[16];
+		struct coap_packet ack;
+
+		ret = coap_ack_init(&ack, &notification, buf, sizeof(buf), 0);
+		zassert_ok(ret);
+
+		len = zsock_sendto(sock, ack.data, ack.offset, 0,
+				   (struct sockaddr *)&server_addr, sizeof(server_addr));
+		zassert_equal(len, ack.offset);
+	}
+}
+
+static void notify_all(uint8_t type, int expected)
+{
+	uint8_t buf[64];
+	struct coap_packet notification;
+	int age;
+	int ret;
+
+	age = coap_resource_increment_age(&obs);
+
+	ret = coap_packet_init(&notification, buf, sizeof(buf), COAP_VERSION_1, type, 0, NULL,
+			       COAP_RESPONSE_CODE_CONTENT, 0);
+	zassert_ok(ret);
+
+	ret = coap_append_option_int(&notification, COAP_OPTION_OBSERVE, age);
+	zassert_ok(ret);
+
+	ret = coap_packet_append_payload_marker(&notification);
+	zassert_ok(ret);
+
+	ret = coap_packet_append_payload(&notification, "hello", 5);
+	zassert_ok(ret);
+
+	ret = coap_resource_notify_all(&obs, &notification, NULL);
+	zassert_equal(ret, expected, "Notified %d observers", ret);
+}
+
+ZTEST(coap_service_transfer, test_notify_all)
+{
+	const uint8_t tokens[] = { 0x11, 0x22, 0x33 };
+	int socks[ARRAY_SIZE(tokens)];
+
+	for (int i = 0; i < ARRAY_SIZE(tokens); i++) {
+		socks[i] = client_socket();
+		observe(socks[i], tokens[i]);
+	}
+
+	notify_all(COAP_TYPE_NON_CON, ARRAY_SIZE(tokens));
+
+	for (int i = 0; i < ARRAY_SIZE(tokens); i++) {
+		expect_notification(socks[i], tokens[i], obs.age, COAP_TYPE_NON_CON);
+	}
+
+	notify_all(COAP_TYPE_CON, ARRAY_SIZE(tokens));
+
+	for (int i = 0; i < ARRAY_SIZE(tokens); i++) {
+		expect_notification(socks[i], tokens[i], obs.age, COAP_TYPE_CON);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(tokens); i++) {
+		zassert_ok(coap_resource_remove_observer_by_token(&obs, &tokens[i], 1));
+		zsock_close(socks[i]);
+	}
+
+	notify_all(COAP_TYPE_NON_CON, 0);
+}
+
+ZTEST(coap_service_transfer, test_notify_all_invalid)
+{
+	uint8_t buf[16];
+	struct coap_packet notification;
+	int ret;
+
+	ret = coap_packet_init(&notification, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_ACK, 0,
+			       NULL, COAP_RESPONSE_CODE_CONTENT, 0);
+	zassert_ok(ret);
+
+	zassert_equal(coap_resource_notify_all(&obs, &notification, NULL), -EINVAL);
+}
+
+static void *setup(void)
+{
+	for (int i = 0; i < sizeof(body); i++) {
+		body[i] = i * 7;
+	}
+
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_port = htons(SERVER_PORT);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &server_addr.sin_addr);
+
+	zassert_equal(coap_service_is_running(&test_service), 1);
+
+	return NULL;
+}
+
+ZTEST_SUITE(coap_service_transfer, NULL, setup, NULL, NULL, NULL);
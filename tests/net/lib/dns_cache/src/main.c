@@ -133,3 +133,101 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("example00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02zu.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* The oldest entry was used recently, so the second oldest goes */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", &info_read, 1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example01.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_find_family)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	info_write.ai_family = AF_INET6;
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+
+	zassert_equal(2, dns_cache_find(&test_dns_cache, query, info_read, 2));
+	zassert_equal(1, dns_cache_find_family(&test_dns_cache, query, AF_INET6, info_read, 2));
+	zassert_equal(AF_INET6, info_read[0].ai_family);
+	zassert_equal(1, dns_cache_find_family(&test_dns_cache, query, AF_INET, info_read, 2));
+	zassert_equal(AF_INET, info_read[0].ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_INET6,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative entry adding should work.");
+
+	/* The negative answer replaces the cached address */
+	zassert_equal(-ENODATA,
+		      dns_cache_find_family(&test_dns_cache, query, AF_INET6, &info_read, 1));
+	zassert_equal(0, dns_cache_find_family(&test_dns_cache, query, AF_INET, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+
+	/* And a positive answer replaces the negative one */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find_family(&test_dns_cache, query, AF_INET6, &info_read, 1));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_INET6,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative entry adding should work.");
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_family(&test_dns_cache, query, AF_INET6, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_nonexistent_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "nonexistent";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_UNSPEC,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative entry adding should work.");
+
+	/* NXDOMAIN covers both families and replaces the cached address */
+	zassert_equal(-ENOENT,
+		      dns_cache_find_family(&test_dns_cache, query, AF_INET, &info_read, 1));
+	zassert_equal(-ENOENT,
+		      dns_cache_find_family(&test_dns_cache, query, AF_INET6, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+
+	/* A positive answer for either family replaces it */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find_family(&test_dns_cache, query, AF_INET, &info_read, 1));
+	zassert_equal(0, dns_cache_find_family(&test_dns_cache, query, AF_INET6, &info_read, 1));
+}
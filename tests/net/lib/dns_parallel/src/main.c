@@ -0,0 +1,380 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+
+#include "dns_pack.h"
+
+#define SILENT_PORT 15353
+#define STUB_PORT 15354
+
+#define DNS_TIMEOUT 2000
+#define WAIT_TIME K_MSEC(DNS_TIMEOUT + 500)
+
+/* Well below the DNS timeout, so the silent server was not waited for */
+#define FAST_ANSWER_MS (DNS_TIMEOUT / 2)
+
+#define NEGATIVE_TTL 30
+#define POSITIVE_TTL 60
+
+#define STACK_SIZE 2048
+#define THREAD_PRIORITY K_PRIO_COOP(2)
+
+static const uint8_t test_ipv4[] = { 192, 0, 2, 1 };
+static const uint8_t test_ipv6[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 1 };
+
+static int silent_sock = -1;
+static int stub_sock = -1;
+static atomic_t silent_queries;
+static atomic_t stub_queries;
+
+static uint8_t req_buf[512];
+static uint8_t resp_buf[512];
+
+struct test_result {
+	struct k_sem done;
+	int status;
+	int count;
+};
+
+static struct test_result result;
+
+/* Answers according to the first label of the query name:
+ *   ok-*    A and AAAA records
+ *   nx-*    NXDOMAIN with a SOA record for negative caching
+ *   v4-*    A record, the AAAA query is never answered
+ */
+static int stub_answer(const uint8_t *query, int query_len)
+{
+	const uint8_t *name = query + DNS_MSG_HEADER_SIZE;
+	size_t name_len = strnlen((const char *)name, query_len - DNS_MSG_HEADER_SIZE) + 1;
+	size_t pos = DNS_MSG_HEADER_SIZE + name_len + DNS_QTYPE_LEN + DNS_QCLASS_LEN;
+	uint16_t qtype;
+
+	if (pos > query_len || name[0] < 3) {
+		return -EINVAL;
+	}
+
+	qtype = sys_get_be16(name + name_len);
+
+	/* Header and the question are echoed back */
+	memcpy(resp_buf, query, pos);
+	resp_buf[2] |= 0x80; /* QR */
+	resp_buf[3] = 0x80;  /* RA, no error */
+	sys_put_be16(0, resp_buf + 6);
+	sys_put_be16(0, resp_buf + 8);
+	sys_put_be16(0, resp_buf + 10);
+
+	if (memcmp(name + 1, "nx-", 3) == 0) {
+		resp_buf[3] |= DNS_HEADER_NAMEERROR;
+		sys_put_be16(1, resp_buf + 8);
+
+		/* Owner name points to the question */
+		sys_put_be16(0xc000 | DNS_MSG_HEADER_SIZE, resp_buf + pos);
+		sys_put_be16(DNS_RR_TYPE_SOA, resp_buf + pos + 2);
+		sys_put_be16(DNS_CLASS_IN, resp_buf + pos + 4);
+		sys_put_be32(3600, resp_buf + pos + 6);
+		sys_put_be16(2 + 5 * 4, resp_buf + pos + 10);
+		pos += 12;
+
+		/* Root MNAME and RNAME, then serial, refresh, retry, expire */
+		memset(resp_buf + pos, 0, 2 + 4 * 4);
+		pos += 2 + 4 * 4;
+
+		sys_put_be32(NEGATIVE_TTL, resp_buf + pos);
+		pos += 4;
+
+		return pos;
+	}
+
+	if (qtype == DNS_RR_TYPE_AAAA && memcmp(name + 1, "v4-", 3) == 0) {
+		return 0;
+	}
+
+	if (memcmp(name + 1, "ok-", 3) != 0 && memcmp(name + 1, "v4-", 3) != 0) {
+		return -EINVAL;
+	}
+
+	sys_put_be16(1, resp_buf + 6);
+	sys_put_be16(0xc000 | DNS_MSG_HEADER_SIZE, resp_buf + pos);
+	sys_put_be16(qtype, resp_buf + pos + 2);
+	sys_put_be16(DNS_CLASS_IN, resp_buf + pos + 4);
+	sys_put_be32(POSITIVE_TTL, resp_buf + pos + 6);
+	pos += 10;
+
+	if (qtype == DNS_RR_TYPE_A) {
+		sys_put_be16(sizeof(test_ipv4), resp_buf + pos);
+		memcpy(resp_buf + pos + 2, test_ipv4, sizeof(test_ipv4));
+		pos += 2 + sizeof(test_ipv4);
+	} else {
+		sys_put_be16(sizeof(test_ipv6), resp_buf + pos);
+		memcpy(resp_buf + pos + 2, test_ipv6, sizeof(test_ipv6));
+		pos += 2 + sizeof(test_ipv6);
+	}
+
+	return pos;
+}
+
+static void stub_server(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds[2] = {
+		{ .fd = silent_sock, .events = ZSOCK_POLLIN },
+		{ .fd = stub_sock, .events = ZSOCK_POLLIN },
+	};
+	struct sockaddr_in peer;
+	socklen_t peer_len;
+	int len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (zsock_poll(fds, ARRAY_SIZE(fds), -1) <= 0) {
+			continue;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+			if (!(fds[i].revents & ZSOCK_POLLIN)) {
+				continue;
+			}
+
+			peer_len = sizeof(peer);
+			len = zsock_recvfrom(fds[i].fd, req_buf, sizeof(req_buf), 0,
+					     (struct sockaddr *)&peer, &peer_len);
+			if (len < DNS_MSG_HEADER_SIZE) {
+				continue;
+			}
+
+			if (fds[i].fd == silent_sock) {
+				atomic_inc(&silent_queries);
+				continue;
+			}
+
+			atomic_inc(&stub_queries);
+
+			len = stub_answer(req_buf, len);
+			if (len > 0) {
+				(void)zsock_sendto(stub_sock, resp_buf, len, 0,
+						   (struct sockaddr *)&peer, peer_len);
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(stub_server_id, STACK_SIZE, stub_server, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, -1);
+
+static int bind_udp(uint16_t port)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	int sock;
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot bind to port %d (%d)", port, errno);
+
+	return sock;
+}
+
+static void *dns_parallel_setup(void)
+{
+	silent_sock = bind_udp(SILENT_PORT);
+	stub_sock = bind_udp(STUB_PORT);
+
+	k_sem_init(&result.done, 0, 1);
+	k_thread_start(stub_server_id);
+
+	return NULL;
+}
+
+static void dns_parallel_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_set(&silent_queries, 0);
+	atomic_set(&stub_queries, 0);
+	result.status = 0;
+	result.count = 0;
+	k_sem_reset(&result.done);
+}
+
+static void result_cb(enum dns_resolve_status status, struct dns_addrinfo *info,
+		      void *user_data)
+{
+	struct test_result *res = user_data;
+
+	if (status == DNS_EAI_INPROGRESS && info != NULL) {
+		res->count++;
+		return;
+	}
+
+	res->status = status;
+	k_sem_give(&res->done);
+}
+
+static int resolve(const char *name, enum dns_query_type type)
+{
+	int ret;
+
+	k_sem_reset(&result.done);
+	result.status = 0;
+	result.count = 0;
+
+	ret = dns_get_addr_info(name, type, NULL, result_cb, &result, DNS_TIMEOUT);
+	zassert_ok(ret, "Cannot start query for %s (%d)", name, ret);
+
+	zassert_ok(k_sem_take(&result.done, WAIT_TIME), "No result for %s", name);
+
+	return result.status;
+}
+
+ZTEST(dns_parallel, test_first_answer_wins)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_equal(resolve("ok-parallel.example", DNS_QUERY_TYPE_A), DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1, "Expected one address, got %d", result.count);
+	zassert_true(k_uptime_get() - start < FAST_ANSWER_MS,
+		     "The silent server was waited for");
+
+	zassert_equal(atomic_get(&silent_queries), 1, "Silent server not queried");
+	zassert_equal(atomic_get(&stub_queries), 1, "Stub server not queried");
+}
+
+ZTEST(dns_parallel, test_positive_cache)
+{
+	zassert_equal(resolve("ok-cached.example", DNS_QUERY_TYPE_AAAA), DNS_EAI_ALLDONE);
+	zassert_equal(atomic_get(&stub_queries), 1);
+
+	zassert_equal(resolve("ok-cached.example", DNS_QUERY_TYPE_AAAA), DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1, "Expected one address, got %d", result.count);
+	zassert_equal(atomic_get(&stub_queries), 1, "Cached answer was queried again");
+
+	/* Only the AAAA record is cached */
+	zassert_equal(resolve("ok-cached.example", DNS_QUERY_TYPE_A), DNS_EAI_ALLDONE);
+	zassert_equal(atomic_get(&stub_queries), 2, "A record was not queried");
+}
+
+ZTEST(dns_parallel, test_negative_cache)
+{
+	int64_t start;
+
+	zassert_equal(resolve("nx-missing.example", DNS_QUERY_TYPE_A), DNS_EAI_NONAME);
+	zassert_equal(result.count, 0);
+	zassert_equal(atomic_get(&stub_queries), 1);
+
+	/* NXDOMAIN covers every record type of the name */
+	start = k_uptime_get();
+	zassert_equal(resolve("nx-missing.example", DNS_QUERY_TYPE_A), DNS_EAI_NONAME);
+	zassert_equal(resolve("nx-missing.example", DNS_QUERY_TYPE_AAAA), DNS_EAI_NONAME);
+	zassert_true(k_uptime_get() - start < FAST_ANSWER_MS, "Negative answer not cached");
+	zassert_equal(atomic_get(&stub_queries), 1, "Negative answer was queried again");
+}
+
+ZTEST(dns_parallel, test_getaddrinfo_both_families)
+{
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_UNSPEC,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res = NULL;
+	int ret;
+
+	ret = zsock_getaddrinfo("ok-both.example", "80", &hints, &res);
+	zassert_ok(ret, "getaddrinfo failed (%d)", ret);
+	zassert_not_null(res);
+	zassert_not_null(res->ai_next, "Only one address family resolved");
+	zassert_is_null(res->ai_next->ai_next);
+
+	/* IPv4 first, like with queries done one after the other */
+	zassert_equal(res->ai_family, AF_INET);
+	zassert_mem_equal(&net_sin(res->ai_addr)->sin_addr, test_ipv4, sizeof(test_ipv4));
+	zassert_equal(net_sin(res->ai_addr)->sin_port, htons(80));
+	zassert_equal(res->ai_next->ai_family, AF_INET6);
+	zassert_mem_equal(&net_sin6(res->ai_next->ai_addr)->sin6_addr, test_ipv6,
+			  sizeof(test_ipv6));
+	zassert_equal(net_sin6(res->ai_next->ai_addr)->sin6_port, htons(80));
+
+	zsock_freeaddrinfo(res);
+}
+
+ZTEST(dns_parallel, test_getaddrinfo_resolution_delay)
+{
+	struct zsock_addrinfo *res = NULL;
+	int64_t start = k_uptime_get();
+	int ret;
+
+	/* The AAAA query is never answered, so only the resolution delay
+	 * is waited for it once the A record has been received.
+	 */
+	ret = zsock_getaddrinfo("v4-only.example", NULL, NULL, &res);
+	zassert_ok(ret, "getaddrinfo failed (%d)", ret);
+	zassert_true(k_uptime_get() - start < FAST_ANSWER_MS, "AAAA query was waited for");
+
+	zassert_not_null(res);
+	zassert_equal(res->ai_family, AF_INET);
+	zassert_is_null(res->ai_next);
+
+	/* The AAAA query was sent even though it was not waited for */
+	zassert_equal(atomic_get(&stub_queries), 2, "Expected A and AAAA queries");
+
+	zsock_freeaddrinfo(res);
+}
+
+ZTEST(dns_parallel, test_getaddrinfo_nxdomain)
+{
+	struct zsock_addrinfo *res = NULL;
+	int ret;
+
+	ret = zsock_getaddrinfo("nx-both.example", NULL, NULL, &res);
+	zassert_equal(ret, DNS_EAI_NONAME, "Unexpected result (%d)", ret);
+	zassert_is_null(res);
+}
+
+ZTEST(dns_parallel, test_getaddrinfo_busy_slot)
+{
+	struct zsock_addrinfo *res = NULL;
+	uint16_t dns_id;
+	int ret;
+
+	/* Hold one of the two query slots with a query that is never
+	 * answered, so the A and AAAA queries have to be sent in turn.
+	 */
+	ret = dns_get_addr_info("v4-busy.example", DNS_QUERY_TYPE_AAAA, &dns_id,
+				result_cb, &result, DNS_TIMEOUT);
+	zassert_ok(ret, "Cannot start query (%d)", ret);
+
+	ret = zsock_getaddrinfo("ok-busy.example", NULL, NULL, &res);
+	zassert_ok(ret, "getaddrinfo failed (%d)", ret);
+
+	zassert_not_null(res);
+	zassert_equal(res->ai_family, AF_INET);
+	zassert_not_null(res->ai_next, "Only one address family resolved");
+	zassert_equal(res->ai_next->ai_family, AF_INET6);
+	zassert_is_null(res->ai_next->ai_next);
+
+	zsock_freeaddrinfo(res);
+
+	zassert_ok(dns_cancel_addr_info(dns_id));
+	zassert_ok(k_sem_take(&result.done, WAIT_TIME), "Query not cancelled");
+	zassert_equal(result.status, DNS_EAI_CANCELED);
+}
+
+ZTEST_SUITE(dns_parallel, NULL, dns_parallel_setup, dns_parallel_before, NULL, NULL);
@@ -10,6 +10,8 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/posix/sys/eventfd.h>
@@ -28,6 +30,15 @@
 #define TEST_DYNAMIC_GET_PAYLOAD "Test dynamic GET"
 #define TEST_STATIC_PAYLOAD "Hello, World!"
 
+/* FNV-1a hash of TEST_STATIC_PAYLOAD */
+#define TEST_STATIC_ETAG "\"5aecf734\""
+
+#if defined(CONFIG_HTTP_SERVER_ETAG)
+#define TEST_STATIC_ETAG_HEADER "ETag: " TEST_STATIC_ETAG "\r\n"
+#else
+#define TEST_STATIC_ETAG_HEADER ""
+#endif
+
 /* Random base64 encoded data */
 #define TEST_LONG_PAYLOAD_CHUNK_1                                                                  \
 	"Z3479c2x8gXgzvDpvt4YuQePsvmsur1J1U+lLKzkyGCQgtWEysRjnO63iZvN/Zaag5YlliAkcaWi"             \
@@ -166,6 +177,11 @@ BUILD_ASSERT(sizeof(long_payload) - 1 > CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE,
 #define TEST_HTTP2_TRAILING_HEADER_STREAM_1 \
 	0x00, 0x00, 0x0c, 0x01, 0x05, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
 	0x40, 0x84, 0x92, 0xda, 0x69, 0xf5, 0x85, 0x9c, 0xa3, 0x90, 0xb6, 0x7f
+/* GET / with "if-none-match: TEST_STATIC_ETAG", literal without indexing */
+#define TEST_HTTP2_HEADERS_GET_ROOT_IF_NONE_MATCH_STREAM_1 \
+	0x00, 0x00, 0x10, 0x01, 0x05, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
+	0x82, 0x84, 0x86, 0x0f, 0x1a, 0x0a, 0x22, 0x35, 0x61, 0x65, 0x63, 0x66, \
+	0x37, 0x33, 0x34, 0x22
 #define TEST_HTTP2_RST_STREAM_STREAM_1 \
 	0x00, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, TEST_STREAM_ID_1, \
 	0xaa, 0xaa, 0xaa, 0xaa
@@ -699,6 +715,93 @@ ZTEST(server_function_tests, test_http1_static_get)
 		"HTTP/1.1 200 OK\r\n"
 		"Content-Type: text/html\r\n"
 		"Content-Length: 13\r\n"
+		TEST_STATIC_ETAG_HEADER
+		"\r\n"
+		TEST_STATIC_PAYLOAD;
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, sizeof(expected_response) - 1);
+	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+			  "Received data doesn't match expected response");
+}
+
+ZTEST(server_function_tests, test_http1_static_not_modified)
+{
+	static const char http1_request[] =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"If-None-Match: W/" TEST_STATIC_ETAG "\r\n"
+		"\r\n";
+	static const char expected_response[] =
+		"HTTP/1.1 304 Not Modified\r\n"
+		TEST_STATIC_ETAG_HEADER
+		"\r\n";
+	size_t offset = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_HTTP_SERVER_ETAG);
+
+	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, sizeof(expected_response) - 1);
+	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+			  "Received data doesn't match expected response");
+}
+
+ZTEST(server_function_tests, test_http2_static_not_modified)
+{
+	static const uint8_t request_get_static_not_modified[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_ROOT_IF_NONE_MATCH_STREAM_1,
+		TEST_HTTP2_GOAWAY,
+	};
+	static const struct http_header expected_headers[] = {
+		{ .name = ":status", .value = "304" },
+		{ .name = "etag", .value = TEST_STATIC_ETAG },
+	};
+	size_t offset = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_HTTP_SERVER_ETAG);
+
+	ret = zsock_send(client_fd, request_get_static_not_modified,
+			 sizeof(request_get_static_not_modified), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+
+	/* No DATA frame follows, the stream ends with the headers. */
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1,
+				   HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM,
+				   expected_headers, ARRAY_SIZE(expected_headers));
+}
+
+ZTEST(server_function_tests, test_http1_static_modified)
+{
+	static const char http1_request[] =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"If-None-Match: \"00000000\"\r\n"
+		"\r\n";
+	static const char expected_response[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Type: text/html\r\n"
+		"Content-Length: 13\r\n"
+		TEST_STATIC_ETAG_HEADER
 		"\r\n"
 		TEST_STATIC_PAYLOAD;
 	size_t offset = 0;
@@ -939,6 +1042,7 @@ ZTEST(server_function_tests, test_http1_connection_close)
 		"HTTP/1.1 200 OK\r\n"
 		"Content-Type: text/html\r\n"
 		"Content-Length: 13\r\n"
+		TEST_STATIC_ETAG_HEADER
 		"\r\n"
 		TEST_STATIC_PAYLOAD;
 	size_t offset = 0;
@@ -974,6 +1078,92 @@ ZTEST(server_function_tests, test_http1_connection_close)
 	zassert_equal(ret, 0, "Connection should've been closed");
 }
 
+static int test_connect_client(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	int fd, ret;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "Failed to create client socket (%d)", errno);
+
+	ret = zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+	zassert_ok(ret, "Failed to set timeout (%d)", errno);
+
+	ret = zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr.s_addr);
+	zassert_equal(ret, 1, "inet_pton() failed");
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "Failed to connect (%d)", errno);
+
+	return fd;
+}
+
+ZTEST(server_function_tests, test_http1_clients_limit)
+{
+	static const char http1_request[] =
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char expected_response[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Type: text/html\r\n"
+		"Content-Length: 13\r\n"
+		TEST_STATIC_ETAG_HEADER
+		"\r\n"
+		TEST_STATIC_PAYLOAD;
+	int fds[CONFIG_HTTP_SERVER_MAX_CLIENTS];
+	int extra_fd;
+	size_t offset = 0;
+	int ret;
+
+	/* client_fd already takes one slot, the last connection is one too
+	 * many.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		fds[i] = test_connect_client();
+	}
+
+	extra_fd = fds[ARRAY_SIZE(fds) - 1];
+
+	/* Let the server accept all of them. */
+	k_msleep(100);
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_EVICT_IDLE_CLIENTS)) {
+		ret = zsock_recv(extra_fd, buf, sizeof(buf), 0);
+		zassert_true(ret <= 0, "Connection should've been closed");
+		goto out;
+	}
+
+	/* All the other clients are idle, so one of them makes room for the
+	 * new connection.
+	 */
+	ret = zsock_send(extra_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	while (offset < sizeof(expected_response) - 1) {
+		ret = zsock_recv(extra_fd, buf + offset, sizeof(buf) - offset, 0);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		offset += ret;
+	}
+
+	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+			  "Received data doesn't match expected response");
+
+out:
+	for (int i = 0; i < ARRAY_SIZE(fds); i++) {
+		(void)zsock_close(fds[i]);
+	}
+}
+
 ZTEST(server_function_tests, test_http2_post_data_with_padding)
 {
 	static const uint8_t request_post_dynamic[] = {
@@ -1909,6 +2099,31 @@ ZTEST(server_function_tests_no_init, test_get_frame_type_name)
 			  "CONTINUATION", "Unexpected frame type");
 }
 
+ZTEST(server_function_tests_no_init, test_parse_accept_encoding)
+{
+	static const struct {
+		const char *value;
+		uint8_t expected;
+	} cases[] = {
+		{ "", 0 },
+		{ "identity", 0 },
+		{ "gzip", HTTP_SERVER_ACCEPT_GZIP },
+		{ "deflate, gzip, br", HTTP_SERVER_ACCEPT_GZIP | HTTP_SERVER_ACCEPT_BR },
+		{ "br;q=1.0, GZIP;q=0.5", HTTP_SERVER_ACCEPT_GZIP | HTTP_SERVER_ACCEPT_BR },
+		{ "gzip;q=0, br", HTTP_SERVER_ACCEPT_BR },
+		{ "br ; q=0.0,gzip", HTTP_SERVER_ACCEPT_GZIP },
+		{ "*", HTTP_SERVER_ACCEPT_GZIP | HTTP_SERVER_ACCEPT_BR },
+		{ "gzipped, brotli", 0 },
+	};
+	static struct http_client_ctx ctx;
+
+	ARRAY_FOR_EACH(cases, i) {
+		http_server_parse_accept_encoding(&ctx, cases[i].value, strlen(cases[i].value));
+		zassert_equal(ctx.accept_encoding, cases[i].expected,
+			      "Wrong encodings for \"%s\"", cases[i].value);
+	}
+}
+
 ZTEST(server_function_tests_no_init, test_parse_http_frames)
 {
 	static struct http_client_ctx ctx_client1;
@@ -2031,6 +2246,131 @@ static void http_server_tests_after(void *fixture)
 	(void)http_server_stop();
 }
 
+#if defined(CONFIG_FILE_SYSTEM)
+#define TEST_FS_MNT_POINT "/tfs"
+
+/* Files of the test filesystem, only their sizes are reported */
+static const struct {
+	const char *name;
+	size_t size;
+} test_fs_files[] = {
+	{ TEST_FS_MNT_POINT "/all.html", 300 },
+	{ TEST_FS_MNT_POINT "/all.html.gz", 200 },
+	{ TEST_FS_MNT_POINT "/all.html.br", 100 },
+	{ TEST_FS_MNT_POINT "/no_br.html", 300 },
+	{ TEST_FS_MNT_POINT "/no_br.html.gz", 200 },
+	{ TEST_FS_MNT_POINT "/no_gz.html", 300 },
+	{ TEST_FS_MNT_POINT "/no_gz.html.br", 100 },
+	{ TEST_FS_MNT_POINT "/gz_only.html.gz", 200 },
+};
+
+static int test_fs_mount(struct fs_mount_t *mountp)
+{
+	ARG_UNUSED(mountp);
+
+	return 0;
+}
+
+static int test_fs_stat(struct fs_mount_t *mountp, const char *path,
+			struct fs_dirent *entry)
+{
+	ARG_UNUSED(mountp);
+
+	ARRAY_FOR_EACH(test_fs_files, i) {
+		if (strcmp(path, test_fs_files[i].name) == 0) {
+			entry->type = FS_DIR_ENTRY_FILE;
+			entry->size = test_fs_files[i].size;
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static const struct fs_file_system_t test_fs = {
+	.mount = test_fs_mount,
+	.stat = test_fs_stat,
+};
+
+static struct fs_mount_t test_fs_mnt = {
+	.type = FS_TYPE_EXTERNAL_BASE,
+	.mnt_point = TEST_FS_MNT_POINT,
+};
+
+static void *static_fs_tests_setup(void)
+{
+	zassert_ok(fs_register(FS_TYPE_EXTERNAL_BASE, &test_fs), "Cannot register test fs");
+	zassert_ok(fs_mount(&test_fs_mnt), "Cannot mount test fs");
+
+	return NULL;
+}
+
+ZTEST(server_static_fs_tests, test_find_file_variants)
+{
+	static const struct {
+		const char *name;
+		uint8_t accept_encoding;
+		const char *expected_name;
+		size_t expected_size;
+		const char *expected_encoding;
+	} cases[] = {
+		/* Brotli preferred over gzip, gzip over the plain file */
+		{ "/all.html", HTTP_SERVER_ACCEPT_BR | HTTP_SERVER_ACCEPT_GZIP,
+		  "/all.html.br", 100, "br" },
+		{ "/all.html", HTTP_SERVER_ACCEPT_GZIP, "/all.html.gz", 200, "gzip" },
+		{ "/all.html", HTTP_SERVER_ACCEPT_BR, "/all.html.br", 100, "br" },
+		{ "/all.html", 0, "/all.html", 300, NULL },
+		/* Fallback to the next variant the client accepts */
+		{ "/no_br.html", HTTP_SERVER_ACCEPT_BR | HTTP_SERVER_ACCEPT_GZIP,
+		  "/no_br.html.gz", 200, "gzip" },
+		{ "/no_br.html", HTTP_SERVER_ACCEPT_BR, "/no_br.html", 300, NULL },
+		{ "/no_gz.html", HTTP_SERVER_ACCEPT_GZIP, "/no_gz.html", 300, NULL },
+		/* A gzipped file stored alone is served anyway */
+		{ "/gz_only.html", 0, "/gz_only.html.gz", 200, "gzip" },
+		{ "/gz_only.html", HTTP_SERVER_ACCEPT_BR, "/gz_only.html.gz", 200, "gzip" },
+	};
+	char fname[64];
+	const char *content_encoding;
+	size_t file_size;
+	int ret;
+
+	ARRAY_FOR_EACH(cases, i) {
+		snprintk(fname, sizeof(fname), TEST_FS_MNT_POINT "%s", cases[i].name);
+		content_encoding = "invalid";
+		file_size = 0;
+
+		ret = http_server_find_file(fname, sizeof(fname), &file_size,
+					    cases[i].accept_encoding, &content_encoding);
+		zassert_ok(ret, "File not found for \"%s\" (case %zu)", cases[i].name, i);
+		zassert_str_equal(fname + strlen(TEST_FS_MNT_POINT), cases[i].expected_name,
+				  "Wrong variant (case %zu)", i);
+		zassert_equal(file_size, cases[i].expected_size, "Wrong size (case %zu)", i);
+
+		if (cases[i].expected_encoding == NULL) {
+			zassert_is_null(content_encoding, "Unexpected encoding (case %zu)", i);
+		} else {
+			zassert_not_null(content_encoding, "Missing encoding (case %zu)", i);
+			zassert_str_equal(content_encoding, cases[i].expected_encoding,
+					  "Wrong encoding (case %zu)", i);
+		}
+	}
+}
+
+ZTEST(server_static_fs_tests, test_find_file_missing)
+{
+	char fname[64] = TEST_FS_MNT_POINT "/missing.html";
+	const char *content_encoding;
+	size_t file_size;
+
+	zassert_equal(http_server_find_file(fname, sizeof(fname), &file_size,
+					    HTTP_SERVER_ACCEPT_BR | HTTP_SERVER_ACCEPT_GZIP,
+					    &content_encoding),
+		      -ENOENT, "Missing file found");
+}
+
+ZTEST_SUITE(server_static_fs_tests, NULL, static_fs_tests_setup, NULL, NULL, NULL);
+#endif /* CONFIG_FILE_SYSTEM */
+
 ZTEST_SUITE(server_function_tests, NULL, NULL, http_server_tests_before,
 	    http_server_tests_after, NULL);
 ZTEST_SUITE(server_function_tests_no_init, NULL, NULL, NULL,
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
+
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/ztest.h>
@@ -296,6 +298,168 @@ ZTEST(http2_hpack, test_http2_hpack_static_decode)
 				 ARRAY_SIZE(test_static_headers));
 }
 
+/* Copy-paste from RFC7541 Appendix A, index 1 first. */
+static const struct {
+	const char *name;
+	const char *value;
+} test_rfc_static_table[] = {
+	{ ":authority", "" },
+	{ ":method", "GET" },
+	{ ":method", "POST" },
+	{ ":path", "/" },
+	{ ":path", "/index.html" },
+	{ ":scheme", "http" },
+	{ ":scheme", "https" },
+	{ ":status", "200" },
+	{ ":status", "204" },
+	{ ":status", "206" },
+	{ ":status", "304" },
+	{ ":status", "400" },
+	{ ":status", "404" },
+	{ ":status", "500" },
+	{ "accept-charset", "" },
+	{ "accept-encoding", "gzip, deflate" },
+	{ "accept-language", "" },
+	{ "accept-ranges", "" },
+	{ "accept", "" },
+	{ "access-control-allow-origin", "" },
+	{ "age", "" },
+	{ "allow", "" },
+	{ "authorization", "" },
+	{ "cache-control", "" },
+	{ "content-disposition", "" },
+	{ "content-encoding", "" },
+	{ "content-language", "" },
+	{ "content-length", "" },
+	{ "content-location", "" },
+	{ "content-range", "" },
+	{ "content-type", "" },
+	{ "cookie", "" },
+	{ "date", "" },
+	{ "etag", "" },
+	{ "expect", "" },
+	{ "expires", "" },
+	{ "from", "" },
+	{ "host", "" },
+	{ "if-match", "" },
+	{ "if-modified-since", "" },
+	{ "if-none-match", "" },
+	{ "if-range", "" },
+	{ "if-unmodified-since", "" },
+	{ "last-modified", "" },
+	{ "link", "" },
+	{ "location", "" },
+	{ "max-forwards", "" },
+	{ "proxy-authenticate", "" },
+	{ "proxy-authorization", "" },
+	{ "range", "" },
+	{ "referer", "" },
+	{ "refresh", "" },
+	{ "retry-after", "" },
+	{ "server", "" },
+	{ "set-cookie", "" },
+	{ "strict-transport-security", "" },
+	{ "transfer-encoding", "" },
+	{ "user-agent", "" },
+	{ "vary", "" },
+	{ "via", "" },
+	{ "www-authenticate", "" },
+};
+
+/* The encoder finds static entries through a hash index built offline, check
+ * that every name and name/value pair of the RFC table is found at its index.
+ */
+ZTEST(http2_hpack, test_http2_hpack_static_table_lookup)
+{
+	static const char other_value[] = "zephyr";
+	struct http_hpack_header_buf hdr;
+	uint32_t name_index;
+	int ret;
+
+	ARRAY_FOR_EACH(test_rfc_static_table, i) {
+		uint32_t index = i + 1;
+
+		hdr.name = test_rfc_static_table[i].name;
+		hdr.name_len = strlen(hdr.name);
+
+		if (test_rfc_static_table[i].value[0] != '\0') {
+			hdr.value = test_rfc_static_table[i].value;
+			hdr.value_len = strlen(hdr.value);
+
+			ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+			zassert_equal(ret, 1, "%s: %s not indexed", hdr.name, hdr.value);
+			zassert_equal(test_buf[0], 0x80 | index, "%s: %s wrong index",
+				      hdr.name, hdr.value);
+		}
+
+		/* Entries sharing a name are adjacent, the name refers to the
+		 * first of them.
+		 */
+		name_index = index;
+		while (name_index > 1 &&
+		       strcmp(test_rfc_static_table[name_index - 2].name, hdr.name) == 0) {
+			name_index--;
+		}
+
+		hdr.value = other_value;
+		hdr.value_len = sizeof(other_value) - 1;
+
+		/* Literal never indexed, with a 4-bit prefix index */
+		ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+		zassert_true(ret > 2, "%s not encoded (%d)", hdr.name, ret);
+
+		if (name_index < 15) {
+			zassert_equal(test_buf[0], 0x10 | name_index, "%s wrong name index",
+				      hdr.name);
+		} else {
+			zassert_equal(test_buf[0], 0x1f, "%s wrong name index", hdr.name);
+			zassert_equal(test_buf[1], name_index - 15, "%s wrong name index",
+				      hdr.name);
+		}
+	}
+}
+
+uint32_t http_hpack_static_hash_bucket(const char *name, size_t name_len);
+const uint8_t *http_hpack_static_hash_index(size_t *buckets, const uint8_t **next);
+
+/* Rebuild the static table hash index from the RFC table, entries sharing a
+ * name are chained once, and check that the one in the encoder is up to date.
+ */
+ZTEST(http2_hpack, test_http2_hpack_static_hash_index)
+{
+	uint8_t head[64] = { 0 };
+	uint8_t next[ARRAY_SIZE(test_rfc_static_table) + 1] = { 0 };
+	const uint8_t *enc_head, *enc_next;
+	size_t buckets;
+
+	enc_head = http_hpack_static_hash_index(&buckets, &enc_next);
+	zassert_true(buckets <= ARRAY_SIZE(head), "Too many buckets (%zu)", buckets);
+
+	ARRAY_FOR_EACH(test_rfc_static_table, i) {
+		const char *name = test_rfc_static_table[i].name;
+		uint32_t bucket;
+		uint8_t *link;
+
+		if (i > 0 && strcmp(test_rfc_static_table[i - 1].name, name) == 0) {
+			continue;
+		}
+
+		bucket = http_hpack_static_hash_bucket(name, strlen(name));
+		zassert_true(bucket < buckets, "%s: bucket %u out of range", name,
+			     (unsigned int)bucket);
+
+		link = &head[bucket];
+		while (*link != 0) {
+			link = &next[*link];
+		}
+
+		*link = i + 1;
+	}
+
+	zassert_mem_equal(enc_head, head, buckets, "Stale static hash buckets");
+	zassert_mem_equal(enc_next, next, sizeof(next), "Stale static hash chains");
+}
+
 static const struct example_headers test_dec_literal_indexed_headers[] = {
 	{ ":path", "/sample/path",
 	  { 0x04, 0x0c, 0x2f, 0x73, 0x61, 0x6d, 0x70, 0x6c,
@@ -494,4 +658,177 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+ZTEST(http2_hpack, test_http2_hpack_long_value_encode)
+{
+	static const uint8_t expected[] = { 0x10, 0x01, 0x78, 0x7f, 0x48 };
+	static char value[200];
+	struct http_hpack_header_buf hdr = {
+		.name = "x",
+		.value = value,
+		.name_len = 1,
+		.value_len = sizeof(value) - 1,
+	};
+	int ret;
+
+	/* The value does not compress, its length needs a two byte integer. */
+	memset(value, '~', sizeof(value) - 1);
+
+	ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+	zassert_equal(ret, sizeof(expected) + sizeof(value) - 1, "Wrong encoding length");
+	zassert_mem_equal(test_buf, expected, sizeof(expected), "Length wrongly encoded");
+	zassert_mem_equal(test_buf + sizeof(expected), value, sizeof(value) - 1,
+			  "Value wrongly encoded");
+}
+
+static void test_hpack_verify_table_encode(struct http_hpack_dynamic_table *table,
+					   const struct example_headers *example,
+					   size_t num_examples,
+					   const uint8_t *expected, size_t expected_len)
+{
+	size_t offset = 0;
+
+	for (int i = 0; i < num_examples; i++) {
+		struct http_hpack_header_buf hdr = {
+			.name = example[i].name,
+			.value = example[i].value,
+			.name_len = strlen(example[i].name),
+			.value_len = strlen(example[i].value)
+		};
+		int ret;
+
+		ret = http_hpack_encode_header_table(test_buf + offset,
+						     sizeof(test_buf) - offset,
+						     &hdr, table);
+		zassert_true(ret > 0, "Failed to encode header (%d)", ret);
+		offset += ret;
+	}
+
+	zassert_equal(offset, expected_len, "Wrong encoding length");
+	zassert_mem_equal(test_buf, expected, expected_len, "Headers wrongly encoded");
+}
+
+/* Response examples from RFC7541 ch C.6, with a 256 bytes table */
+static const struct example_headers test_table_response_1[] = {
+	{ ":status", "302" },
+	{ "cache-control", "private" },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	{ "location", "https://www.example.com" },
+};
+
+static const uint8_t test_table_response_1_encoded[] = {
+	0x48, 0x82, 0x64, 0x02, 0x58, 0x85, 0xae, 0xc3,
+	0x77, 0x1a, 0x4b, 0x61, 0x96, 0xd0, 0x7a, 0xbe,
+	0x94, 0x10, 0x54, 0xd4, 0x44, 0xa8, 0x20, 0x05,
+	0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x82, 0xa6,
+	0x2d, 0x1b, 0xff, 0x6e, 0x91, 0x9d, 0x29, 0xad,
+	0x17, 0x18, 0x63, 0xc7, 0x8f, 0x0b, 0x97, 0xc8,
+	0xe9, 0xae, 0x82, 0xae, 0x43, 0xd3,
+};
+
+static const struct example_headers test_table_response_2[] = {
+	{ ":status", "307" },
+	{ "cache-control", "private" },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+	{ "location", "https://www.example.com" },
+};
+
+/* Unlike in the RFC, "307" is not Huffman encoded as it would not be shorter.
+ * Adding it evicts ":status: 302", the other fields are found in the table.
+ */
+static const uint8_t test_table_response_2_encoded[] = {
+	0x48, 0x03, 0x33, 0x30, 0x37, 0xc1, 0xc0, 0xbf,
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_encode)
+{
+	static struct http_hpack_dynamic_table table;
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	http_hpack_dynamic_table_init(&table);
+	zassert_equal(table.max_size, 256, "Unexpected table size");
+
+	test_hpack_verify_table_encode(&table, test_table_response_1,
+				       ARRAY_SIZE(test_table_response_1),
+				       test_table_response_1_encoded,
+				       sizeof(test_table_response_1_encoded));
+	zassert_equal(table.size, 222, "Wrong table size");
+
+	test_hpack_verify_table_encode(&table, test_table_response_2,
+				       ARRAY_SIZE(test_table_response_2),
+				       test_table_response_2_encoded,
+				       sizeof(test_table_response_2_encoded));
+	zassert_equal(table.size, 222, "Wrong table size");
+	zassert_equal(table.count, 4, "Wrong number of entries");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_size_update)
+{
+	static const struct example_headers status[] = {
+		{ ":status", "200" },
+	};
+	/* Size updates to 0 and back to 256, then the indexed field */
+	static const uint8_t expected[] = { 0x20, 0x3f, 0xe1, 0x01, 0x88 };
+	static struct http_hpack_dynamic_table table;
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	http_hpack_dynamic_table_init(&table);
+	test_hpack_verify_table_encode(&table, test_table_response_1,
+				       ARRAY_SIZE(test_table_response_1),
+				       test_table_response_1_encoded,
+				       sizeof(test_table_response_1_encoded));
+
+	/* The table cannot grow past its configured size. */
+	http_hpack_dynamic_table_set_max_size(&table, 0);
+	http_hpack_dynamic_table_set_max_size(&table, 4096);
+	zassert_equal(table.max_size, 256, "Unexpected table size");
+	zassert_equal(table.count, 0, "Table should have been emptied");
+
+	/* The size update fits but the field doesn't, the update must be
+	 * sent again with the next attempt.
+	 */
+	struct http_hpack_header_buf hdr = {
+		.name = status[0].name,
+		.value = status[0].value,
+		.name_len = strlen(status[0].name),
+		.value_len = strlen(status[0].value),
+	};
+	int ret;
+
+	ret = http_hpack_encode_header_table(test_buf, sizeof(expected) - 1, &hdr, &table);
+	zassert_equal(ret, -ENOBUFS, "Field should not fit (%d)", ret);
+	zassert_true(table.size_update, "Size update was lost");
+
+	test_hpack_verify_table_encode(&table, status, ARRAY_SIZE(status),
+				       expected, sizeof(expected));
+	zassert_false(table.size_update, "Size update was not cleared");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_sensitive)
+{
+	static struct http_hpack_dynamic_table table;
+	struct http_hpack_header_buf hdr = {
+		.name = "set-cookie",
+		.value = "id=1",
+		.name_len = strlen("set-cookie"),
+		.value_len = strlen("id=1"),
+	};
+	int ret;
+
+	http_hpack_dynamic_table_init(&table);
+
+	for (int i = 0; i < 2; i++) {
+		ret = http_hpack_encode_header_table(test_buf, sizeof(test_buf), &hdr, &table);
+		zassert_true(ret > 0, "Failed to encode header (%d)", ret);
+		zassert_equal(test_buf[0], 0x1f, "Should be never indexed");
+	}
+
+	zassert_equal(table.count, 0, "Sensitive field should not be in the table");
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
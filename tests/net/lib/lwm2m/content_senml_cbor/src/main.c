@@ -955,6 +955,40 @@ ZTEST(net_content_senml_cbor_nomem, test_put_time_nomem)
 	zassert_equal(ret, -ENOMEM, "Invalid error code returned");
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+ZTEST(net_content_senml_cbor_nomem, test_put_array_head_nomem)
+{
+	int ret;
+
+	/* Room for the array head, but not for the record */
+	test_msg.cpkt.offset -= 1;
+	test_msg.path.res_id = TEST_RES_S8;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_equal(ret, -ENOMEM, "Invalid error code returned");
+
+	/* The array head is taken back along with the record */
+	zassert_equal(test_msg.cpkt.offset, sizeof(test_msg.msg_data) - 1,
+		      "Invalid packet offset");
+}
+#endif
+
+ZTEST(net_content_senml_cbor, test_put_object_instance)
+{
+	int ret;
+	uint8_t *payload = test_msg.msg_data + TEST_PAYLOAD_OFFSET;
+
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_true(ret >= 0, "Error reported");
+
+	/* One record per resource, the base name is carried by the first one only */
+	zassert_equal(payload[0], (0x04 << 5) | TEST_OBJ_RES_MAX_ID, "Invalid record count");
+	zassert_equal(payload[1], (0x05 << 5) | 3, "Invalid first record");
+	zassert_equal(payload[2], (0x01 << 5) | 1, "Missing base name");
+}
+
 ZTEST(net_content_senml_cbor, test_get_s32)
 {
 	int ret;
@@ -458,6 +458,31 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_lookup)
+{
+	struct lwm2m_engine_obj_inst *oi[CONFIG_LWM2M_IPSO_TEMP_SENSOR_INSTANCE_COUNT];
+
+	for (int i = 0; i < ARRAY_SIZE(oi); i++) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, i)), 0);
+		oi[i] = lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, i));
+		zassert_not_null(oi[i]);
+		zassert_equal(oi[i]->obj_inst_id, i);
+	}
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 1)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3304, 0)));
+
+	for (int i = 0; i < ARRAY_SIZE(oi); i++) {
+		if (i == 1) {
+			continue;
+		}
+
+		zassert_equal(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, i)), oi[i]);
+		zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, i)), 0);
+	}
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
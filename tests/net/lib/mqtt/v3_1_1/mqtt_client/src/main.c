@@ -41,6 +41,7 @@ static struct mqtt_test_ctx {
 	bool suback_handled;
 	bool unsuback_handled;
 	uint16_t msg_id;
+	uint8_t broker_flags;
 	int payload_left;
 	const uint8_t *payload;
 } test_ctx;
@@ -368,6 +369,7 @@ static int broker_receive(uint8_t expected_packet)
 		      "Unexpected packet type received at the broker, (%02x)",
 		      type);
 
+	test_ctx.broker_flags = flags;
 	broker_validate_packet(buf.cur, length, type, flags);
 
 	broker_offset -= bytes_consumed;
@@ -623,6 +625,8 @@ static void test_publish(enum mqtt_qos qos)
 
 	ret = mqtt_publish(&client_ctx, &param);
 	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush (%d)", ret);
 	broker_process(MQTT_PKT_TYPE_PUBLISH);
 
 	client_wait(true);
@@ -801,6 +805,161 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+static void prepare_publish(struct mqtt_publish_param *param, enum mqtt_qos qos)
+{
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1U;
+
+	memset(param, 0, sizeof(*param));
+	param->message.topic.qos = qos;
+	param->message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param->message.topic.topic.size = strlen(get_mqtt_topic());
+	param->message.payload.data = (uint8_t *)payload_short;
+	param->message.payload.len = strlen(payload_short);
+	param->message_id = test_ctx.msg_id;
+}
+
+static bool broker_has_data(void)
+{
+	struct zsock_pollfd fds[1] = {
+		{ c_sock, ZSOCK_POLLIN, 0},
+	};
+
+	return broker_offset > 0 || zsock_poll(fds, ARRAY_SIZE(fds), TIMEOUT) > 0;
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queued)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MQTT_LIB_TX_QUEUE);
+
+	prepare_publish(&param, MQTT_QOS_0_AT_MOST_ONCE);
+
+	test_connect();
+
+	for (int i = 0; i < 3; i++) {
+		ret = mqtt_publish(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	}
+
+	zassert_false(broker_has_data(), "Publish should wait in the queue");
+	zassert_equal(mqtt_keepalive_time_left(&client_ctx), 0,
+		      "Queued data should expire the poll timeout");
+
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush (%d)", ret);
+
+	for (int i = 0; i < 3; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_disconnect();
+}
+
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+static void test_publish_param(const struct mqtt_publish_param *param)
+{
+	int ret;
+
+	ret = mqtt_publish(&client_ctx, param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+}
+
+ZTEST(mqtt_client, test_mqtt_inflight_window)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	prepare_publish(&param, MQTT_QOS_1_AT_LEAST_ONCE);
+
+	test_connect();
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_WINDOW; i++) {
+		ret = mqtt_publish(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+		param.message_id++;
+	}
+
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_equal(ret, -EBUSY, "Inflight window should be full (%d)", ret);
+
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush (%d)", ret);
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_WINDOW; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	/* Acknowledgments arrive in order. */
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_WINDOW; i++) {
+		test_ctx.msg_id = 1U + i;
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+
+	test_ctx.msg_id = param.message_id;
+	test_publish_param(&param);
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_inflight_retransmit)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	prepare_publish(&param, MQTT_QOS_1_AT_LEAST_ONCE);
+
+	test_connect();
+
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	ret = mqtt_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	zassert_false(test_ctx.broker_flags & MQTT_HEADER_DUP_MASK,
+		      "First transmission should not be a duplicate");
+
+	/* Leave the PUBACK unread until the retransmission timeout. */
+	zassert_true(mqtt_keepalive_time_left(&client_ctx) <=
+		     CONFIG_MQTT_LIB_INFLIGHT_RETRANSMIT_TIMEOUT,
+		     "Poll timeout should account for the retransmission");
+	k_msleep(CONFIG_MQTT_LIB_INFLIGHT_RETRANSMIT_TIMEOUT);
+
+	ret = mqtt_live(&client_ctx);
+	zassert_equal(ret, -EAGAIN, "No ping expected (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	zassert_true(test_ctx.broker_flags & MQTT_HEADER_DUP_MASK,
+		     "Retransmission should carry the DUP flag");
+
+	/* The broker acknowledged both transmissions. */
+	for (int i = 0; i < 2; i++) {
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+	zassert_true(mqtt_keepalive_time_left(&client_ctx) >
+		     CONFIG_MQTT_LIB_INFLIGHT_RETRANSMIT_TIMEOUT,
+		     "Nothing should be left to retransmit");
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
@@ -53,4 +53,31 @@ ZTEST(test_collector, test_prometheus_collector_register)
 	zassert_equal(counter->value, 1, "Counter value is not 1");
 }
 
+static void test_scrape_cb(const struct prometheus_collector *collector, void *user_data)
+{
+	ARG_UNUSED(collector);
+	ARG_UNUSED(user_data);
+}
+
+/**
+ * @brief Test prometheus_collector_set_scrape_cb
+ *
+ * @details The test shall set and clear the scrape callback of the collector
+ * and check that prometheus_collector_get_scrape_cb() returns it.
+ */
+ZTEST(test_collector, test_prometheus_collector_scrape_cb)
+{
+	zassert_is_null(prometheus_collector_get_scrape_cb(&test_custom_collector),
+			"Unexpected scrape callback");
+
+	zassert_ok(prometheus_collector_set_scrape_cb(&test_custom_collector, test_scrape_cb,
+						      NULL));
+	zassert_equal(prometheus_collector_get_scrape_cb(&test_custom_collector), test_scrape_cb,
+		      "Scrape callback not set");
+
+	zassert_ok(prometheus_collector_set_scrape_cb(&test_custom_collector, NULL, NULL));
+	zassert_is_null(prometheus_collector_get_scrape_cb(&test_custom_collector),
+			"Scrape callback not cleared");
+}
+
 ZTEST_SUITE(test_collector, NULL, NULL, NULL, NULL, NULL);
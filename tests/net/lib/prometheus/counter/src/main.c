@@ -43,4 +43,40 @@ ZTEST(test_counter, test_prometheus_counter_inc)
 	zassert_equal(test_counter_m.value, 2, "Counter value is not 2");
 }
 
+struct prometheus_metric test_counter_add_metric = {
+	.type = PROMETHEUS_COUNTER,
+	.name = "test_counter_add",
+	.description = "Test counter add",
+};
+
+PROMETHEUS_COUNTER_DEFINE(test_counter_add_m, &test_counter_add_metric);
+
+/**
+ * @brief Test prometheus_counter_add, prometheus_counter_set and prometheus_counter_get
+ * @details The test shall add to the counter, overwrite its value and check
+ * that the getter returns the expected value after each step.
+ */
+ZTEST(test_counter, test_prometheus_counter_add_set)
+{
+	int ret;
+
+	zassert_equal(prometheus_counter_get(&test_counter_add_m), 0, "Counter value is not 0");
+
+	ret = prometheus_counter_add(&test_counter_add_m, 5);
+	zassert_ok(ret, "Error adding to counter");
+
+	zassert_equal(prometheus_counter_get(&test_counter_add_m), 5, "Counter value is not 5");
+
+	ret = prometheus_counter_set(&test_counter_add_m, 0x100000000ULL);
+	zassert_ok(ret, "Error setting counter");
+
+	ret = prometheus_counter_inc(&test_counter_add_m);
+	zassert_ok(ret, "Error incrementing counter");
+
+	zassert_equal(prometheus_counter_get(&test_counter_add_m), 0x100000001ULL,
+		      "Counter value is not 0x100000001");
+
+	zassert_equal(prometheus_counter_add(NULL, 1), -EINVAL, "NULL counter accepted");
+}
+
 ZTEST_SUITE(test_counter, NULL, NULL, NULL, NULL, NULL);
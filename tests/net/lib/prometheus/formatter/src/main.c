@@ -7,6 +7,8 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
+#include <zephyr/net/prometheus/histogram.h>
 #include <zephyr/net/prometheus/collector.h>
 #include <zephyr/net/prometheus/formatter.h>
 
@@ -62,4 +64,120 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 	zassert_equal(strcmp(formatted, exposed), 0, "Exposition format is not as expected");
 }
 
+struct prometheus_metric test_scraped_metric = {
+	.type = PROMETHEUS_COUNTER,
+	.name = "test_scraped",
+	.description = "Test scraped counter",
+};
+
+PROMETHEUS_COUNTER_DEFINE(test_scraped_m, &test_scraped_metric);
+
+struct prometheus_metric test_gauge_metric = {
+	.type = PROMETHEUS_GAUGE,
+	.name = "test_gauge",
+	.description = "",
+};
+
+PROMETHEUS_GAUGE_DEFINE(test_gauge_m, &test_gauge_metric);
+
+struct prometheus_metric test_histogram_metric = {
+	.type = PROMETHEUS_HISTOGRAM,
+	.name = "test_histogram",
+	.description = "Test histogram",
+};
+
+PROMETHEUS_HISTOGRAM_DEFINE(test_histogram_m, &test_histogram_metric);
+
+static struct prometheus_histogram_bucket test_buckets[] = {
+	{ .upper_bound = 0.5 },
+	{ .upper_bound = 1.0 },
+};
+
+PROMETHEUS_COLLECTOR_DEFINE(test_chunked_collector);
+
+static void test_scrape_cb(const struct prometheus_collector *collector, void *user_data)
+{
+	int *scrapes = user_data;
+
+	zassert_equal(collector, &test_chunked_collector, "Wrong collector");
+
+	(*scrapes)++;
+	prometheus_counter_set(&test_scraped_m, *scrapes * 10);
+}
+
+/**
+ * @brief Test the streaming Prometheus formatter
+ * @details The test shall format several metrics in chunks smaller than the
+ * whole exposition, check that every chunk holds whole lines and that the
+ * chunks add up to the expected output, with the scrape callback invoked once
+ * per scrape.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_chunked)
+{
+	int ret;
+	int scrapes = 0;
+	int chunks = 0;
+	size_t len = 0;
+	char chunk[48];
+	char formatted[2 * MAX_BUFFER_SIZE];
+	struct prometheus_format_ctx ctx;
+	char exposed[] = "# HELP test_scraped Test scraped counter\n"
+			 "# TYPE test_scraped counter\n"
+			 "test_scraped 10\n"
+			 "# TYPE test_gauge gauge\n"
+			 "test_gauge 1.500000\n"
+			 "# HELP test_histogram Test histogram\n"
+			 "# TYPE test_histogram histogram\n"
+			 "test_histogram_bucket{le=\"0.500000\"} 1\n"
+			 "test_histogram_bucket{le=\"1.000000\"} 1\n"
+			 "test_histogram_sum 1.000000\n"
+			 "test_histogram_count 2\n";
+
+	test_histogram_m.buckets = test_buckets;
+	test_histogram_m.num_buckets = ARRAY_SIZE(test_buckets);
+
+	prometheus_collector_register_metric(&test_chunked_collector, test_scraped_m.base);
+	prometheus_collector_register_metric(&test_chunked_collector, test_gauge_m.base);
+	prometheus_collector_register_metric(&test_chunked_collector, test_histogram_m.base);
+
+	ret = prometheus_collector_set_scrape_cb(&test_chunked_collector, test_scrape_cb,
+						 &scrapes);
+	zassert_ok(ret, "Error setting scrape callback");
+
+	zassert_ok(prometheus_gauge_set(&test_gauge_m, 1.5), "Error setting gauge");
+	zassert_ok(prometheus_histogram_observe(&test_histogram_m, 0.25), "Error observing");
+	zassert_ok(prometheus_histogram_observe(&test_histogram_m, 0.75), "Error observing");
+
+	prometheus_format_init(&ctx, &test_chunked_collector);
+	zassert_equal(scrapes, 1, "Scrape callback not invoked");
+
+	while ((ret = prometheus_format_next(&ctx, chunk, sizeof(chunk))) > 0) {
+		zassert_equal(strlen(chunk), ret, "Chunk length mismatch");
+		zassert_equal(chunk[ret - 1], '\n', "Chunk does not end with a whole line");
+		zassert_true(len + ret < sizeof(formatted), "Exposition too long");
+
+		memcpy(formatted + len, chunk, ret);
+		len += ret;
+		chunks++;
+	}
+
+	zassert_ok(ret, "Error formatting chunk (%d)", ret);
+	zassert_true(prometheus_format_done(&ctx), "Formatter not done");
+	zassert_true(chunks > 1, "Exposition was not split into chunks");
+
+	formatted[len] = '\0';
+	zassert_equal(strcmp(formatted, exposed), 0, "Exposition format is not as expected");
+
+	/* A buffer too small for the whole exposition must be reported */
+	ret = prometheus_format_exposition(&test_chunked_collector, chunk, sizeof(chunk));
+	zassert_equal(ret, -ENOMEM, "Truncated exposition not reported");
+
+	/* A line longer than the buffer cannot be written at all */
+	prometheus_format_init(&ctx, &test_chunked_collector);
+	ret = prometheus_format_next(&ctx, chunk, 8);
+	zassert_equal(ret, -ENOMEM, "Line longer than buffer not reported");
+
+	zassert_equal(scrapes, 3, "Scrape callback not invoked per scrape");
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
@@ -45,6 +45,7 @@ ZTEST(test_gauge, test_gauge_set)
 	zassert_ok(ret, "Error setting gauge");
 
 	zassert_equal(test_gauge_m.value, 2, "Gauge value is not 2");
+	zassert_equal(prometheus_gauge_get(&test_gauge_m), 2, "Gauge value is not 2");
 }
 
 ZTEST_SUITE(test_gauge, NULL, NULL, NULL, NULL, NULL);
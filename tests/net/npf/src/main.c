@@ -483,4 +483,53 @@ ZTEST(net_pkt_filter_test_suite, test_npf_ipv6_address_filtering)
 	net_pkt_unref(pkt_v4);
 }
 
+static struct in_addr ipv4_large_list[12] = {
+	{ { { 10, 0, 0, 1 } } },
+	{ { { 10, 0, 0, 2 } } },
+	{ { { 10, 0, 0, 3 } } },
+	{ { { 10, 0, 1, 1 } } },
+	{ { { 10, 0, 1, 2 } } },
+	{ { { 10, 0, 1, 3 } } },
+	{ { { 172, 16, 0, 1 } } },
+	{ { { 172, 16, 0, 2 } } },
+	{ { { 172, 16, 0, 3 } } },
+	{ { { 192, 168, 0, 1 } } },
+	{ { { 192, 168, 0, 2 } } },
+	{ { { 192, 168, 0, 3 } } },
+};
+
+static NPF_IP_SRC_ADDR_ALLOWLIST(allowlist_ipv4_large, (void *)ipv4_large_list,
+				 ARRAY_SIZE(ipv4_large_list), AF_INET);
+static NPF_SIZE_MAX(maxsize_100, 100);
+
+static NPF_RULE(ipv4_large_allowlist, NET_OK, maxsize_100, allowlist_ipv4_large);
+
+ZTEST(net_pkt_filter_test_suite, test_npf_ipv4_large_address_set)
+{
+	struct in_addr dst = { { { 192, 168, 2, 1 } } };
+	struct in_addr other = { { { 10, 0, 2, 1 } } };
+	struct net_pkt *pkt = build_test_ip_pkt(&ipv4_large_list[0], &dst, AF_INET,
+						&dummy_iface_a);
+
+	npf_append_ipv4_recv_rule(&ipv4_large_allowlist);
+	npf_append_ipv4_recv_rule(&npf_default_drop);
+
+	for (int it = 0; it < ARRAY_SIZE(ipv4_large_list); it++) {
+		memcpy((struct in_addr *)NET_IPV4_HDR(pkt)->src, &ipv4_large_list[it],
+		       sizeof(struct in_addr));
+		zassert_true(net_pkt_filter_ip_recv_ok(pkt), "");
+	}
+
+	memcpy((struct in_addr *)NET_IPV4_HDR(pkt)->src, &other, sizeof(struct in_addr));
+	zassert_false(net_pkt_filter_ip_recv_ok(pkt), "");
+
+	/* Changing an installed set needs the rule list to be updated */
+	ipv4_large_list[5] = other;
+	npf_rules_update(&npf_ipv4_recv_rules);
+	zassert_true(net_pkt_filter_ip_recv_ok(pkt), "");
+
+	zassert_true(npf_remove_all_ipv4_recv_rules(), "");
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_filter_test_suite, NULL, test_npf_iface, NULL, NULL, NULL);
@@ -1496,6 +1496,78 @@ ZTEST(net_socket_tcp, test_so_sndbuf_win_size)
 	test_context_cleanup();
 }
 
+#define PACING_DATA_LEN 4000
+#define PACING_RATE 20000 /* bytes per second */
+
+ZTEST(net_socket_tcp, test_so_max_pacing_rate)
+{
+	static uint8_t tx_buf[PACING_DATA_LEN];
+	static uint8_t rx_buf[PACING_DATA_LEN];
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	uint32_t optval = PACING_RATE;
+	uint32_t retval = 0;
+	socklen_t optlen = sizeof(retval);
+	int64_t start;
+	int64_t elapsed;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_PACING);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	rv = zsock_setsockopt(c_sock, SOL_SOCKET, SO_MAX_PACING_RATE, &optval,
+			      sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	rv = zsock_getsockopt(c_sock, SOL_SOCKET, SO_MAX_PACING_RATE, &retval,
+			      &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(retval, optval, "getsockopt got invalid pacing rate");
+	zassert_equal(optlen, sizeof(retval), "getsockopt got invalid size");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	for (size_t i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = (uint8_t)i;
+	}
+
+	start = k_uptime_get();
+
+	rv = zsock_send(c_sock, tx_buf, sizeof(tx_buf), 0);
+	zassert_equal(rv, sizeof(tx_buf), "send failed (%d)", errno);
+
+	rv = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_WAITALL);
+	zassert_equal(rv, sizeof(rx_buf), "recv failed (%d)", errno);
+
+	elapsed = k_uptime_delta(&start);
+
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(tx_buf), "Data mismatch");
+
+	/* Only the first segment may leave without waiting for the pacing
+	 * rate, the loopback MTU allows at most a third of the data in it.
+	 */
+	zassert_true(elapsed >= (PACING_DATA_LEN * 2 / 3) * MSEC_PER_SEC / PACING_RATE,
+		     "Data received after %d ms, not paced", (int)elapsed);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_v4_so_rcvtimeo)
 {
 	int c_sock;
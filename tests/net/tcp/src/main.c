@@ -31,7 +31,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "tcp.h"
-#include "tcp_private.h"
+#include "tcp_internal.h"
 #include "net_stats.h"
 
 #include <zephyr/ztest.h>
@@ -114,6 +114,8 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_SACK_IPV4 = 19,
+	TEST_SERVER_SENDER_IPV4 = 20,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +140,8 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_test(struct net_pkt *pkt);
+static void handle_server_sender_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,6 +239,20 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Window advertised by the peer, as written in the TCP header */
+static uint16_t peer_window = NET_IPV6_MTU;
+
+/* Options added by the peer to segments other than SYN */
+static uint8_t peer_options[12];
+static size_t peer_options_len;
+
+static bool syn_with_options(uint8_t flags)
+{
+	return (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+		test_case_no == TEST_SERVER_SACK_IPV4 ||
+		test_case_no == TEST_SERVER_SENDER_IPV4) && (flags & SYN);
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -245,11 +263,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (syn_with_options(flags)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (!(flags & SYN)) {
+		opts = peer_options;
+		opts_len = peer_options_len;
 	}
 
 	/* Allocate buffer */
@@ -284,14 +307,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = peer_window;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -303,9 +321,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0U) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -490,6 +508,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_SACK_IPV4:
+		handle_server_sack_test(pkt);
+		break;
+	case TEST_SERVER_SENDER_IPV4:
+		handle_server_sender_test(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -766,6 +790,8 @@ static void test_server_timeout(struct k_work *work)
 {
 	if (test_case_no == TEST_SERVER_IPV4 ||
 	    test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+	    test_case_no == TEST_SERVER_SACK_IPV4 ||
+	    test_case_no == TEST_SERVER_SENDER_IPV4 ||
 	    test_case_no == TEST_SERVER_RST_ON_CLOSED_PORT ||
 	    test_case_no == TEST_SERVER_RST_ON_LISTENING_PORT_NO_ACTIVE_CONNECTION) {
 		handle_server_test(AF_INET, NULL);
@@ -2602,4 +2628,849 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+static int read_tcp_option(struct net_pkt *pkt, struct tcphdr *th,
+			   uint8_t kind, uint8_t *value, size_t value_len)
+{
+	uint8_t options[40];
+	size_t options_len = (th->th_off - 5) * 4;
+	size_t i = 0;
+	int ret;
+
+	if (options_len == 0) {
+		return -ENOENT;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret == 0) {
+		ret = net_pkt_read(pkt, options, options_len);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (i < options_len) {
+		uint8_t opt = options[i];
+		uint8_t opt_len;
+
+		if (opt == NET_TCP_END_OPT) {
+			break;
+		}
+
+		if (opt == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= options_len) {
+			break;
+		}
+
+		opt_len = options[i + 1];
+		if (opt_len < 2 || i + opt_len > options_len) {
+			break;
+		}
+
+		if (opt == kind) {
+			if (value != NULL) {
+				memcpy(value, &options[i + 2],
+				       MIN(value_len, opt_len - 2));
+			}
+
+			return opt_len - 2;
+		}
+
+		i += opt_len;
+	}
+
+	return -ENOENT;
+}
+
+static uint32_t sack_expected_ack;
+static uint32_t sack_expected_start;
+static uint32_t sack_expected_end;
+
+static void handle_server_sack_test(struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	uint8_t sack[NET_TCP_SACK_BLOCK_SIZE];
+	struct tcphdr th;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	switch (t_state) {
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+
+		ret = read_tcp_option(pkt, &th, NET_TCP_SACK_PERM_OPT, NULL, 0);
+		zassert_equal(ret, 0, "SACK permitted option missing in SYN ACK");
+
+		seq++;
+		ack = ntohl(th.th_seq) + 1U;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_DATA_ACK;
+
+		ret = net_recv_data(net_iface, reply);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		break;
+	case T_DATA_ACK:
+		zassert_equal(sack_expected_ack, ntohl(th.th_ack),
+			      "Expected ACK %u but got %u",
+			      sack_expected_ack, ntohl(th.th_ack));
+
+		ret = read_tcp_option(pkt, &th, NET_TCP_SACK_OPT, sack, sizeof(sack));
+		if (sack_expected_end == 0U) {
+			zassert_equal(ret, -ENOENT, "Unexpected SACK option");
+		} else {
+			zassert_equal(ret, NET_TCP_SACK_BLOCK_SIZE,
+				      "Expected one SACK block (%d)", ret);
+			zassert_equal(sys_get_be32(&sack[0]), sack_expected_start,
+				      "Invalid SACK block start");
+			zassert_equal(sys_get_be32(&sack[4]), sack_expected_end,
+				      "Invalid SACK block end");
+		}
+
+		test_sem_give();
+		break;
+	default:
+		zassert_true(false, "%s: unexpected state", __func__);
+		return;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void send_sack_test_data(uint32_t offset, size_t len,
+				uint32_t expected_ack,
+				uint32_t expected_start,
+				uint32_t expected_end)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = 1U + offset;
+	sack_expected_ack = expected_ack;
+	sack_expected_start = expected_start;
+	sack_expected_end = expected_end;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				  lorem_ipsum + offset, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Peer will release the semaphore after it checked the ACK */
+	test_sem_take(K_MSEC(1000), __LINE__);
+}
+
+/* Test case scenario IPv4
+ *   Expect SYN with SACK permitted option,
+ *   send SYN ACK with SACK permitted option,
+ *   expect ACK,
+ *   send out-of-order DATA,
+ *   expect duplicate ACK with a SACK block covering the DATA,
+ *   send the missing DATA,
+ *   expect ACK covering all the DATA without a SACK block,
+ *   send RST.
+ */
+ZTEST(net_tcp, test_server_sack_ipv4)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_SACK);
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_SACK_IPV4;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	/* test_tcp_accept_cb will release the semaphore after successful
+	 * connection.
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_true(accepted_ctx->tcp->sack_permitted, "SACK not negotiated");
+
+	/* Out-of-order data, expect the hole to be reported */
+	send_sack_test_data(10, 10, 1, 11, 21);
+
+	/* Fill the hole, everything is acknowledged cumulatively */
+	send_sack_test_data(0, 10, 21, 0, 0);
+
+	/* Abort the connection, no need for a full closing handshake */
+	seq = 21U;
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Data segments sent by the stack under test. The peer only records them,
+ * the test case decides which of them get acknowledged.
+ */
+#define SENT_SEGMENTS_MAX 16
+
+static struct sent_segment {
+	uint32_t seq; /* relative to the first byte of data */
+	uint16_t len;
+	int64_t time;
+} sent_segments[SENT_SEGMENTS_MAX];
+
+static int sent_segment_count;
+static uint32_t sender_isn;
+static K_SEM_DEFINE(sent_sem, 0, SENT_SEGMENTS_MAX);
+
+static void handle_server_sender_test(struct net_pkt *pkt)
+{
+	struct sent_segment *segment;
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	switch (t_state) {
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+		seq++;
+		ack = ntohl(th.th_seq) + 1U;
+		sender_isn = ack;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_DATA;
+
+		ret = net_recv_data(net_iface, reply);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		break;
+	case T_DATA:
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+		if (len == 0U) {
+			/* Nothing to record for pure ACKs */
+			break;
+		}
+
+		zassert_true(sent_segment_count < SENT_SEGMENTS_MAX,
+			     "Too many segments");
+
+		segment = &sent_segments[sent_segment_count++];
+		segment->seq = ntohl(th.th_seq) - sender_isn;
+		segment->len = len;
+		segment->time = k_uptime_get();
+
+		k_sem_give(&sent_sem);
+		break;
+	default:
+		zassert_true(false, "%s: unexpected state", __func__);
+		return;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Listen for a connection whose accepted side sends data to the peer, the
+ * options of the listening context are inherited by the accepted one.
+ */
+static struct net_context *sender_test_listen(void)
+{
+	struct net_context *ctx;
+	int ret;
+
+	k_sem_reset(&test_sem);
+	k_sem_reset(&sent_sem);
+	sent_segment_count = 0;
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_SENDER_IPV4;
+	seq = ack = 0;
+	peer_window = htons(NET_IPV6_MTU);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	return ctx;
+}
+
+static void sender_test_accept(struct net_context *ctx)
+{
+	struct tcp *conn;
+	int ret;
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* The accept callback runs before the handshake is complete, wait
+	 * for the connection to be fully set up.
+	 */
+	conn = accepted_ctx->tcp;
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	k_mutex_unlock(&conn->lock);
+}
+
+/* Establish a connection whose accepted side sends data to the peer,
+ * returns the listening context.
+ */
+static struct net_context *sender_test_setup(void)
+{
+	struct net_context *ctx;
+
+	ctx = sender_test_listen();
+	sender_test_accept(ctx);
+
+	return ctx;
+}
+
+static void sender_test_teardown(struct net_context *ctx)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	/* Abort the connection, no need for a full closing handshake */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	peer_window = NET_IPV6_MTU;
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Acknowledge the data up to rel_ack, optionally with a SACK block */
+static void sender_ack(uint32_t rel_ack, uint32_t sack_start, uint32_t sack_end)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	ack = sender_isn + rel_ack;
+
+	if (sack_end != sack_start) {
+		peer_options[0] = NET_TCP_NOP_OPT;
+		peer_options[1] = NET_TCP_NOP_OPT;
+		peer_options[2] = NET_TCP_SACK_OPT;
+		peer_options[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		sys_put_be32(sender_isn + sack_start, &peer_options[4]);
+		sys_put_be32(sender_isn + sack_end, &peer_options[8]);
+		peer_options_len = sizeof(peer_options);
+	}
+
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	peer_options_len = 0;
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+}
+
+static void sender_wait_segments(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&sent_sem, K_MSEC(1000)), 0,
+			      "Segment %d not sent", sent_segment_count);
+	}
+}
+
+static void sender_check_segment(int i, uint32_t rel_seq, uint16_t len)
+{
+	zassert_equal(sent_segments[i].seq, rel_seq,
+		      "Segment %d: expected seq %u but got %u", i, rel_seq,
+		      sent_segments[i].seq);
+	zassert_equal(sent_segments[i].len, len,
+		      "Segment %d: expected len %u but got %u", i, len,
+		      sent_segments[i].len);
+}
+
+/* Test case scenario IPv4
+ *   Establish a connection which negotiates SACK,
+ *   send five segments of data,
+ *   ACK the first one and drop the second one,
+ *   send a duplicate ACK with a SACK block covering the last three,
+ *   expect only the dropped segment to be retransmitted,
+ *   send an ACK covering all the data,
+ *   expect the scoreboard to be empty.
+ */
+ZTEST(net_tcp, test_server_sack_retransmit_ipv4)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint16_t mss;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_SACK);
+
+	ctx = sender_test_setup();
+	conn = accepted_ctx->tcp;
+
+	zassert_true(conn->sack_permitted, "SACK not negotiated");
+
+	mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Do not let the congestion window hold back the burst */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = UINT16_MAX;
+	k_mutex_unlock(&conn->lock);
+#endif
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 5 * mss, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 5 * mss, "Failed to send data (%d)", ret);
+
+	sender_wait_segments(5);
+	for (int i = 0; i < 5; i++) {
+		sender_check_segment(i, i * mss, mss);
+	}
+
+	/* The second segment is lost, the last three ones got through */
+	sender_ack(mss, 0, 0);
+	sender_ack(mss, 2 * mss, 5 * mss);
+
+	/* Only the hole is retransmitted */
+	sender_wait_segments(1);
+	sender_check_segment(5, mss, mss);
+	zassert_not_equal(k_sem_take(&sent_sem, K_MSEC(20)), 0,
+			  "Unexpected retransmission");
+
+#if defined(CONFIG_NET_TCP_SACK)
+	zassert_equal(conn->sack_scoreboard_num, 1, "Invalid scoreboard size %d",
+		      conn->sack_scoreboard_num);
+	zassert_equal(conn->sack_scoreboard[0].start, sender_isn + 2 * mss,
+		      "Invalid scoreboard start");
+	zassert_equal(conn->sack_scoreboard[0].end, sender_isn + 5 * mss,
+		      "Invalid scoreboard end");
+#endif
+
+	/* The retransmission filled the hole */
+	sender_ack(5 * mss, 0, 0);
+	k_msleep(10);
+
+#if defined(CONFIG_NET_TCP_SACK)
+	zassert_equal(conn->sack_scoreboard_num, 0, "Scoreboard not cleared");
+#endif
+	zassert_equal(conn->send_data_total, 0, "Data not acknowledged");
+
+	sender_test_teardown(ctx);
+}
+
+static void check_congestion_option(struct net_context *ctx, const char *name)
+{
+	char buf[16];
+	size_t len = sizeof(buf);
+	int ret;
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, name, strlen(name) + 1);
+	zassert_equal(ret, 0, "Failed to select %s (%d)", name, ret);
+
+	ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, buf, &len);
+	zassert_equal(ret, 0, "Failed to get congestion control (%d)", ret);
+	zassert_str_equal(buf, name, "Unexpected congestion control %s", buf);
+	zassert_equal(len, strlen(name) + 1, "Unexpected length %zu", len);
+}
+
+/* Test case scenario
+ *   Select each built-in congestion control algorithm on a context
+ *   and read the selection back, an unknown name is rejected.
+ */
+ZTEST(net_tcp, test_congestion_control_option)
+{
+	struct net_context *ctx;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		check_congestion_option(ctx, "cubic");
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_BBR)) {
+		check_congestion_option(ctx, "bbr");
+	}
+
+	check_congestion_option(ctx, "reno");
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "unknown",
+				 sizeof("unknown"));
+	zassert_equal(ret, -ENOENT, "Unknown algorithm accepted (%d)", ret);
+
+	net_context_put(ctx);
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+enum ca_step {
+	CA_INIT,          /* connection established */
+	CA_SLOW_START,    /* two rounds of slow start done */
+	CA_FAST_RECOVERY, /* lost segment retransmitted after 3 duplicate ACKs */
+	CA_RECOVERED,     /* lost segment acknowledged */
+	CA_AVOIDANCE,     /* one more round acknowledged */
+	CA_STEPS,
+};
+
+struct ca_trace {
+	uint16_t mss;
+	uint16_t cwnd[CA_STEPS];
+	uint16_t ssthresh[CA_STEPS];
+};
+
+static void ca_trace_record(struct tcp *conn, struct ca_trace *trace,
+			    enum ca_step step)
+{
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	trace->cwnd[step] = conn->ca.cwnd;
+	trace->ssthresh[step] = conn->ca.ssthresh;
+	k_mutex_unlock(&conn->lock);
+}
+
+/* Drive a connection using the given congestion control algorithm through
+ * slow start, a fast retransmit and the following recovery, recording the
+ * window after each step.
+ */
+static void ca_scenario(const char *name, struct ca_trace *trace)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint16_t mss;
+	int ret;
+
+	ctx = sender_test_listen();
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, name, strlen(name) + 1);
+	zassert_equal(ret, 0, "Failed to select %s (%d)", name, ret);
+
+	sender_test_accept(ctx);
+	conn = accepted_ctx->tcp;
+	mss = conn_mss(conn);
+	trace->mss = mss;
+
+	ca_trace_record(conn, trace, CA_INIT);
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 6 * mss, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 6 * mss, "Failed to send data (%d)", ret);
+
+	/* The initial window holds one segment */
+	sender_wait_segments(1);
+	zassert_not_equal(k_sem_take(&sent_sem, K_MSEC(20)), 0,
+			  "Initial window exceeded");
+
+	sender_ack(mss, 0, 0);
+	sender_wait_segments(2);
+
+	sender_ack(3 * mss, 0, 0);
+	sender_wait_segments(3);
+	ca_trace_record(conn, trace, CA_SLOW_START);
+
+	for (int i = 0; i < 6; i++) {
+		sender_check_segment(i, i * mss, mss);
+	}
+
+	/* The fourth segment is lost */
+	for (int i = 0; i < 3; i++) {
+		sender_ack(3 * mss, 0, 0);
+	}
+
+	sender_wait_segments(1);
+	sender_check_segment(6, 3 * mss, mss);
+	ca_trace_record(conn, trace, CA_FAST_RECOVERY);
+
+	sender_ack(6 * mss, 0, 0);
+	k_msleep(10);
+	ca_trace_record(conn, trace, CA_RECOVERED);
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 2 * mss, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 2 * mss, "Failed to send data (%d)", ret);
+
+	sender_wait_segments(2);
+	sender_check_segment(7, 6 * mss, mss);
+	sender_check_segment(8, 7 * mss, mss);
+
+	sender_ack(8 * mss, 0, 0);
+	k_msleep(10);
+	ca_trace_record(conn, trace, CA_AVOIDANCE);
+
+	zassert_equal(conn->send_data_total, 0, "Data not acknowledged");
+
+	sender_test_teardown(ctx);
+}
+
+static void ca_trace_check(const struct ca_trace *trace, enum ca_step step,
+			   uint16_t cwnd, uint16_t ssthresh)
+{
+	zassert_equal(trace->cwnd[step], cwnd, "Step %d: expected cwnd %u but got %u",
+		      step, cwnd, trace->cwnd[step]);
+	zassert_equal(trace->ssthresh[step], ssthresh,
+		      "Step %d: expected ssthresh %u but got %u", step, ssthresh,
+		      trace->ssthresh[step]);
+}
+
+/* Test case scenario
+ *   New Reno halves the window on a loss, inflates it by one segment for
+ *   every duplicate ACK during fast recovery and deflates it back to
+ *   ssthresh once the loss is repaired.
+ */
+ZTEST(net_tcp, test_congestion_control_reno)
+{
+	struct ca_trace trace;
+	uint16_t mss;
+
+	ca_scenario("reno", &trace);
+	mss = trace.mss;
+
+	ca_trace_check(&trace, CA_INIT, mss, 3 * mss);
+	ca_trace_check(&trace, CA_SLOW_START, 3 * mss, 3 * mss);
+	/* ssthresh is half of the three segments in flight, at least two */
+	ca_trace_check(&trace, CA_FAST_RECOVERY, 5 * mss, 2 * mss);
+	ca_trace_check(&trace, CA_RECOVERED, 2 * mss, 2 * mss);
+	/* mss * mss / cwnd per ACK in congestion avoidance */
+	ca_trace_check(&trace, CA_AVOIDANCE, 2 * mss + DIV_ROUND_UP(mss, 2), 2 * mss);
+}
+
+/* Test case scenario
+ *   CUBIC reduces the window by beta_cubic (0.7) on a loss and grows it
+ *   back towards the window where the loss happened.
+ */
+ZTEST(net_tcp, test_congestion_control_cubic)
+{
+	struct ca_trace trace;
+	uint16_t ssthresh;
+	uint16_t mss;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_CUBIC);
+
+	ca_scenario("cubic", &trace);
+	mss = trace.mss;
+	ssthresh = (3 * mss * 7) / 10;
+
+	ca_trace_check(&trace, CA_INIT, mss, 3 * mss);
+	ca_trace_check(&trace, CA_SLOW_START, 3 * mss, 3 * mss);
+	ca_trace_check(&trace, CA_FAST_RECOVERY, 3 * mss + ssthresh, ssthresh);
+	ca_trace_check(&trace, CA_RECOVERED, ssthresh, ssthresh);
+
+	zassert_true(trace.cwnd[CA_AVOIDANCE] > ssthresh, "Window did not grow");
+	zassert_true(trace.cwnd[CA_AVOIDANCE] < 3 * mss,
+		     "Window grew past the window of the loss (%u)",
+		     trace.cwnd[CA_AVOIDANCE]);
+	zassert_equal(trace.ssthresh[CA_AVOIDANCE], ssthresh, "ssthresh changed");
+}
+
+/* Test case scenario
+ *   BBR-lite grows the window by the acknowledged data during startup and
+ *   does not treat a loss as a congestion signal.
+ */
+ZTEST(net_tcp, test_congestion_control_bbr)
+{
+	struct ca_trace trace;
+	uint16_t mss;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_BBR);
+
+	ca_scenario("bbr", &trace);
+	mss = trace.mss;
+
+	ca_trace_check(&trace, CA_INIT, mss, UINT16_MAX);
+	ca_trace_check(&trace, CA_SLOW_START, 4 * mss, UINT16_MAX);
+	ca_trace_check(&trace, CA_FAST_RECOVERY, 4 * mss, UINT16_MAX);
+	ca_trace_check(&trace, CA_RECOVERED, 7 * mss, UINT16_MAX);
+
+	/* Startup may end here, the window then follows the measured
+	 * bandwidth but never drops below four segments.
+	 */
+	zassert_true(trace.cwnd[CA_AVOIDANCE] >= 4 * mss, "Window too small (%u)",
+		     trace.cwnd[CA_AVOIDANCE]);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
+/* Test case scenario
+ *   Limit the pacing rate of a context and read the limit back,
+ *   a zero rate is rejected.
+ */
+ZTEST(net_tcp, test_max_pacing_rate_option)
+{
+	struct net_context *ctx;
+	uint32_t rate;
+	size_t len = sizeof(rate);
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_PACING);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_tcp_get_option(ctx, TCP_OPT_MAX_PACING_RATE, &rate, &len);
+	zassert_equal(ret, 0, "Failed to get pacing rate (%d)", ret);
+	zassert_equal(rate, UINT32_MAX, "Pacing rate limited by default");
+
+	rate = 10000;
+	ret = net_tcp_set_option(ctx, TCP_OPT_MAX_PACING_RATE, &rate, sizeof(rate));
+	zassert_equal(ret, 0, "Failed to set pacing rate (%d)", ret);
+
+	rate = 0;
+	ret = net_tcp_get_option(ctx, TCP_OPT_MAX_PACING_RATE, &rate, &len);
+	zassert_equal(ret, 0, "Failed to get pacing rate (%d)", ret);
+	zassert_equal(rate, 10000, "Unexpected pacing rate %u", rate);
+
+	rate = 0;
+	ret = net_tcp_set_option(ctx, TCP_OPT_MAX_PACING_RATE, &rate, sizeof(rate));
+	zassert_equal(ret, -EINVAL, "Zero pacing rate accepted (%d)", ret);
+
+	net_context_put(ctx);
+}
+
+#if defined(CONFIG_NET_TCP_PACING)
+#define PACING_INTERVAL_MS 20
+#define PACING_SEGMENTS 4
+
+/* Test case scenario
+ *   Limit the pacing rate to one segment every PACING_INTERVAL_MS,
+ *   queue a burst of data,
+ *   expect a single segment to be sent right away and the pacing timer
+ *   to be armed for the next one,
+ *   expect the remaining segments to be spaced by the pacing interval.
+ */
+ZTEST(net_tcp, test_max_pacing_rate_burst)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t tick_ms = k_ticks_to_ms_ceil32(1);
+	uint32_t rate;
+	uint16_t mss;
+	bool pending;
+	int ret;
+
+	ctx = sender_test_setup();
+	conn = accepted_ctx->tcp;
+	mss = conn_mss(conn);
+
+	rate = mss * MSEC_PER_SEC / PACING_INTERVAL_MS;
+	ret = net_tcp_set_option(accepted_ctx, TCP_OPT_MAX_PACING_RATE, &rate,
+				 sizeof(rate));
+	zassert_equal(ret, 0, "Failed to set pacing rate (%d)", ret);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Only pacing may hold back the burst */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = UINT16_MAX;
+	k_mutex_unlock(&conn->lock);
+#endif
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, PACING_SEGMENTS * mss,
+			       NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, PACING_SEGMENTS * mss, "Failed to send data (%d)", ret);
+
+	sender_wait_segments(1);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	pending = k_work_delayable_is_pending(&conn->pacing_timer);
+	k_mutex_unlock(&conn->lock);
+
+	zassert_true(pending, "Pacing timer not armed");
+	zassert_not_equal(k_sem_take(&sent_sem, K_MSEC(PACING_INTERVAL_MS / 2)), 0,
+			  "Segment sent before the pacing interval");
+
+	for (int i = 1; i < PACING_SEGMENTS; i++) {
+		int32_t gap;
+
+		/* Keep the retransmission timer from firing */
+		sender_ack(i * mss, 0, 0);
+
+		sender_wait_segments(1);
+		sender_check_segment(i, i * mss, mss);
+
+		/* A late timer may catch up by up to one tick */
+		gap = (int32_t)(sent_segments[i].time - sent_segments[i - 1].time);
+		zassert_true(gap >= (int32_t)(PACING_INTERVAL_MS - tick_ms - 1),
+			     "Segment %d sent after %d ms", i, gap);
+		zassert_true(gap <= (int32_t)(2 * PACING_INTERVAL_MS + tick_ms),
+			     "Segment %d delayed by %d ms", i, gap);
+	}
+
+	sender_ack(PACING_SEGMENTS * mss, 0, 0);
+	k_msleep(10);
+
+	zassert_equal(conn->send_data_total, 0, "Data not acknowledged");
+	zassert_equal(conn->tx_burst_max, 1, "Segments sent back to back (%u)",
+		      conn->tx_burst_max);
+
+	sender_test_teardown(ctx);
+}
+#endif /* CONFIG_NET_TCP_PACING */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -1053,6 +1053,92 @@ ZTEST(net_traffic_class, test_mix_all_2)
 	test_traffic_class_recv_data_mix_all_2();
 }
 
+#if defined(CONFIG_NET_RX_STEERING)
+static void rx_steering_stats_snapshot(struct net_rx_steering_stats *stats)
+{
+	for (int i = 0; i < net_rx_steering_queue_count(); i++) {
+		zassert_equal(net_rx_steering_stats_get(i, &stats[i]), 0,
+			      "Cannot get queue %d statistics", i);
+	}
+}
+
+ZTEST(net_traffic_class, test_rx_steering_flow)
+{
+	struct net_rx_steering_stats before[CONFIG_NET_RX_STEERING_QUEUES];
+	struct net_rx_steering_stats after[CONFIG_NET_RX_STEERING_QUEUES];
+	int queue = -1;
+
+	rx_steering_stats_snapshot(before);
+
+	/* The packets are sent from one context, so they share a 5-tuple */
+	test_traffic_class_recv_data_prio_be();
+	zassert_false(test_failed, "Traffic class verification failed.");
+
+	rx_steering_stats_snapshot(after);
+
+	for (int i = 0; i < net_rx_steering_queue_count(); i++) {
+		atomic_val_t pkts = atomic_get(&after[i].pkts) -
+				    atomic_get(&before[i].pkts);
+
+		zassert_equal(atomic_get(&after[i].depth), 0,
+			      "Queue %d not drained", i);
+
+		if (pkts == 0) {
+			continue;
+		}
+
+		zassert_equal(queue, -1, "Flow spread over queues %d and %d",
+			      queue, i);
+		queue = i;
+
+		zassert_equal(pkts, MAX_PKT_TO_RECV, "Queue %d got %ld packets",
+			      i, (long)pkts);
+		zassert_true(atomic_get(&after[i].bytes) >
+			     atomic_get(&before[i].bytes), "No bytes counted");
+		zassert_true(atomic_get(&after[i].max_depth) > 0,
+			     "Maximum depth not updated");
+	}
+
+	zassert_not_equal(queue, -1, "Flow not steered");
+}
+
+ZTEST(net_traffic_class, test_rx_steering_unknown_l3)
+{
+	struct net_rx_steering_stats before[CONFIG_NET_RX_STEERING_QUEUES];
+	struct net_rx_steering_stats after[CONFIG_NET_RX_STEERING_QUEUES];
+	/* Starts like a 6LoWPAN IPHC header, not like an IPv6 one */
+	static const uint8_t frame[] = { 0x61, 0x00, 0x3a, 0x02, 0x01, 0xff };
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface not found");
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(frame), AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+	zassert_equal(net_pkt_write(pkt, frame, sizeof(frame)), 0,
+		      "Cannot write pkt");
+
+	rx_steering_stats_snapshot(before);
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "Cannot receive pkt (%d)", ret);
+
+	/* Let the RX thread drop the packet */
+	k_sleep(K_MSEC(10));
+
+	rx_steering_stats_snapshot(after);
+
+	/* The family of the packet is unknown, so it must not be hashed */
+	for (int i = 0; i < net_rx_steering_queue_count(); i++) {
+		zassert_equal(atomic_get(&after[i].pkts), atomic_get(&before[i].pkts),
+			      "Packet of unknown family steered to queue %d", i);
+	}
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 static void run_before(void *dummy)
 {
 	ARG_UNUSED(dummy);
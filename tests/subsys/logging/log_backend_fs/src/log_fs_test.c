@@ -10,11 +10,13 @@
  *
  */
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/logging/log_backend_fs.h>
 
 #define DT_DRV_COMPAT zephyr_fstab_littlefs
 #define TEST_AUTOMOUNT DT_PROP(DT_DRV_INST(0), automount)
@@ -29,6 +31,7 @@ FS_FSTAB_DECLARE_ENTRY(PARTITION_NODE);
 static const char *log_prefix = CONFIG_LOG_BACKEND_FS_FILE_PREFIX;
 
 int write_log_to_file(uint8_t *data, size_t length, void *ctx);
+int write_log_to_buffer(uint8_t *data, size_t length, void *ctx);
 
 
 ZTEST(test_log_backend_fs, test_fs_nonexist)
@@ -230,4 +233,172 @@ ZTEST(test_log_backend_fs, test_log_fs_files_max)
 	zassert_equal(test_mask, 0b11110, "Unexpected file numeration");
 }
 
+ZTEST(test_log_backend_fs, test_log_fs_stats)
+{
+	struct log_backend_fs_stats before, after;
+	uint8_t to_log[] = "Counted log";
+	int rc;
+
+	log_backend_fs_stats_get(&before);
+
+	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	zassert_equal(rc, sizeof(to_log), "Unexpected rteval.");
+
+	log_backend_fs_stats_get(&after);
+
+	zassert_equal(after.writes, before.writes + 1);
+	zassert_equal(after.syncs, before.syncs + 1);
+	zassert_equal(after.bytes_written, before.bytes_written + sizeof(to_log));
+}
+
 ZTEST_SUITE(test_log_backend_fs, NULL, NULL, NULL, NULL, NULL);
+
+#ifdef CONFIG_LOG_BACKEND_FS_ASYNC
+#define ASYNC_BUF_SIZE CONFIG_LOG_BACKEND_FS_ASYNC_BUF_SIZE
+
+/* Log files are at most CONFIG_LOG_BACKEND_FS_FILE_SIZE bytes each */
+static uint8_t logs[CONFIG_LOG_BACKEND_FS_FILE_SIZE * CONFIG_LOG_BACKEND_FS_FILES_LIMIT];
+
+/* Read all log files, oldest first, into logs[] and return the length. */
+static size_t read_logs(void)
+{
+	struct fs_dir_t dir;
+	struct fs_file_t file;
+	char fname[MAX_PATH_LEN];
+	int min = INT_MAX, max = -1;
+	size_t len = 0;
+	int rc;
+
+	fs_dir_t_init(&dir);
+
+	zassert_equal(fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR), 0,
+		      "Can not open directory.");
+	while (true) {
+		struct fs_dirent ent = { 0 };
+		int num;
+
+		rc = fs_readdir(&dir, &ent);
+		if ((rc < 0) || (ent.name[0] == 0)) {
+			break;
+		}
+		if (ent.type == FS_DIR_ENTRY_FILE &&
+		    strncmp(ent.name, log_prefix, strlen(log_prefix)) == 0) {
+			num = atoi(&ent.name[strlen(log_prefix)]);
+			min = MIN(min, num);
+			max = MAX(max, num);
+		}
+	}
+	(void)fs_closedir(&dir);
+
+	for (int i = min; i <= max; i++) {
+		fs_file_t_init(&file);
+		sprintf(fname, "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR, log_prefix, i);
+		if (fs_open(&file, fname, FS_O_READ) != 0) {
+			continue;
+		}
+
+		rc = fs_read(&file, &logs[len], sizeof(logs) - len);
+		zassert_true(rc >= 0, "Can not read log file.");
+		len += rc;
+
+		zassert_equal(fs_close(&file), 0, "Can not close log file.");
+	}
+
+	return len;
+}
+
+static void zassert_logs_end_with(const uint8_t *data, size_t length)
+{
+	size_t len = read_logs();
+
+	zassert_true(len >= length, "Log files too short (%zu B)", len);
+	zassert_mem_equal(&logs[len - length], data, length,
+			  "Text inside log files is not correct.");
+}
+
+ZTEST(test_log_backend_fs_async, test_log_fs_async_file_content)
+{
+	struct log_backend_fs_stats before, after;
+	uint8_t to_log[] = "Async Log";
+	int rc;
+
+	log_backend_fs_stats_get(&before);
+
+	rc = write_log_to_buffer(to_log, sizeof(to_log), NULL);
+	zassert_equal(rc, sizeof(to_log), "Unexpected rteval.");
+
+	/* Buffered, not written yet */
+	log_backend_fs_stats_get(&after);
+	zassert_equal(after.bytes_logged, before.bytes_logged + sizeof(to_log));
+	zassert_equal(after.writes, before.writes);
+
+	log_backend_fs_flush();
+
+	log_backend_fs_stats_get(&after);
+	zassert_equal(after.writes, before.writes + 1);
+	zassert_equal(after.bytes_written, before.bytes_written + sizeof(to_log));
+	zassert_logs_end_with(to_log, sizeof(to_log));
+}
+
+ZTEST(test_log_backend_fs_async, test_log_fs_async_flush_timeout)
+{
+	struct log_backend_fs_stats before, after;
+	uint8_t to_log[] = "Timed Log";
+	int rc;
+
+	log_backend_fs_stats_get(&before);
+
+	rc = write_log_to_buffer(to_log, sizeof(to_log), NULL);
+	zassert_equal(rc, sizeof(to_log), "Unexpected rteval.");
+
+	k_msleep(CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT / 2);
+	log_backend_fs_stats_get(&after);
+	zassert_equal(after.writes, before.writes, "Written before the flush timeout");
+
+	/* The work queue writes the partly filled buffer once the timeout expires */
+	k_msleep(CONFIG_LOG_BACKEND_FS_ASYNC_FLUSH_TIMEOUT);
+	log_backend_fs_stats_get(&after);
+	zassert_equal(after.writes, before.writes + 1, "Not written after the flush timeout");
+	zassert_equal(after.bytes_written, before.bytes_written + sizeof(to_log));
+	zassert_logs_end_with(to_log, sizeof(to_log));
+}
+
+ZTEST(test_log_backend_fs_async, test_log_fs_async_rotation)
+{
+	struct log_backend_fs_stats before, after;
+	static uint8_t to_log[3 * ASYNC_BUF_SIZE];
+	int rc;
+
+	BUILD_ASSERT(sizeof(to_log) > CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+		     "Test output must not fit in one log file");
+
+	for (size_t i = 0; i < sizeof(to_log); i++) {
+		to_log[i] = 'a' + i % 26;
+	}
+
+	log_backend_fs_stats_get(&before);
+
+	/* Every full buffer is swapped and written by the work queue, the log
+	 * thread only waits when both buffers are full.
+	 */
+	for (size_t i = 0; i < sizeof(to_log); i += 7) {
+		size_t n = MIN(7, sizeof(to_log) - i);
+
+		rc = write_log_to_buffer(&to_log[i], n, NULL);
+		zassert_equal(rc, n, "Unexpected rteval.");
+	}
+
+	/* Nothing is left in the active buffer, wait for the last write */
+	log_backend_fs_flush();
+
+	log_backend_fs_stats_get(&after);
+	zassert_equal(after.writes, before.writes + 3, "Not written in whole buffers");
+	zassert_equal(after.bytes_written, before.bytes_written + sizeof(to_log));
+	zassert_true(after.rotations > before.rotations, "Log file not rotated");
+
+	/* Complete and in order across the rotated files */
+	zassert_logs_end_with(to_log, sizeof(to_log));
+}
+
+ZTEST_SUITE(test_log_backend_fs_async, NULL, NULL, NULL, NULL, NULL);
+#endif /* CONFIG_LOG_BACKEND_FS_ASYNC */
@@ -284,6 +284,48 @@ ZTEST(test_log_output, test_skip_src)
 	zassert_str_equal(exp_str, mock_buffer);
 }
 
+/* The prefix cache is filled only when the prefix ends up in the output buffer
+ * in one piece, so use an instance with a buffer large enough for a line.
+ */
+static uint8_t log_output_line_buf[64];
+LOG_OUTPUT_DEFINE(log_output_line, mock_output_func,
+		  log_output_line_buf, sizeof(log_output_line_buf));
+
+ZTEST(test_log_output, test_repeated_prefix)
+{
+	char package[256];
+	static const char *exp_str =
+		"[00:00:01.000,000] <inf> " DNAME "/" SNAME ": " TEST_STR "\r\n"
+		"[00:00:01.500,000] <inf> " DNAME "/" SNAME ": " TEST_STR "\r\n"
+		"[00:00:02.000,000] <err> " DNAME "/" SNAME ": " TEST_STR "\r\n"
+		"[00:00:02.000,000] <err> " SNAME ": " TEST_STR "\r\n";
+	uint32_t flags = LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP |
+			 LOG_OUTPUT_FLAG_LEVEL;
+	int err;
+
+	if (IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_DATE_TIMESTAMP) ||
+	    IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_ISO8601_TIMESTAMP)) {
+		ztest_test_skip();
+	}
+
+	log_output_timestamp_freq_set(1000000);
+
+	err = cbprintf_package(package, sizeof(package), 0, TEST_STR);
+	zassert_true(err > 0);
+
+	log_output_process(&log_output_line, 1000000, DNAME, SNAME, NULL, LOG_LEVEL_INF,
+			   package, NULL, 0, flags);
+	log_output_process(&log_output_line, 1500000, DNAME, SNAME, NULL, LOG_LEVEL_INF,
+			   package, NULL, 0, flags);
+	log_output_process(&log_output_line, 2000000, DNAME, SNAME, NULL, LOG_LEVEL_ERR,
+			   package, NULL, 0, flags);
+	log_output_process(&log_output_line, 2000000, NULL, SNAME, NULL, LOG_LEVEL_ERR,
+			   package, NULL, 0, flags);
+
+	mock_buffer[mock_len] = '\0';
+	zassert_str_equal(exp_str, mock_buffer);
+}
+
 static void before(void *notused)
 {
 	reset_mock_buffer();
@@ -0,0 +1,167 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/cbprintf.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define INTERVAL_MS CONFIG_LOG_RATELIMIT_INTERVAL_MS
+#define BURST       CONFIG_LOG_RATELIMIT_BURST
+
+static struct {
+	uint32_t msgs;
+	uint32_t reports;
+	char report[128];
+} out;
+
+struct fmt_buf {
+	char data[128];
+	size_t len;
+};
+
+static int char_out(int c, void *ctx)
+{
+	struct fmt_buf *buf = ctx;
+
+	if (buf->len < sizeof(buf->data) - 1) {
+		buf->data[buf->len++] = (char)c;
+	}
+
+	return c;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	struct fmt_buf buf = { .len = 0 };
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+
+	ARG_UNUSED(backend);
+
+	(void)cbpprintf((cbprintf_cb)char_out, &buf, package);
+	buf.data[buf.len] = '\0';
+
+	if (strstr(buf.data, "messages suppressed") != NULL) {
+		out.reports++;
+		strcpy(out.report, buf.data);
+	} else {
+		out.msgs++;
+	}
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(test_backend, backend_api, true);
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+/* Let the deferred report be emitted and the rate limit be refilled */
+static void wait_interval(void)
+{
+	k_msleep(INTERVAL_MS + 20);
+	flush();
+}
+
+static void log_rl(int i)
+{
+	LOG_WRN_RATELIMIT("test %d", i);
+}
+
+ZTEST(log_ratelimit, test_ratelimit)
+{
+	for (int i = 0; i < 10; i++) {
+		log_rl(i);
+	}
+	flush();
+
+	zassert_equal(out.msgs, BURST);
+
+	wait_interval();
+	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		zassert_equal(out.reports, 1);
+		zassert_str_equal(out.report, "7 messages suppressed: \"test %d\"");
+	} else {
+		zassert_equal(out.reports, 0);
+	}
+
+	/* Bucket is refilled after the interval */
+	log_rl(10);
+	flush();
+
+	zassert_equal(out.msgs, BURST + 1);
+	zassert_equal(out.reports, 1);
+	zassert_str_equal(out.report, "7 messages suppressed: \"test %d\"");
+}
+
+ZTEST(log_ratelimit, test_ratelimit_rate)
+{
+	for (int i = 0; i < 5; i++) {
+		LOG_INF_RATELIMIT_RATE(1, 10 * INTERVAL_MS, "rate %d", i);
+	}
+	flush();
+
+	zassert_equal(out.msgs, 1);
+
+	wait_interval();
+	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		zassert_equal(out.reports, 1);
+		zassert_str_equal(out.report, "4 messages suppressed: \"rate %d\"");
+	}
+}
+
+ZTEST(log_ratelimit, test_sampled)
+{
+	for (int i = 0; i < 10; i++) {
+		LOG_ERR_SAMPLED(4, "sample %d", i);
+	}
+	flush();
+
+	/* Calls 0, 4 and 8 */
+	zassert_equal(out.msgs, 3);
+
+	wait_interval();
+	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		zassert_equal(out.reports, 1);
+		zassert_str_equal(out.report, "7 messages suppressed: \"sample %d\"");
+	} else {
+		/* Reported by the sampled messages, the last one is still pending. */
+		zassert_equal(out.reports, 2);
+		zassert_str_equal(out.report, "3 messages suppressed: \"sample %d\"");
+	}
+}
+
+ZTEST(log_ratelimit, test_filtered_level)
+{
+	for (int i = 0; i < 10; i++) {
+		LOG_DBG_RATELIMIT("debug %d", i);
+		LOG_DBG_SAMPLED(2, "debug %d", i);
+	}
+
+	wait_interval();
+	zassert_equal(out.msgs, 0);
+	zassert_equal(out.reports, 0);
+}
+
+static void before(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	memset(&out, 0, sizeof(out));
+}
+
+ZTEST_SUITE(log_ratelimit, NULL, NULL, before, NULL, NULL);
@@ -344,6 +344,63 @@ ZTEST(sh, test_shell_fprintf)
 		     "Expected string to contain '%s', got '%s'", expect, buf);
 }
 
+#define OUTPUT_LONG_LEN  100
+#define OUTPUT_LINES     10
+
+static int cmd_output_order(const struct shell *sh, size_t argc, char **argv)
+{
+	char line[OUTPUT_LONG_LEN + 1];
+
+	/* One print longer than the output ring buffer, then many short ones */
+	for (int i = 0; i < OUTPUT_LONG_LEN; i++) {
+		line[i] = 'a' + i % 26;
+	}
+	line[OUTPUT_LONG_LEN] = '\0';
+
+	shell_print(sh, "%s", line);
+
+	for (int i = 0; i < OUTPUT_LINES; i++) {
+		shell_print(sh, "line %d", i);
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(test_output_order, NULL, NULL, cmd_output_order);
+
+ZTEST(sh, test_output_order)
+{
+	char expect[OUTPUT_LONG_LEN + 1];
+	const struct shell *sh;
+	const char *buf;
+	size_t size;
+
+	sh = shell_backend_dummy_get_ptr();
+	zassert_not_null(sh, "Failed to get shell");
+
+	shell_backend_dummy_clear_output(sh);
+	test_shell_execute_cmd("test_output_order", 0);
+	buf = shell_backend_dummy_get_output(sh, &size);
+
+	for (int i = 0; i < OUTPUT_LONG_LEN; i++) {
+		expect[i] = 'a' + i % 26;
+	}
+	expect[OUTPUT_LONG_LEN] = '\0';
+
+	/* Complete, also when it does not fit in CONFIG_SHELL_OUTPUT_BUFFER_SIZE */
+	buf = strstr(buf, expect);
+	zassert_not_null(buf, "Long line missing or cut");
+	buf += OUTPUT_LONG_LEN;
+
+	/* And in order */
+	for (int i = 0; i < OUTPUT_LINES; i++) {
+		snprintk(expect, sizeof(expect), "line %d", i);
+		buf = strstr(buf, expect);
+		zassert_not_null(buf, "'%s' missing or out of order", expect);
+		buf += strlen(expect);
+	}
+}
+
 #define RAW_ARG "aaa \"\" bbb"
 #define CMD_MAND_1_OPT_RAW_NAME cmd_mand_1_opt_raw
 